@@ -81,4 +81,11 @@ else ()
     message(FATAL_ERROR "Could not find: sndfile")
 endif ()
 
-
+# MP3 encoding is available since libsndfile 1.1.0
+include(CheckCSourceCompiles)
+set(CMAKE_REQUIRED_INCLUDES ${SNDFILE_INCDIR})
+check_c_source_compiles("
+    #include <sndfile.h>
+    int main(void) { return SF_FORMAT_MPEG | SF_FORMAT_MPEG_LAYER_III | SFC_SET_BITRATE_MODE; }
+    " SNDFILE_HAS_MPEG)
+unset(CMAKE_REQUIRED_INCLUDES)
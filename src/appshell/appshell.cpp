@@ -262,10 +262,18 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
     io::path stylePath = task.params[CommandLineController::ParamKey::StylePath].toString();
     bool forceMode = task.params[CommandLineController::ParamKey::ForceMode].toBool();
 
+    if (task.params.contains(CommandLineController::ParamKey::CachePath)) {
+        io::path cachePath = task.params[CommandLineController::ParamKey::CachePath].toString();
+        std::string cacheOptions = task.params[CommandLineController::ParamKey::CacheOptions].toString().toStdString();
+        converter()->setCache(cachePath, cacheOptions);
+    }
+
     switch (task.type) {
-    case CommandLineController::ConvertType::Batch:
-        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode);
-        break;
+    case CommandLineController::ConvertType::Batch: {
+        size_t workersCount = static_cast<size_t>(task.params.value(CommandLineController::ParamKey::BatchWorkersCount, 1).toInt());
+        io::path reportPath = task.params[CommandLineController::ParamKey::BatchReportPath].toString();
+        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode, workersCount, reportPath);
+    } break;
     case CommandLineController::ConvertType::ConvertScoreParts:
         ret = converter()->convertScoreParts(task.inputFile, task.outputFile, stylePath);
         break;
@@ -293,6 +301,9 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
         std::string scoreSource = task.params[CommandLineController::ParamKey::ScoreSource].toString().toStdString();
         ret = converter()->updateSource(task.inputFile, scoreSource, forceMode);
     } break;
+    case CommandLineController::ConvertType::Server:
+        ret = converter()->runServer(task.inputFile.toStdString());
+        break;
     }
 
     if (!ret) {
@@ -54,6 +54,20 @@ void CommandLineController::parse(const QStringList& args)
     // Converter mode
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
+    m_parser.addOption(QCommandLineOption("jobs",
+                                          "Use with '-j <file>', convert the scores of the job in parallel by 'count' worker processes",
+                                          "count"));
+    m_parser.addOption(QCommandLineOption("job-report",
+                                          "Use with '-j <file>', write the job report to 'file' instead of '<job file>.report.json'",
+                                          "file"));
+    m_parser.addOption(QCommandLineOption("converter-server",
+                                          "Keep running and convert the scores on the requests read from stdin, one JSON object per line"));
+    m_parser.addOption(QCommandLineOption("server-socket",
+                                          "Use with '--converter-server', read the requests from the local socket 'name' instead of stdin",
+                                          "name"));
+    m_parser.addOption(QCommandLineOption("cache-dir",
+                                          "Cache the conversion results in 'dir' and reuse them for the unchanged scores",
+                                          "dir"));
     m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
     m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
     m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
@@ -194,6 +208,25 @@ void CommandLineController::apply()
         application()->setRunMode(IApplication::RunMode::Converter);
         m_converterTask.type = ConvertType::Batch;
         m_converterTask.inputFile = m_parser.value("j");
+
+        if (m_parser.isSet("jobs")) {
+            std::optional<int> val = intValue("jobs");
+            if (val && val.value() > 0) {
+                m_converterTask.params[CommandLineController::ParamKey::BatchWorkersCount] = val.value();
+            } else {
+                LOGE() << "Option: --jobs not recognized count value: " << m_parser.value("jobs");
+            }
+        }
+
+        if (m_parser.isSet("job-report")) {
+            m_converterTask.params[CommandLineController::ParamKey::BatchReportPath] = m_parser.value("job-report");
+        }
+    }
+
+    if (m_parser.isSet("converter-server")) {
+        application()->setRunMode(IApplication::RunMode::Converter);
+        m_converterTask.type = ConvertType::Server;
+        m_converterTask.inputFile = m_parser.value("server-socket");
     }
 
     if (m_parser.isSet("score-media")) {
@@ -244,6 +277,11 @@ void CommandLineController::apply()
         }
     }
 
+    if (m_parser.isSet("cache-dir")) {
+        m_converterTask.params[CommandLineController::ParamKey::CachePath] = m_parser.value("cache-dir");
+        m_converterTask.params[CommandLineController::ParamKey::CacheOptions] = cacheOptions();
+    }
+
     if (m_parser.isSet("F") || m_parser.isSet("R")) {
         configuration()->revertToFactorySettings(m_parser.isSet("R"));
     }
@@ -265,6 +303,25 @@ void CommandLineController::apply()
     }
 }
 
+QString CommandLineController::cacheOptions() const
+{
+    //! NOTE The options that don't change the conversion results: the paths of the outputs and of the jobs,
+    //! the contents of the input files are hashed by the cache itself
+    static const QStringList NEUTRAL_OPTIONS {
+        "o", "export-to", "j", "job", "jobs", "job-report", "converter-server", "server-socket", "cache-dir",
+        "d", "debug", "S", "style", "highlight-config"
+    };
+
+    QStringList options;
+    for (const QString& name : m_parser.optionNames()) {
+        if (!NEUTRAL_OPTIONS.contains(name)) {
+            options << name + "=" + m_parser.values(name).join(",");
+        }
+    }
+
+    return options.join(" ");
+}
+
 CommandLineController::ConverterTask CommandLineController::converterTask() const
 {
     return m_converterTask;
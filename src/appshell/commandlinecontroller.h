@@ -59,7 +59,8 @@ public:
         ExportScoreParts,
         ExportScorePartsPdf,
         ExportScoreTranspose,
-        SourceUpdate
+        SourceUpdate,
+        Server
     };
 
     enum class ParamKey {
@@ -67,7 +68,11 @@ public:
         StylePath,
         ScoreSource,
         ScoreTransposeOptions,
-        ForceMode
+        ForceMode,
+        BatchWorkersCount,
+        BatchReportPath,
+        CachePath,
+        CacheOptions
     };
 
     struct ConverterTask {
@@ -86,6 +91,7 @@ public:
 
 private:
     void printLongVersion() const;
+    QString cacheOptions() const;
 
     QCommandLineParser m_parser;
     ConverterTask m_converterTask;
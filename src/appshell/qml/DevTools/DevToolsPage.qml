@@ -52,6 +52,7 @@ DockPage {
         case "mu3dialogs": root.central = notationDialogs; break
         case "telemetry": root.central = telemetryComp; break
         case "audio": root.central = audioComp; break
+        case "audiotelemetry": root.central = audioTelemetryComp; break
         case "synth": root.central = synthSettingsComp; break
         case "midiports": root.central = midiPortsComp; break
         case "vst": root.central = vstComponent; break
@@ -86,6 +87,7 @@ DockPage {
                         { "name": "mu3dialogs", "title": "MU3Dialogs" },
                         { "name": "telemetry", "title": "Telemetry" },
                         { "name": "audio", "title": "Audio" },
+                        { "name": "audiotelemetry", "title": "Audio telemetry" },
                         { "name": "synth", "title": "Synth" },
                         { "name": "midiports", "title": "MIDI ports" },
                         { "name": "vst", "title": "VST" },
@@ -142,6 +144,12 @@ DockPage {
         Playback {}
     }
 
+    Component {
+        id: audioTelemetryComp
+
+        AudioTelemetry {}
+    }
+
     Component {
         id: synthSettingsComp
 
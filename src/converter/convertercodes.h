@@ -32,6 +32,9 @@ enum class Err {
 
     BatchJobFileFailedOpen = 1301,
     BatchJobFileFailedParse = 1302,
+    BatchJobFailed = 1303,
+    BatchJobWorkerFailed = 1304,
+    BatchJobReportFailedWrite = 1305,
 
     ConvertTypeUnknown = 1310,
 
@@ -39,6 +42,9 @@ enum class Err {
 
     OutFileFailedOpen = 1330,
     OutFileFailedWrite = 1331,
+
+    ServerFailedListen = 1340,
+    ServerInvalidRequest = 1341,
 };
 
 inline Ret make_ret(Err e)
@@ -25,6 +25,7 @@
 #include "modularity/imoduleexport.h"
 #include "ret.h"
 #include "io/path.h"
+#include "progress.h"
 
 namespace mu::converter {
 class IConverterController : MODULE_EXPORT_INTERFACE
@@ -34,7 +35,8 @@ public:
     virtual ~IConverterController() = default;
 
     virtual Ret fileConvert(const io::path& in, const io::path& out, const io::path& stylePath = io::path(), bool forceMode = false) = 0;
-    virtual Ret batchConvert(const io::path& batchJobFile, const io::path& stylePath = io::path(), bool forceMode = false) = 0;
+    virtual Ret batchConvert(const io::path& batchJobFile, const io::path& stylePath = io::path(), bool forceMode = false,
+                             size_t workersCount = 1, const io::path& reportPath = io::path()) = 0;
     virtual Ret convertScoreParts(const io::path& in, const io::path& out, const io::path& stylePath = io::path(),
                                   bool forceMode = false) = 0;
 
@@ -51,6 +53,20 @@ public:
                                      const io::path& stylePath = io::path(), bool forceMode = false) = 0;
 
     virtual Ret updateSource(const io::path& in, const std::string& newSource, bool forceMode = false) = 0;
+
+    //! NOTE Serves the conversion requests until the shutdown request or the end of the input.
+    //! The requests are read from the local socket with the given name or from stdin, if the name is empty
+    virtual Ret runServer(const std::string& socketName = std::string()) = 0;
+
+    //! NOTE Enables the on-disk cache of the conversion results in the given directory.
+    //! The options are the ones the results depend on besides the settings, e.g. the command line options
+    virtual void setCache(const io::path& cachePath, const std::string& options) = 0;
+
+    //! NOTE The progress of the conversion running now, the receivers are called by the conversion itself
+    virtual framework::ProgressChannel progressChanged() const = 0;
+
+    //! NOTE Interrupts the conversion running now at its next step, it returns Ret::Code::Cancel
+    virtual void cancel() = 0;
 };
 }
 
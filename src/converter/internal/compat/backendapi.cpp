@@ -21,6 +21,8 @@
  */
 #include "backendapi.h"
 
+#include <algorithm>
+#include <deque>
 #include <stdio.h>
 
 #include <QString>
@@ -30,11 +32,17 @@
 #include <QJsonArray>
 #include <QJsonValue>
 #include <QRandomGenerator>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 #include "engraving/compat/scoreaccess.h"
 #include "libmscore/excerpt.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/page.h"
 
 #include "backendjsonwriter.h"
+#include "base64device.h"
 #include "notationmeta.h"
 
 #include "log.h"
@@ -70,21 +78,70 @@ Ret BackendApi::exportScoreMedia(const io::path& in, const io::path& out, const
 
     INotationPtr notation = openScoreRetVal.val->notation();
 
-    bool result = true;
+    QElapsedTimer timer;
+    timer.start();
+
+    //! NOTE The pages, the positions and the pdf only read the laid out score, so they are rendered at once by the thread pool.
+    //! The repeats are unwound beforehand, the positions writers read them
+    Ms::MasterScore* masterScore = notation->elements()->msScore()->masterScore();
+    masterScore->setExpandRepeats(true);
+    masterScore->repeatList();
+
+    //! NOTE The renders of a page (png, svg, pdf) read its bsp tree at once, so it is rebuilt here
+    for (Ms::Page* page : notation->elements()->msScore()->pages()) {
+        page->validateBspTree();
+    }
+
+    INotationWriter::Options pngOptions {
+        { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
+    };
+
+    INotationWriter::Options svgOptions {
+        { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) },
+        { INotationWriter::OptionKey::NOTES_COLORS, Val(readNotesColors(highlightConfigPath)) }
+    };
+
+    //! NOTE The pngs and the pdf paint the same pages, so each page is recorded once
+    if (pageRecordsCache()) {
+        pageRecordsCache()->open();
+    }
+
+    QFuture<MediaItem> segmentsPositions = startRenderMediaItem(SEGMENTS_POSITIONS_WRITER_NAME, notation);
+    QFuture<MediaItem> measuresPositions = startRenderMediaItem(MEASURES_POSITIONS_WRITER_NAME, notation);
+    QFuture<MediaItem> pdf = startRenderMediaItem(PDF_WRITER_NAME, notation);
 
     QFile outputFile;
     openOutputFile(outputFile, out);
 
     BackendJsonWriter jsonWriter(&outputFile);
+    QJsonObject timings;
+
+    bool result = true;
+
+    result &= writeMediaPages("pngs", PNG_WRITER_NAME, notation, pngOptions, jsonWriter, timings, ADD_SEPARATOR);
+    result &= writeMediaPages("svgs", SVG_WRITER_NAME, notation, svgOptions, jsonWriter, timings, ADD_SEPARATOR);
+    result &= writeMediaItem(SEGMENTS_POSITIONS_WRITER_NAME, segmentsPositions.result(), jsonWriter, timings, ADD_SEPARATOR);
+    result &= writeMediaItem(MEASURES_POSITIONS_WRITER_NAME, measuresPositions.result(), jsonWriter, timings, ADD_SEPARATOR);
+    result &= writeMediaItem(PDF_WRITER_NAME, pdf.result(), jsonWriter, timings, ADD_SEPARATOR);
+
+    if (pageRecordsCache()) {
+        pageRecordsCache()->close();
+    }
+
+    //! NOTE The midi and the musicxml export modify the score (the repeats, the concert pitch),
+    //! so they are done when the rendering is finished. The midi writer seeks, so it's written to the memory first
+    result &= writeMediaItem(MIDI_WRITER_NAME, renderMediaItem(MIDI_WRITER_NAME, notation), jsonWriter, timings, ADD_SEPARATOR);
+    result &= streamMediaItem(MUSICXML_WRITER_NAME, notation, jsonWriter, timings, ADD_SEPARATOR);
+
+    QElapsedTimer metaDataTimer;
+    metaDataTimer.start();
+    result &= exportScoreMetaData(notation, jsonWriter, ADD_SEPARATOR);
+    timings[QString::fromStdString(META_DATA_NAME)] = metaDataTimer.elapsed();
 
-    result &= exportScorePngs(notation, jsonWriter, ADD_SEPARATOR);
-    result &= exportScoreSvgs(notation, highlightConfigPath, jsonWriter, ADD_SEPARATOR);
-    result &= exportScoreElementsPositions(SEGMENTS_POSITIONS_WRITER_NAME, notation, jsonWriter, ADD_SEPARATOR);
-    result &= exportScoreElementsPositions(MEASURES_POSITIONS_WRITER_NAME, notation, jsonWriter, ADD_SEPARATOR);
-    result &= exportScorePdf(notation, jsonWriter, ADD_SEPARATOR);
-    result &= exportScoreMidi(notation, jsonWriter, ADD_SEPARATOR);
-    result &= exportScoreMusicXML(notation, jsonWriter, ADD_SEPARATOR);
-    result &= exportScoreMetaData(notation, jsonWriter);
+    timings["total"] = timer.elapsed();
+
+    jsonWriter.addKey("timings");
+    jsonWriter.addValue(QJsonDocument(timings).toJson(QJsonDocument::Compact), false, true);
 
     return result ? make_ret(Ret::Code::Ok) : make_ret(Ret::Code::InternalError);
 }
@@ -274,163 +331,144 @@ QVariantMap BackendApi::readNotesColors(const io::path& filePath)
     return result;
 }
 
-Ret BackendApi::exportScorePngs(const INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator)
+QFuture<BackendApi::MediaItem> BackendApi::startRenderMediaItem(const std::string& writerName, const INotationPtr notation)
 {
-    TRACEFUNC
-
-    auto pngWriter = writers()->writer(PNG_WRITER_NAME);
-    if (!pngWriter) {
-        LOGW() << "Not found writer " << PNG_WRITER_NAME;
-        return make_ret(Ret::Code::InternalError);
-    }
-
-    jsonWriter.addKey("pngs");
-    jsonWriter.openArray();
+    return QtConcurrent::run([writerName, notation]() {
+        return renderMediaItem(writerName, notation);
+    });
+}
 
-    PageList notationPages = pages(notation);
+BackendApi::MediaItem BackendApi::renderMediaItem(const std::string& writerName, const INotationPtr notation,
+                                                  const INotationWriter::Options& options)
+{
+    TRACEFUNC
 
-    bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        QByteArray pngData;
-        QBuffer pngDevice(&pngData);
-        pngDevice.open(QIODevice::ReadWrite);
-
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
-        };
-
-        Ret writeRet = pngWriter->write(notation, pngDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
-            result = false;
-        }
+    QElapsedTimer timer;
+    timer.start();
 
-        bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(pngData.toBase64(), lastArrayValue);
-    }
+    RetVal<QByteArray> writerRetVal = processWriter(writerName, notation, options);
 
-    jsonWriter.closeArray(addSeparator);
+    MediaItem item;
+    item.ret = writerRetVal.ret;
+    item.data = writerRetVal.val;
+    item.timeMs = timer.elapsed();
 
-    return result ? make_ret(Ret::Code::Ok) : make_ret(Ret::Code::InternalError);
+    return item;
 }
 
-Ret BackendApi::exportScoreSvgs(const INotationPtr notation, const io::path& highlightConfigPath, BackendJsonWriter& jsonWriter,
+Ret BackendApi::writeMediaPages(const std::string& key, const std::string& writerName, const INotationPtr notation,
+                                const INotationWriter::Options& options, BackendJsonWriter& jsonWriter, QJsonObject& timings,
                                 bool addSeparator)
 {
     TRACEFUNC
 
-    auto svgWriter = writers()->writer(SVG_WRITER_NAME);
-    if (!svgWriter) {
-        LOGW() << "Not found writer " << SVG_WRITER_NAME;
-        return make_ret(Ret::Code::InternalError);
+    //! NOTE The pages are rendered in parallel, but only as many of them as the pool runs at once are kept in memory
+    const size_t pagesCount = pages(notation).size();
+    const size_t maxRendersCount = static_cast<size_t>(std::max(1, QThreadPool::globalInstance()->maxThreadCount()));
+
+    std::deque<QFuture<MediaItem> > renders;
+    size_t nextPage = 0;
+
+    auto startNextRender = [&]() {
+        INotationWriter::Options pageOptions = options;
+        pageOptions[INotationWriter::OptionKey::PAGE_NUMBER] = Val(static_cast<int>(nextPage));
+        ++nextPage;
+
+        renders.push_back(QtConcurrent::run([writerName, notation, pageOptions]() {
+            return renderMediaItem(writerName, notation, pageOptions);
+        }));
+    };
+
+    while (nextPage < pagesCount && renders.size() < maxRendersCount) {
+        startNextRender();
     }
 
-    jsonWriter.addKey("svgs");
+    jsonWriter.addKey(key.c_str());
     jsonWriter.openArray();
 
-    PageList notationPages = pages(notation);
-    QVariantMap notesColors = readNotesColors(highlightConfigPath);
-
     bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        QByteArray svgData;
-        QBuffer svgDevice(&svgData);
-        svgDevice.open(QIODevice::ReadWrite);
-
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) },
-            { INotationWriter::OptionKey::NOTES_COLORS, Val(notesColors) }
-        };
-
-        Ret writeRet = svgWriter->write(notation, svgDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
+    int64_t timeMs = 0;
+
+    for (size_t i = 0; i < pagesCount; ++i) {
+        MediaItem page = renders.front().result();
+        renders.pop_front();
+
+        if (nextPage < pagesCount) {
+            startNextRender();
+        }
+
+        if (!page.ret) {
             result = false;
         }
 
-        bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(svgData.toBase64(), !lastArrayValue);
+        bool lastArrayValue = ((pagesCount - 1) == i);
+        jsonWriter.addBase64Value(page.data, !lastArrayValue);
+
+        timeMs += page.timeMs;
     }
 
     jsonWriter.closeArray(addSeparator);
 
+    //! NOTE The sum of the pages times, they are rendered in parallel
+    timings[QString::fromStdString(key)] = static_cast<qint64>(timeMs);
+
     return result ? make_ret(Ret::Code::Ok) : make_ret(Ret::Code::InternalError);
 }
 
-Ret BackendApi::exportScoreElementsPositions(const std::string& elementsPositionsWriterName, const INotationPtr notation,
-                                             BackendJsonWriter& jsonWriter, bool addSeparator)
+Ret BackendApi::writeMediaItem(const std::string& key, const MediaItem& item, BackendJsonWriter& jsonWriter, QJsonObject& timings,
+                               bool addSeparator)
 {
-    TRACEFUNC
+    timings[QString::fromStdString(key)] = static_cast<qint64>(item.timeMs);
 
-    RetVal<QByteArray> writerRetVal = processWriter(elementsPositionsWriterName, notation);
-    if (!writerRetVal.ret) {
-        return writerRetVal.ret;
+    if (!item.ret) {
+        return item.ret;
     }
 
-    jsonWriter.addKey(elementsPositionsWriterName.c_str());
-    jsonWriter.addValue(writerRetVal.val, addSeparator, false);
+    jsonWriter.addKey(key.c_str());
+    jsonWriter.addBase64Value(item.data, addSeparator);
 
     return make_ret(Ret::Code::Ok);
 }
 
-Ret BackendApi::exportScorePdf(const INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator)
+Ret BackendApi::streamMediaItem(const std::string& writerName, const INotationPtr notation, BackendJsonWriter& jsonWriter,
+                                QJsonObject& timings, bool addSeparator)
 {
     TRACEFUNC
 
-    RetVal<QByteArray> writerRetVal = processWriter(PDF_WRITER_NAME, notation);
-    if (!writerRetVal.ret) {
-        return writerRetVal.ret;
+    auto writer = writers()->writer(writerName);
+    if (!writer) {
+        LOGW() << "Not found writer " << writerName;
+        return make_ret(Ret::Code::InternalError);
     }
 
-    jsonWriter.addKey(PDF_WRITER_NAME.c_str());
-    jsonWriter.addValue(writerRetVal.val, addSeparator);
-
-    return make_ret(Ret::Code::Ok);
-}
+    QElapsedTimer timer;
+    timer.start();
 
-Ret BackendApi::exportScorePdf(const INotationPtr notation, Device& destinationDevice)
-{
-    TRACEFUNC
+    jsonWriter.addKey(writerName.c_str());
 
-    RetVal<QByteArray> writerRetVal = processWriter(PDF_WRITER_NAME, notation);
-    if (!writerRetVal.ret) {
-        return writerRetVal.ret;
+    Ret ret = writer->write(notation, *jsonWriter.openBase64Value());
+    if (!ret) {
+        LOGW() << ret.toString();
     }
 
-    bool ok = destinationDevice.write(QJsonDocument::fromJson(writerRetVal.val).toJson(QJsonDocument::Compact)) != -1;
-    destinationDevice.close();
+    jsonWriter.closeBase64Value(addSeparator);
 
-    return ok ? make_ret(Ret::Code::Ok) : make_ret(Ret::Code::InternalError);
-}
+    timings[QString::fromStdString(writerName)] = static_cast<qint64>(timer.elapsed());
 
-Ret BackendApi::exportScoreMidi(const INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator)
-{
-    TRACEFUNC
-
-    RetVal<QByteArray> writerRetVal = processWriter(MIDI_WRITER_NAME, notation);
-    if (!writerRetVal.ret) {
-        return writerRetVal.ret;
-    }
-
-    jsonWriter.addKey(MIDI_WRITER_NAME.c_str());
-    jsonWriter.addValue(writerRetVal.val, addSeparator);
-
-    return make_ret(Ret::Code::Ok);
+    return ret;
 }
 
-Ret BackendApi::exportScoreMusicXML(const INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator)
+Ret BackendApi::exportScorePdf(const INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator)
 {
     TRACEFUNC
 
-    RetVal<QByteArray> writerRetVal = processWriter(MUSICXML_WRITER_NAME, notation);
+    RetVal<QByteArray> writerRetVal = processWriter(PDF_WRITER_NAME, notation);
     if (!writerRetVal.ret) {
         return writerRetVal.ret;
     }
 
-    jsonWriter.addKey(MUSICXML_WRITER_NAME.c_str());
-    jsonWriter.addValue(writerRetVal.val, addSeparator);
+    jsonWriter.addKey(PDF_WRITER_NAME.c_str());
+    jsonWriter.addBase64Value(writerRetVal.val, addSeparator);
 
     return make_ret(Ret::Code::Ok);
 }
@@ -451,7 +489,8 @@ Ret BackendApi::exportScoreMetaData(const INotationPtr notation, BackendJsonWrit
     return make_ret(Ret::Code::Ok);
 }
 
-mu::RetVal<QByteArray> BackendApi::processWriter(const std::string& writerName, const INotationPtr notation)
+mu::RetVal<QByteArray> BackendApi::processWriter(const std::string& writerName, const INotationPtr notation,
+                                                 const INotationWriter::Options& options)
 {
     auto writer = writers()->writer(writerName);
     if (!writer) {
@@ -463,7 +502,7 @@ mu::RetVal<QByteArray> BackendApi::processWriter(const std::string& writerName,
     QBuffer device(&data);
     device.open(QIODevice::ReadWrite);
 
-    Ret writeRet = writer->write(notation, device);
+    Ret writeRet = writer->write(notation, device, options);
     if (!writeRet) {
         LOGW() << writeRet.toString();
         return writeRet;
@@ -471,7 +510,7 @@ mu::RetVal<QByteArray> BackendApi::processWriter(const std::string& writerName,
 
     RetVal<QByteArray> result;
     result.ret = make_ret(Ret::Code::Ok);
-    result.val = data.toBase64();
+    result.val = data;
 
     device.close();
 
@@ -499,7 +538,7 @@ mu::RetVal<QByteArray> BackendApi::processWriter(const std::string& writerName,
 
     RetVal<QByteArray> result;
     result.ret = make_ret(Ret::Code::Ok);
-    result.val = data.toBase64();
+    result.val = data;
 
     device.close();
 
@@ -548,42 +587,51 @@ Ret BackendApi::doExportScoreParts(const notation::INotationPtr notation, Device
 Ret BackendApi::doExportScorePartsPdfs(const IMasterNotationPtr masterNotation, Device& destinationDevice,
                                        const std::string& scoreFileName)
 {
-    QJsonObject jsonForPdfs;
-    jsonForPdfs["score"] = QString::fromStdString(scoreFileName);
-    QByteArray scoreBin = processWriter(PDF_WRITER_NAME, masterNotation->notation()).val;
-    jsonForPdfs["scoreBin"] = QString::fromLatin1(scoreBin);
+    BackendJsonWriter jsonWriter(&destinationDevice);
 
-    INotationPtrList notations;
+    jsonWriter.addKey("score");
+    jsonWriter.addStringValue(QString::fromStdString(scoreFileName), ADD_SEPARATOR);
 
-    QJsonArray partsArray;
+    jsonWriter.addKey("scoreBin");
+    jsonWriter.addBase64Value(processWriter(PDF_WRITER_NAME, masterNotation->notation()).val, ADD_SEPARATOR);
+
+    INotationPtrList notations;
     QJsonArray partsNamesArray;
     for (IExcerptNotationPtr e : masterNotation->excerpts().val) {
-        QJsonValue partNameVal(e->title());
-        partsNamesArray.append(partNameVal);
-
-        QByteArray partBin = processWriter(PDF_WRITER_NAME, e->notation()).val;
-        QJsonValue partVal(QString::fromLatin1(partBin));
-        partsArray.append(partVal);
-
+        partsNamesArray.append(QJsonValue(e->title()));
         notations.push_back(e->notation());
     }
 
-    jsonForPdfs["parts"] = partsNamesArray;
-    jsonForPdfs["partsBin"] = partsArray;
+    jsonWriter.addKey("parts");
+    jsonWriter.addValue(QJsonDocument(partsNamesArray).toJson(QJsonDocument::Compact), ADD_SEPARATOR, true);
 
-    jsonForPdfs["scoreFullPostfix"] = QString("-Score_and_parts") + ".pdf";
+    //! NOTE One part is kept in memory at once
+    jsonWriter.addKey("partsBin");
+    jsonWriter.openArray();
+    for (size_t i = 0; i < notations.size(); ++i) {
+        bool lastArrayValue = ((notations.size() - 1) == i);
+        jsonWriter.addBase64Value(processWriter(PDF_WRITER_NAME, notations[i]).val, !lastArrayValue);
+    }
+    jsonWriter.closeArray(ADD_SEPARATOR);
+
+    jsonWriter.addKey("scoreFullPostfix");
+    jsonWriter.addStringValue(QString("-Score_and_parts") + ".pdf", ADD_SEPARATOR);
 
     INotationWriter::Options options {
         { INotationWriter::OptionKey::UNIT_TYPE, Val(static_cast<int>(INotationWriter::UnitType::MULTI_PART)) }
     };
 
     QByteArray fullScoreData = processWriter(PDF_WRITER_NAME, notations, options).val;
-    jsonForPdfs["scoreFullBin"] = QString::fromLatin1(fullScoreData.toBase64());
 
-    QJsonDocument jsonDoc(jsonForPdfs);
-    bool ok = destinationDevice.write(QJsonDocument(jsonDoc).toJson(QJsonDocument::Compact)) != -1;
+    //! NOTE The full score is encoded to base64 twice, the clients expect it so
+    jsonWriter.addKey("scoreFullBin");
+    Base64Device fullScoreDevice(jsonWriter.openBase64Value());
+    fullScoreDevice.open(QIODevice::WriteOnly);
+    fullScoreDevice.write(fullScoreData);
+    fullScoreDevice.close();
+    jsonWriter.closeBase64Value();
 
-    return ok;
+    return make_ret(Ret::Code::Ok);
 }
 
 Ret BackendApi::doExportScoreTranspose(const INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator)
@@ -22,6 +22,9 @@
 #ifndef MU_CONVERTER_BACKENDAPI_H
 #define MU_CONVERTER_BACKENDAPI_H
 
+#include <QFuture>
+#include <QJsonObject>
+
 #include "retval.h"
 
 #include "io/path.h"
@@ -31,6 +34,7 @@
 #include "system/ifilesystem.h"
 #include "project/iprojectcreator.h"
 #include "project/inotationwritersregister.h"
+#include "importexport/imagesexport/ipagerecordscache.h"
 
 namespace Ms {
 class Score;
@@ -43,6 +47,7 @@ class BackendApi
     INJECT_STATIC(converter, system::IFileSystem, fileSystem)
     INJECT_STATIC(converter, project::IProjectCreator, notationCreator)
     INJECT_STATIC(converter, project::INotationWritersRegister, writers)
+    INJECT_STATIC(converter, iex::imagesexport::IPageRecordsCache, pageRecordsCache)
 
 public:
     static Ret exportScoreMedia(const io::path& in, const io::path& out, const io::path& highlightConfigPath,
@@ -56,6 +61,12 @@ public:
     static Ret updateSource(const io::path& in, const std::string& newSource, bool forceMode = false);
 
 private:
+    struct MediaItem {
+        Ret ret;
+        QByteArray data;
+        int64_t timeMs = 0;
+    };
+
     static Ret openOutputFile(QFile& file, const io::path& out);
 
     static RetVal<project::INotationProjectPtr> openProject(const io::path& path,
@@ -68,18 +79,23 @@ private:
 
     static QVariantMap readNotesColors(const io::path& filePath);
 
-    static Ret exportScorePngs(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
-    static Ret exportScoreSvgs(const notation::INotationPtr notation, const io::path& highlightConfigPath, BackendJsonWriter& jsonWriter,
+    static QFuture<MediaItem> startRenderMediaItem(const std::string& writerName, const notation::INotationPtr notation);
+    static MediaItem renderMediaItem(const std::string& writerName, const notation::INotationPtr notation,
+                                     const project::INotationWriter::Options& options = project::INotationWriter::Options());
+
+    static Ret writeMediaPages(const std::string& key, const std::string& writerName, const notation::INotationPtr notation,
+                               const project::INotationWriter::Options& options, BackendJsonWriter& jsonWriter, QJsonObject& timings,
                                bool addSeparator = false);
-    static Ret exportScoreElementsPositions(const std::string& elementsPositionsWriterName, const notation::INotationPtr notation,
-                                            BackendJsonWriter& jsonWriter, bool addSeparator = false);
+    static Ret writeMediaItem(const std::string& key, const MediaItem& item, BackendJsonWriter& jsonWriter, QJsonObject& timings,
+                              bool addSeparator = false);
+    static Ret streamMediaItem(const std::string& writerName, const notation::INotationPtr notation, BackendJsonWriter& jsonWriter,
+                               QJsonObject& timings, bool addSeparator = false);
+
     static Ret exportScorePdf(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
-    static Ret exportScorePdf(const notation::INotationPtr notation, mu::io::Device& destinationDevice);
-    static Ret exportScoreMidi(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
-    static Ret exportScoreMusicXML(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
     static Ret exportScoreMetaData(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
 
-    static mu::RetVal<QByteArray> processWriter(const std::string& writerName, const notation::INotationPtr notation);
+    static mu::RetVal<QByteArray> processWriter(const std::string& writerName, const notation::INotationPtr notation,
+                                                const project::INotationWriter::Options& options = project::INotationWriter::Options());
     static mu::RetVal<QByteArray> processWriter(const std::string& writerName, const notation::INotationPtrList notations,
                                                 const project::INotationWriter::Options& options);
 
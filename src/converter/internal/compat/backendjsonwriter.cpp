@@ -21,6 +21,11 @@
  */
 #include "backendjsonwriter.h"
 
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include "base64device.h"
+
 using namespace mu::converter;
 using namespace mu::io;
 
@@ -58,6 +63,39 @@ void BackendJsonWriter::addValue(const QByteArray& data, bool addSeparator, bool
     }
 }
 
+void BackendJsonWriter::addStringValue(const QString& str, bool addSeparator)
+{
+    //! NOTE Qt can't write a single json value, so it is written as an array and the brackets are cut off
+    QByteArray json = QJsonDocument(QJsonArray { str }).toJson(QJsonDocument::Compact);
+    addValue(json.mid(1, json.size() - 2), addSeparator, true);
+}
+
+void BackendJsonWriter::addBase64Value(const QByteArray& data, bool addSeparator)
+{
+    openBase64Value()->write(data);
+    closeBase64Value(addSeparator);
+}
+
+mu::io::Device* BackendJsonWriter::openBase64Value()
+{
+    m_destinationDevice->write("\"");
+
+    m_base64Device = std::make_unique<Base64Device>(m_destinationDevice);
+    m_base64Device->open(QIODevice::WriteOnly);
+
+    return m_base64Device.get();
+}
+
+void BackendJsonWriter::closeBase64Value(bool addSeparator)
+{
+    m_base64Device.reset();
+
+    m_destinationDevice->write("\"");
+    if (addSeparator) {
+        m_destinationDevice->write(",\n");
+    }
+}
+
 void BackendJsonWriter::openArray()
 {
     m_destinationDevice->write(" [");
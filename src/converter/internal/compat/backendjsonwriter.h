@@ -22,10 +22,13 @@
 #ifndef MU_CONVERTER_BACKENDJSONWRITER_H
 #define MU_CONVERTER_BACKENDJSONWRITER_H
 
+#include <memory>
+
 #include "io/path.h"
 #include "io/device.h"
 
 namespace mu::converter {
+class Base64Device;
 class BackendJsonWriter
 {
 public:
@@ -34,12 +37,19 @@ public:
 
     void addKey(const char* arrayName);
     void addValue(const QByteArray& data, bool addSeparator = false, bool isJson = false);
+    void addStringValue(const QString& str, bool addSeparator = false);
+
+    //! NOTE The data is encoded to base64 straight into the destination device
+    void addBase64Value(const QByteArray& data, bool addSeparator = false);
+    io::Device* openBase64Value();
+    void closeBase64Value(bool addSeparator = false);
 
     void openArray();
     void closeArray(bool addSeparator = false);
 
 private:
     io::Device* m_destinationDevice = nullptr;
+    std::unique_ptr<Base64Device> m_base64Device;
 };
 }
 
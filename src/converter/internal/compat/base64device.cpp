@@ -0,0 +1,101 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "base64device.h"
+
+#include <algorithm>
+
+using namespace mu::converter;
+using namespace mu::io;
+
+//! NOTE Whole triplets, so the chunks are encoded without the padding
+static constexpr qint64 CHUNK_SIZE = 3 * 16 * 1024;
+
+Base64Device::Base64Device(Device* destinationDevice)
+    : m_destinationDevice(destinationDevice)
+{
+}
+
+Base64Device::~Base64Device()
+{
+    close();
+}
+
+bool Base64Device::isSequential() const
+{
+    return true;
+}
+
+void Base64Device::close()
+{
+    if (isOpen() && !m_tail.isEmpty()) {
+        writeEncoded(m_tail.constData(), m_tail.size());
+        m_tail.clear();
+    }
+
+    Device::close();
+}
+
+qint64 Base64Device::readData(char*, qint64)
+{
+    return -1;
+}
+
+qint64 Base64Device::writeData(const char* data, qint64 size)
+{
+    const char* begin = data;
+    const char* end = data + size;
+
+    if (!m_tail.isEmpty()) {
+        while (m_tail.size() < 3 && begin != end) {
+            m_tail.append(*begin++);
+        }
+
+        if (m_tail.size() < 3) {
+            return size;
+        }
+
+        if (!writeEncoded(m_tail.constData(), m_tail.size())) {
+            return -1;
+        }
+
+        m_tail.clear();
+    }
+
+    while (end - begin >= 3) {
+        qint64 chunkSize = std::min(CHUNK_SIZE, static_cast<qint64>(end - begin) / 3 * 3);
+        if (!writeEncoded(begin, chunkSize)) {
+            return -1;
+        }
+
+        begin += chunkSize;
+    }
+
+    m_tail.append(begin, static_cast<int>(end - begin));
+
+    return size;
+}
+
+bool Base64Device::writeEncoded(const char* data, qint64 size)
+{
+    QByteArray encoded = QByteArray::fromRawData(data, static_cast<int>(size)).toBase64();
+    return m_destinationDevice->write(encoded) == encoded.size();
+}
@@ -0,0 +1,53 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_CONVERTER_BASE64DEVICE_H
+#define MU_CONVERTER_BASE64DEVICE_H
+
+#include <QByteArray>
+
+#include "io/device.h"
+
+namespace mu::converter {
+//! NOTE Encodes the written data to base64 and writes it to the destination device by chunks,
+//! so the encoded copy of the data isn't kept in memory
+class Base64Device : public io::Device
+{
+public:
+    Base64Device(io::Device* destinationDevice);
+    ~Base64Device() override;
+
+    bool isSequential() const override;
+    void close() override;
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 size) override;
+
+private:
+    bool writeEncoded(const char* data, qint64 size);
+
+    io::Device* m_destinationDevice = nullptr;
+    QByteArray m_tail; // less than 3 bytes, they are encoded with the next data
+};
+}
+
+#endif // MU_CONVERTER_BASE64DEVICE_H
@@ -0,0 +1,318 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "convertercache.h"
+
+#include <algorithm>
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+
+#include "settings.h"
+#include "version.h"
+#include "libmscore/mscore.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::converter;
+using namespace mu::framework;
+
+static constexpr auto HASH_ALGORITHM = QCryptographicHash::Sha256;
+
+//! NOTE Only the settings of these modules change the conversion results
+static const std::vector<std::string> RESULT_SETTINGS_MODULES { "iex_", "engraving", "notation" };
+
+//! NOTE The audio targets depend on the audio and midi settings (the voices budget, the user soundfonts directories...)
+//! and on the soundfonts as well, the other targets don't
+static const std::vector<std::string> AUDIO_SETTINGS_MODULES { "audio", "midi" };
+static const std::vector<std::string> AUDIO_TARGETS { "wav", "mp3", "ogg", "flac" };
+
+static bool isAudioTarget(const std::string& target)
+{
+    return std::find(AUDIO_TARGETS.cbegin(), AUDIO_TARGETS.cend(), target) != AUDIO_TARGETS.cend();
+}
+
+static QByteArray settingsHash(const std::vector<std::string>& modules)
+{
+    QCryptographicHash hash(HASH_ALGORITHM);
+
+    for (const auto& pair : settings()->items()) {
+        const Settings::Key& key = pair.first;
+
+        bool isModuleSetting = std::any_of(modules.cbegin(), modules.cend(), [&key](const std::string& m) {
+            return key.moduleName.rfind(m, 0) == 0;
+        });
+
+        if (!isModuleSetting) {
+            continue;
+        }
+
+        hash.addData(QByteArray::fromStdString(key.moduleName + "/" + key.key + "=" + settings()->value(key).toString() + "\n"));
+    }
+
+    return hash.result();
+}
+
+void ConverterCache::setPath(const io::path& path)
+{
+    m_path = path;
+}
+
+void ConverterCache::setOptions(const std::string& options)
+{
+    m_options = options;
+}
+
+void ConverterCache::setSoundFontDirectories(const io::paths& directories)
+{
+    m_soundFontDirectories = directories;
+    m_soundFontsHash.clear();
+}
+
+void ConverterCache::setMaxSize(uint64_t maxSizeBytes)
+{
+    m_maxSizeBytes = maxSizeBytes;
+}
+
+bool ConverterCache::isEnabled() const
+{
+    return !m_path.empty();
+}
+
+RetVal<QByteArray> ConverterCache::sourceHash(const std::vector<io::path>& sourceFiles) const
+{
+    TRACEFUNC;
+
+    RetVal<QByteArray> rv;
+    QCryptographicHash hash(HASH_ALGORITHM);
+
+    for (const io::path& path : sourceFiles) {
+        //! NOTE The separator keeps a missing file and an empty one apart
+        hash.addData("|", 1);
+
+        if (path.empty()) {
+            continue;
+        }
+
+        QFile file(path.toQString());
+        if (!file.open(QIODevice::ReadOnly) || !hash.addData(&file)) {
+            rv.ret = make_ret(Ret::Code::UnknownError);
+            return rv;
+        }
+    }
+
+    rv.ret = make_ret(Ret::Code::Ok);
+    rv.val = hash.result();
+    return rv;
+}
+
+std::string ConverterCache::key(const QByteArray& sourceHash, const std::string& target) const
+{
+    QCryptographicHash hash(HASH_ALGORITHM);
+    hash.addData(sourceHash);
+    hash.addData(environmentHash());
+    hash.addData(QByteArray::fromStdString(target));
+
+    if (isAudioTarget(target)) {
+        hash.addData(settingsHash(AUDIO_SETTINGS_MODULES));
+        hash.addData(soundFontsHash());
+    }
+
+    return hash.result().toHex().toStdString();
+}
+
+QByteArray ConverterCache::environmentHash() const
+{
+    QCryptographicHash hash(HASH_ALGORITHM);
+
+    hash.addData(QByteArray::number(Ms::MSCVERSION));
+    hash.addData(QByteArray::fromStdString(Version::fullVersion()));
+    hash.addData(QByteArray::fromStdString(Version::revision()));
+    hash.addData(QByteArray::fromStdString(m_options));
+
+    hash.addData(settingsHash(RESULT_SETTINGS_MODULES));
+
+    return hash.result();
+}
+
+QByteArray ConverterCache::soundFontsHash() const
+{
+    //! NOTE The soundfonts directories are listed once, not on each conversion (e.g. of the server or of the batch job)
+    if (!m_soundFontsHash.isEmpty()) {
+        return m_soundFontsHash;
+    }
+
+    TRACEFUNC;
+
+    QCryptographicHash hash(HASH_ALGORITHM);
+
+    //! NOTE The soundfonts are too big to be hashed, their size and time are enough to notice a change
+    for (const io::path& dirPath : m_soundFontDirectories) {
+        QStringList entries;
+
+        QDirIterator it(dirPath.toQString(), QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            const QFileInfo& info = it.fileInfo();
+            entries << QString("%1:%2:%3\n").arg(info.filePath()).arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch());
+        }
+
+        //! NOTE The iteration order depends on the file system
+        entries.sort();
+
+        hash.addData(dirPath.toQString().toUtf8());
+        hash.addData(entries.join(QString()).toUtf8());
+    }
+
+    m_soundFontsHash = hash.result();
+
+    return m_soundFontsHash;
+}
+
+std::vector<io::path> ConverterCache::files(const std::string& key) const
+{
+    std::vector<io::path> result;
+
+    QDir entry(QDir(m_path.toQString()).filePath(QString::fromStdString(key)));
+    if (!entry.exists()) {
+        return result;
+    }
+
+    for (int i = 0;; ++i) {
+        QString filePath = entry.filePath(QString::number(i));
+        if (!QFileInfo::exists(filePath)) {
+            break;
+        }
+
+        result.push_back(filePath);
+    }
+
+    //! NOTE The time of the first file is the time of the last use of the entry
+    if (!result.empty()) {
+        QFile first(result.front().toQString());
+        if (first.open(QIODevice::ReadWrite)) {
+            first.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        }
+    }
+
+    return result;
+}
+
+Ret ConverterCache::store(const std::string& key, const std::vector<io::path>& files) const
+{
+    TRACEFUNC;
+
+    QDir cacheDir(m_path.toQString());
+    if (!cacheDir.mkpath(".")) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    const QString entryName = QString::fromStdString(key);
+    if (cacheDir.exists(entryName)) {
+        return make_ret(Ret::Code::Ok);
+    }
+
+    //! NOTE Several processes may store the same entry at once (e.g. the batch workers), the first rename wins
+    const QString tempName = QString("%1.%2.tmp").arg(entryName).arg(QCoreApplication::applicationPid());
+    QDir tempDir(cacheDir.filePath(tempName));
+    tempDir.removeRecursively();
+
+    if (!cacheDir.mkdir(tempName)) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (!QFile::copy(files[i].toQString(), tempDir.filePath(QString::number(i)))) {
+            LOGE() << "failed copy to the cache: " << files[i];
+            tempDir.removeRecursively();
+            return make_ret(Ret::Code::UnknownError);
+        }
+    }
+
+    if (!cacheDir.rename(tempName, entryName)) {
+        tempDir.removeRecursively();
+    }
+
+    removeLeastRecentlyUsed();
+
+    return make_ret(Ret::Code::Ok);
+}
+
+void ConverterCache::removeLeastRecentlyUsed() const
+{
+    TRACEFUNC;
+
+    struct Entry {
+        QString path;
+        QDateTime lastUsed;
+        uint64_t size = 0;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t totalSize = 0;
+
+    QDir cacheDir(m_path.toQString());
+    for (const QFileInfo& entryInfo : cacheDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        //! NOTE The entries being written by other processes
+        if (entryInfo.fileName().endsWith(".tmp")) {
+            continue;
+        }
+
+        Entry entry;
+        entry.path = entryInfo.filePath();
+        entry.lastUsed = entryInfo.lastModified();
+
+        for (const QFileInfo& fileInfo : QDir(entry.path).entryInfoList(QDir::Files)) {
+            entry.size += static_cast<uint64_t>(fileInfo.size());
+
+            if (fileInfo.fileName() == "0") {
+                entry.lastUsed = fileInfo.lastModified();
+            }
+        }
+
+        totalSize += entry.size;
+        entries.push_back(entry);
+    }
+
+    if (totalSize <= m_maxSizeBytes) {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& e1, const Entry& e2) {
+        return e1.lastUsed < e2.lastUsed;
+    });
+
+    for (const Entry& entry : entries) {
+        if (totalSize <= m_maxSizeBytes) {
+            break;
+        }
+
+        if (QDir(entry.path).removeRecursively()) {
+            totalSize -= entry.size;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_CONVERTER_CONVERTERCACHE_H
+#define MU_CONVERTER_CONVERTERCACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <QByteArray>
+
+#include "io/path.h"
+#include "retval.h"
+
+namespace mu::converter {
+//! NOTE The on-disk cache of the conversion results.
+//! A result is stored under the hash of everything it depends on: the source files (the score, the style...),
+//! the engraving version, the import/export settings, the conversion options and the target.
+//! So converting an unchanged score again costs a hash and a copy.
+//! The audio targets depend on the audio settings and the soundfonts as well, so these are a part of their keys only
+//!
+//! Each entry is a directory with the result files, named by their index.
+//! The entries are written to a temporary directory and renamed, so a reader never sees a partial one.
+//! When the cache outgrows its max size, the least recently used entries are removed
+static constexpr uint64_t CONVERTER_CACHE_DEFAULT_MAX_SIZE = 1024ull * 1024 * 1024;
+
+class ConverterCache
+{
+public:
+    ConverterCache() = default;
+
+    void setPath(const io::path& path);
+    void setOptions(const std::string& options);
+    void setSoundFontDirectories(const io::paths& directories);
+    void setMaxSize(uint64_t maxSizeBytes);
+
+    bool isEnabled() const;
+
+    //! NOTE The empty paths are skipped (e.g. no style file)
+    RetVal<QByteArray> sourceHash(const std::vector<io::path>& sourceFiles) const;
+    std::string key(const QByteArray& sourceHash, const std::string& target) const;
+
+    //! NOTE The cached files of the key in their order, empty if there is no such entry
+    std::vector<io::path> files(const std::string& key) const;
+    Ret store(const std::string& key, const std::vector<io::path>& files) const;
+
+private:
+    QByteArray environmentHash() const;
+    QByteArray soundFontsHash() const;
+    void removeLeastRecentlyUsed() const;
+
+    io::path m_path;
+    std::string m_options;
+    io::paths m_soundFontDirectories;
+    mutable QByteArray m_soundFontsHash;
+    uint64_t m_maxSizeBytes = CONVERTER_CACHE_DEFAULT_MAX_SIZE;
+};
+}
+
+#endif // MU_CONVERTER_CONVERTERCACHE_H
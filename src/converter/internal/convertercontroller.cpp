@@ -21,16 +21,34 @@
  */
 #include "convertercontroller.h"
 
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonParseError>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+#include <sys/resource.h>
+#endif
 
 #include "log.h"
 #include "convertercodes.h"
 #include "stringutils.h"
 #include "compat/backendapi.h"
+#include "converterserver.h"
 
 using namespace mu::converter;
 using namespace mu::project;
@@ -39,7 +57,65 @@ using namespace mu::notation;
 static const std::string PDF_SUFFIX = "pdf";
 static const std::string PNG_SUFFIX = "png";
 
-mu::Ret ConverterController::batchConvert(const io::path& batchJobFile, const io::path& stylePath, bool forceMode)
+static const std::string BATCH_JOB_REPORT_SUFFIX = ".report.json";
+
+//! NOTE The options of the batch job itself, the workers get their own ones
+static const QStringList BATCH_JOB_OPTIONS { "-j", "--job", "--jobs", "--job-report" };
+
+static constexpr int WORKER_WAIT_STEP_MSECS = 20;
+
+static size_t peakMemoryBytes()
+{
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef Q_OS_MACOS
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+    return 0;
+#endif
+}
+
+static mu::io::path pageFilePath(const mu::io::path& out, size_t pageIdx)
+{
+    return mu::io::path(mu::io::dirpath(out) + "/" + mu::io::basename(out) + "-%1." + mu::io::suffix(out)).toQString().arg(pageIdx + 1);
+}
+
+static QStringList workerArguments()
+{
+    //! NOTE The workers get the same options as this process, e.g. the style or the image resolution
+    QStringList appArgs = QCoreApplication::arguments();
+    QStringList args;
+
+    for (int i = 1; i < appArgs.size(); ++i) {
+        const QString& arg = appArgs[i];
+
+        if (BATCH_JOB_OPTIONS.contains(arg)) {
+            ++i; // the value of the option
+            continue;
+        }
+
+        if (BATCH_JOB_OPTIONS.contains(arg.section('=', 0, 0))) {
+            continue;
+        }
+
+        if (arg.startsWith("-j") && !arg.startsWith("--")) {
+            continue;
+        }
+
+        args << arg;
+    }
+
+    return args;
+}
+
+mu::Ret ConverterController::batchConvert(const io::path& batchJobFile, const io::path& stylePath, bool forceMode,
+                                          size_t workersCount, const io::path& reportPath)
 {
     TRACEFUNC;
 
@@ -49,18 +125,262 @@ mu::Ret ConverterController::batchConvert(const io::path& batchJobFile, const io
         return batchJob.ret;
     }
 
-    Ret ret = make_ret(Ret::Code::Ok);
-    for (const Job& job : batchJob.val) {
-        ret = fileConvert(job.in, job.out, stylePath, forceMode);
-        if (!ret) {
-            LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
-            break;
+    QElapsedTimer timer;
+    timer.start();
+
+    std::vector<JobGroup> groups = groupBatchJob(batchJob.val);
+    BatchJobResults results(batchJob.val.size());
+
+    workersCount = std::clamp(workersCount, size_t(1), std::max(groups.size(), size_t(1)));
+
+    if (workersCount > 1) {
+        convertJobGroupsInWorkers(groups, batchJob.val, workersCount, results);
+    } else {
+        for (const JobGroup& group : groups) {
+            convertJobGroup(group, batchJob.val, stylePath, forceMode, results);
         }
     }
 
+    size_t failedCount = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!results[i].ret) {
+            LOGE() << "failed convert, err: " << results[i].ret.toString()
+                   << ", in: " << batchJob.val[i].in << ", out: " << batchJob.val[i].out;
+            ++failedCount;
+        }
+    }
+
+    io::path report = reportPath.empty() ? batchJobFile + BATCH_JOB_REPORT_SUFFIX : reportPath;
+    Ret ret = writeBatchJobReport(report, batchJob.val, results, workersCount, timer.elapsed());
+    if (!ret) {
+        LOGE() << "failed write batch job report, err: " << ret.toString() << ", path: " << report;
+    }
+
+    LOGI() << "converted: " << results.size() - failedCount << ", failed: " << failedCount << ", report: " << report;
+
+    if (failedCount > 0) {
+        return make_ret(Err::BatchJobFailed);
+    }
+
     return ret;
 }
 
+std::vector<ConverterController::JobGroup> ConverterController::groupBatchJob(const BatchJob& batchJob) const
+{
+    std::vector<JobGroup> groups;
+    std::map<std::string, size_t> groupIndexes;
+
+    for (size_t i = 0; i < batchJob.size(); ++i) {
+        const Job& job = batchJob[i];
+
+        auto it = groupIndexes.find(job.in.toStdString());
+        if (it == groupIndexes.end()) {
+            it = groupIndexes.emplace(job.in.toStdString(), groups.size()).first;
+
+            JobGroup group;
+            group.in = job.in;
+            groups.push_back(std::move(group));
+        }
+
+        groups[it->second].jobIndexes.push_back(i);
+    }
+
+    return groups;
+}
+
+void ConverterController::convertJobGroup(const JobGroup& group, const BatchJob& batchJob, const io::path& stylePath, bool forceMode,
+                                          BatchJobResults& results) const
+{
+    TRACEFUNC;
+
+    LOGI() << "in: " << group.in << ", outputs: " << group.jobIndexes.size();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    //! NOTE The jobs found in the cache are copied from there, the score is loaded only for the others
+    std::vector<size_t> jobIndexes;
+    std::map<size_t, std::string> cacheKeys;
+
+    if (m_cache.isEnabled()) {
+        RetVal<QByteArray> sourceHash = m_cache.sourceHash({ group.in, stylePath });
+
+        for (size_t idx : group.jobIndexes) {
+            const io::path& out = batchJob[idx].out;
+            const std::string key = sourceHash.ret ? m_cache.key(sourceHash.val, io::suffix(out)) : std::string();
+
+            if (restoreFromCache(key, out)) {
+                JobResult& result = results[idx];
+                result.ret = make_ret(Ret::Code::Ok);
+                result.convertTimeMs = timer.elapsed();
+                timer.restart();
+                continue;
+            }
+
+            cacheKeys[idx] = key;
+            jobIndexes.push_back(idx);
+        }
+    } else {
+        jobIndexes = group.jobIndexes;
+    }
+
+    if (jobIndexes.empty()) {
+        return;
+    }
+
+    timer.restart();
+
+    auto notationProject = notationCreator()->newProject();
+    IF_ASSERT_FAILED(notationProject) {
+        for (size_t idx : jobIndexes) {
+            results[idx].ret = make_ret(Err::UnknownError);
+        }
+        return;
+    }
+
+    Ret ret = notationProject->load(group.in, stylePath, forceMode);
+    if (!ret) {
+        LOGE() << "failed load notation, err: " << ret.toString() << ", path: " << group.in;
+        ret = make_ret(Err::InFileFailedLoad);
+    }
+
+    int64_t loadTimeMs = timer.elapsed();
+
+    //! NOTE The targets of the group paint the same laid out pages (e.g. png and pdf), so the pages are recorded once
+    if (pageRecordsCache()) {
+        pageRecordsCache()->open();
+    }
+
+    for (size_t idx : jobIndexes) {
+        JobResult& result = results[idx];
+        result.loadTimeMs = loadTimeMs;
+
+        if (ret) {
+            timer.restart();
+            INotationPtr notation = notationProject->masterNotation()->notation();
+            result.ret = convertNotation(notation, batchJob[idx].out);
+            result.convertTimeMs = timer.elapsed();
+
+            if (result.ret) {
+                storeToCache(cacheKeys[idx], notation, batchJob[idx].out);
+            }
+        } else {
+            result.ret = ret;
+        }
+    }
+
+    if (pageRecordsCache()) {
+        pageRecordsCache()->close();
+    }
+}
+
+void ConverterController::convertJobGroupsInWorkers(const std::vector<JobGroup>& groups, const BatchJob& batchJob, size_t workersCount,
+                                                    BatchJobResults& results) const
+{
+    TRACEFUNC;
+
+    //! NOTE Each group is converted by its own process: the layout isn't thread safe,
+    //! a crash fails only the jobs of its group and the peak memory is the one of the group
+    struct Worker {
+        size_t groupIdx = 0;
+        io::path reportPath;
+        std::unique_ptr<QProcess> process;
+    };
+
+    auto failGroup = [&results](const JobGroup& group, const Ret& ret) {
+        for (size_t idx : group.jobIndexes) {
+            results[idx].ret = ret;
+        }
+    };
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        LOGE() << "failed create temp dir for the workers, err: " << tempDir.errorString();
+        for (const JobGroup& group : groups) {
+            failGroup(group, make_ret(Err::BatchJobWorkerFailed, tempDir.errorString().toStdString()));
+        }
+        return;
+    }
+
+    const QString appPath = QCoreApplication::applicationFilePath();
+    const QStringList args = workerArguments();
+
+    std::list<Worker> workers;
+    size_t nextGroupIdx = 0;
+
+    auto startWorker = [&](size_t groupIdx) -> Ret {
+        BatchJob groupJob;
+        for (size_t idx : groups[groupIdx].jobIndexes) {
+            groupJob.push_back(batchJob[idx]);
+        }
+
+        io::path jobPath = tempDir.filePath(QString("job-%1.json").arg(groupIdx));
+        Ret ret = writeBatchJob(jobPath, groupJob);
+        if (!ret) {
+            return ret;
+        }
+
+        Worker worker;
+        worker.groupIdx = groupIdx;
+        worker.reportPath = tempDir.filePath(QString("report-%1.json").arg(groupIdx));
+        worker.process = std::make_unique<QProcess>();
+        worker.process->setProcessChannelMode(QProcess::ForwardedChannels);
+        worker.process->start(appPath, QStringList(args) << "-j" << jobPath.toQString() << "--job-report" << worker.reportPath.toQString());
+
+        if (!worker.process->waitForStarted()) {
+            return make_ret(Err::BatchJobWorkerFailed, worker.process->errorString().toStdString());
+        }
+
+        workers.push_back(std::move(worker));
+
+        return make_ret(Ret::Code::Ok);
+    };
+
+    auto finishWorker = [&](const Worker& worker) {
+        const JobGroup& group = groups[worker.groupIdx];
+
+        //! NOTE A crashed worker leaves no report
+        RetVal<BatchJobReport> report = readBatchJobReport(worker.reportPath);
+        if (!report.ret || report.val.results.size() != group.jobIndexes.size()) {
+            bool crashed = worker.process->exitStatus() == QProcess::CrashExit;
+            std::string text = crashed ? "worker crashed" : "worker exit code: " + std::to_string(worker.process->exitCode());
+            LOGE() << "failed convert " << group.in << ", " << text;
+            failGroup(group, make_ret(Err::BatchJobWorkerFailed, text));
+            return;
+        }
+
+        //! NOTE The worker converted only this group, so its peak is the one of the group
+        for (size_t i = 0; i < group.jobIndexes.size(); ++i) {
+            JobResult& result = results[group.jobIndexes[i]];
+            result = report.val.results[i];
+            result.groupPeakMemoryBytes = report.val.processPeakMemoryBytes;
+        }
+    };
+
+    while (nextGroupIdx < groups.size() || !workers.empty()) {
+        while (workers.size() < workersCount && nextGroupIdx < groups.size()) {
+            size_t groupIdx = nextGroupIdx++;
+
+            Ret ret = startWorker(groupIdx);
+            if (!ret) {
+                LOGE() << "failed start worker, err: " << ret.toString() << ", in: " << groups[groupIdx].in;
+                failGroup(groups[groupIdx], ret);
+            }
+        }
+
+        for (auto it = workers.begin(); it != workers.end();) {
+            QProcess* process = it->process.get();
+            if (process->state() != QProcess::NotRunning && !process->waitForFinished(WORKER_WAIT_STEP_MSECS)) {
+                ++it;
+                continue;
+            }
+
+            finishWorker(*it);
+            it = workers.erase(it);
+        }
+    }
+}
+
 mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out, const io::path& stylePath, bool forceMode)
 {
     TRACEFUNC;
@@ -71,25 +391,51 @@ mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out
         return make_ret(Err::UnknownError);
     }
 
-    std::string suffix = io::suffix(out);
-    auto writer = writers()->writer(suffix);
-    if (!writer) {
+    if (!writers()->writer(io::suffix(out))) {
         return make_ret(Err::ConvertTypeUnknown);
     }
 
-    Ret ret = notationProject->load(in, stylePath, forceMode);
+    startProgress();
+
+    const std::string key = cacheKey({ in, stylePath }, io::suffix(out));
+    if (restoreFromCache(key, out)) {
+        return notifyProgress(1, 1, "writing");
+    }
+
+    Ret ret = notifyProgress(0, 0, "loading");
+    if (!ret) {
+        return ret;
+    }
+
+    ret = notationProject->load(in, stylePath, forceMode);
     if (!ret) {
         LOGE() << "failed load notation, err: " << ret.toString() << ", path: " << in;
         return make_ret(Err::InFileFailedLoad);
     }
 
+    INotationPtr notation = notationProject->masterNotation()->notation();
+
+    ret = convertNotation(notation, out);
+    if (ret) {
+        storeToCache(key, notation, out);
+    }
+
+    return ret;
+}
+
+mu::Ret ConverterController::convertNotation(INotationPtr notation, const io::path& out) const
+{
+    std::string suffix = io::suffix(out);
+    auto writer = writers()->writer(suffix);
+    if (!writer) {
+        return make_ret(Err::ConvertTypeUnknown);
+    }
+
     if (isConvertPageByPage(suffix)) {
-        ret = convertPageByPage(writer, notationProject->masterNotation()->notation(), out);
-    } else {
-        ret = convertFullNotation(writer, notationProject->masterNotation()->notation(), out);
+        return convertPageByPage(writer, notation, out);
     }
 
-    return make_ret(Ret::Code::Ok);
+    return convertFullNotation(writer, notation, out);
 }
 
 mu::Ret ConverterController::convertScoreParts(const mu::io::path& in, const mu::io::path& out, const mu::io::path& stylePath,
@@ -162,6 +508,112 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
     return rv;
 }
 
+mu::Ret ConverterController::writeBatchJob(const io::path& batchJobFile, const BatchJob& batchJob) const
+{
+    QJsonArray arr;
+    for (const Job& job : batchJob) {
+        QJsonObject obj;
+        obj["in"] = job.in.toQString();
+        obj["out"] = job.out.toQString();
+        arr << obj;
+    }
+
+    QFile file(batchJobFile.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::OutFileFailedOpen);
+    }
+
+    file.write(QJsonDocument(arr).toJson());
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::Ret ConverterController::writeBatchJobReport(const io::path& reportPath, const BatchJob& batchJob, const BatchJobResults& results,
+                                                 size_t workersCount, int64_t totalTimeMs) const
+{
+    TRACEFUNC;
+
+    QJsonArray jobs;
+    int failedCount = 0;
+
+    for (size_t i = 0; i < batchJob.size(); ++i) {
+        const JobResult& result = results[i];
+
+        QJsonObject obj;
+        obj["in"] = batchJob[i].in.toQString();
+        obj["out"] = batchJob[i].out.toQString();
+        obj["success"] = result.ret.success();
+        obj["code"] = result.ret.code();
+        if (!result.ret) {
+            obj["error"] = QString::fromStdString(result.ret.toString());
+            ++failedCount;
+        }
+        obj["loadTimeMs"] = static_cast<qint64>(result.loadTimeMs);
+        obj["convertTimeMs"] = static_cast<qint64>(result.convertTimeMs);
+        if (result.groupPeakMemoryBytes > 0) {
+            obj["groupPeakMemoryBytes"] = static_cast<qint64>(result.groupPeakMemoryBytes);
+        }
+
+        jobs << obj;
+    }
+
+    QJsonObject root;
+    root["workersCount"] = static_cast<int>(workersCount);
+    root["totalTimeMs"] = static_cast<qint64>(totalTimeMs);
+    root["succeededCount"] = static_cast<int>(batchJob.size()) - failedCount;
+    root["failedCount"] = failedCount;
+
+    //! NOTE The peak is the one of the whole process, it can't be split between the jobs converted by it
+    root["processPeakMemoryBytes"] = static_cast<qint64>(peakMemoryBytes());
+    root["jobs"] = jobs;
+
+    QFile file(reportPath.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::BatchJobReportFailedWrite);
+    }
+
+    file.write(QJsonDocument(root).toJson());
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::RetVal<ConverterController::BatchJobReport> ConverterController::readBatchJobReport(const io::path& reportPath) const
+{
+    RetVal<BatchJobReport> rv;
+    QFile file(reportPath.toQString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        rv.ret = make_ret(Err::BatchJobFileFailedOpen);
+        return rv;
+    }
+
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        rv.ret = make_ret(Err::BatchJobFileFailedParse, err.errorString().toStdString());
+        return rv;
+    }
+
+    const QJsonObject root = doc.object();
+    const QJsonArray jobs = root["jobs"].toArray();
+
+    for (const QJsonValue v : jobs) {
+        QJsonObject obj = v.toObject();
+
+        JobResult result;
+        result.ret = Ret(obj["code"].toInt(), obj["error"].toString().toStdString());
+        result.loadTimeMs = static_cast<int64_t>(obj["loadTimeMs"].toDouble());
+        result.convertTimeMs = static_cast<int64_t>(obj["convertTimeMs"].toDouble());
+        result.groupPeakMemoryBytes = static_cast<size_t>(obj["groupPeakMemoryBytes"].toDouble());
+
+        rv.val.results.push_back(std::move(result));
+    }
+
+    rv.val.processPeakMemoryBytes = static_cast<size_t>(root["processPeakMemoryBytes"].toDouble());
+
+    rv.ret = make_ret(Ret::Code::Ok);
+    return rv;
+}
+
 bool ConverterController::isConvertPageByPage(const std::string& suffix) const
 {
     QList<std::string> types {
@@ -175,38 +627,94 @@ mu::Ret ConverterController::convertPageByPage(INotationWriterPtr writer, INotat
 {
     TRACEFUNC;
 
-    for (size_t i = 0; i < notation->elements()->pages().size(); i++) {
-        const QString filePath = io::path(io::dirpath(out) + "/" + io::basename(out) + "-%1." + io::suffix(out)).toQString().arg(i + 1);
+    //! NOTE The per page writers (png, svg) only read the laid out score, so the pages are rendered and encoded
+    //! by the thread pool, while the finished ones are written here in the page order.
+    //! Only as many pages as the pool runs at once are kept in memory
+    const size_t pagesCount = notation->elements()->pages().size();
+    const size_t maxRendersCount = static_cast<size_t>(std::max(1, QThreadPool::globalInstance()->maxThreadCount()));
 
-        QFile file(filePath);
-        if (!file.open(QFile::WriteOnly)) {
-            return make_ret(Err::OutFileFailedOpen);
-        }
+    std::deque<QFuture<RetVal<QByteArray> > > renders;
+    size_t nextPage = 0;
 
+    auto startNextRender = [&]() {
         INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
+            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(nextPage)) },
         };
+        ++nextPage;
+
+        renders.push_back(QtConcurrent::run([writer, notation, options]() {
+            RetVal<QByteArray> page;
+            QBuffer buffer(&page.val);
+            buffer.open(QIODevice::WriteOnly);
+            page.ret = writer->write(notation, buffer, options);
+            return page;
+        }));
+    };
 
-        Ret ret = writer->write(notation, file, options);
+    //! NOTE The renders read the score, they must be finished before it can go away
+    auto waitRenders = [&renders]() {
+        for (QFuture<RetVal<QByteArray> >& render : renders) {
+            render.waitForFinished();
+        }
+    };
+
+    while (nextPage < pagesCount && renders.size() < maxRendersCount) {
+        startNextRender();
+    }
+
+    for (size_t i = 0; i < pagesCount; i++) {
+        Ret ret = notifyProgress(static_cast<int64_t>(i), static_cast<int64_t>(pagesCount), "writing");
         if (!ret) {
-            LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
+            waitRenders();
+            return ret;
+        }
+
+        RetVal<QByteArray> page = renders.front().result();
+        renders.pop_front();
+
+        if (nextPage < pagesCount) {
+            startNextRender();
+        }
+
+        if (!page.ret) {
+            LOGE() << "failed write, err: " << page.ret.toString() << ", path: " << out;
+            waitRenders();
+            return make_ret(Err::OutFileFailedWrite);
+        }
+
+        const QString filePath = pageFilePath(out, i).toQString();
+
+        QFile file(filePath);
+        if (!file.open(QFile::WriteOnly)) {
+            waitRenders();
+            return make_ret(Err::OutFileFailedOpen);
+        }
+
+        if (file.write(page.val) != page.val.size()) {
+            LOGE() << "failed write, path: " << filePath;
+            waitRenders();
             return make_ret(Err::OutFileFailedWrite);
         }
 
         file.close();
     }
 
-    return make_ret(Ret::Code::Ok);
+    return notifyProgress(static_cast<int64_t>(pagesCount), static_cast<int64_t>(pagesCount), "writing");
 }
 
 mu::Ret ConverterController::convertFullNotation(INotationWriterPtr writer, INotationPtr notation, const mu::io::path& out) const
 {
+    Ret ret = notifyProgress(0, 1, "writing");
+    if (!ret) {
+        return ret;
+    }
+
     QFile file(out.toQString());
     if (!file.open(QFile::WriteOnly)) {
         return make_ret(Err::OutFileFailedOpen);
     }
 
-    Ret ret = writer->write(notation, file);
+    ret = writer->write(notation, file);
     if (!ret) {
         LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
         return make_ret(Err::OutFileFailedWrite);
@@ -214,7 +722,7 @@ mu::Ret ConverterController::convertFullNotation(INotationWriterPtr writer, INot
 
     file.close();
 
-    return make_ret(Ret::Code::Ok);
+    return notifyProgress(1, 1, "writing");
 }
 
 mu::Ret ConverterController::convertScorePartsToPdf(INotationWriterPtr writer, IMasterNotationPtr masterNotation, const io::path& out) const
@@ -280,7 +788,28 @@ mu::Ret ConverterController::exportScoreMedia(const mu::io::path& in, const mu::
 {
     TRACEFUNC;
 
-    return BackendApi::exportScoreMedia(in, out, highlightConfigPath, stylePath, forceMode);
+    startProgress();
+
+    //! NOTE The export is done in one step, it can be cancelled only before it's started
+    Ret ret = notifyProgress(0, 1, "exporting");
+    if (!ret) {
+        return ret;
+    }
+
+    //! NOTE The output goes to stdout when there is no output file, it isn't cached then
+    const std::string key = out.empty() ? std::string() : cacheKey({ in, stylePath, highlightConfigPath }, "score-media");
+    if (restoreFromCache(key, out)) {
+        return notifyProgress(1, 1, "exporting");
+    }
+
+    ret = BackendApi::exportScoreMedia(in, out, highlightConfigPath, stylePath, forceMode);
+    if (!ret) {
+        return ret;
+    }
+
+    storeToCache(key, nullptr, out);
+
+    return notifyProgress(1, 1, "exporting");
 }
 
 mu::Ret ConverterController::exportScoreMeta(const mu::io::path& in, const mu::io::path& out, const io::path& stylePath, bool forceMode)
@@ -319,3 +848,121 @@ mu::Ret ConverterController::updateSource(const io::path& in, const std::string&
 
     return BackendApi::updateSource(in, newSource, forceMode);
 }
+
+mu::Ret ConverterController::runServer(const std::string& socketName)
+{
+    TRACEFUNC;
+
+    ConverterServer server(this);
+    return server.run(QString::fromStdString(socketName));
+}
+
+void ConverterController::setCache(const io::path& cachePath, const std::string& options)
+{
+    m_cache.setPath(cachePath);
+    m_cache.setOptions(options);
+
+    //! NOTE The audio module may be disabled
+    if (audioConfiguration()) {
+        m_cache.setSoundFontDirectories(audioConfiguration()->soundFontDirectories());
+    }
+}
+
+std::string ConverterController::cacheKey(const std::vector<io::path>& sourceFiles, const std::string& target) const
+{
+    if (!m_cache.isEnabled()) {
+        return std::string();
+    }
+
+    RetVal<QByteArray> sourceHash = m_cache.sourceHash(sourceFiles);
+    if (!sourceHash.ret) {
+        LOGW() << "failed hash the sources, the result isn't cached";
+        return std::string();
+    }
+
+    return m_cache.key(sourceHash.val, target);
+}
+
+std::vector<mu::io::path> ConverterController::outputFiles(const io::path& out, size_t filesCount) const
+{
+    if (!isConvertPageByPage(io::suffix(out))) {
+        return { out };
+    }
+
+    std::vector<io::path> files;
+    for (size_t i = 0; i < filesCount; ++i) {
+        files.push_back(pageFilePath(out, i));
+    }
+
+    return files;
+}
+
+bool ConverterController::restoreFromCache(const std::string& key, const io::path& out) const
+{
+    if (key.empty()) {
+        return false;
+    }
+
+    const std::vector<io::path> cachedFiles = m_cache.files(key);
+    if (cachedFiles.empty()) {
+        return false;
+    }
+
+    const std::vector<io::path> files = outputFiles(out, cachedFiles.size());
+    if (files.size() != cachedFiles.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        QFile::remove(files[i].toQString());
+
+        if (!QFile::copy(cachedFiles[i].toQString(), files[i].toQString())) {
+            LOGW() << "failed copy from the cache, path: " << files[i];
+            return false;
+        }
+    }
+
+    LOGI() << "from the cache: " << out;
+    return true;
+}
+
+void ConverterController::storeToCache(const std::string& key, INotationPtr notation, const io::path& out) const
+{
+    if (key.empty()) {
+        return;
+    }
+
+    const size_t pagesCount = notation ? notation->elements()->pages().size() : 0;
+
+    Ret ret = m_cache.store(key, outputFiles(out, pagesCount));
+    if (!ret) {
+        LOGW() << "failed store to the cache, err: " << ret.toString() << ", out: " << out;
+    }
+}
+
+mu::framework::ProgressChannel ConverterController::progressChanged() const
+{
+    return m_progressChanged;
+}
+
+void ConverterController::cancel()
+{
+    m_isCancelRequested = true;
+}
+
+void ConverterController::startProgress()
+{
+    m_isCancelRequested = false;
+}
+
+mu::Ret ConverterController::notifyProgress(int64_t current, int64_t total, const std::string& status) const
+{
+    m_progressChanged.send(framework::Progress(current, total, status));
+
+    //! NOTE The receivers may request the cancel right from the notification
+    if (m_isCancelRequested) {
+        return make_ret(Ret::Code::Cancel);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
@@ -22,27 +22,34 @@
 #ifndef MU_CONVERTER_CONVERTERCONTROLLER_H
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
-#include <list>
+#include <vector>
 
 #include "../iconvertercontroller.h"
 
 #include "modularity/ioc.h"
 #include "project/iprojectcreator.h"
 #include "project/inotationwritersregister.h"
+#include "audio/iaudioconfiguration.h"
+#include "importexport/imagesexport/ipagerecordscache.h"
 
 #include "retval.h"
 
+#include "convertercache.h"
+
 namespace mu::converter {
 class ConverterController : public IConverterController
 {
     INJECT(converter, project::IProjectCreator, notationCreator)
     INJECT(converter, project::INotationWritersRegister, writers)
+    INJECT(converter, audio::IAudioConfiguration, audioConfiguration)
+    INJECT(converter, iex::imagesexport::IPageRecordsCache, pageRecordsCache)
 
 public:
     ConverterController() = default;
 
     Ret fileConvert(const io::path& in, const io::path& out, const io::path& stylePath = io::path(), bool forceMode = false) override;
-    Ret batchConvert(const io::path& batchJobFile, const io::path& stylePath = io::path(), bool forceMode = false) override;
+    Ret batchConvert(const io::path& batchJobFile, const io::path& stylePath = io::path(), bool forceMode = false,
+                     size_t workersCount = 1, const io::path& reportPath = io::path()) override;
     Ret convertScoreParts(const io::path& in, const io::path& out, const io::path& stylePath = io::path(), bool forceMode = false) override;
 
     Ret exportScoreMedia(const io::path& in, const io::path& out,
@@ -57,6 +64,13 @@ public:
 
     Ret updateSource(const io::path& in, const std::string& newSource, bool forceMode = false) override;
 
+    Ret runServer(const std::string& socketName = std::string()) override;
+
+    void setCache(const io::path& cachePath, const std::string& options) override;
+
+    framework::ProgressChannel progressChanged() const override;
+    void cancel() override;
+
 private:
 
     struct Job {
@@ -64,9 +78,51 @@ private:
         io::path out;
     };
 
-    using BatchJob = std::list<Job>;
+    using BatchJob = std::vector<Job>;
+
+    //! NOTE The jobs with the same input, the score is loaded once for all of them
+    struct JobGroup {
+        io::path in;
+        std::vector<size_t> jobIndexes;
+    };
+
+    struct JobResult {
+        Ret ret;
+        int64_t loadTimeMs = 0;     // shared by the jobs of the group
+        int64_t convertTimeMs = 0;
+        size_t groupPeakMemoryBytes = 0; // of the worker process, which converted the group, 0 if converted by this process
+    };
+
+    //! NOTE The results are in the order of the jobs
+    using BatchJobResults = std::vector<JobResult>;
+
+    struct BatchJobReport {
+        BatchJobResults results;
+        size_t processPeakMemoryBytes = 0; // of the process, which converted the jobs
+    };
 
     RetVal<BatchJob> parseBatchJob(const io::path& batchJobFile) const;
+    Ret writeBatchJob(const io::path& batchJobFile, const BatchJob& batchJob) const;
+    std::vector<JobGroup> groupBatchJob(const BatchJob& batchJob) const;
+
+    void convertJobGroup(const JobGroup& group, const BatchJob& batchJob, const io::path& stylePath, bool forceMode,
+                         BatchJobResults& results) const;
+    void convertJobGroupsInWorkers(const std::vector<JobGroup>& groups, const BatchJob& batchJob, size_t workersCount,
+                                   BatchJobResults& results) const;
+
+    Ret writeBatchJobReport(const io::path& reportPath, const BatchJob& batchJob, const BatchJobResults& results,
+                            size_t workersCount, int64_t totalTimeMs) const;
+    RetVal<BatchJobReport> readBatchJobReport(const io::path& reportPath) const;
+
+    Ret convertNotation(notation::INotationPtr notation, const io::path& out) const;
+
+    std::string cacheKey(const std::vector<io::path>& sourceFiles, const std::string& target) const;
+    std::vector<io::path> outputFiles(const io::path& out, size_t filesCount) const;
+    bool restoreFromCache(const std::string& key, const io::path& out) const;
+    void storeToCache(const std::string& key, notation::INotationPtr notation, const io::path& out) const;
+
+    void startProgress();
+    Ret notifyProgress(int64_t current, int64_t total, const std::string& status) const;
 
     bool isConvertPageByPage(const std::string& suffix) const;
     Ret convertPageByPage(project::INotationWriterPtr writer, notation::INotationPtr notation, const io::path& out) const;
@@ -74,6 +130,11 @@ private:
 
     Ret convertScorePartsToPdf(project::INotationWriterPtr writer, notation::IMasterNotationPtr masterNotation, const io::path& out) const;
     Ret convertScorePartsToPngs(project::INotationWriterPtr writer, notation::IMasterNotationPtr masterNotation, const io::path& out) const;
+
+    ConverterCache m_cache;
+
+    mutable framework::ProgressChannel m_progressChanged;
+    bool m_isCancelRequested = false;
 };
 }
 
@@ -0,0 +1,384 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "converterserver.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QLocalServer>
+#include <QLocalSocket>
+
+#include "log.h"
+#include "convertercodes.h"
+
+using namespace mu;
+using namespace mu::converter;
+
+static const QString CONVERT_REQUEST = "convert";
+static const QString SCORE_MEDIA_REQUEST = "scoreMedia";
+static const QString CANCEL_REQUEST = "cancel";
+static const QString SHUTDOWN_REQUEST = "shutdown";
+
+static constexpr int CONNECT_TIMEOUT_MSECS = 1000;
+
+ConverterServer::ConverterServer(IConverterController* converter)
+    : m_converter(converter)
+{
+}
+
+ConverterServer::~ConverterServer()
+{
+    *m_isAlive = false;
+    delete m_server;
+}
+
+Ret ConverterServer::run(const QString& socketName)
+{
+    IF_ASSERT_FAILED(m_converter) {
+        return make_ret(Err::UnknownError);
+    }
+
+    if (socketName.isEmpty()) {
+        startStdinReader();
+    } else if (!listen(socketName)) {
+        return make_ret(Err::ServerFailedListen);
+    }
+
+    m_converter->progressChanged().onReceive(this, [this](const framework::Progress& progress) {
+        if (!m_currentRequest) {
+            return;
+        }
+
+        QJsonObject data;
+        data["current"] = static_cast<qint64>(progress.current);
+        data["total"] = static_cast<qint64>(progress.total);
+        data["status"] = QString::fromStdString(progress.status);
+        sendEvent(m_currentRequest.value(), "progress", data);
+
+        //! NOTE The conversion blocks the loop, so the requests (e.g. the cancel of this one) are read here
+        QCoreApplication::processEvents();
+    });
+
+    LOGI() << "converter server started, input: " << (socketName.isEmpty() ? QString("stdin") : socketName);
+
+    QEventLoop loop;
+    m_loop = &loop;
+    loop.exec();
+    m_loop = nullptr;
+
+    m_converter->progressChanged().resetOnReceive(this);
+
+    LOGI() << "converter server finished";
+
+    return make_ret(Ret::Code::Ok);
+}
+
+bool ConverterServer::listen(const QString& socketName)
+{
+    m_server = new QLocalServer();
+
+    bool ok = m_server->listen(socketName);
+
+    //! NOTE The socket file of the crashed server is left on Unix.
+    //! It's removed only if nothing accepts the connections, so another running server isn't hijacked
+    if (!ok && m_server->serverError() == QAbstractSocket::AddressInUseError && !isServerRunning(socketName)) {
+        QLocalServer::removeServer(socketName);
+        ok = m_server->listen(socketName);
+    }
+
+    if (!ok) {
+        LOGE() << "failed listen: " << m_server->errorString();
+        return false;
+    }
+
+    QObject::connect(m_server, &QLocalServer::newConnection, [this]() {
+        while (QLocalSocket* socket = m_server->nextPendingConnection()) {
+            QObject::connect(socket, &QLocalSocket::readyRead, [this, socket]() {
+                onClientReadyRead(socket);
+            });
+
+            QObject::connect(socket, &QLocalSocket::disconnected, [this, socket]() {
+                onClientDisconnected(socket);
+            });
+        }
+    });
+
+    return true;
+}
+
+bool ConverterServer::isServerRunning(const QString& socketName) const
+{
+    QLocalSocket socket;
+    socket.connectToServer(socketName);
+
+    bool running = socket.waitForConnected(CONNECT_TIMEOUT_MSECS);
+    socket.abort();
+
+    return running;
+}
+
+void ConverterServer::startStdinReader()
+{
+    //! NOTE Reading stdin blocks, so it's done by a thread, which passes the lines to the main thread
+    std::shared_ptr<bool> isAlive = m_isAlive;
+
+    std::thread([this, isAlive]() {
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            QByteArray data = QByteArray::fromStdString(line);
+            QMetaObject::invokeMethod(qApp, [this, isAlive, data]() {
+                if (*isAlive) {
+                    onLine(data, nullptr, true);
+                }
+            }, Qt::QueuedConnection);
+        }
+
+        QMetaObject::invokeMethod(qApp, [this, isAlive]() {
+            if (*isAlive) {
+                onInputFinished();
+            }
+        }, Qt::QueuedConnection);
+    }).detach();
+}
+
+void ConverterServer::onClientReadyRead(QLocalSocket* socket)
+{
+    while (socket->canReadLine()) {
+        onLine(socket->readLine(), socket, false);
+    }
+}
+
+void ConverterServer::onClientDisconnected(QLocalSocket* socket)
+{
+    m_queue.remove_if([socket](const Request& request) {
+        return request.client == socket;
+    });
+
+    if (m_currentRequest && m_currentRequest->client == socket) {
+        m_converter->cancel();
+    }
+
+    socket->deleteLater();
+}
+
+void ConverterServer::onLine(const QByteArray& line, QLocalSocket* client, bool isStdinClient)
+{
+    QByteArray data = line.trimmed();
+    if (data.isEmpty()) {
+        return;
+    }
+
+    Request request;
+    request.client = client;
+    request.isStdinClient = isStdinClient;
+
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(data, &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        QJsonObject error;
+        error["error"] = "failed parse request: " + err.errorString();
+        sendEvent(request, "failed", error);
+        return;
+    }
+
+    request.params = doc.object();
+    request.id = request.params["id"].toVariant().toString();
+    request.type = request.params["type"].toString();
+
+    if (request.type == SHUTDOWN_REQUEST) {
+        onInputFinished();
+        return;
+    }
+
+    if (request.type == CANCEL_REQUEST) {
+        cancelRequest(request);
+        return;
+    }
+
+    if (m_isShuttingDown) {
+        QJsonObject error;
+        error["error"] = "the server is shutting down";
+        sendEvent(request, "failed", error);
+        return;
+    }
+
+    m_queue.push_back(request);
+    sendEvent(request, "queued");
+
+    scheduleNextRequest();
+}
+
+void ConverterServer::onInputFinished()
+{
+    //! NOTE The accepted requests are finished before the exit
+    m_isShuttingDown = true;
+    scheduleNextRequest();
+}
+
+void ConverterServer::cancelRequest(const Request& cancel)
+{
+    auto isSameRequest = [&cancel](const Request& request) {
+        return request.id == cancel.id
+               && request.client == cancel.client
+               && request.isStdinClient == cancel.isStdinClient;
+    };
+
+    if (m_currentRequest && isSameRequest(m_currentRequest.value())) {
+        //! NOTE The request is reported as cancelled, when the conversion is interrupted
+        m_converter->cancel();
+        return;
+    }
+
+    auto it = std::find_if(m_queue.begin(), m_queue.end(), isSameRequest);
+    if (it != m_queue.end()) {
+        sendEvent(*it, "cancelled");
+        m_queue.erase(it);
+        return;
+    }
+
+    QJsonObject error;
+    error["error"] = "no request to cancel";
+    sendEvent(cancel, "failed", error);
+}
+
+void ConverterServer::scheduleNextRequest()
+{
+    if (m_isNextRequestScheduled) {
+        return;
+    }
+
+    m_isNextRequestScheduled = true;
+
+    std::shared_ptr<bool> isAlive = m_isAlive;
+    QMetaObject::invokeMethod(qApp, [this, isAlive]() {
+        if (!*isAlive) {
+            return;
+        }
+
+        m_isNextRequestScheduled = false;
+        processNextRequest();
+    }, Qt::QueuedConnection);
+}
+
+void ConverterServer::processNextRequest()
+{
+    //! NOTE The events are processed during the conversion, the next request is scheduled again after it
+    if (m_currentRequest) {
+        return;
+    }
+
+    if (m_queue.empty()) {
+        if (m_isShuttingDown && m_loop) {
+            m_loop->quit();
+        }
+        return;
+    }
+
+    m_currentRequest = m_queue.front();
+    m_queue.pop_front();
+
+    sendEvent(m_currentRequest.value(), "started");
+
+    QElapsedTimer timer;
+    timer.start();
+
+    Ret ret = executeRequest(m_currentRequest.value());
+
+    Request request = m_currentRequest.value();
+    m_currentRequest.reset();
+
+    if (ret) {
+        QJsonObject data;
+        data["timeMs"] = static_cast<qint64>(timer.elapsed());
+        sendEvent(request, "finished", data);
+    } else if (check_ret(ret, Ret::Code::Cancel)) {
+        sendEvent(request, "cancelled");
+    } else {
+        QJsonObject error;
+        error["code"] = ret.code();
+        error["error"] = QString::fromStdString(ret.toString());
+        sendEvent(request, "failed", error);
+    }
+
+    scheduleNextRequest();
+}
+
+Ret ConverterServer::executeRequest(const Request& request)
+{
+    TRACEFUNC;
+
+    const QJsonObject& params = request.params;
+
+    io::path in = params["in"].toString();
+    io::path out = params["out"].toString();
+    io::path stylePath = params["style"].toString();
+    bool forceMode = params["force"].toBool();
+
+    //! NOTE Without the output file the score media is printed to stdout, which is used for the responses
+    if (in.empty() || out.empty()) {
+        return make_ret(Err::ServerInvalidRequest, "no input or output file");
+    }
+
+    if (request.type == CONVERT_REQUEST) {
+        return m_converter->fileConvert(in, out, stylePath, forceMode);
+    }
+
+    if (request.type == SCORE_MEDIA_REQUEST) {
+        io::path highlightConfigPath = params["highlightConfig"].toString();
+        return m_converter->exportScoreMedia(in, out, highlightConfigPath, stylePath, forceMode);
+    }
+
+    return make_ret(Err::ServerInvalidRequest, "unknown request type: " + request.type.toStdString());
+}
+
+void ConverterServer::sendEvent(const Request& request, const QString& event, QJsonObject data) const
+{
+    if (!request.id.isEmpty()) {
+        data["id"] = request.id;
+    }
+
+    data["event"] = event;
+
+    sendToClient(request, data);
+}
+
+void ConverterServer::sendToClient(const Request& request, const QJsonObject& msg) const
+{
+    QByteArray data = QJsonDocument(msg).toJson(QJsonDocument::Compact) + '\n';
+
+    if (request.isStdinClient) {
+        std::cout << data.constData() << std::flush;
+        return;
+    }
+
+    if (request.client) {
+        request.client->write(data);
+        request.client->flush();
+    }
+}
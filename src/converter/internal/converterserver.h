@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_CONVERTER_CONVERTERSERVER_H
+#define MU_CONVERTER_CONVERTERSERVER_H
+
+#include <list>
+#include <memory>
+#include <optional>
+
+#include <QJsonObject>
+#include <QPointer>
+#include <QString>
+
+#include "async/asyncable.h"
+
+#include "../iconvertercontroller.h"
+
+class QEventLoop;
+class QLocalServer;
+class QLocalSocket;
+
+namespace mu::converter {
+//! NOTE Keeps the application running and converts the scores on request,
+//! so the startup (modules, fonts, instruments) is paid once for all of them.
+//!
+//! The requests and the responses are JSON objects, one per line:
+//!   {"id": "1", "type": "convert", "in": "a.mscz", "out": "a.pdf", "style": "a.mss", "force": false}
+//!   {"id": "2", "type": "scoreMedia", "in": "a.mscz", "out": "a.json", "highlightConfig": "h.json"}
+//!   {"id": "2", "type": "cancel"}
+//!   {"type": "shutdown"}
+//! Each request gets "queued" and then "started", "progress", "finished", "failed" or "cancelled" events:
+//!   {"id": "1", "event": "progress", "current": 2, "total": 5, "status": "writing"}
+//!
+//! The requests are converted one by one in the main thread, the layout isn't thread safe
+class ConverterServer : public async::Asyncable
+{
+public:
+    explicit ConverterServer(IConverterController* converter);
+    ~ConverterServer();
+
+    Ret run(const QString& socketName);
+
+private:
+    struct Request {
+        QString id;
+        QString type;
+        QJsonObject params;
+        QPointer<QLocalSocket> client; // null for stdin
+        bool isStdinClient = false;
+    };
+
+    bool listen(const QString& socketName);
+    bool isServerRunning(const QString& socketName) const;
+    void startStdinReader();
+
+    void onClientReadyRead(QLocalSocket* socket);
+    void onClientDisconnected(QLocalSocket* socket);
+    void onLine(const QByteArray& line, QLocalSocket* client, bool isStdinClient);
+    void onInputFinished();
+
+    void cancelRequest(const Request& cancel);
+    void scheduleNextRequest();
+    void processNextRequest();
+    Ret executeRequest(const Request& request);
+
+    void sendEvent(const Request& request, const QString& event, QJsonObject data = QJsonObject()) const;
+    void sendToClient(const Request& request, const QJsonObject& msg) const;
+
+    IConverterController* m_converter = nullptr;
+
+    QEventLoop* m_loop = nullptr;
+    QLocalServer* m_server = nullptr;
+
+    //! NOTE The stdin reader thread may outlive the server, it's blocked in reading
+    std::shared_ptr<bool> m_isAlive = std::make_shared<bool>(true);
+
+    std::list<Request> m_queue;
+    std::optional<Request> m_currentRequest;
+    bool m_isNextRequestScheduled = false;
+    bool m_isShuttingDown = false;
+};
+}
+
+#endif // MU_CONVERTER_CONVERTERSERVER_H
@@ -0,0 +1,212 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "internal/convertercache.h"
+#include "settings.h"
+
+using namespace mu;
+using namespace mu::converter;
+
+class ConverterCacheTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_cacheDir.isValid());
+        ASSERT_TRUE(m_filesDir.isValid());
+
+        m_cache.setPath(io::path(m_cacheDir.path()));
+    }
+
+    io::path makeFile(const QString& name, const QByteArray& data) const
+    {
+        QString filePath = m_filesDir.filePath(name);
+
+        QFile file(filePath);
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(data);
+
+        return io::path(filePath);
+    }
+
+    static QByteArray readFile(const io::path& path)
+    {
+        QFile file(path.toQString());
+        EXPECT_TRUE(file.open(QIODevice::ReadOnly));
+        return file.readAll();
+    }
+
+    std::string makeKey(const std::vector<io::path>& sourceFiles, const std::string& target) const
+    {
+        RetVal<QByteArray> sourceHash = m_cache.sourceHash(sourceFiles);
+        EXPECT_TRUE(sourceHash.ret);
+        return m_cache.key(sourceHash.val, target);
+    }
+
+    //! NOTE Makes the entry look used at the given time
+    void setUsedTime(const std::string& key, const QDateTime& time) const
+    {
+        QFile file(m_cacheDir.filePath(QString::fromStdString(key) + "/0"));
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.setFileTime(time, QFileDevice::FileModificationTime));
+    }
+
+    QTemporaryDir m_cacheDir;
+    QTemporaryDir m_filesDir;
+    ConverterCache m_cache;
+};
+
+TEST_F(ConverterCacheTests, Key)
+{
+    //! GIVEN Score and style
+    io::path score = makeFile("score.mscx", "score");
+    io::path style = makeFile("style.mss", "style");
+
+    //! THEN The key is the same for the same sources and target
+    std::string key = makeKey({ score, style }, "pdf");
+    EXPECT_FALSE(key.empty());
+    EXPECT_EQ(key, makeKey({ score, style }, "pdf"));
+
+    //! THEN It differs for another target, sources or options
+    EXPECT_NE(key, makeKey({ score, style }, "png"));
+    EXPECT_NE(key, makeKey({ score, io::path() }, "pdf"));
+    EXPECT_NE(key, makeKey({ io::path(), score }, "pdf"));
+
+    m_cache.setOptions("--some-option");
+    EXPECT_NE(key, makeKey({ score, style }, "pdf"));
+}
+
+TEST_F(ConverterCacheTests, KeyDependsOnSoundFonts)
+{
+    //! GIVEN Soundfonts directory
+    QTemporaryDir soundFontsDir;
+    ASSERT_TRUE(soundFontsDir.isValid());
+    m_cache.setSoundFontDirectories({ io::path(soundFontsDir.path()) });
+
+    io::path score = makeFile("score.mscx", "score");
+    std::string key = makeKey({ score }, "mp3");
+    std::string pdfKey = makeKey({ score }, "pdf");
+
+    //! WHEN A soundfont is added
+    QFile soundFont(soundFontsDir.filePath("piano.sf2"));
+    ASSERT_TRUE(soundFont.open(QIODevice::WriteOnly));
+    soundFont.write("soundfont");
+    soundFont.close();
+
+    //! THEN The directories aren't listed again by the same process, the key is the same
+    EXPECT_EQ(key, makeKey({ score }, "mp3"));
+
+    //! THEN The key of the next process is changed
+    m_cache.setSoundFontDirectories({ io::path(soundFontsDir.path()) });
+    std::string keyWithSoundFont = makeKey({ score }, "mp3");
+    EXPECT_NE(key, keyWithSoundFont);
+
+    //! WHEN The soundfont is changed
+    ASSERT_TRUE(soundFont.open(QIODevice::Append));
+    soundFont.write("more");
+    soundFont.close();
+
+    //! THEN The key of the next process is changed
+    m_cache.setSoundFontDirectories({ io::path(soundFontsDir.path()) });
+    EXPECT_NE(keyWithSoundFont, makeKey({ score }, "mp3"));
+
+    //! THEN The key of a target without audio doesn't depend on the soundfonts
+    EXPECT_EQ(pdfKey, makeKey({ score }, "pdf"));
+}
+
+TEST_F(ConverterCacheTests, OnlyAudioKeysDependOnAudioSettings)
+{
+    //! GIVEN Score
+    io::path score = makeFile("score.mscx", "score");
+    std::string mp3Key = makeKey({ score }, "mp3");
+    std::string pdfKey = makeKey({ score }, "pdf");
+    std::string midiKey = makeKey({ score }, "mid");
+
+    //! WHEN An audio setting is added
+    framework::settings()->setDefaultValue(framework::Settings::Key("audio", "converter_cache_tests/voices"), Val(64));
+
+    //! THEN Only the key of the audio target is changed
+    EXPECT_NE(mp3Key, makeKey({ score }, "mp3"));
+    EXPECT_EQ(pdfKey, makeKey({ score }, "pdf"));
+    EXPECT_EQ(midiKey, makeKey({ score }, "mid"));
+}
+
+TEST_F(ConverterCacheTests, StoreRestore)
+{
+    //! GIVEN Results of the conversion
+    std::vector<io::path> pages = { makeFile("page-1.png", "page 1"), makeFile("page-2.png", "page 2") };
+    std::string key = makeKey({ makeFile("score.mscx", "score") }, "png");
+
+    EXPECT_TRUE(m_cache.files(key).empty());
+
+    //! WHEN Store them
+    EXPECT_TRUE(m_cache.store(key, pages));
+
+    //! THEN The same files are restored in their order
+    std::vector<io::path> files = m_cache.files(key);
+    ASSERT_EQ(files.size(), 2u);
+    EXPECT_EQ(readFile(files[0]), "page 1");
+    EXPECT_EQ(readFile(files[1]), "page 2");
+
+    //! THEN The stored entry isn't rewritten
+    EXPECT_TRUE(m_cache.store(key, { makeFile("other.png", "other") }));
+    EXPECT_EQ(m_cache.files(key).size(), 2u);
+
+    //! THEN Nothing is restored for another key
+    EXPECT_TRUE(m_cache.files(makeKey({ makeFile("other.mscx", "other") }, "png")).empty());
+}
+
+TEST_F(ConverterCacheTests, RemoveLeastRecentlyUsed)
+{
+    //! GIVEN Cache, which has room for two entries
+    const QByteArray result(100, 'r');
+    m_cache.setMaxSize(2 * result.size());
+
+    std::string key1 = makeKey({ makeFile("score1.mscx", "score 1") }, "pdf");
+    std::string key2 = makeKey({ makeFile("score2.mscx", "score 2") }, "pdf");
+    std::string key3 = makeKey({ makeFile("score3.mscx", "score 3") }, "pdf");
+
+    //! GIVEN Two entries, the first one is used after the second one
+    EXPECT_TRUE(m_cache.store(key1, { makeFile("result1.pdf", result) }));
+    EXPECT_TRUE(m_cache.store(key2, { makeFile("result2.pdf", result) }));
+
+    QDateTime now = QDateTime::currentDateTime();
+    setUsedTime(key1, now.addSecs(-20));
+    setUsedTime(key2, now.addSecs(-10));
+
+    EXPECT_FALSE(m_cache.files(key1).empty());
+
+    //! WHEN Store the third one
+    EXPECT_TRUE(m_cache.store(key3, { makeFile("result3.pdf", result) }));
+
+    //! THEN The least recently used one is removed
+    EXPECT_FALSE(m_cache.files(key1).empty());
+    EXPECT_TRUE(m_cache.files(key2).empty());
+    EXPECT_FALSE(m_cache.files(key3).empty());
+}
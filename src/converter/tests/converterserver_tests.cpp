@@ -0,0 +1,261 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalSocket>
+#include <QTimer>
+
+#include "mocks/convertercontrollermock.h"
+
+#include "convertercodes.h"
+#include "internal/converterserver.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace mu;
+using namespace mu::converter;
+
+static constexpr int RESPONSE_TIMEOUT_MSECS = 5000;
+
+class ConverterServerTests : public ::testing::Test
+{
+public:
+    using ResponseHandler = std::function<void (const QJsonObject& response, QLocalSocket& client)>;
+
+    void SetUp() override
+    {
+        m_converter = std::make_shared<NiceMock<ConverterControllerMock>>();
+        ON_CALL(*m_converter, progressChanged()).WillByDefault(Return(m_progressChanged));
+
+        //! NOTE Unique per process, so the parallel test runs don't share the socket
+        m_socketName = QString("converter_server_tests_%1").arg(QCoreApplication::applicationPid());
+    }
+
+    //! NOTE Runs the server with a client, which sends the lines once connected.
+    //! The server quits after the shutdown request, when the accepted requests are done
+    Ret runSession(const QByteArrayList& lines, const ResponseHandler& onResponse = nullptr)
+    {
+        QLocalSocket client;
+
+        auto readResponses = [this, &client, &onResponse]() {
+            while (client.canReadLine()) {
+                QJsonObject response = QJsonDocument::fromJson(client.readLine()).object();
+                m_responses.push_back(response);
+
+                if (onResponse) {
+                    onResponse(response, client);
+                }
+            }
+        };
+
+        QObject::connect(&client, &QLocalSocket::readyRead, readResponses);
+
+        QObject::connect(&client, &QLocalSocket::connected, [&client, lines]() {
+            client.write(lines.join('\n') + '\n');
+            client.flush();
+        });
+
+        QTimer::singleShot(0, [this, &client]() {
+            client.connectToServer(m_socketName);
+        });
+
+        ConverterServer server(m_converter.get());
+        Ret ret = server.run(m_socketName);
+
+        //! NOTE The last responses may be sent right before the server quits
+        while (client.waitForReadyRead(100)) {
+        }
+        readResponses();
+
+        return ret;
+    }
+
+    //! NOTE The events of the request in the order they were received
+    QStringList events(const QString& id) const
+    {
+        QStringList result;
+        for (const QJsonObject& response : m_responses) {
+            if (response["id"].toString() == id) {
+                result << response["event"].toString();
+            }
+        }
+
+        return result;
+    }
+
+    QJsonObject lastResponse(const QString& id) const
+    {
+        for (auto it = m_responses.rbegin(); it != m_responses.rend(); ++it) {
+            if ((*it)["id"].toString() == id) {
+                return *it;
+            }
+        }
+
+        return QJsonObject();
+    }
+
+    static QByteArray convertRequest(const QString& id, const QString& in, const QString& out)
+    {
+        QJsonObject request;
+        request["id"] = id;
+        request["type"] = "convert";
+        request["in"] = in;
+        request["out"] = out;
+
+        return QJsonDocument(request).toJson(QJsonDocument::Compact);
+    }
+
+    static QByteArray cancelRequest(const QString& id)
+    {
+        return QString(R"({"id": "%1", "type": "cancel"})").arg(id).toUtf8();
+    }
+
+    static QByteArray shutdownRequest()
+    {
+        return R"({"type": "shutdown"})";
+    }
+
+protected:
+    std::shared_ptr<NiceMock<ConverterControllerMock> > m_converter;
+    framework::ProgressChannel m_progressChanged;
+    QString m_socketName;
+
+    std::vector<QJsonObject> m_responses;
+};
+
+TEST_F(ConverterServerTests, ConvertRequest)
+{
+    //! GIVEN The conversion, which reports a step
+    EXPECT_CALL(*m_converter, fileConvert(io::path("a.mscz"), io::path("a.pdf"), io::path(), false))
+    .WillOnce(Invoke([this](const io::path&, const io::path&, const io::path&, bool) {
+        m_progressChanged.send(framework::Progress(1, 2));
+        return make_ret(Ret::Code::Ok);
+    }));
+
+    //! WHEN The request is sent
+    Ret ret = runSession({ convertRequest("1", "a.mscz", "a.pdf"), shutdownRequest() });
+
+    //! THEN The server goes through all the stages of the request and quits
+    EXPECT_TRUE(ret);
+    EXPECT_EQ(events("1"), QStringList({ "queued", "started", "progress", "finished" }));
+
+    QJsonObject progress;
+    for (const QJsonObject& response : m_responses) {
+        if (response["event"].toString() == "progress") {
+            progress = response;
+        }
+    }
+
+    EXPECT_EQ(progress["current"].toInt(), 1);
+    EXPECT_EQ(progress["total"].toInt(), 2);
+}
+
+TEST_F(ConverterServerTests, MalformedLines)
+{
+    //! GIVEN Only the valid request is converted
+    EXPECT_CALL(*m_converter, fileConvert(io::path("c.mscz"), io::path("c.png"), _, _))
+    .WillOnce(Return(make_ret(Ret::Code::Ok)));
+
+    //! WHEN A line, which isn't JSON, and a request without the output file are sent before the valid one
+    Ret ret = runSession({ "{not json", convertRequest("2", "b.mscz", ""), convertRequest("3", "c.mscz", "c.png"), shutdownRequest() });
+
+    //! THEN Each of the invalid lines fails on its own, the server keeps going
+    EXPECT_TRUE(ret);
+
+    ASSERT_FALSE(m_responses.empty());
+    EXPECT_EQ(m_responses.front()["event"].toString(), "failed");
+    EXPECT_FALSE(m_responses.front().contains("id"));
+    EXPECT_TRUE(m_responses.front()["error"].toString().startsWith("failed parse request"));
+
+    EXPECT_EQ(events("2"), QStringList({ "queued", "started", "failed" }));
+    EXPECT_EQ(lastResponse("2")["code"].toInt(), static_cast<int>(Err::ServerInvalidRequest));
+
+    EXPECT_EQ(events("3"), QStringList({ "queued", "started", "finished" }));
+}
+
+TEST_F(ConverterServerTests, CancelQueuedRequest)
+{
+    //! GIVEN Only the request, which isn't cancelled, is converted
+    EXPECT_CALL(*m_converter, fileConvert(io::path("a.mscz"), _, _, _))
+    .WillOnce(Return(make_ret(Ret::Code::Ok)));
+
+    EXPECT_CALL(*m_converter, fileConvert(io::path("b.mscz"), _, _, _))
+    .Times(0);
+
+    //! WHEN The second request is cancelled before it's started, and an unknown one is cancelled too
+    Ret ret = runSession({ convertRequest("1", "a.mscz", "a.pdf"), convertRequest("2", "b.mscz", "b.pdf"),
+                           cancelRequest("2"), cancelRequest("9"), shutdownRequest() });
+
+    //! THEN The cancelled request is never started
+    EXPECT_TRUE(ret);
+    EXPECT_EQ(events("1"), QStringList({ "queued", "started", "finished" }));
+    EXPECT_EQ(events("2"), QStringList({ "queued", "cancelled" }));
+    EXPECT_EQ(events("9"), QStringList({ "failed" }));
+}
+
+TEST_F(ConverterServerTests, CancelRunningRequest)
+{
+    //! GIVEN The conversion, which goes on step by step until it's cancelled
+    bool cancelled = false;
+    EXPECT_CALL(*m_converter, cancel())
+    .WillOnce(Invoke([&cancelled]() {
+        cancelled = true;
+    }));
+
+    EXPECT_CALL(*m_converter, fileConvert(io::path("a.mscz"), _, _, _))
+    .WillOnce(Invoke([this, &cancelled](const io::path&, const io::path&, const io::path&, bool) {
+        QElapsedTimer timer;
+        timer.start();
+
+        //! NOTE The server reads the requests while the progress is reported
+        for (int step = 0; !cancelled && timer.elapsed() < RESPONSE_TIMEOUT_MSECS; ++step) {
+            m_progressChanged.send(framework::Progress(step, 0));
+        }
+
+        return cancelled ? make_ret(Ret::Code::Cancel) : make_ret(Ret::Code::Ok);
+    }));
+
+    //! WHEN The client cancels the request as soon as it's started
+    Ret ret = runSession({ convertRequest("1", "a.mscz", "a.pdf"), shutdownRequest() },
+                         [](const QJsonObject& response, QLocalSocket& client) {
+        if (response["id"].toString() == "1" && response["event"].toString() == "started") {
+            client.write(cancelRequest("1") + '\n');
+            client.flush();
+        }
+    });
+
+    //! THEN The conversion is interrupted and reported as cancelled
+    EXPECT_TRUE(ret);
+    EXPECT_TRUE(cancelled);
+    EXPECT_EQ(lastResponse("1")["event"].toString(), "cancelled");
+}
@@ -0,0 +1,53 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_CONVERTER_CONVERTERCONTROLLERMOCK_H
+#define MU_CONVERTER_CONVERTERCONTROLLERMOCK_H
+
+#include <gmock/gmock.h>
+
+#include "converter/iconvertercontroller.h"
+
+namespace mu::converter {
+class ConverterControllerMock : public IConverterController
+{
+public:
+    MOCK_METHOD(Ret, fileConvert, (const io::path&, const io::path&, const io::path&, bool), (override));
+    MOCK_METHOD(Ret, batchConvert, (const io::path&, const io::path&, bool, size_t, const io::path&), (override));
+    MOCK_METHOD(Ret, convertScoreParts, (const io::path&, const io::path&, const io::path&, bool), (override));
+
+    MOCK_METHOD(Ret, exportScoreMedia, (const io::path&, const io::path&, const io::path&, const io::path&, bool), (override));
+    MOCK_METHOD(Ret, exportScoreMeta, (const io::path&, const io::path&, const io::path&, bool), (override));
+    MOCK_METHOD(Ret, exportScoreParts, (const io::path&, const io::path&, const io::path&, bool), (override));
+    MOCK_METHOD(Ret, exportScorePartsPdfs, (const io::path&, const io::path&, const io::path&, bool), (override));
+    MOCK_METHOD(Ret, exportScoreTranspose, (const io::path&, const io::path&, const std::string&, const io::path&, bool), (override));
+
+    MOCK_METHOD(Ret, updateSource, (const io::path&, const std::string&, bool), (override));
+
+    MOCK_METHOD(Ret, runServer, (const std::string&), (override));
+    MOCK_METHOD(void, setCache, (const io::path&, const std::string&), (override));
+
+    MOCK_METHOD(framework::ProgressChannel, progressChanged, (), (const, override));
+    MOCK_METHOD(void, cancel, (), (override));
+};
+}
+
+#endif // MU_CONVERTER_CONVERTERCONTROLLERMOCK_H
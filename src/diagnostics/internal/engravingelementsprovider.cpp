@@ -31,18 +31,27 @@ void EngravingElementsProvider::reg(const Ms::EngravingObject* e)
         return;
     }
 
-    m_elements.push_back(e);
+    {
+        std::lock_guard<std::mutex> lock(m_elementsMutex);
+        m_elements.push_back(e);
+    }
+
     m_registreChanged.send(e, true);
 }
 
 void EngravingElementsProvider::unreg(const Ms::EngravingObject* e)
 {
-    m_elements.remove(e);
+    {
+        std::lock_guard<std::mutex> lock(m_elementsMutex);
+        m_elements.remove(e);
+    }
+
     m_registreChanged.send(e, false);
 }
 
 std::list<const Ms::EngravingObject*> EngravingElementsProvider::elements() const
 {
+    std::lock_guard<std::mutex> lock(m_elementsMutex);
     return m_elements;
 }
 
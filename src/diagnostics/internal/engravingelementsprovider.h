@@ -22,6 +22,8 @@
 #ifndef MU_DIAGNOSTICS_ENGRAVINGELEMENTSPROVIDER_H
 #define MU_DIAGNOSTICS_ENGRAVINGELEMENTSPROVIDER_H
 
+#include <mutex>
+
 #include "../iengravingelementsprovider.h"
 
 namespace mu::diagnostics {
@@ -43,6 +45,8 @@ public:
 
 private:
 
+    //! NOTE The elements may be created by the render threads (e.g. the clones of the svg export)
+    mutable std::mutex m_elementsMutex;
     std::list<const Ms::EngravingObject*> m_elements;
     async::Channel<const Ms::EngravingObject*, bool> m_registreChanged;
 
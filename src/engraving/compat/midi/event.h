@@ -420,6 +420,8 @@ public:
             _highestChannel = c;
         }
     }
+
+    int highestChannel() const { return _highestChannel; }
 };
 
 typedef EventList::iterator iEvent;
@@ -95,6 +95,11 @@ struct DrawData
         Transform transform;
         bool isAntialiasing = false;
         CompositionMode compositionMode = CompositionMode::SourceOver;
+
+        //! NOTE The clip rect is in the coordinates of the clip transform, the transform when it was set
+        bool isClipping = false;
+        RectF clipRect;
+        Transform clipTransform;
     };
 
     struct Data {
@@ -99,6 +99,12 @@ void BufferedPaintProvider::endObject()
 
 const DrawData::Data& BufferedPaintProvider::currentData() const
 {
+    //! NOTE The painter asks for the transform before it begins the target
+    if (m_currentObjects.empty()) {
+        static const DrawData::Data null;
+        return null;
+    }
+
     return m_currentObjects.top().datas.back();
 }
 
@@ -107,8 +113,40 @@ const DrawData::State& BufferedPaintProvider::currentState() const
     return currentData().state;
 }
 
-DrawData::Data& BufferedPaintProvider::editableData()
+//! NOTE The primitives of a data are painted by their kind, not in the order they were added.
+//! So a primitive, that would be painted before the ones already in the data, starts a new data with the same state
+DrawData::Data& BufferedPaintProvider::editableData(Primitive primitive)
 {
+    DrawData::Data& data = m_currentObjects.top().datas.back();
+
+    bool hasPaintedLater = false;
+    switch (primitive) {
+    case Primitive::Path:
+        hasPaintedLater = hasPaintedLater || !data.polygons.empty();
+        [[fallthrough]];
+    case Primitive::Polygon:
+        hasPaintedLater = hasPaintedLater || !data.texts.empty();
+        [[fallthrough]];
+    case Primitive::Text:
+        hasPaintedLater = hasPaintedLater || !data.rectTexts.empty();
+        [[fallthrough]];
+    case Primitive::RectText:
+        hasPaintedLater = hasPaintedLater || !data.pixmaps.empty();
+        [[fallthrough]];
+    case Primitive::Pixmap:
+        hasPaintedLater = hasPaintedLater || !data.tiledPixmap.empty();
+        [[fallthrough]];
+    case Primitive::TiledPixmap:
+        break;
+    }
+
+    if (!hasPaintedLater) {
+        return data;
+    }
+
+    DrawData::Data newData;
+    newData.state = data.state;
+    m_currentObjects.top().datas.push_back(std::move(newData));
     return m_currentObjects.top().datas.back();
 }
 
@@ -174,10 +212,17 @@ const Brush& BufferedPaintProvider::brush() const
 
 void BufferedPaintProvider::save()
 {
+    m_savedStates.push(currentState());
 }
 
 void BufferedPaintProvider::restore()
 {
+    IF_ASSERT_FAILED(!m_savedStates.empty()) {
+        return;
+    }
+
+    editableState() = m_savedStates.top();
+    m_savedStates.pop();
 }
 
 void BufferedPaintProvider::setTransform(const Transform& transform)
@@ -196,16 +241,20 @@ const Transform& BufferedPaintProvider::transform() const
 void BufferedPaintProvider::drawPath(const PainterPath& path)
 {
     const DrawData::State& st = currentState();
+    const bool noPen = st.pen.style() == PenStyle::NoPen;
+    const bool noBrush = st.brush.style() == BrushStyle::NoBrush;
+    if (noPen && noBrush) {
+        LOGW() << "not set pen or brush, path will not draw";
+        return;
+    }
+
     DrawMode mode = DrawMode::StrokeAndFill;
-    if (st.pen.style() == PenStyle::NoPen) {
+    if (noPen) {
         mode = DrawMode::Fill;
-    } else if (st.brush.style() == BrushStyle::NoBrush) {
+    } else if (noBrush) {
         mode = DrawMode::Stroke;
-    } else {
-        LOGW() << "not set pen or brush, path will not draw";
-        return;
     }
-    editableData().paths.push_back({ path, st.pen, st.brush, mode });
+    editableData(Primitive::Path).paths.push_back({ path, st.pen, st.brush, mode });
 }
 
 void BufferedPaintProvider::drawPolygon(const PointF* points, size_t pointCount, PolygonMode mode)
@@ -214,17 +263,17 @@ void BufferedPaintProvider::drawPolygon(const PointF* points, size_t pointCount,
     for (size_t i = 0; i < pointCount; ++i) {
         pol[i] = PointF(points[i].x(), points[i].y());
     }
-    editableData().polygons.push_back(DrawPolygon { pol, mode });
+    editableData(Primitive::Polygon).polygons.push_back(DrawPolygon { pol, mode });
 }
 
 void BufferedPaintProvider::drawText(const PointF& point, const QString& text)
 {
-    editableData().texts.push_back(DrawText { point, text });
+    editableData(Primitive::Text).texts.push_back(DrawText { point, text });
 }
 
 void BufferedPaintProvider::drawText(const RectF& rect, int flags, const QString& text)
 {
-    editableData().rectTexts.push_back(DrawRectText { rect, flags, text });
+    editableData(Primitive::RectText).rectTexts.push_back(DrawRectText { rect, flags, text });
 }
 
 void BufferedPaintProvider::drawTextWorkaround(const Font& f, const PointF& pos, const QString& text)
@@ -240,12 +289,39 @@ void BufferedPaintProvider::drawSymbol(const PointF& point, uint ucs4Code)
 
 void BufferedPaintProvider::drawPixmap(const PointF& p, const Pixmap& pm)
 {
-    editableData().pixmaps.push_back(DrawPixmap { p, pm });
+    editableData(Primitive::Pixmap).pixmaps.push_back(DrawPixmap { p, pm });
 }
 
 void BufferedPaintProvider::drawTiledPixmap(const RectF& rect, const Pixmap& pm, const PointF& offset)
 {
-    editableData().tiledPixmap.push_back(DrawTiledPixmap { rect, pm, offset });
+    editableData(Primitive::TiledPixmap).tiledPixmap.push_back(DrawTiledPixmap { rect, pm, offset });
+}
+
+#ifndef NO_QT_SUPPORT
+void BufferedPaintProvider::drawPixmap(const PointF& point, const QPixmap& pm)
+{
+    drawPixmap(point, Pixmap::fromQPixmap(pm));
+}
+
+void BufferedPaintProvider::drawTiledPixmap(const RectF& rect, const QPixmap& pm, const PointF& offset)
+{
+    drawTiledPixmap(rect, Pixmap::fromQPixmap(pm), offset);
+}
+
+#endif
+
+//! NOTE As QPainter::setClipRect(), the rect is mapped by the current transform and it enables the clipping
+void BufferedPaintProvider::setClipRect(const RectF& rect)
+{
+    DrawData::State& st = editableState();
+    st.clipRect = rect;
+    st.clipTransform = st.transform;
+    st.isClipping = true;
+}
+
+void BufferedPaintProvider::setClipping(bool enable)
+{
+    editableState().isClipping = enable;
 }
 
 const DrawData& BufferedPaintProvider::drawData() const
@@ -256,6 +332,6 @@ const DrawData& BufferedPaintProvider::drawData() const
 void BufferedPaintProvider::clear()
 {
     m_buf = DrawData();
-    std::stack<DrawData::Object> empty;
-    m_currentObjects.swap(empty);
+    m_currentObjects = std::stack<DrawData::Object>();
+    m_savedStates = std::stack<DrawData::State>();
 }
@@ -78,6 +78,14 @@ public:
     void drawPixmap(const PointF& p, const Pixmap& pm) override;
     void drawTiledPixmap(const RectF& rect, const Pixmap& pm, const PointF& offset = PointF()) override;
 
+#ifndef NO_QT_SUPPORT
+    void drawPixmap(const PointF& point, const QPixmap& pm) override;
+    void drawTiledPixmap(const RectF& rect, const QPixmap& pm, const PointF& offset = PointF()) override;
+#endif
+
+    void setClipRect(const RectF& rect) override;
+    void setClipping(bool enable) override;
+
     // ---
 
     const DrawData& drawData() const;
@@ -85,14 +93,25 @@ public:
 
 private:
 
+    //! NOTE In the order the primitives of a data are painted
+    enum class Primitive {
+        Path = 0,
+        Polygon,
+        Text,
+        RectText,
+        Pixmap,
+        TiledPixmap
+    };
+
     const DrawData::Data& currentData() const;
-    DrawData::Data& editableData();
+    DrawData::Data& editableData(Primitive primitive);
 
     const DrawData::State& currentState() const;
     DrawData::State& editableState();
 
     DrawData m_buf;
     std::stack<DrawData::Object> m_currentObjects;
+    std::stack<DrawData::State> m_savedStates;
     bool m_isActive = false;
     DrawObjectsLogger* m_drawObjectsLogger = nullptr;
 };
@@ -158,6 +158,11 @@ static QJsonObject toObj(const DrawData::State& st)
     obj["isAntialiasing"] = st.isAntialiasing;
     obj["transform"] = toArr(st.transform);
     obj["compositionMode"] = static_cast<int>(st.compositionMode);
+    if (st.isClipping) {
+        obj["isClipping"] = st.isClipping;
+        obj["clipRect"] = toArr(st.clipRect);
+        obj["clipTransform"] = toArr(st.clipTransform);
+    }
     return obj;
 }
 
@@ -169,6 +174,11 @@ static void fromObj(const QJsonObject& obj, DrawData::State& st)
     st.isAntialiasing = obj["isAntialiasing"].toBool();
     fromArr(obj["transform"].toArray(), st.transform);
     st.compositionMode = static_cast<CompositionMode>(obj["compositionMode"].toInt());
+    st.isClipping = obj["isClipping"].toBool();
+    if (st.isClipping) {
+        fromArr(obj["clipRect"].toArray(), st.clipRect);
+        fromArr(obj["clipTransform"].toArray(), st.clipTransform);
+    }
 }
 
 static QJsonObject toObj(const PainterPath& path)
@@ -286,7 +286,8 @@ void QPainterProvider::drawTextWorkaround(const Font& f, const PointF& pos, cons
 
 void QPainterProvider::drawSymbol(const PointF& point, uint ucs4Code)
 {
-    static QHash<uint, QString> cache;
+    //! NOTE The pages are drawn by several threads at once (the exports), so the cache is per thread
+    static thread_local QHash<uint, QString> cache;
     if (!cache.contains(ucs4Code)) {
         cache[ucs4Code] = QString::fromUcs4(&ucs4Code, 1);
     }
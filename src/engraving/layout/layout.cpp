@@ -73,9 +73,21 @@ Layout::Layout(Ms::Score* score)
 }
 
 void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, const Fraction& et)
+{
+    layoutRange(options, st, et, -1);
+}
+
+void Layout::doLayoutPages(const LayoutOptions& options, int pagesCount)
+{
+    Q_ASSERT(pagesCount > 0);
+    layoutRange(options, Fraction(0, 1), Fraction(-1, 1), pagesCount);
+}
+
+void Layout::layoutRange(const LayoutOptions& options, const Fraction& st, const Fraction& et, int maxPagesCount)
 {
     CmdStateLocker cmdStateLocker(m_score);
     LayoutContext lc(m_score);
+    lc.maxPagesCount = maxPagesCount;
 
     Fraction stick(st);
     Fraction etick(et);
@@ -238,7 +250,10 @@ void Layout::doLayout(const LayoutOptions& options, LayoutContext& lc)
         //    c) this page ends with the same measure as the previous layout
         //    pageOldMeasure will be last measure from previous layout if range was completed on or before this page
         //    it will be nullptr if this page was never laid out or if we collected a system for next page
-    } while (lc.curSystem && !(lc.rangeDone && lmb == lc.pageOldMeasure));
+        // or
+        // 3) we have laid out the requested number of pages
+    } while (lc.curSystem && !(lc.rangeDone && lmb == lc.pageOldMeasure)
+             && (lc.maxPagesCount < 0 || lc.curPage < lc.maxPagesCount));
     // && page->system(0)->measures().back()->tick() > endTick // FIXME: perhaps the first measure was meant? Or last system?
 
     if (!lc.curSystem) {
@@ -40,8 +40,14 @@ public:
 
     void doLayoutRange(const LayoutOptions& options, const Ms::Fraction&, const Ms::Fraction&);
 
+    //! NOTE Lays out the score from the beginning, but stops when the given number of pages is laid out.
+    //! The rest of the score stays without layout, so a complete layout is needed before the score is edited or shown
+    void doLayoutPages(const LayoutOptions& options, int pagesCount);
+
 private:
 
+    void layoutRange(const LayoutOptions& options, const Ms::Fraction&, const Ms::Fraction&, int maxPagesCount);
+
     void layoutLinear(const LayoutOptions& options, LayoutContext& lc);
     void layoutLinear(bool layoutAll, const LayoutOptions& options, LayoutContext& lc);
     void resetSystems(bool layoutAll, const LayoutOptions& options, LayoutContext& lc);
@@ -59,6 +59,7 @@ struct LayoutContext
     int measureNo = 0;
     Ms::Fraction startTick;
     Ms::Fraction endTick;
+    int maxPagesCount = -1; // the page layout stops after this number of pages, -1 means no limit
 
     LayoutContext(Ms::Score* s);
     LayoutContext(const LayoutContext&) = delete;
@@ -213,6 +213,8 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/pitchvalue.h
     ${CMAKE_CURRENT_LIST_DIR}/pos.cpp
     ${CMAKE_CURRENT_LIST_DIR}/pos.h
+    ${CMAKE_CURRENT_LIST_DIR}/positiontable.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/positiontable.h
     ${CMAKE_CURRENT_LIST_DIR}/property.cpp
     ${CMAKE_CURRENT_LIST_DIR}/property.h
     ${CMAKE_CURRENT_LIST_DIR}/range.cpp
@@ -168,6 +168,7 @@ void MasterScore::setPlaylistDirty()
     _playlistDirty = true;
     _repeatList->setScoreChanged();
     _repeatList2->setScoreChanged();
+    invalidatePositionTables();
 }
 
 //---------------------------------------------------------
@@ -192,6 +193,23 @@ void MasterScore::updateRepeatListTempo()
 {
     _repeatList->updateTempo();
     _repeatList2->updateTempo();
+    invalidatePositionTables();
+}
+
+//---------------------------------------------------------
+//   invalidatePositionTables
+//    the events of the position tables of the score and
+//    of its parts follow the repeats and the tempo
+//---------------------------------------------------------
+
+void MasterScore::invalidatePositionTables()
+{
+    invalidatePositionTable();
+    for (const Excerpt* excerpt : qAsConst(_excerpts)) {
+        if (excerpt->partScore()) {
+            excerpt->partScore()->invalidatePositionTable();
+        }
+    }
 }
 
 //---------------------------------------------------------
@@ -74,6 +74,8 @@ class MasterScore : public Score
     void removeDeletedMidiMapping();
     int updateMidiMapping();
 
+    void invalidatePositionTables();
+
     QFileInfo _sessionStartBackupInfo;
     QFileInfo info;
 
@@ -121,10 +121,10 @@ int MScore::mtcType;
 
 bool MScore::noExcerpts = false;
 bool MScore::noImages = false;
-bool MScore::pdfPrinting = false;
-bool MScore::svgPrinting = false;
+thread_local bool MScore::pdfPrinting = false;
+thread_local bool MScore::svgPrinting = false;
 
-double MScore::pixelRatio  = 0.8;         // DPI / logicalDPI
+thread_local double MScore::pixelRatio  = 0.8;         // DPI / logicalDPI
 
 extern void initDrumset();
 extern QString mscoreGlobalShare;
@@ -371,9 +371,10 @@ public:
     static bool noExcerpts;
     static bool noImages;
 
-    static bool pdfPrinting;
-    static bool svgPrinting;
-    static double pixelRatio;
+    //! NOTE The state of the render, several renders may run at once in different threads (e.g. the media export)
+    static thread_local bool pdfPrinting;
+    static thread_local bool svgPrinting;
+    static thread_local double pixelRatio;
 
     static qreal verticalPageGap;
     static qreal horizontalPageGapEven;
@@ -103,6 +103,22 @@ QList<EngravingItem*> Page::items(const mu::PointF& p)
 #endif
 }
 
+//---------------------------------------------------------
+//   validateBspTree
+//    items() rebuilds an invalid tree on the first call,
+//    so the tree is rebuilt here beforehand when the page
+//    is going to be read by several threads at once
+//---------------------------------------------------------
+
+void Page::validateBspTree()
+{
+#ifdef USE_BSP
+    if (!bspTreeValid) {
+        doRebuildBspTree();
+    }
+#endif
+}
+
 //---------------------------------------------------------
 //   appendSystem
 //---------------------------------------------------------
@@ -86,6 +86,7 @@ public:
     QList<EngravingItem*> items(const mu::RectF& r);
     QList<EngravingItem*> items(const mu::PointF& p);
     void invalidateBspTree() { bspTreeValid = false; }
+    void validateBspTree();
     mu::PointF pagePos() const override { return mu::PointF(); }       ///< position in page coordinates
     QList<EngravingItem*> elements() const;           ///< list of visible elements
     mu::RectF tbbox();                             // tight bounding box, excluding white space
@@ -0,0 +1,179 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "positiontable.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "measure.h"
+#include "page.h"
+#include "repeatlist.h"
+#include "score.h"
+#include "segment.h"
+#include "system.h"
+#include "tempo.h"
+
+using namespace mu;
+
+namespace Ms {
+//---------------------------------------------------------
+//   build
+//---------------------------------------------------------
+
+void PositionTable::build(const Score* score)
+{
+    clear();
+
+    std::unordered_map<const Measure*, size_t> measureIdx;
+    std::unordered_map<const Segment*, size_t> segmentIdx;
+
+    const System* lastSystem = nullptr;
+    int lastPageIdx = -1;
+
+    for (const Measure* m = score->firstMeasureMM(); m; m = m->nextMeasureMM()) {
+        const System* system = m->system();
+        if (system && system != lastSystem) {
+            lastSystem = system;
+            lastPageIdx = score->pageIdx(system->page());
+        }
+
+        MeasurePosition mp;
+        mp.measure = m;
+        mp.system = system;
+        mp.tick = m->tick().ticks();
+        if (system) {
+            mp.page = system->page();
+            mp.pageIdx = lastPageIdx;
+            mp.pos = PointF(m->pagePos().x(), system->pagePos().y());
+        }
+
+        measureIdx[m] = _measures.size();
+        _measures.push_back(mp);
+
+        const Segment* first = m->first(SegmentType::ChordRest);
+        for (const Segment* s = first; s; s = s->next(SegmentType::ChordRest)) {
+            SegmentPosition sp;
+            sp.segment = s;
+            sp.measure = m;
+            sp.system = system;
+            sp.page = mp.page;
+            sp.pageIdx = mp.pageIdx;
+            sp.tick = s->tick().ticks();
+            sp.isCursorStop = s == first || s->visible();
+
+            const Segment* ns = s->next(SegmentType::ChordRest);
+            while (ns && !ns->visible()) {
+                ns = ns->next(SegmentType::ChordRest);
+            }
+
+            if (ns) {
+                sp.endTick = ns->tick().ticks();
+            } else {
+                sp.endTick = m->endTick().ticks();
+            }
+
+            if (system) {
+                sp.pos = s->pagePos();
+                if (ns) {
+                    sp.endX = ns->pagePos().x();
+                } else {
+                    // measure->width is not good enough because of courtesy keysig, timesig
+                    const Segment* barLine = m->findSegment(SegmentType::EndBarLine, m->tick() + m->ticks());
+                    sp.endX = barLine ? barLine->pagePos().x() : m->pagePos().x() + m->width();
+                }
+            }
+
+            segmentIdx[s] = _segments.size();
+            _segments.push_back(sp);
+        }
+    }
+
+    //! NOTE The time of an event is taken in its repeat segment,
+    //! instead of looking the repeat segment up for every tick (see RepeatList::utick2utime)
+    const TempoMap* tempoMap = score->tempomap();
+
+    for (const RepeatSegment* rs : score->repeatList()) {
+        int startTick = rs->tick;
+        int endTick = startTick + rs->len();
+        int tickOffset = rs->utick - rs->tick;
+
+        for (const Measure* m = score->tick2measureMM(Fraction::fromTicks(startTick)); m; m = m->nextMeasureMM()) {
+            int tick = m->tick().ticks();
+            _measureEvents.push_back({ tick + tickOffset, tempoMap->tick2time(tick) + rs->timeOffset, measureIdx[m] });
+
+            for (const Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+                tick = s->tick().ticks();
+                _segmentEvents.push_back({ tick + tickOffset, tempoMap->tick2time(tick) + rs->timeOffset, segmentIdx[s] });
+            }
+
+            if (m->endTick().ticks() >= endTick) {
+                break;
+            }
+        }
+    }
+
+    _valid = true;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void PositionTable::clear()
+{
+    _segments.clear();
+    _measures.clear();
+    _segmentEvents.clear();
+    _measureEvents.clear();
+    _valid = false;
+}
+
+//---------------------------------------------------------
+//   cursorSegment
+//    the segment the playback cursor moves from at tick,
+//    nullptr if the tick is out of the laid out measures
+//---------------------------------------------------------
+
+const PositionTable::SegmentPosition* PositionTable::cursorSegment(int tick) const
+{
+    auto it = std::upper_bound(_segments.cbegin(), _segments.cend(), tick, [](int t, const SegmentPosition& sp) {
+        return t < sp.tick;
+    });
+
+    if (it == _segments.cbegin()) {
+        return nullptr;
+    }
+
+    // the first segment of a measure is always a stop
+    --it;
+    while (!it->isCursorStop) {
+        --it;
+    }
+
+    if (tick >= it->endTick) {
+        return nullptr;
+    }
+
+    return &(*it);
+}
+}
@@ -0,0 +1,96 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __POSITIONTABLE_H__
+#define __POSITIONTABLE_H__
+
+#include <vector>
+
+#include "infrastructure/draw/geometry.h"
+
+namespace Ms {
+class Score;
+class Measure;
+class Page;
+class Segment;
+class System;
+
+//---------------------------------------------------------
+//   PositionTable
+//    the page positions of the ChordRest segments and of
+//    the measures in the order of the layout (with the mm rests),
+//    and the unrolled playback events of them.
+//    Built once after the layout, see Score::positionTable()
+//---------------------------------------------------------
+
+class PositionTable
+{
+public:
+    struct SegmentPosition {
+        const Segment* segment = nullptr;
+        const Measure* measure = nullptr;
+        const System* system = nullptr;
+        const Page* page = nullptr;
+        int pageIdx = -1;
+        int tick = 0;
+        int endTick = 0;            // tick of the next visible ChordRest segment of the measure or the measure end
+        mu::PointF pos;             // page position
+        qreal endX = 0.0;           // page x of endTick
+        bool isCursorStop = false;  // the first segment of the measure or a visible one
+    };
+
+    struct MeasurePosition {
+        const Measure* measure = nullptr;
+        const System* system = nullptr;
+        const Page* page = nullptr;
+        int pageIdx = -1;
+        int tick = 0;
+        mu::PointF pos;             // page x of the measure, page y of the system
+    };
+
+    struct Event {
+        int utick = 0;
+        qreal utime = 0.0;          // seconds
+        size_t index = 0;           // in segments() or measures()
+    };
+
+    void build(const Score* score);
+    void clear();
+    bool isValid() const { return _valid; }
+
+    const std::vector<SegmentPosition>& segments() const { return _segments; }
+    const std::vector<MeasurePosition>& measures() const { return _measures; }
+
+    const std::vector<Event>& segmentEvents() const { return _segmentEvents; }
+    const std::vector<Event>& measureEvents() const { return _measureEvents; }
+
+    const SegmentPosition* cursorSegment(int tick) const;
+
+private:
+    std::vector<SegmentPosition> _segments;       // sorted by tick
+    std::vector<MeasurePosition> _measures;       // sorted by tick
+    std::vector<Event> _segmentEvents;            // sorted by utick
+    std::vector<Event> _measureEvents;            // sorted by utick
+    bool _valid = false;
+};
+}     // namespace Ms
+#endif
@@ -27,9 +27,16 @@
 
 #include "rendermidi.h"
 
+#include <algorithm>
+#include <numeric>
 #include <set>
 #include <cmath>
 
+#include <QThreadPool>
+#ifndef Q_OS_WASM
+#include <QtConcurrent>
+#endif
+
 #include "style/style.h"
 #include "compat/midi/event.h"
 
@@ -1161,6 +1168,50 @@ void MidiRenderer::renderStaffChunk(const Chunk& chunk, EventMap* events, const
     }
 }
 
+//---------------------------------------------------------
+//   renderStavesInParallel
+//    Staves are split into contiguous groups, each group is
+//    rendered on the global thread pool into its own EventMap.
+//    Everything that modifies the score (play events, velocities,
+//    channels) is prepared before, so rendering of a staff only
+//    reads the score. The maps are merged in staff order, so events
+//    with equal ticks keep the order of the sequential rendering.
+//---------------------------------------------------------
+
+void MidiRenderer::renderStavesInParallel(const Chunk& chunk, EventMap* events, const StaffContext& sctx)
+{
+    const QList<Staff*>& staves = score->staves();
+    const int stavesCount = staves.size();
+    const int groupsCount = std::min(stavesCount, std::max(1, QThreadPool::globalInstance()->maxThreadCount()));
+
+    std::vector<EventMap> groupEvents(groupsCount);
+    std::vector<int> groups(groupsCount);
+    std::iota(groups.begin(), groups.end(), 0);
+
+    auto renderGroup = [&](int groupIdx) {
+        const int firstStaff = stavesCount * groupIdx / groupsCount;
+        const int lastStaff = stavesCount * (groupIdx + 1) / groupsCount;
+
+        StaffContext groupCtx = sctx;
+        for (int staffIdx = firstStaff; staffIdx < lastStaff; ++staffIdx) {
+            groupCtx.staff = staves.at(staffIdx);
+            renderStaffChunk(chunk, &groupEvents[groupIdx], groupCtx);
+        }
+    };
+
+#ifndef Q_OS_WASM
+    // the calling thread renders the groups too, while it waits
+    QtConcurrent::blockingMap(groups, renderGroup);
+#else
+    std::for_each(groups.begin(), groups.end(), renderGroup);
+#endif
+
+    for (EventMap& group : groupEvents) {
+        events->registerChannel(group.highestChannel());
+        events->merge(group);
+    }
+}
+
 //---------------------------------------------------------
 //   renderSpanners
 //---------------------------------------------------------
@@ -2465,13 +2516,15 @@ void Score::renderMidi(EventMap* events, const SynthesizerState& synthState)
     renderMidi(events, true, MScore::playRepeats, synthState);
 }
 
-void Score::renderMidi(EventMap* events, bool metronome, bool expandRepeats, const SynthesizerState& synthState)
+void Score::renderMidi(EventMap* events, bool metronome, bool expandRepeats, const SynthesizerState& synthState,
+                       bool renderStavesInParallel)
 {
     masterScore()->setExpandRepeats(expandRepeats);
     MidiRenderer::Context ctx;
     ctx.synthState = synthState;
     ctx.metronome = metronome;
     ctx.renderHarmony = true;
+    ctx.renderStavesInParallel = renderStavesInParallel;
     MidiRenderer(this).renderScore(events, ctx);
 }
 
@@ -2525,14 +2578,19 @@ void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Conte
         break;
     }
 
+    StaffContext sctx;
+    sctx.method = renderMethod;
+    sctx.cc = cc;
+    sctx.renderHarmony = ctx.renderHarmony;
+
     // create note & other events
-    for (Staff* st : score->staves()) {
-        StaffContext sctx;
-        sctx.staff = st;
-        sctx.method = renderMethod;
-        sctx.cc = cc;
-        sctx.renderHarmony = ctx.renderHarmony;
-        renderStaffChunk(chunk, events, sctx);
+    if (ctx.renderStavesInParallel) {
+        renderStavesInParallel(chunk, events, sctx);
+    } else {
+        for (Staff* st : score->staves()) {
+            sctx.staff = st;
+            renderStaffChunk(chunk, events, sctx);
+        }
     }
     events->fixupMIDI();
 
@@ -115,6 +115,7 @@ private:
     void updateState();
 
     void renderStaffChunk(const Chunk&, EventMap* events, const StaffContext& sctx);
+    void renderStavesInParallel(const Chunk&, EventMap* events, const StaffContext& sctx);
     void renderSpanners(const Chunk&, EventMap* events);
     void renderMetronome(const Chunk&, EventMap* events);
     void renderMetronome(EventMap* events, Measure const* m, const Fraction& tickOffset);
@@ -131,6 +132,7 @@ public:
         Ms::SynthesizerState synthState;
         bool metronome{ true };
         bool renderHarmony{ false };
+        bool renderStavesInParallel{ false };   ///< render staves on worker threads, each into its own EventMap
 
         Context() {}
     };
@@ -28,6 +28,7 @@
 #include "score.h"
 
 #include <assert.h>
+#include <algorithm>
 #include <cmath>
 #include <QBuffer>
 
@@ -825,6 +826,34 @@ ScoreContentState Score::state() const
     return ScoreContentState(this, undoStack()->state());
 }
 
+//---------------------------------------------------------
+//   printing
+//    True if we are drawing to a printer. The score may be
+//    drawn by several threads at once (e.g. the media export),
+//    so the state is kept per thread
+//---------------------------------------------------------
+
+static thread_local std::vector<const Score*> s_printingScores;
+
+bool Score::printing() const
+{
+    return !s_printingScores.empty() && std::find(s_printingScores.cbegin(), s_printingScores.cend(), this) != s_printingScores.cend();
+}
+
+//---------------------------------------------------------
+//   setPrinting
+//---------------------------------------------------------
+
+void Score::setPrinting(bool val)
+{
+    auto it = std::find(s_printingScores.begin(), s_printingScores.end(), this);
+    if (val && it == s_printingScores.end()) {
+        s_printingScores.push_back(this);
+    } else if (!val && it != s_printingScores.end()) {
+        s_printingScores.erase(it);
+    }
+}
+
 //---------------------------------------------------------
 //   playlistDirty
 //---------------------------------------------------------
@@ -1923,6 +1952,31 @@ int Score::utime2utick(qreal utime) const
     return repeatList().utime2utick(utime);
 }
 
+//---------------------------------------------------------
+//   positionTable
+//    built on the first query after the layout
+//    or a change of the repeats, see invalidatePositionTable()
+//---------------------------------------------------------
+
+const PositionTable& Score::positionTable() const
+{
+    std::lock_guard<std::mutex> lock(m_positionTableMutex);
+    if (!m_positionTable.isValid()) {
+        m_positionTable.build(this);
+    }
+    return m_positionTable;
+}
+
+//---------------------------------------------------------
+//   invalidatePositionTable
+//---------------------------------------------------------
+
+void Score::invalidatePositionTable()
+{
+    std::lock_guard<std::mutex> lock(m_positionTableMutex);
+    m_positionTable.clear();
+}
+
 //---------------------------------------------------------
 //   inputPos
 //---------------------------------------------------------
@@ -5212,6 +5266,24 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 
     m_layoutOptions.updateFromStyle(style());
     m_layout.doLayoutRange(m_layoutOptions, st, et);
+    invalidatePositionTable();
+}
+
+//---------------------------------------------------------
+//   doLayoutPages
+//    lay out only the first pagesCount pages,
+//    e.g. for a thumbnail; the rest of the score is left
+//    without layout
+//---------------------------------------------------------
+
+void Score::doLayoutPages(int pagesCount)
+{
+    _scoreFont = ScoreFont::fontByName(style().value(Sid::MusicalSymbolFont).toString());
+    _noteHeadWidth = _scoreFont->width(SymId::noteheadBlack, spatium() / SPATIUM20);
+
+    m_layoutOptions.updateFromStyle(style());
+    m_layout.doLayoutPages(m_layoutOptions, pagesCount);
+    invalidatePositionTable();
 }
 
 UndoStack* Score::undoStack() const { return _masterScore->undoStack(); }
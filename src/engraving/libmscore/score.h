@@ -28,6 +28,7 @@
  Definition of Score class.
 */
 
+#include <mutex>
 #include <set>
 #include <QFileInfo>
 #include <QQueue>
@@ -44,6 +45,7 @@
 #include "layoutbreak.h"
 #include "property.h"
 #include "chordlist.h"
+#include "positiontable.h"
 
 #include "infrastructure/io/mscwriter.h"
 #include "infrastructure/io/mscreader.h"
@@ -480,7 +482,6 @@ private:
     bool _showPageborders       { false };
     bool _markIrregularMeasures { true };
     bool _showInstrumentNames   { true };
-    bool _printing              { false };        ///< True if we are drawing to a printer
     bool _autosaveDirty         { true };
     bool _savedCapture          { false };        ///< True if we saved an image capture
     bool _saved                 { false };      ///< True if project was already saved; only on first
@@ -510,6 +511,9 @@ private:
     mu::engraving::LayoutOptions m_layoutOptions;
     mu::engraving::compat::DummyElement* m_dummyElement = nullptr;
 
+    mutable PositionTable m_positionTable;
+    mutable std::mutex m_positionTableMutex;
+
     ChordRest* nextMeasure(ChordRest* element, bool selectBehavior = false, bool mmRest = false);
     ChordRest* prevMeasure(ChordRest* element, bool mmRest = false);
     void cmdResetAllStyle();
@@ -899,8 +903,8 @@ public:
     bool saved() const { return _saved; }
     void setSaved(bool v) { _saved = v; }
     void setSavedCapture(bool v) { _savedCapture = v; }
-    bool printing() const { return _printing; }
-    void setPrinting(bool val) { _printing = val; }
+    bool printing() const;
+    void setPrinting(bool val);
     void setAutosaveDirty(bool v) { _autosaveDirty = v; }
     bool autosaveDirty() const { return _autosaveDirty; }
     virtual bool playlistDirty() const;
@@ -974,7 +978,8 @@ public:
     void readAddConnector(ConnectorInfoReader* info, bool pasteMode) override;
     void pasteSymbols(XmlReader& e, ChordRest* dst);
     void renderMidi(EventMap* events, const SynthesizerState& synthState);
-    void renderMidi(EventMap* events, bool metronome, bool expandRepeats, const SynthesizerState& synthState);
+    void renderMidi(EventMap* events, bool metronome, bool expandRepeats, const SynthesizerState& synthState,
+                    bool renderStavesInParallel = false);
 
     BeatType tick2beatType(const Fraction& tick);
 
@@ -1036,6 +1041,8 @@ public:
     virtual const RepeatList& repeatList2() const;
     qreal utick2utime(int tick) const;
     int utime2utick(qreal utime) const;
+    const PositionTable& positionTable() const;
+    void invalidatePositionTable();
 
     void nextInputPos(ChordRest* cr, bool);
     void cmdMirrorNoteHead();
@@ -1092,6 +1099,7 @@ public:
 
     void doLayout();
     void doLayoutRange(const Fraction& st, const Fraction& et);
+    void doLayoutPages(int pagesCount);
 
     SynthesizerState& synthesizerState() { return _synthesizerState; }
     void setSynthesizerState(const SynthesizerState& s);
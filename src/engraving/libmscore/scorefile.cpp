@@ -390,9 +390,13 @@ void Score::readStaff(XmlReader& e)
 
 std::shared_ptr<mu::draw::Pixmap> Score::createThumbnail()
 {
+    //! NOTE In the page mode the current layout is used as it is. Otherwise only the first page is laid out
+    //! for the thumbnail, the complete layout in the current mode is restored afterwards
     LayoutMode mode = layoutMode();
-    setLayoutMode(LayoutMode::PAGE);
-    doLayout();
+    if (mode != LayoutMode::PAGE) {
+        setLayoutMode(LayoutMode::PAGE);
+        doLayoutPages(1);
+    }
 
     Page* page = pages().at(0);
     RectF fr  = page->abbox();
@@ -513,7 +517,7 @@ bool Score::writeScore(QIODevice* f, bool msczFormat, bool onlySelection, compat
 
 void Score::print(mu::draw::Painter* painter, int pageNo)
 {
-    _printing  = true;
+    setPrinting(true);
     MScore::pdfPrinting = true;
     Page* page = pages().at(pageNo);
     RectF fr  = page->abbox();
@@ -530,7 +534,7 @@ void Score::print(mu::draw::Painter* painter, int pageNo)
         painter->restore();
     }
     MScore::pdfPrinting = false;
-    _printing = false;
+    setPrinting(false);
 }
 
 //---------------------------------------------------------
@@ -674,11 +674,12 @@ void ScoreFont::draw(SymId id, Painter* painter, const SizeF& mag, const PointF&
         return;
     }
 
-    qreal size = 20.0 * MScore::pixelRatio;
-    m_font.setPointSizeF(size);
+    //! NOTE The font is copied, the symbols may be drawn by several threads at once
+    mu::draw::Font font(m_font);
+    font.setPointSizeF(20.0 * MScore::pixelRatio);
     SizeF imag = SizeF(1.0 / mag.width(), 1.0 / mag.height());
     painter->scale(mag.width(), mag.height());
-    painter->setFont(m_font);
+    painter->setFont(font);
     painter->drawSymbol(PointF(pos.x() * imag.width(), pos.y() * imag.height()), symCode(id));
     painter->scale(imag.width(), imag.height());
 }
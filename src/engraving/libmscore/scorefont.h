@@ -107,7 +107,7 @@ private:
 
     bool m_loaded = false;
     std::vector<Sym> m_symbols;
-    mutable mu::draw::Font m_font;
+    mu::draw::Font m_font;
 
     QString m_name;
     QString m_family;
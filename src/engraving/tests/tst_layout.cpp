@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "testing/qtestsuite.h"
+
+#include "testbase.h"
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measurebase.h"
+#include "libmscore/page.h"
+#include "libmscore/system.h"
+
+static const QString ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestLayout
+//---------------------------------------------------------
+
+class TestLayout : public QObject, public MTest
+{
+    Q_OBJECT
+
+    QString layoutDump(const Score* score) const;
+
+private slots:
+    void initTestCase();
+    void layoutPages();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestLayout::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   layoutDump
+//    the pages, the systems and the positions of the
+//    measures, one line per measure
+//---------------------------------------------------------
+
+QString TestLayout::layoutDump(const Score* score) const
+{
+    QString dump;
+    for (int pageIdx = 0; pageIdx < score->npages(); ++pageIdx) {
+        const Page* page = score->pages().at(pageIdx);
+        for (int systemIdx = 0; systemIdx < page->systems().size(); ++systemIdx) {
+            const System* system = page->systems().at(systemIdx);
+            for (const MeasureBase* mb : system->measures()) {
+                dump += QString("%1 %2 %3: %4 %5 %6 %7\n")
+                        .arg(pageIdx).arg(systemIdx).arg(mb->tick().ticks())
+                        .arg(system->pos().y()).arg(mb->pos().x()).arg(mb->width()).arg(mb->height());
+            }
+        }
+    }
+
+    return dump;
+}
+
+//---------------------------------------------------------
+//   layoutPages
+//    doLayoutPages() lays out only the requested pages,
+//    and the following full layout is the same as
+//    the layout of the freshly read score
+//---------------------------------------------------------
+
+void TestLayout::layoutPages()
+{
+    MasterScore* score = readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    QVERIFY(score);
+
+    const int pagesCount = score->npages();
+    QVERIFY(pagesCount > 1);
+    const QString fullLayout = layoutDump(score);
+
+    score->doLayoutPages(1);
+    QCOMPARE(score->npages(), 1);
+
+    score->doLayout();
+    QCOMPARE(score->npages(), pagesCount);
+    QCOMPARE(layoutDump(score), fullLayout);
+
+    delete score;
+}
+
+QTEST_MAIN(TestLayout)
+#include "tst_layout.moc"
@@ -70,6 +70,8 @@ private slots:
     void midi03();
     void events_data();
     void events();
+    void eventsStavesInParallel_data();
+    void eventsStavesInParallel();
     void midiBendsExport1() { midiExportTestRef("testBends1"); }
     void midiBendsExport2() { midiExportTestRef("testBends2"); }        // Play property test
     void midiPortExport() { midiExportTestRef("testMidiPort"); }
@@ -594,6 +596,50 @@ void TestMidi::events()
     delete score;
 }
 
+//---------------------------------------------------------
+//   eventsStavesInParallel
+//   rendering staves on worker threads must produce the same
+//   events in the same order as the sequential rendering
+//---------------------------------------------------------
+
+void TestMidi::eventsStavesInParallel_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::newRow("testKantataBWV140Excerpts") << "testKantataBWV140Excerpts";
+    QTest::newRow("testAndanteExcerpts") << "testAndanteExcerpts";
+    QTest::newRow("testGlissandoAcrossStaffs") << "testGlissandoAcrossStaffs";
+    QTest::newRow("testPedal") << "testPedal";
+}
+
+void TestMidi::eventsStavesInParallel()
+{
+    QFETCH(QString, file);
+
+    MasterScore* score = readScore(MIDI_DATA_DIR + file + ".mscx");
+    QVERIFY(score);
+
+    SynthesizerState ss;
+    EventMap sequentialEvents;
+    score->renderMidi(&sequentialEvents, true, true, ss, false);
+    EventMap parallelEvents;
+    score->renderMidi(&parallelEvents, true, true, ss, true);
+
+    QCOMPARE(parallelEvents.size(), sequentialEvents.size());
+    QCOMPARE(parallelEvents.highestChannel(), sequentialEvents.highestChannel());
+
+    auto parallelIt = parallelEvents.cbegin();
+    for (auto it = sequentialEvents.cbegin(); it != sequentialEvents.cend(); ++it, ++parallelIt) {
+        QCOMPARE(parallelIt->first, it->first);
+        QCOMPARE(parallelIt->second.type(), it->second.type());
+        QCOMPARE(parallelIt->second.channel(), it->second.channel());
+        QCOMPARE(parallelIt->second.dataA(), it->second.dataA());
+        QCOMPARE(parallelIt->second.dataB(), it->second.dataB());
+        QCOMPARE(parallelIt->second.discard(), it->second.discard());
+    }
+
+    delete score;
+}
+
 //---------------------------------------------------------
 //   testMidiExport
 //---------------------------------------------------------
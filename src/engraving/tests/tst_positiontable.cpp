@@ -0,0 +1,183 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "testing/qtestsuite.h"
+
+#include <algorithm>
+
+#include "testbase.h"
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/positiontable.h"
+#include "libmscore/repeatlist.h"
+#include "libmscore/segment.h"
+
+static const QString POSITIONTABLE_DATA_DIR("positiontable_data/");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestPositionTable
+//    positiontable01: 1;2;3; 2;3;4;5;6 with the repeats expanded,
+//    measure 2 has four quarters, the others a whole note,
+//    the tempo changes in measure 4
+//---------------------------------------------------------
+
+class TestPositionTable : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void events();
+    void cursorSegment();
+    void cursorSegmentInvisible();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestPositionTable::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   events
+//    the unrolled events must match the repeat list
+//---------------------------------------------------------
+
+void TestPositionTable::events()
+{
+    MasterScore* score = readScore(POSITIONTABLE_DATA_DIR + "positiontable01.mscx");
+    QVERIFY(score);
+    score->setExpandRepeats(true);
+
+    const PositionTable& table = score->positionTable();
+    const RepeatList& repeatList = score->repeatList();
+
+    QCOMPARE(table.measureEvents().size(), size_t(8));
+    QCOMPARE(table.segmentEvents().size(), size_t(14));
+
+    auto byUtick = [](const PositionTable::Event& e1, const PositionTable::Event& e2) {
+        return e1.utick < e2.utick;
+    };
+    QVERIFY(std::is_sorted(table.measureEvents().cbegin(), table.measureEvents().cend(), byUtick));
+    QVERIFY(std::is_sorted(table.segmentEvents().cbegin(), table.segmentEvents().cend(), byUtick));
+
+    for (const PositionTable::Event& e : table.measureEvents()) {
+        QVERIFY(e.index < table.measures().size());
+        QCOMPARE(repeatList.utick2tick(e.utick), table.measures()[e.index].tick);
+        QVERIFY(qAbs(e.utime - repeatList.utick2utime(e.utick)) < 1e-6);
+    }
+
+    for (const PositionTable::Event& e : table.segmentEvents()) {
+        QVERIFY(e.index < table.segments().size());
+        QCOMPARE(repeatList.utick2tick(e.utick), table.segments()[e.index].tick);
+        QVERIFY(qAbs(e.utime - repeatList.utick2utime(e.utick)) < 1e-6);
+    }
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   cursorSegment
+//---------------------------------------------------------
+
+void TestPositionTable::cursorSegment()
+{
+    MasterScore* score = readScore(POSITIONTABLE_DATA_DIR + "positiontable01.mscx");
+    QVERIFY(score);
+
+    const PositionTable& table = score->positionTable();
+
+    // inside a segment of measure 2
+    const PositionTable::SegmentPosition* position = table.cursorSegment(2400 + 100);
+    QVERIFY(position);
+    QCOMPARE(position->tick, 2400);
+    QCOMPARE(position->endTick, 2880);
+
+    // the last segment of the measure moves to the end barline
+    position = table.cursorSegment(3839);
+    QVERIFY(position);
+    QCOMPARE(position->tick, 3360);
+    QCOMPARE(position->endTick, 3840);
+
+    const Segment* barLine = position->measure->findSegment(SegmentType::EndBarLine, Fraction::fromTicks(3840));
+    QVERIFY(barLine);
+    QCOMPARE(position->endX, barLine->pagePos().x());
+
+    // the measure end is the start of the next measure
+    position = table.cursorSegment(3840);
+    QVERIFY(position);
+    QCOMPARE(position->tick, 3840);
+    QCOMPARE(position->measure->tick().ticks(), 3840);
+
+    // out of the score
+    QVERIFY(!table.cursorSegment(-1));
+    QVERIFY(!table.cursorSegment(score->endTick().ticks()));
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   cursorSegmentInvisible
+//    the cursor moves over the invisible segments,
+//    the first segment of a measure is a stop anyway
+//---------------------------------------------------------
+
+void TestPositionTable::cursorSegmentInvisible()
+{
+    MasterScore* score = readScore(POSITIONTABLE_DATA_DIR + "positiontable01.mscx");
+    QVERIFY(score);
+
+    Measure* measure = score->tick2measure(Fraction::fromTicks(1920));
+    QVERIFY(measure);
+
+    Segment* first = measure->findSegment(SegmentType::ChordRest, Fraction::fromTicks(1920));
+    Segment* second = measure->findSegment(SegmentType::ChordRest, Fraction::fromTicks(2400));
+    Segment* third = measure->findSegment(SegmentType::ChordRest, Fraction::fromTicks(2880));
+    QVERIFY(first && second && third);
+
+    first->setVisible(false);
+    second->setVisible(false);
+    score->doLayout();
+
+    const PositionTable& table = score->positionTable();
+
+    const PositionTable::SegmentPosition* position = table.cursorSegment(2400);
+    QVERIFY(position);
+    QVERIFY(position->segment == first);
+    QCOMPARE(position->endTick, 2880);
+    QCOMPARE(position->endX, third->pagePos().x());
+
+    position = table.cursorSegment(2880);
+    QVERIFY(position);
+    QVERIFY(position->segment == third);
+
+    delete score;
+}
+
+QTEST_MAIN(TestPositionTable)
+#include "tst_positiontable.moc"
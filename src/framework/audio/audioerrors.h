@@ -59,6 +59,13 @@ enum class Err {
 
     // clock
     InvalidTimeLoop = 350,
+
+    // offline render
+    NothingToRender = 360,
+
+    // track freeze
+    FreezeCacheWriteFailed = 370,
+    TrackIsNotFreezable = 371,
 };
 
 inline Ret make_ret(Err e)
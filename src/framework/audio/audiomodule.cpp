@@ -21,6 +21,9 @@
  */
 #include "audiomodule.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 #include <QQmlEngine>
 
 #include "ui/iuiengine.h"
@@ -32,6 +35,7 @@
 #include "internal/audiothread.h"
 #include "internal/audiobuffer.h"
 #include "internal/audiothreadsecurer.h"
+#include "internal/offlinerenderer.h"
 
 #include "internal/worker/audioengine.h"
 #include "internal/worker/playback.h"
@@ -41,9 +45,11 @@
 #include "internal/synthesizers/synthresolver.h"
 
 #include "internal/fx/fxresolver.h"
+#include "internal/fx/musefxresolver.h"
 
 #include "view/synthssettingsmodel.h"
 #include "devtools/waveformmodel.h"
+#include "devtools/audiotelemetrymodel.h"
 
 #include "diagnostics/idiagnosticspathsregister.h"
 
@@ -85,6 +91,32 @@ static std::shared_ptr<IAudioDriver> s_audioDriver = std::shared_ptr<IAudioDrive
 static std::shared_ptr<IAudioDriver> s_audioDriver = std::shared_ptr<IAudioDriver>(new WebAudioDriver());
 #endif
 
+#ifndef Q_OS_WASM
+#include "internal/platform/null/nullaudiodriver.h"
+
+//! NOTE MU_AUDIO_DRIVER=null (or null-freerunning) replaces the platform driver,
+//! so the engine works on the machines without a sound card (e.g. CI)
+static std::shared_ptr<IAudioDriver> driverFromEnvironment()
+{
+    const char* driverName = std::getenv("MU_AUDIO_DRIVER");
+    if (!driverName) {
+        return nullptr;
+    }
+
+    std::string name(driverName);
+    if (name == "null") {
+        return std::make_shared<NullAudioDriver>(NullAudioDriver::Pacing::Realtime);
+    }
+
+    if (name == "null-freerunning") {
+        return std::make_shared<NullAudioDriver>(NullAudioDriver::Pacing::FreeRunning);
+    }
+
+    LOGW() << "unknown audio driver: " << name << ", the platform driver is used";
+    return nullptr;
+}
+#endif
+
 static void audio_init_qrc()
 {
     Q_INIT_RESOURCE(audio);
@@ -102,10 +134,17 @@ std::string AudioModule::moduleName() const
 
 void AudioModule::registerExports()
 {
+#ifndef Q_OS_WASM
+    if (std::shared_ptr<IAudioDriver> driver = driverFromEnvironment()) {
+        s_audioDriver = driver;
+    }
+#endif
+
     ioc()->registerExport<IAudioConfiguration>(moduleName(), s_audioConfiguration);
     ioc()->registerExport<IAudioThreadSecurer>(moduleName(), std::make_shared<AudioThreadSecurer>());
     ioc()->registerExport<IAudioDriver>(moduleName(), s_audioDriver);
     ioc()->registerExport<IPlayback>(moduleName(), s_playbackFacade);
+    ioc()->registerExport<IOfflineRenderer>(moduleName(), std::make_shared<OfflineRenderer>());
 
     ioc()->registerExport<ISynthResolver>(moduleName(), s_synthResolver);
     ioc()->registerExport<IFxResolver>(moduleName(), s_fxResolver);
@@ -119,6 +158,7 @@ void AudioModule::registerResources()
 void AudioModule::registerUiTypes()
 {
     qmlRegisterType<WaveFormModel>("MuseScore.Audio", 1, 0, "WaveFormModel");
+    qmlRegisterType<AudioTelemetryModel>("MuseScore.Audio", 1, 0, "AudioTelemetryModel");
     qmlRegisterType<synth::SynthsSettingsModel>("MuseScore.Audio", 1, 0, "SynthsSettingsModel");
 
     ioc()->resolve<ui::IUiEngine>(moduleName())->addSourceImportPath(audio_QML_IMPORT);
@@ -171,6 +211,7 @@ void AudioModule::onInit(const framework::IApplication::RunMode& mode)
     requiredSpec.format = IAudioDriver::Format::AudioF32;
     requiredSpec.channels = s_audioConfiguration->audioChannelsCount();
     requiredSpec.samples = s_audioConfiguration->driverBufferSize();
+    requiredSpec.periodsCount = static_cast<uint8_t>(std::min(s_audioConfiguration->driverPeriodsCount(), 255u));
     requiredSpec.callback = [](void* /*userdata*/, uint8_t* stream, int byteCount) {
         auto samplesPerChannel = byteCount / (2 * sizeof(float));
         s_audioBuffer->pop(reinterpret_cast<float*>(stream), samplesPerChannel);
@@ -193,12 +234,19 @@ void AudioModule::onInit(const framework::IApplication::RunMode& mode)
         AudioEngine::instance()->setAudioChannelsCount(s_audioConfiguration->audioChannelsCount());
         AudioEngine::instance()->setSampleRate(activeSpec.sampleRate);
         AudioEngine::instance()->setReadBufferSize(activeSpec.samples);
+        AudioEngine::instance()->setRenderWorkersCount(s_audioConfiguration->renderWorkersCount());
+        AudioEngine::instance()->setParallelRenderThreshold(s_audioConfiguration->parallelRenderMinChannelsCount());
+        AudioEngine::instance()->setVoicesBudget(s_audioConfiguration->voicesBudget());
+        AudioEngine::instance()->setMaxSourceSampleRate(s_audioConfiguration->maxSourceSampleRate());
 
         auto fluidResolver = std::make_shared<FluidResolver>(s_audioConfiguration->soundFontDirectories(),
                                                              s_audioConfiguration->soundFontDirectoriesChanged());
         s_synthResolver->registerResolver(AudioSourceType::Fluid, fluidResolver);
         s_synthResolver->init(s_audioConfiguration->defaultAudioInputParams());
 
+        auto museFxResolver = std::make_shared<MuseFxResolver>(s_audioConfiguration->audioChannelsCount());
+        s_fxResolver->registerResolver(AudioFxType::MuseFx, museFxResolver);
+
         // Initialize IPlayback facade and make sure that it's initialized after the audio-engine
         s_playbackFacade->init();
     };
@@ -223,6 +271,7 @@ void AudioModule::onInit(const framework::IApplication::RunMode& mode)
 void AudioModule::onDeinit()
 {
     if (s_audioDriver->isOpened()) {
+        LOGI() << "audio driver xruns: " << s_audioDriver->stats().xrunsCount;
         s_audioDriver->close();
     }
 
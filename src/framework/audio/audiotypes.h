@@ -23,10 +23,15 @@
 #ifndef MU_AUDIO_AUDIOTYPES_H
 #define MU_AUDIO_AUDIOTYPES_H
 
+#include <algorithm>
 #include <variant>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <array>
+#include <atomic>
+#include <cmath>
 
 #include "midi/miditypes.h"
 #include "io/path.h"
@@ -42,6 +47,8 @@ using volume_dbfs_t = float;
 using gain_t = float;
 using balance_t = float;
 
+static constexpr audioch_t MAX_SUPPORTED_AUDIO_CHANNELS = 8;
+
 using TrackSequenceId = int32_t;
 using TrackSequenceIdList = std::vector<TrackSequenceId>;
 
@@ -57,7 +64,8 @@ using AudioResourceVendor = std::string;
 enum class AudioResourceType {
     Undefined = -1,
     FluidSoundfont,
-    VstPlugin
+    VstPlugin,
+    MusePlugin
 };
 
 struct AudioResourceMeta {
@@ -90,7 +98,8 @@ using FxProcessorIdList =  std::vector<FxProcessorId>;
 
 enum class AudioFxType {
     Undefined = -1,
-    VstFx
+    VstFx,
+    MuseFx
 };
 
 enum class AudioFxCategory {
@@ -113,24 +122,30 @@ enum class AudioFxCategory {
 
 using AudioFxCategories = std::set<AudioFxCategory>;
 
+//! NOTE The settings of an fx, the keys are defined by the fx
+using AudioFxValues = std::map<std::string, float>;
+
 struct AudioFxParams {
     AudioFxType type() const
     {
         switch (resourceMeta.type) {
         case AudioResourceType::VstPlugin: return AudioFxType::VstFx;
+        case AudioResourceType::MusePlugin: return AudioFxType::MuseFx;
         default: return AudioFxType::Undefined;
         }
     }
 
     AudioFxCategories categories;
     AudioResourceMeta resourceMeta;
+    AudioFxValues values;
     bool active = false;
 
     bool operator ==(const AudioFxParams& other) const
     {
         return resourceMeta == other.resourceMeta
                && active == other.active
-               && categories == other.categories;
+               && categories == other.categories
+               && values == other.values;
     }
 
     bool isValid() const
@@ -194,9 +209,90 @@ struct AudioParams {
     AudioOutputParams out;
 };
 
-struct AudioSignalChanges {
-    async::Channel<audioch_t, float> amplitudeChanges;
-    async::Channel<audioch_t, volume_dbfs_t> pressureChanges;
+//! NOTE Latest signal values of an audio output, updated by the audio worker a few dozen times per second.
+//! It's meant to be polled by the consumers, reading it doesn't lock
+class AudioSignalsSnapshot
+{
+public:
+    AudioSignalsSnapshot()
+    {
+        for (std::atomic<float>& amplitude : m_amplitudes) {
+            amplitude.store(0.f, std::memory_order_relaxed);
+        }
+    }
+
+    // root mean square of the latest processed samples
+    float amplitude(const audioch_t audioChNum) const
+    {
+        if (audioChNum >= MAX_SUPPORTED_AUDIO_CHANNELS) {
+            return 0.f;
+        }
+
+        return m_amplitudes[audioChNum].load(std::memory_order_relaxed);
+    }
+
+    // the same value in the "decibels relative to full scale" units
+    volume_dbfs_t pressure(const audioch_t audioChNum) const
+    {
+        return 20 * std::log10(std::abs(amplitude(audioChNum)));
+    }
+
+    void setAmplitude(const audioch_t audioChNum, const float amplitude)
+    {
+        if (audioChNum >= MAX_SUPPORTED_AUDIO_CHANNELS) {
+            return;
+        }
+
+        m_amplitudes[audioChNum].store(amplitude, std::memory_order_relaxed);
+    }
+
+    // number of the channels the amplitudes are published for, 0 until the first publication
+    audioch_t audioChannelsCount() const
+    {
+        return m_audioChannelsCount.load(std::memory_order_relaxed);
+    }
+
+    void setAudioChannelsCount(const audioch_t audioChannelsCount)
+    {
+        m_audioChannelsCount.store(std::min(audioChannelsCount, MAX_SUPPORTED_AUDIO_CHANNELS), std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<float>, MAX_SUPPORTED_AUDIO_CHANNELS> m_amplitudes;
+    std::atomic<audioch_t> m_audioChannelsCount = 0;
+};
+
+using AudioSignalsSnapshotPtr = std::shared_ptr<const AudioSignalsSnapshot>;
+
+//! NOTE Share of the real time spent on the processing of the audio blocks,
+//! 1 means a block is processed as long as it plays, i.e. the deadline is reached
+struct AudioProcessingLoad {
+    float average = 0.f;
+    float peak = 0.f; // the heaviest block
+};
+
+struct AudioFxTelemetry {
+    AudioResourceId resourceId;
+    AudioProcessingLoad load;
+};
+
+struct AudioChannelTelemetry {
+    TrackId trackId = -1;
+    AudioProcessingLoad sourceLoad;
+    std::vector<AudioFxTelemetry> fx;
+    unsigned int activeVoicesCount = 0; // the most voices played at once
+    unsigned int stolenVoicesCount = 0; // the voices stolen to stay within the voices budget
+};
+
+//! NOTE Performance of the audio worker over the latest interval, published a few times per second
+struct AudioTelemetry {
+    AudioProcessingLoad load;               // the whole mix, the deadline is the playback duration of the block
+    samples_t bufferFilledSamples = 0;      // the lowest fill of the output buffer
+    samples_t bufferTargetSamples = 0;      // the fill the worker keeps the output buffer at
+    uint64_t bufferUnderrunsCount = 0;      // the reads of the output buffer with not enough samples since the start
+    unsigned int voicesBudget = 0;          // the voices all the synthesizers may play at once now, 0 means no budget
+    uint64_t stolenVoicesCount = 0;         // the voices stolen to stay within the budget since the start
+    std::vector<AudioChannelTelemetry> channels;
 };
 
 using PlaybackData = std::variant<midi::MidiData, io::Device*>;
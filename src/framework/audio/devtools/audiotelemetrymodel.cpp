@@ -0,0 +1,157 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audiotelemetrymodel.h"
+
+#include <algorithm>
+
+#include "itracks.h"
+
+using namespace mu::audio;
+
+static QVariantMap loadToMap(const AudioProcessingLoad& load)
+{
+    QVariantMap result;
+    result["average"] = load.average;
+    result["peak"] = load.peak;
+
+    return result;
+}
+
+AudioTelemetryModel::AudioTelemetryModel(QObject* parent)
+    : QObject(parent)
+{
+    playback()->sequenceIdList().onResolve(this, [this](const TrackSequenceIdList& sequenceIds) {
+        m_sequenceIds.insert(sequenceIds.begin(), sequenceIds.end());
+    });
+
+    playback()->sequenceAdded().onReceive(this, [this](const TrackSequenceId sequenceId) {
+        m_sequenceIds.insert(sequenceId);
+    });
+
+    playback()->telemetryUpdated().onReceive(this, [this](const AudioTelemetry& telemetry) {
+        setTelemetry(telemetry);
+    });
+}
+
+float AudioTelemetryModel::load() const
+{
+    return m_telemetry.load.average;
+}
+
+float AudioTelemetryModel::peakLoad() const
+{
+    return m_telemetry.load.peak;
+}
+
+float AudioTelemetryModel::bufferFillLevel() const
+{
+    if (m_telemetry.bufferTargetSamples == 0) {
+        return 0.f;
+    }
+
+    return std::min(static_cast<float>(m_telemetry.bufferFilledSamples) / m_telemetry.bufferTargetSamples, 1.f);
+}
+
+int AudioTelemetryModel::bufferUnderrunsCount() const
+{
+    return static_cast<int>(m_telemetry.bufferUnderrunsCount);
+}
+
+int AudioTelemetryModel::driverXrunsCount() const
+{
+    return static_cast<int>(m_driverXrunsCount);
+}
+
+int AudioTelemetryModel::voicesBudget() const
+{
+    return static_cast<int>(m_telemetry.voicesBudget);
+}
+
+int AudioTelemetryModel::stolenVoicesCount() const
+{
+    return static_cast<int>(m_telemetry.stolenVoicesCount);
+}
+
+QVariantList AudioTelemetryModel::channels() const
+{
+    std::vector<const AudioChannelTelemetry*> sorted;
+    for (const AudioChannelTelemetry& channel : m_telemetry.channels) {
+        sorted.push_back(&channel);
+    }
+
+    std::sort(sorted.begin(), sorted.end(), [](const AudioChannelTelemetry* c1, const AudioChannelTelemetry* c2) {
+        return c1->sourceLoad.peak > c2->sourceLoad.peak;
+    });
+
+    QVariantList result;
+
+    for (const AudioChannelTelemetry* channel : sorted) {
+        QVariantList fxList;
+        for (const AudioFxTelemetry& fx : channel->fx) {
+            QVariantMap fxMap = loadToMap(fx.load);
+            fxMap["name"] = QString::fromStdString(fx.resourceId);
+            fxList << fxMap;
+        }
+
+        auto it = m_trackNames.find(channel->trackId);
+
+        QVariantMap channelMap = loadToMap(channel->sourceLoad);
+        channelMap["name"] = it != m_trackNames.end() ? it->second : QString::number(channel->trackId);
+        channelMap["voices"] = channel->activeVoicesCount;
+        channelMap["stolenVoices"] = channel->stolenVoicesCount;
+        channelMap["fx"] = fxList;
+
+        result << channelMap;
+    }
+
+    return result;
+}
+
+void AudioTelemetryModel::setTelemetry(const AudioTelemetry& telemetry)
+{
+    m_telemetry = telemetry;
+
+    if (audioDriver()->isOpened()) {
+        m_driverXrunsCount = audioDriver()->stats().xrunsCount;
+    }
+
+    for (const AudioChannelTelemetry& channel : m_telemetry.channels) {
+        if (m_trackNames.find(channel.trackId) != m_trackNames.end()) {
+            continue;
+        }
+
+        //! NOTE The name is requested once, until it's resolved the channel is shown by the track id
+        m_trackNames[channel.trackId] = QString::number(channel.trackId);
+
+        for (const TrackSequenceId sequenceId : m_sequenceIds) {
+            TrackId trackId = channel.trackId;
+
+            playback()->tracks()->trackName(sequenceId, trackId).onResolve(this, [this, trackId](const TrackName& name) {
+                if (!name.empty()) {
+                    m_trackNames[trackId] = QString::fromStdString(name);
+                }
+            });
+        }
+    }
+
+    emit telemetryChanged();
+}
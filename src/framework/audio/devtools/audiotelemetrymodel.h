@@ -0,0 +1,83 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_AUDIOTELEMETRYMODEL_H
+#define MU_AUDIO_AUDIOTELEMETRYMODEL_H
+
+#include <map>
+#include <set>
+
+#include <QObject>
+#include <QVariantList>
+
+#include "modularity/ioc.h"
+#include "async/asyncable.h"
+
+#include "iaudiodriver.h"
+#include "iplayback.h"
+
+namespace mu::audio {
+class AudioTelemetryModel : public QObject, public async::Asyncable
+{
+    Q_OBJECT
+
+    INJECT(audio, IPlayback, playback)
+    INJECT(audio, IAudioDriver, audioDriver)
+
+    Q_PROPERTY(float load READ load NOTIFY telemetryChanged)
+    Q_PROPERTY(float peakLoad READ peakLoad NOTIFY telemetryChanged)
+    Q_PROPERTY(float bufferFillLevel READ bufferFillLevel NOTIFY telemetryChanged)
+    Q_PROPERTY(int bufferUnderrunsCount READ bufferUnderrunsCount NOTIFY telemetryChanged)
+    Q_PROPERTY(int driverXrunsCount READ driverXrunsCount NOTIFY telemetryChanged)
+    Q_PROPERTY(int voicesBudget READ voicesBudget NOTIFY telemetryChanged)
+    Q_PROPERTY(int stolenVoicesCount READ stolenVoicesCount NOTIFY telemetryChanged)
+
+    //! NOTE The heaviest channels first
+    Q_PROPERTY(QVariantList channels READ channels NOTIFY telemetryChanged)
+
+public:
+    explicit AudioTelemetryModel(QObject* parent = nullptr);
+
+    float load() const;
+    float peakLoad() const;
+    float bufferFillLevel() const;
+    int bufferUnderrunsCount() const;
+    int driverXrunsCount() const;
+    int voicesBudget() const;
+    int stolenVoicesCount() const;
+
+    QVariantList channels() const;
+
+signals:
+    void telemetryChanged();
+
+private:
+    void setTelemetry(const AudioTelemetry& telemetry);
+
+    AudioTelemetry m_telemetry;
+    uint64_t m_driverXrunsCount = 0;
+
+    std::set<TrackSequenceId> m_sequenceIds;
+    std::map<TrackId, QString> m_trackNames;
+};
+}
+
+#endif // MU_AUDIO_AUDIOTELEMETRYMODEL_H
@@ -27,24 +27,34 @@ using namespace mu::audio;
 static const volume_dbfs_t MAX_DISPLAYED_DBFS = 0.f; // 100%
 static const volume_dbfs_t MIN_DISPLAYED_DBFS = -60.f; // 0%
 
+static const int UPDATE_INTERVAL_MS = 33;
+
 WaveFormModel::WaveFormModel(QObject* parent)
     : QObject(parent)
 {
-    playback()->audioOutput()->masterSignalChanges().onResolve(this, [this](AudioSignalChanges signalChanges) {
-        signalChanges.amplitudeChanges.onReceive(this, [this](const audioch_t, const float amplitude) {
-            setCurrentSignalAmplitude(amplitude);
-        });
-
-        signalChanges.pressureChanges.onReceive(this, [this](const audioch_t, const volume_dbfs_t pressure) {
-            if (pressure < MIN_DISPLAYED_DBFS) {
-                setCurrentVolumePressure(MIN_DISPLAYED_DBFS);
-            } else if (pressure > MAX_DISPLAYED_DBFS) {
-                setCurrentVolumePressure(MAX_DISPLAYED_DBFS);
-            } else {
-                setCurrentVolumePressure(pressure);
-            }
-        });
+    playback()->audioOutput()->masterSignalsSnapshot().onResolve(this, [this](AudioSignalsSnapshotPtr snapshot) {
+        m_signalsSnapshot = std::move(snapshot);
+    });
+
+    connect(&m_updateTimer, &QTimer::timeout, this, [this]() {
+        if (!m_signalsSnapshot) {
+            return;
+        }
+
+        setCurrentSignalAmplitude(m_signalsSnapshot->amplitude(0));
+
+        volume_dbfs_t pressure = m_signalsSnapshot->pressure(0);
+        if (pressure < MIN_DISPLAYED_DBFS) {
+            setCurrentVolumePressure(MIN_DISPLAYED_DBFS);
+        } else if (pressure > MAX_DISPLAYED_DBFS) {
+            setCurrentVolumePressure(MAX_DISPLAYED_DBFS);
+        } else {
+            setCurrentVolumePressure(pressure);
+        }
     });
+
+    m_updateTimer.setSingleShot(false);
+    m_updateTimer.start(UPDATE_INTERVAL_MS);
 }
 
 QStringList WaveFormModel::availableSources() const
@@ -24,6 +24,7 @@
 #define MU_AUDIO_WAVEFORMMODEL_H
 
 #include <QObject>
+#include <QTimer>
 
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
@@ -82,6 +83,9 @@ private:
 
     float m_currentSignalAmplitude = 0.f;
     float m_currentVolumePressure = 0.f;
+
+    AudioSignalsSnapshotPtr m_signalsSnapshot = nullptr;
+    QTimer m_updateTimer;
 };
 }
 
@@ -45,6 +45,14 @@ public:
 
     virtual audioch_t audioChannelsCount() const = 0;
     virtual unsigned int driverBufferSize() const = 0; // samples
+    virtual unsigned int driverPeriodsCount() const = 0;
+
+    virtual size_t renderWorkersCount() const = 0;
+    virtual size_t parallelRenderMinChannelsCount() const = 0;
+    virtual unsigned int voicesBudget() const = 0; // the voices all the synthesizers may play at once, 0 means no budget
+    virtual unsigned int maxSourceSampleRate() const = 0; // the sources render at most at this rate and are resampled, 0 means no limit
+
+    virtual io::path freezeCacheDirectory() const = 0;
 
     virtual bool isShowControlsInMixer() const = 0;
     virtual void setIsShowControlsInMixer(bool show) = 0;
@@ -54,6 +54,13 @@ public:
         uint16_t samples;             // Audio buffer size in sample FRAMES (total samples divided by channel count)
         Callback callback;            // Callback that feeds the audio device
         void* userdata;               // Userdata passed to callback (ignored for NULL callbacks).
+        uint8_t periodsCount = 0;     // Number of periods the device buffer is split into, 0 - the driver's default
+    };
+
+    struct Stats
+    {
+        uint64_t xrunsCount = 0;      // Number of the device buffer underruns since the driver was opened
+        uint32_t latencyFrames = 0;   // Frames queued in the device, i.e. the output latency in sample FRAMES
     };
 
     virtual std::string name() const = 0;
@@ -68,6 +75,8 @@ public:
 
     virtual void resume() = 0;
     virtual void suspend() = 0;
+
+    virtual Stats stats() const = 0;
 };
 using IAudioDriverPtr = std::shared_ptr<IAudioDriver>;
 }
@@ -46,8 +46,12 @@ public:
 
     virtual async::Promise<AudioResourceMetaList> availableOutputResources() const = 0;
 
-    virtual async::Promise<AudioSignalChanges> signalChanges(const TrackSequenceId sequenceId, const TrackId trackId) const = 0;
-    virtual async::Promise<AudioSignalChanges> masterSignalChanges() const = 0;
+    virtual async::Promise<AudioSignalsSnapshotPtr> signalsSnapshot(const TrackSequenceId sequenceId, const TrackId trackId) const = 0;
+    virtual async::Promise<AudioSignalsSnapshotPtr> masterSignalsSnapshot() const = 0;
+
+    //! NOTE A frozen track is played from its pre-rendered audio, see FrozenTrackSource
+    virtual void setTrackFrozen(const TrackSequenceId sequenceId, const TrackId trackId, const bool frozen) = 0;
+    virtual async::Promise<bool> isTrackFrozen(const TrackSequenceId sequenceId, const TrackId trackId) const = 0;
 };
 
 using IAudioOutputPtr = std::shared_ptr<IAudioOutput>;
@@ -46,6 +46,11 @@ void AudioBuffer::setSource(std::shared_ptr<IAudioSource> source)
 void AudioBuffer::forward()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_audioChannelsCount > 0) {
+        m_filledSamples.store(sampleLag(), std::memory_order_relaxed);
+    }
+
     fillup();
 }
 
@@ -53,6 +58,10 @@ void AudioBuffer::pop(float* dest, size_t sampleCount)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
+    if (m_audioChannelsCount > 0 && sampleLag() < sampleCount) {
+        m_underrunsCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
     size_t from = m_readIndex;
     auto memStep = sizeof(float);
     size_t to = m_readIndex + sampleCount * m_audioChannelsCount;
@@ -82,6 +91,17 @@ void AudioBuffer::setMinSampleLag(size_t lag)
         lag = m_data.size();
     }
     m_minSampleLag = lag;
+    m_targetSamples.store(m_minSampleLag + FILL_OVER, std::memory_order_relaxed);
+}
+
+IAudioBuffer::Stats AudioBuffer::stats() const
+{
+    Stats stats;
+    stats.filledSamples = m_filledSamples.load(std::memory_order_relaxed);
+    stats.targetSamples = m_targetSamples.load(std::memory_order_relaxed);
+    stats.underrunsCount = m_underrunsCount.load(std::memory_order_relaxed);
+
+    return stats;
 }
 
 void AudioBuffer::fillup()
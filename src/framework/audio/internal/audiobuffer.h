@@ -48,6 +48,8 @@ public:
     void pop(float* dest, size_t sampleCount) override;
     void setMinSampleLag(size_t lag) override;
 
+    Stats stats() const override;
+
 private:
 
     unsigned int sampleLag() const;
@@ -63,6 +65,10 @@ private:
 
     std::vector<float> m_data = {};
     std::shared_ptr<IAudioSource> m_source = nullptr;
+
+    std::atomic<samples_t> m_filledSamples = 0;
+    std::atomic<samples_t> m_targetSamples = FILL_SAMPLES + FILL_OVER;
+    std::atomic<uint64_t> m_underrunsCount = 0;
 };
 }
 
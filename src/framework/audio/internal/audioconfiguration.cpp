@@ -26,6 +26,9 @@
 #include "global/xmlreader.h"
 #include "global/xmlwriter.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "log.h"
 
 //TODO: remove with global clearing of Q_OS_*** defines
@@ -41,6 +44,11 @@ static const audioch_t AUDIO_CHANNELS = 2;
 //TODO: add other setting: audio device etc
 static const Settings::Key AUDIO_API_KEY("audio", "io/audioApi");
 static const Settings::Key AUDIO_BUFFER_SIZE("audio", "driver_buffer");
+static const Settings::Key AUDIO_PERIODS_COUNT("audio", "driver_periods");
+static const Settings::Key AUDIO_RENDER_WORKERS_COUNT("audio", "render_workers");
+static const Settings::Key AUDIO_PARALLEL_RENDER_MIN_CHANNELS("audio", "parallel_render_min_channels");
+static const Settings::Key AUDIO_VOICES_BUDGET("audio", "voices_budget");
+static const Settings::Key AUDIO_MAX_SOURCE_SAMPLE_RATE("audio", "max_source_sample_rate");
 
 static const Settings::Key USER_SOUNDFONTS_PATH("midi", "application/paths/mySoundfonts");
 
@@ -59,6 +67,18 @@ void AudioConfiguration::init()
     defaultBufferSize = 1024;
 #endif
     settings()->setDefaultValue(AUDIO_BUFFER_SIZE, Val(defaultBufferSize));
+    settings()->setDefaultValue(AUDIO_PERIODS_COUNT, Val(2));
+
+    int defaultRenderWorkersCount = 0;
+#ifndef Q_OS_WASM
+    //! NOTE Leave one core for the main thread and one for the audio worker itself
+    int cpuCount = static_cast<int>(std::thread::hardware_concurrency());
+    defaultRenderWorkersCount = std::clamp(cpuCount - 2, 0, 6);
+#endif
+    settings()->setDefaultValue(AUDIO_RENDER_WORKERS_COUNT, Val(defaultRenderWorkersCount));
+    settings()->setDefaultValue(AUDIO_PARALLEL_RENDER_MIN_CHANNELS, Val(4));
+    settings()->setDefaultValue(AUDIO_VOICES_BUDGET, Val(2048));
+    settings()->setDefaultValue(AUDIO_MAX_SOURCE_SAMPLE_RATE, Val(48000));
 
     settings()->setDefaultValue(SHOW_CONTROLS_IN_MIXER, Val(true));
     settings()->setDefaultValue(AUDIO_API_KEY, Val("Core Audio"));
@@ -96,6 +116,36 @@ unsigned int AudioConfiguration::driverBufferSize() const
     return settings()->value(AUDIO_BUFFER_SIZE).toInt();
 }
 
+unsigned int AudioConfiguration::driverPeriodsCount() const
+{
+    return static_cast<unsigned int>(std::max(settings()->value(AUDIO_PERIODS_COUNT).toInt(), 0));
+}
+
+size_t AudioConfiguration::renderWorkersCount() const
+{
+    return static_cast<size_t>(std::max(settings()->value(AUDIO_RENDER_WORKERS_COUNT).toInt(), 0));
+}
+
+size_t AudioConfiguration::parallelRenderMinChannelsCount() const
+{
+    return static_cast<size_t>(std::max(settings()->value(AUDIO_PARALLEL_RENDER_MIN_CHANNELS).toInt(), 0));
+}
+
+unsigned int AudioConfiguration::voicesBudget() const
+{
+    return static_cast<unsigned int>(std::max(settings()->value(AUDIO_VOICES_BUDGET).toInt(), 0));
+}
+
+unsigned int AudioConfiguration::maxSourceSampleRate() const
+{
+    return static_cast<unsigned int>(std::max(settings()->value(AUDIO_MAX_SOURCE_SAMPLE_RATE).toInt(), 0));
+}
+
+io::path AudioConfiguration::freezeCacheDirectory() const
+{
+    return globalConfiguration()->userAppDataPath() + "/audio_freeze_cache";
+}
+
 SoundFontPaths AudioConfiguration::soundFontDirectories() const
 {
     std::string pathsStr = settings()->value(USER_SOUNDFONTS_PATH).toString();
@@ -42,6 +42,14 @@ public:
 
     audioch_t audioChannelsCount() const override;
     unsigned int driverBufferSize() const override;
+    unsigned int driverPeriodsCount() const override;
+
+    size_t renderWorkersCount() const override;
+    size_t parallelRenderMinChannelsCount() const override;
+    unsigned int voicesBudget() const override;
+    unsigned int maxSourceSampleRate() const override;
+
+    io::path freezeCacheDirectory() const override;
 
     io::paths soundFontDirectories() const override;
     async::Channel<io::paths> soundFontDirectoriesChanged() const override;
@@ -27,7 +27,228 @@
 
 #include "audiotypes.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MU_AUDIO_SIMD_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MU_AUDIO_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 namespace mu::audio {
+//! NOTE Minimal portable wrapper over 4-lane float vectors: SSE on x86, NEON on ARM, plain floats elsewhere
+namespace simd {
+static constexpr samples_t FLOAT4_SIZE = 4;
+
+#if defined(MU_AUDIO_SIMD_SSE)
+using float4 = __m128;
+
+inline float4 zero4()
+{
+    return _mm_setzero_ps();
+}
+
+inline float4 set4(const float value)
+{
+    return _mm_set1_ps(value);
+}
+
+inline float4 load4(const float* src)
+{
+    return _mm_loadu_ps(src);
+}
+
+inline void store4(float* dst, const float4 v)
+{
+    _mm_storeu_ps(dst, v);
+}
+
+inline float4 add4(const float4 a, const float4 b)
+{
+    return _mm_add_ps(a, b);
+}
+
+inline float4 sub4(const float4 a, const float4 b)
+{
+    return _mm_sub_ps(a, b);
+}
+
+inline float4 mul4(const float4 a, const float4 b)
+{
+    return _mm_mul_ps(a, b);
+}
+
+inline float4 mulAdd4(const float4 a, const float4 b, const float4 acc)
+{
+    return _mm_add_ps(acc, _mm_mul_ps(a, b));
+}
+#elif defined(MU_AUDIO_SIMD_NEON)
+using float4 = float32x4_t;
+
+inline float4 zero4()
+{
+    return vdupq_n_f32(0.f);
+}
+
+inline float4 set4(const float value)
+{
+    return vdupq_n_f32(value);
+}
+
+inline float4 load4(const float* src)
+{
+    return vld1q_f32(src);
+}
+
+inline void store4(float* dst, const float4 v)
+{
+    vst1q_f32(dst, v);
+}
+
+inline float4 add4(const float4 a, const float4 b)
+{
+    return vaddq_f32(a, b);
+}
+
+inline float4 sub4(const float4 a, const float4 b)
+{
+    return vsubq_f32(a, b);
+}
+
+inline float4 mul4(const float4 a, const float4 b)
+{
+    return vmulq_f32(a, b);
+}
+
+inline float4 mulAdd4(const float4 a, const float4 b, const float4 acc)
+{
+    return vmlaq_f32(acc, a, b);
+}
+#else
+struct float4 {
+    float v[FLOAT4_SIZE];
+};
+
+inline float4 zero4()
+{
+    return { { 0.f, 0.f, 0.f, 0.f } };
+}
+
+inline float4 set4(const float value)
+{
+    return { { value, value, value, value } };
+}
+
+inline float4 load4(const float* src)
+{
+    return { { src[0], src[1], src[2], src[3] } };
+}
+
+inline void store4(float* dst, const float4 v)
+{
+    for (samples_t i = 0; i < FLOAT4_SIZE; ++i) {
+        dst[i] = v.v[i];
+    }
+}
+
+inline float4 add4(const float4 a, const float4 b)
+{
+    return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } };
+}
+
+inline float4 sub4(const float4 a, const float4 b)
+{
+    return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } };
+}
+
+inline float4 mul4(const float4 a, const float4 b)
+{
+    return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } };
+}
+
+inline float4 mulAdd4(const float4 a, const float4 b, const float4 acc)
+{
+    return add4(acc, mul4(a, b));
+}
+#endif
+
+//! NOTE Inner product of two arrays, the kernel of the FIR filters
+inline float dotProduct(const float* a, const float* b, const samples_t size)
+{
+    samples_t idx = 0;
+    float4 sums = zero4();
+
+    for (; idx + FLOAT4_SIZE <= size; idx += FLOAT4_SIZE) {
+        sums = mulAdd4(load4(a + idx), load4(b + idx), sums);
+    }
+
+    float laneSums[FLOAT4_SIZE];
+    store4(laneSums, sums);
+
+    float result = (laneSums[0] + laneSums[1]) + (laneSums[2] + laneSums[3]);
+    for (; idx < size; ++idx) {
+        result += a[idx] * b[idx];
+    }
+
+    return result;
+}
+
+//! NOTE Applies the per audio channel gain to the interleaved samples (optionally summed with another buffer first)
+//! and accumulates the per audio channel sum of squares of the result
+template<bool withInput>
+inline void gainKernel(float* outBuffer, const float* inBuffer, const gain_t* gains, const audioch_t audioChannelsCount,
+                       const samples_t samplesPerChannel, float* squaredSums)
+{
+    const samples_t total = samplesPerChannel * audioChannelsCount;
+    samples_t idx = 0;
+
+    //! NOTE When the vector width is a multiple of the audio channels count,
+    //! each lane always carries the same audio channel, so one gain vector fits the whole buffer
+    if (audioChannelsCount > 0 && FLOAT4_SIZE % audioChannelsCount == 0) {
+        float gainPattern[FLOAT4_SIZE];
+        for (samples_t lane = 0; lane < FLOAT4_SIZE; ++lane) {
+            gainPattern[lane] = gains[lane % audioChannelsCount];
+        }
+
+        const float4 gain = load4(gainPattern);
+        float4 sums = zero4();
+
+        for (; idx + FLOAT4_SIZE <= total; idx += FLOAT4_SIZE) {
+            float4 samples = load4(outBuffer + idx);
+
+            if constexpr (withInput) {
+                samples = add4(samples, load4(inBuffer + idx));
+            }
+
+            samples = mul4(samples, gain);
+            store4(outBuffer + idx, samples);
+            sums = mulAdd4(samples, samples, sums);
+        }
+
+        float laneSums[FLOAT4_SIZE];
+        store4(laneSums, sums);
+        for (samples_t lane = 0; lane < FLOAT4_SIZE; ++lane) {
+            squaredSums[lane % audioChannelsCount] += laneSums[lane];
+        }
+    }
+
+    for (; idx < total; ++idx) {
+        audioch_t audioChNum = idx % audioChannelsCount;
+
+        float sample = outBuffer[idx];
+
+        if constexpr (withInput) {
+            sample += inBuffer[idx];
+        }
+
+        sample *= gains[audioChNum];
+        outBuffer[idx] = sample;
+        squaredSums[audioChNum] += sample * sample;
+    }
+}
+}
+
+
 inline float balanceGain(const balance_t balance, const int audioChannelNumber)
 {
     return 0.5f * balance * ((audioChannelNumber * 2.f) - 1) + 0.5f;
@@ -43,10 +264,50 @@ inline volume_dbfs_t dbFullScaleFromSample(const float signalValue)
     return 20 * std::log10(std::abs(signalValue));
 }
 
+inline msecs_t tickToMsecs(const midi::MidiMapping& mapping, const midi::tick_t tick)
+{
+    //! NOTE Same default as in MidiAudioSource::buildTempoMap
+    midi::tempo_t tempo = 500000;
+    midi::tick_t tempoStartTick = 0;
+    double msecs = 0.0;
+
+    auto msecsOfTicks = [&mapping](const midi::tick_t ticks, const midi::tempo_t tempo) {
+        return static_cast<double>(ticks) * static_cast<double>(tempo) / static_cast<double>(mapping.division) / 1000.0;
+    };
+
+    for (const auto& pair : mapping.tempo) {
+        if (pair.first >= tick) {
+            break;
+        }
+
+        msecs += msecsOfTicks(pair.first - tempoStartTick, tempo);
+        tempoStartTick = pair.first;
+        tempo = pair.second;
+    }
+
+    msecs += msecsOfTicks(tick - tempoStartTick, tempo);
+
+    return static_cast<msecs_t>(std::ceil(msecs));
+}
+
 inline float samplesRootMeanSquare(float&& squaredSum, const samples_t sampleCount)
 {
     return std::sqrt(squaredSum / sampleCount);
 }
+
+// buffer[i] *= gains[ch], squaredSums[ch] += buffer[i]^2
+inline void applyGain(float* buffer, const gain_t* gains, const audioch_t audioChannelsCount,
+                      const samples_t samplesPerChannel, float* squaredSums)
+{
+    simd::gainKernel<false>(buffer, nullptr, gains, audioChannelsCount, samplesPerChannel, squaredSums);
+}
+
+// outBuffer[i] = (outBuffer[i] + inBuffer[i]) * gains[ch], squaredSums[ch] += outBuffer[i]^2
+inline void mixWithGain(float* outBuffer, const float* inBuffer, const gain_t* gains, const audioch_t audioChannelsCount,
+                        const samples_t samplesPerChannel, float* squaredSums)
+{
+    simd::gainKernel<true>(outBuffer, inBuffer, gains, audioChannelsCount, samplesPerChannel, squaredSums);
+}
 }
 
 #endif // MU_AUDIO_AUDIOMATHUTILS_H
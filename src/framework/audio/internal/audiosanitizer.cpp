@@ -27,6 +27,8 @@ using namespace mu::audio;
 
 static std::thread::id s_as_mainThreadID;
 static std::thread::id s_as_workerThreadID;
+static thread_local bool s_as_isRenderPoolThread = false;
+static thread_local bool s_as_isOfflineRenderThread = false;
 
 void AudioSanitizer::setupMainThread()
 {
@@ -55,5 +57,26 @@ std::thread::id AudioSanitizer::workerThread()
 
 bool AudioSanitizer::isWorkerThread()
 {
-    return std::this_thread::get_id() == s_as_workerThreadID;
+    //! NOTE An offline render thread owns a private audio graph, so it plays the worker role for it
+    return std::this_thread::get_id() == s_as_workerThreadID || s_as_isOfflineRenderThread;
+}
+
+void AudioSanitizer::setupRenderPoolThread()
+{
+    s_as_isRenderPoolThread = true;
+}
+
+bool AudioSanitizer::isRenderPoolThread()
+{
+    return s_as_isRenderPoolThread;
+}
+
+void AudioSanitizer::setupOfflineRenderThread()
+{
+    s_as_isOfflineRenderThread = true;
+}
+
+bool AudioSanitizer::isOfflineRenderThread()
+{
+    return s_as_isOfflineRenderThread;
 }
@@ -39,11 +39,19 @@ public:
     static void setupWorkerThread();
     static std::thread::id workerThread();
     static bool isWorkerThread();
+
+    static void setupRenderPoolThread();
+    static bool isRenderPoolThread();
+
+    static void setupOfflineRenderThread();
+    static bool isOfflineRenderThread();
 };
 }
 
 #define ONLY_AUDIO_WORKER_THREAD assert(mu::audio::AudioSanitizer::isWorkerThread())
 #define ONLY_AUDIO_MAIN_THREAD assert(mu::audio::AudioSanitizer::isMainThread())
+//! NOTE The channels processing is run by the worker or by the render pool threads on its behalf
+#define ONLY_AUDIO_PROCESS_THREAD assert((mu::audio::AudioSanitizer::isWorkerThread() || mu::audio::AudioSanitizer::isRenderPoolThread()))
 #define ONLY_AUDIO_MAIN_OR_WORKER_THREAD assert((mu::audio::AudioSanitizer::isWorkerThread() || mu::audio::AudioSanitizer::isMainThread()))
 
 #endif // MU_AUDIO_AUDIOSANITIZER_H
@@ -0,0 +1,292 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audioworkerpool.h"
+
+#include <string>
+
+#include "log.h"
+#include "runtime.h"
+
+#include "audiosanitizer.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace mu::audio;
+
+static constexpr int SPIN_ITERATIONS = 2048;
+static constexpr int YIELD_ITERATIONS = 256;
+
+static inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile ("yield");
+#endif
+}
+
+static inline uint32_t generationOf(const uint64_t state)
+{
+    return static_cast<uint32_t>(state >> 32);
+}
+
+static inline uint32_t taskIndexOf(const uint64_t state)
+{
+    return static_cast<uint32_t>(state & 0xFFFFFFFF);
+}
+
+static inline uint32_t tasksCountOf(const uint64_t batch)
+{
+    return static_cast<uint32_t>(batch & 0xFFFFFFFF);
+}
+
+static void pinCurrentThread(const size_t cpuIdx)
+{
+#ifdef Q_OS_LINUX
+    unsigned int cpuCount = std::thread::hardware_concurrency();
+    if (cpuCount == 0) {
+        return;
+    }
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpuIdx % cpuCount, &cpuSet);
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0) {
+        LOGW() << "failed to pin audio render thread to cpu: " << cpuIdx % cpuCount;
+    }
+#else
+    UNUSED(cpuIdx);
+#endif
+}
+
+AudioTaskCounter::AudioTaskCounter(const uint32_t generation)
+    : m_state(static_cast<uint64_t>(generation) << 32), m_batch(static_cast<uint64_t>(generation) << 32)
+{
+}
+
+uint32_t AudioTaskCounter::generation() const
+{
+    //! NOTE Sequentially consistent, a parking worker relies on it (see AudioWorkerPool::wakeWorkers)
+    return generationOf(m_state.load());
+}
+
+uint32_t AudioTaskCounter::publish(const uint32_t tasksCount)
+{
+    //! NOTE The generation wraps around, only the equality of the generations matters
+    uint32_t generation = generationOf(m_state.load(std::memory_order_relaxed)) + 1;
+
+    //! NOTE The batch goes first: a worker, which sees the new state, sees its tasks count as well
+    m_batch.store((static_cast<uint64_t>(generation) << 32) | tasksCount);
+    m_state.store(static_cast<uint64_t>(generation) << 32);
+
+    return generation;
+}
+
+bool AudioTaskCounter::claim(const uint32_t generation, uint32_t& idx)
+{
+    uint64_t state = m_state.load(std::memory_order_acquire);
+
+    while (generationOf(state) == generation) {
+        uint64_t batch = m_batch.load(std::memory_order_acquire);
+        if (generationOf(batch) != generation || taskIndexOf(state) >= tasksCountOf(batch)) {
+            return false;
+        }
+
+        if (m_state.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            idx = taskIndexOf(state);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+AudioWorkerPool::~AudioWorkerPool()
+{
+    deinit();
+}
+
+void AudioWorkerPool::init(const size_t workersCount)
+{
+    if (m_threads.size() == workersCount) {
+        return;
+    }
+
+    deinit();
+
+    if (workersCount == 0) {
+        return;
+    }
+
+    m_running = true;
+
+    m_threads.reserve(workersCount);
+    for (size_t i = 0; i < workersCount; ++i) {
+        m_threads.emplace_back([this, i]() {
+            workerMain(i);
+        });
+    }
+}
+
+void AudioWorkerPool::deinit()
+{
+    m_running = false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_parkMutex);
+        m_workersWakeUp.notify_all();
+    }
+
+    for (std::thread& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    m_threads.clear();
+}
+
+size_t AudioWorkerPool::workersCount() const
+{
+    return m_threads.size();
+}
+
+void AudioWorkerPool::run(const size_t tasksCount, TaskFunc func, const void* data)
+{
+    if (m_threads.empty() || tasksCount < 2) {
+        for (size_t idx = 0; idx < tasksCount; ++idx) {
+            func(data, idx);
+        }
+        return;
+    }
+
+    m_taskFunc = func;
+    m_taskData = data;
+    m_unfinishedTasksCount.store(static_cast<uint32_t>(tasksCount));
+
+    uint32_t generation = m_counter.publish(static_cast<uint32_t>(tasksCount));
+    wakeWorkers();
+
+    runTasks(generation);
+    waitTasksFinished();
+}
+
+void AudioWorkerPool::runTasks(const uint32_t generation)
+{
+    uint32_t idx = 0;
+
+    while (m_counter.claim(generation, idx)) {
+        m_taskFunc(m_taskData, idx);
+
+        //! NOTE The last task wakes up the caller, if it has stopped spinning
+        if (m_unfinishedTasksCount.fetch_sub(1) == 1 && m_isCallerParked.load()) {
+            std::lock_guard<std::mutex> lock(m_parkMutex);
+            m_tasksFinished.notify_one();
+        }
+    }
+}
+
+void AudioWorkerPool::wakeWorkers()
+{
+    //! NOTE The lock is taken only when some workers are parked, i.e. after a pause in the processing.
+    //! A worker counts itself as parked before it checks the generation, so the wake-up isn't lost
+    if (m_parkedWorkersCount.load() == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_parkMutex);
+    m_workersWakeUp.notify_all();
+}
+
+void AudioWorkerPool::waitTasksFinished()
+{
+    for (int i = 0; i < SPIN_ITERATIONS; ++i) {
+        if (m_unfinishedTasksCount.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+
+        cpuRelax();
+    }
+
+    std::unique_lock<std::mutex> lock(m_parkMutex);
+    m_isCallerParked = true;
+    m_tasksFinished.wait(lock, [this]() {
+        return m_unfinishedTasksCount.load() == 0;
+    });
+    m_isCallerParked = false;
+}
+
+void AudioWorkerPool::workerMain(const size_t workerIdx)
+{
+    mu::runtime::setThreadName("audio_render_" + std::to_string(workerIdx));
+
+    AudioSanitizer::setupRenderPoolThread();
+
+    //! NOTE The audio worker and the main thread aren't pinned. By default the pool has fewer threads than the cpus,
+    //! so the scheduler keeps them on the cpus, which the render threads don't take
+    pinCurrentThread(workerIdx);
+
+    uint32_t lastGeneration = m_counter.generation();
+    int idleIterations = 0;
+
+    while (m_running.load(std::memory_order_acquire)) {
+        uint32_t generation = m_counter.generation();
+
+        if (generation != lastGeneration) {
+            lastGeneration = generation;
+            idleIterations = 0;
+            runTasks(generation);
+            continue;
+        }
+
+        if (idleIterations < SPIN_ITERATIONS) {
+            cpuRelax();
+        } else if (idleIterations < SPIN_ITERATIONS + YIELD_ITERATIONS) {
+            std::this_thread::yield();
+        } else {
+            parkWorker(lastGeneration);
+            idleIterations = 0;
+            continue;
+        }
+
+        ++idleIterations;
+    }
+}
+
+void AudioWorkerPool::parkWorker(const uint32_t lastGeneration)
+{
+    std::unique_lock<std::mutex> lock(m_parkMutex);
+
+    m_parkedWorkersCount.fetch_add(1);
+    m_workersWakeUp.wait(lock, [this, lastGeneration]() {
+        return !m_running.load() || m_counter.generation() != lastGeneration;
+    });
+    m_parkedWorkersCount.fetch_sub(1);
+}
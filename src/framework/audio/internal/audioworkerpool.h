@@ -0,0 +1,116 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_AUDIOWORKERPOOL_H
+#define MU_AUDIO_AUDIOWORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mu::audio {
+//! NOTE The claim state of the pool batches: the generation of the current batch in the high 32 bits,
+//! the index of the next unclaimed task in the low 32 bits. The generation is a part of the claimed value,
+//! so a late worker can't claim a task of the next batch with the generation of the previous one
+class AudioTaskCounter
+{
+public:
+    explicit AudioTaskCounter(const uint32_t generation = 0);
+
+    uint32_t generation() const;
+
+    //! NOTE Starts the next batch and returns its generation.
+    //! The previous batch must be over, i.e. all its tasks claimed
+    uint32_t publish(const uint32_t tasksCount);
+
+    //! NOTE Claims the next task of the batch, false if the batch is over or isn't the current one
+    bool claim(const uint32_t generation, uint32_t& idx);
+
+private:
+    std::atomic<uint64_t> m_state = 0;
+
+    //! NOTE The generation in the high 32 bits, the tasks count in the low 32 bits,
+    //! so a late worker doesn't compare its index with the count of the next batch
+    std::atomic<uint64_t> m_batch = 0;
+};
+
+//! NOTE Small fork/join pool of helper threads for the audio worker.
+//! The calling thread publishes a batch of tasks and takes part in processing it,
+//! the tasks are claimed through a single atomic counter, so dispatching a batch
+//! doesn't lock and doesn't allocate.
+//! The idle workers and the waiting caller spin for a while and then park on a condition variable,
+//! so the pool doesn't wake up the cpus, when there is nothing to process (e.g. the playback is stopped)
+class AudioWorkerPool
+{
+public:
+    AudioWorkerPool() = default;
+    ~AudioWorkerPool();
+
+    AudioWorkerPool(const AudioWorkerPool&) = delete;
+    AudioWorkerPool& operator=(const AudioWorkerPool&) = delete;
+
+    void init(const size_t workersCount);
+    void deinit();
+
+    size_t workersCount() const;
+
+    //! NOTE Calls func(idx) for each idx in [0, tasksCount) and returns when all of them are finished
+    template<typename Func>
+    void parallelFor(const size_t tasksCount, const Func& func)
+    {
+        run(tasksCount, [](const void* data, size_t idx) {
+            (*static_cast<const Func*>(data))(idx);
+        }, &func);
+    }
+
+private:
+    using TaskFunc = void (*)(const void* data, size_t idx);
+
+    void run(const size_t tasksCount, TaskFunc func, const void* data);
+    void runTasks(const uint32_t generation);
+
+    void wakeWorkers();
+    void waitTasksFinished();
+
+    void workerMain(const size_t workerIdx);
+    void parkWorker(const uint32_t lastGeneration);
+
+    std::vector<std::thread> m_threads;
+    std::atomic<bool> m_running = false;
+
+    AudioTaskCounter m_counter;
+    std::atomic<uint32_t> m_unfinishedTasksCount = 0;
+
+    std::mutex m_parkMutex;
+    std::condition_variable m_workersWakeUp;
+    std::condition_variable m_tasksFinished;
+    std::atomic<uint32_t> m_parkedWorkersCount = 0;
+    std::atomic<bool> m_isCallerParked = false;
+
+    TaskFunc m_taskFunc = nullptr;
+    const void* m_taskData = nullptr;
+};
+}
+
+#endif // MU_AUDIO_AUDIOWORKERPOOL_H
@@ -0,0 +1,203 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "freezecache.h"
+
+#include <cstring>
+
+#include <QDateTime>
+#include <QDir>
+#include <QSaveFile>
+
+#include "log.h"
+
+#include "audioerrors.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+//! NOTE The cache is local to the machine, so the native byte order is used.
+//! The samples are stored as floats, so the peaks over 1.0 (before the master gain) aren't clipped
+struct SegmentHeader {
+    char magic[4] = { 'M', 'U', 'F', 'Z' };
+    uint32_t version = 2;
+    uint32_t audioChannelsCount = 0;
+    uint32_t sampleRate = 0;
+    uint64_t samplesPerChannel = 0;
+};
+
+FrozenSegment::~FrozenSegment()
+{
+    if (m_data) {
+        m_file.unmap(m_data);
+    }
+}
+
+std::shared_ptr<const FrozenSegment> FrozenSegment::map(const io::path& filePath)
+{
+    std::shared_ptr<FrozenSegment> segment(new FrozenSegment());
+    segment->m_file.setFileName(filePath.toQString());
+
+    if (!segment->m_file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    qint64 fileSize = segment->m_file.size();
+    if (fileSize < static_cast<qint64>(sizeof(SegmentHeader))) {
+        LOGW() << "broken frozen segment: " << filePath;
+        return nullptr;
+    }
+
+    segment->m_data = segment->m_file.map(0, fileSize);
+    if (!segment->m_data) {
+        LOGW() << "failed to map frozen segment: " << filePath;
+        return nullptr;
+    }
+
+    SegmentHeader header;
+    std::memcpy(&header, segment->m_data, sizeof(SegmentHeader));
+
+    const SegmentHeader expected;
+    uint64_t dataSize = header.samplesPerChannel * header.audioChannelsCount * sizeof(float);
+
+    if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version
+        || header.audioChannelsCount == 0 || header.audioChannelsCount > MAX_SUPPORTED_AUDIO_CHANNELS
+        || static_cast<uint64_t>(fileSize) != sizeof(SegmentHeader) + dataSize) {
+        LOGW() << "broken frozen segment: " << filePath;
+        return nullptr;
+    }
+
+    segment->m_samples = reinterpret_cast<const float*>(segment->m_data + sizeof(SegmentHeader));
+    segment->m_audioChannelsCount = header.audioChannelsCount;
+    segment->m_sampleRate = header.sampleRate;
+    segment->m_samplesPerChannel = header.samplesPerChannel;
+
+    return segment;
+}
+
+audioch_t FrozenSegment::audioChannelsCount() const
+{
+    return m_audioChannelsCount;
+}
+
+unsigned int FrozenSegment::sampleRate() const
+{
+    return m_sampleRate;
+}
+
+samples_t FrozenSegment::samplesPerChannel() const
+{
+    return m_samplesPerChannel;
+}
+
+void FrozenSegment::read(float* buffer, const samples_t from, const samples_t samplesPerChannel) const
+{
+    IF_ASSERT_FAILED(from + samplesPerChannel <= m_samplesPerChannel) {
+        return;
+    }
+
+    std::memcpy(buffer, m_samples + from * m_audioChannelsCount, samplesPerChannel * m_audioChannelsCount * sizeof(float));
+}
+
+FreezeCache::FreezeCache(const io::path& directory, const uint64_t maxSizeBytes)
+    : m_directory(directory), m_maxSizeBytes(maxSizeBytes)
+{
+}
+
+bool FreezeCache::contains(const FreezeKey key) const
+{
+    return QFile::exists(segmentPath(key).toQString());
+}
+
+FrozenSegmentPtr FreezeCache::load(const FreezeKey key) const
+{
+    FrozenSegmentPtr segment = FrozenSegment::map(segmentPath(key));
+
+    //! NOTE The modification time is the time of the last use
+    if (segment) {
+        QFile file(segmentPath(key).toQString());
+        if (file.open(QIODevice::ReadWrite)) {
+            file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        }
+    }
+
+    return segment;
+}
+
+Ret FreezeCache::store(const FreezeKey key, const float* buffer, const samples_t samplesPerChannel, const audioch_t audioChannelsCount,
+                       const unsigned int sampleRate) const
+{
+    if (!QDir().mkpath(m_directory.toQString())) {
+        LOGE() << "failed to create the freeze cache directory: " << m_directory;
+        return make_ret(Err::FreezeCacheWriteFailed);
+    }
+
+    SegmentHeader header;
+    header.audioChannelsCount = audioChannelsCount;
+    header.sampleRate = sampleRate;
+    header.samplesPerChannel = samplesPerChannel;
+
+    //! NOTE The file is written aside and renamed when complete, so it is never seen half-written
+    QSaveFile file(segmentPath(key).toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGE() << "failed to open frozen segment for writing: " << segmentPath(key);
+        return make_ret(Err::FreezeCacheWriteFailed);
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(SegmentHeader));
+    file.write(reinterpret_cast<const char*>(buffer), static_cast<qint64>(samplesPerChannel * audioChannelsCount * sizeof(float)));
+
+    if (!file.commit()) {
+        LOGE() << "failed to write frozen segment: " << segmentPath(key);
+        return make_ret(Err::FreezeCacheWriteFailed);
+    }
+
+    removeLeastRecentlyUsed();
+
+    return make_ret(Ret::Code::Ok);
+}
+
+io::path FreezeCache::segmentPath(const FreezeKey key) const
+{
+    return m_directory + "/" + QString::number(key, 16).rightJustified(16, '0') + ".mufz";
+}
+
+void FreezeCache::removeLeastRecentlyUsed() const
+{
+    QDir dir(m_directory.toQString());
+    QFileInfoList files = dir.entryInfoList({ "*.mufz" }, QDir::Files, QDir::Time | QDir::Reversed);
+
+    uint64_t totalSize = 0;
+    for (const QFileInfo& file : files) {
+        totalSize += static_cast<uint64_t>(file.size());
+    }
+
+    //! NOTE The oldest first. A segment, which is mapped by a playing track, may fail to be removed on some systems
+    for (const QFileInfo& file : files) {
+        if (totalSize <= m_maxSizeBytes) {
+            break;
+        }
+
+        if (QFile::remove(file.filePath())) {
+            totalSize -= static_cast<uint64_t>(file.size());
+        }
+    }
+}
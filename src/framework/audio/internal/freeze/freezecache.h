@@ -0,0 +1,96 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_FREEZECACHE_H
+#define MU_AUDIO_FREEZECACHE_H
+
+#include <memory>
+
+#include <QFile>
+
+#include "io/path.h"
+#include "ret.h"
+
+#include "audiotypes.h"
+
+namespace mu::audio {
+using FreezeKey = uint64_t;
+
+//! NOTE The rendered samples of a segment of a frozen track.
+//! The cache file is mapped into memory, the samples are read from it directly
+class FrozenSegment
+{
+public:
+    ~FrozenSegment();
+
+    static std::shared_ptr<const FrozenSegment> map(const io::path& filePath);
+
+    audioch_t audioChannelsCount() const;
+    unsigned int sampleRate() const;
+    samples_t samplesPerChannel() const;
+
+    //! NOTE Writes the interleaved samples from the given position of the segment
+    void read(float* buffer, const samples_t from, const samples_t samplesPerChannel) const;
+
+private:
+    FrozenSegment() = default;
+
+    QFile m_file;
+    uchar* m_data = nullptr;
+    const float* m_samples = nullptr;
+
+    audioch_t m_audioChannelsCount = 0;
+    unsigned int m_sampleRate = 0;
+    samples_t m_samplesPerChannel = 0;
+};
+
+using FrozenSegmentPtr = std::shared_ptr<const FrozenSegment>;
+
+static constexpr uint64_t FREEZE_CACHE_DEFAULT_MAX_SIZE = 2ull * 1024 * 1024 * 1024; // bytes
+
+//! NOTE On-disk storage of the frozen segments. The segments are addressed by the hash of everything,
+//! which affects their sound, so the unchanged segments are found again after any edit.
+//! When the cache grows over the max size, the least recently used segments are removed
+class FreezeCache
+{
+public:
+    explicit FreezeCache(const io::path& directory, const uint64_t maxSizeBytes = FREEZE_CACHE_DEFAULT_MAX_SIZE);
+
+    //! NOTE The file io is done by the calls, they are not meant for the audio worker thread
+    bool contains(const FreezeKey key) const;
+    FrozenSegmentPtr load(const FreezeKey key) const;
+
+    //! NOTE Can be called from any thread, the segment appears in the cache only when it is written completely
+    Ret store(const FreezeKey key, const float* buffer, const samples_t samplesPerChannel, const audioch_t audioChannelsCount,
+              const unsigned int sampleRate) const;
+
+private:
+    io::path segmentPath(const FreezeKey key) const;
+    void removeLeastRecentlyUsed() const;
+
+    io::path m_directory;
+    uint64_t m_maxSizeBytes = 0;
+};
+
+using FreezeCachePtr = std::shared_ptr<FreezeCache>;
+}
+
+#endif // MU_AUDIO_FREEZECACHE_H
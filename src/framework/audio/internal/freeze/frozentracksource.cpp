@@ -0,0 +1,739 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "frozentracksource.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "log.h"
+#include "runtime.h"
+#include "async/async.h"
+
+#include "audioerrors.h"
+#include "internal/audiosanitizer.h"
+#include "internal/audiothread.h"
+#include "internal/audiomathutils.h"
+#include "internal/trackeventsprovider.h"
+#include "internal/fx/fxresolver.h"
+#include "internal/fx/musefxresolver.h"
+#include "internal/synthesizers/synthresolver.h"
+#include "internal/synthesizers/fluidsynth/fluidresolver.h"
+#include "internal/worker/midiaudiosource.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+using namespace mu::async;
+using namespace mu::midi;
+
+static constexpr msecs_t SEGMENT_MSECS = 10000;
+
+//! NOTE The sound of a segment depends on the notes started before it, so a segment is rendered
+//! from the start of the previous one, and the events of the previous one are a part of its key
+static constexpr msecs_t WARMUP_MSECS = SEGMENT_MSECS;
+
+static constexpr msecs_t TAIL_MSECS = 1000; // release time after the last event
+
+//! NOTE Same block as in the offline renderer, it keeps the msecs passed to the midi source exact
+static constexpr unsigned int BLOCKS_PER_SECOND = 100;
+
+//! NOTE Changes the keys of all the segments, when the way they are rendered changes
+static constexpr uint32_t KEY_VERSION = 2;
+
+//! NOTE The frozen audio read ahead by the worker, at least two blocks
+static constexpr samples_t READ_AHEAD_MIN_SAMPLES = 4096;
+
+namespace {
+//! NOTE FNV-1a, stable across runs and platforms, unlike std::hash
+class KeyHasher
+{
+public:
+    void add(const void* data, const size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            m_hash ^= bytes[i];
+            m_hash *= 1099511628211ULL;
+        }
+    }
+
+    template<typename T>
+    void add(const T& value)
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+        add(&value, sizeof(T));
+    }
+
+    void add(const std::string& str)
+    {
+        add(str.size());
+        add(str.data(), str.size());
+    }
+
+    void add(const AudioResourceMeta& meta)
+    {
+        add(meta.id);
+        add(meta.vendor);
+        add(meta.type);
+    }
+
+    void add(const Event& event)
+    {
+        add(event.messageType());
+
+        if (event.messageType() == Event::MessageType::ChannelVoice10) {
+            add(event.to_MIDI10Package());
+        } else {
+            add(event.to_string());
+        }
+    }
+
+    FreezeKey key() const
+    {
+        return m_hash;
+    }
+
+private:
+    FreezeKey m_hash = 14695981039346656037ULL;
+};
+}
+
+FrozenTrackSource::FrozenTrackSource(const TrackId trackId, const MidiData& midiData, ITrackAudioInputPtr liveInput,
+                                     const AudioInputParams& inputParams, const AudioFxParamsMap& fxParams)
+    : m_trackId(trackId), m_midiData(midiData), m_liveInput(std::move(liveInput)), m_inputParams(inputParams), m_fxParams(fxParams)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_cache = std::make_shared<FreezeCache>(configuration()->freezeCacheDirectory());
+
+    m_midiData.stream.fullEventsStream.onReceive(this, [this](Events events) {
+        m_events = std::move(events);
+        m_hasEvents = true;
+
+        updateSegments();
+    });
+
+    //! NOTE The changed ranges get the new keys, only they are rendered again
+    m_midiData.stream.patchStream.onReceive(this, [this](const Events&, tick_t, tick_t) {
+        m_midiData.stream.fullEventsRequest.notify();
+    });
+
+    m_midiData.stream.fullEventsRequest.notify();
+}
+
+FrozenTrackSource::~FrozenTrackSource()
+{
+    m_midiData.stream.fullEventsStream.resetOnReceive(this);
+    m_midiData.stream.patchStream.resetOnReceive(this);
+
+    m_renderAborted = true;
+    if (m_renderThread.joinable()) {
+        m_renderThread.join();
+    }
+}
+
+ITrackAudioInputPtr FrozenTrackSource::liveInput() const
+{
+    return m_liveInput;
+}
+
+bool FrozenTrackSource::isPlayingFrozen() const
+{
+    return m_isPlayingFrozen;
+}
+
+void FrozenTrackSource::setFxParams(const AudioFxParamsMap& fxParams)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (m_fxParams == fxParams) {
+        return;
+    }
+
+    m_fxParams = fxParams;
+    updateSegments();
+}
+
+bool FrozenTrackSource::isActive() const
+{
+    return m_liveInput->isActive();
+}
+
+void FrozenTrackSource::setIsActive(const bool active)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_isActive = active;
+    m_liveInput->setIsActive(active);
+}
+
+void FrozenTrackSource::setSampleRate(unsigned int sampleRate)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_liveInput->setSampleRate(sampleRate);
+
+    if (m_sampleRate == sampleRate) {
+        return;
+    }
+
+    m_sampleRate = sampleRate;
+    updateSegments();
+}
+
+unsigned int FrozenTrackSource::audioChannelsCount() const
+{
+    return m_liveInput->audioChannelsCount();
+}
+
+Channel<unsigned int> FrozenTrackSource::audioChannelsCountChanged() const
+{
+    return m_liveInput->audioChannelsCountChanged();
+}
+
+void FrozenTrackSource::process(float* buffer, unsigned int sampleCount)
+{
+    ONLY_AUDIO_PROCESS_THREAD;
+
+    if (!m_isActive || m_sampleRate == 0) {
+        m_isPlayingFrozen = false;
+        m_liveInput->process(buffer, sampleCount);
+        return;
+    }
+
+    if (m_readAheadEnd - m_readAheadStart >= sampleCount) {
+        audioch_t audioChannelsCount = this->audioChannelsCount();
+        auto begin = m_readAheadBuffer.cbegin() + m_readAheadStart * audioChannelsCount;
+        std::copy(begin, begin + sampleCount * audioChannelsCount, buffer);
+
+        m_readAheadStart += sampleCount;
+        m_isPlayingFrozen = true;
+        m_isLiveInSync = false;
+        m_position += sampleCount;
+        return;
+    }
+
+    m_isPlayingFrozen = false;
+
+    //! NOTE The live input can be moved only by the worker, it stays silent until it's synced
+    if (!m_isLiveInSync) {
+        std::fill(buffer, buffer + sampleCount * audioChannelsCount(), 0.f);
+        m_position += sampleCount;
+        return;
+    }
+
+    m_liveInput->process(buffer, sampleCount);
+    m_position += sampleCount;
+}
+
+void FrozenTrackSource::prepareProcessing(const samples_t samplesPerChannel)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    audioch_t audioChannelsCount = this->audioChannelsCount();
+    if (!m_isActive || m_sampleRate == 0 || audioChannelsCount == 0) {
+        return;
+    }
+
+    samples_t capacity = std::max(READ_AHEAD_MIN_SAMPLES, 2 * samplesPerChannel);
+    if (m_readAheadBuffer.size() < capacity * audioChannelsCount) {
+        m_readAheadBuffer.resize(capacity * audioChannelsCount);
+    }
+
+    capacity = m_readAheadBuffer.size() / audioChannelsCount;
+
+    //! NOTE The unplayed frames are moved to the front, the rest is read from the segments
+    if (m_readAheadStart > 0) {
+        std::copy(m_readAheadBuffer.begin() + m_readAheadStart * audioChannelsCount,
+                  m_readAheadBuffer.begin() + m_readAheadEnd * audioChannelsCount,
+                  m_readAheadBuffer.begin());
+
+        m_readAheadEnd -= m_readAheadStart;
+        m_readAheadStart = 0;
+    }
+
+    samples_t segmentSize = segmentSamplesPerChannel();
+
+    while (m_readAheadEnd < capacity && segmentSize > 0) {
+        samples_t from = m_position + m_readAheadEnd;
+        samples_t count = std::min(capacity - m_readAheadEnd, segmentSize - from % segmentSize);
+
+        if (!readFrozen(m_readAheadBuffer.data() + m_readAheadEnd * audioChannelsCount, from, count)) {
+            break;
+        }
+
+        m_readAheadEnd += count;
+    }
+
+    if (m_readAheadEnd >= samplesPerChannel) {
+        return;
+    }
+
+    //! NOTE The frozen audio ends within the block, the live input plays it.
+    //! It stood still while the frozen segments were played
+    m_readAheadEnd = 0;
+
+    if (!m_isLiveInSync) {
+        m_liveInput->seek(m_position * 1000 / m_sampleRate);
+        m_isLiveInSync = true;
+    }
+}
+
+void FrozenTrackSource::seek(const msecs_t newPositionMsecs)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_position = newPositionMsecs * m_sampleRate / 1000;
+    resetReadAhead();
+
+    m_liveInput->seek(newPositionMsecs);
+    m_isLiveInSync = true;
+}
+
+void FrozenTrackSource::prefetch(const msecs_t positionMsecs)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_liveInput->prefetch(positionMsecs);
+}
+
+void FrozenTrackSource::applyInputParams(const AudioInputParams& originParams, AudioInputParams& resultParams)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_liveInput->applyInputParams(originParams, resultParams);
+
+    if (m_inputParams == resultParams) {
+        return;
+    }
+
+    m_inputParams = resultParams;
+    updateSegments();
+}
+
+unsigned int FrozenTrackSource::activeVoicesCount() const
+{
+    if (m_isPlayingFrozen) {
+        return 0;
+    }
+
+    return m_liveInput->activeVoicesCount();
+}
+
+void FrozenTrackSource::setVoicesLimit(unsigned int limit)
+{
+    //! NOTE The segments are rendered offline with their own synthesizer, only the live input is limited
+    m_liveInput->setVoicesLimit(limit);
+}
+
+unsigned int FrozenTrackSource::stolenVoicesCount() const
+{
+    return m_liveInput->stolenVoicesCount();
+}
+
+void FrozenTrackSource::updateSegments()
+{
+    if (!m_hasEvents || m_sampleRate == 0 || audioChannelsCount() == 0) {
+        return;
+    }
+
+    std::vector<FreezeKey> keys = calculateSegmentKeys();
+    std::vector<FrozenSegmentPtr> segments(keys.size());
+
+    bool keysChanged = keys != m_segmentKeys;
+    bool hasMissingSegments = false;
+
+    //! NOTE The changed segments are loaded from the cache by the render thread, so the worker doesn't wait for the disk
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (i < m_segmentKeys.size() && m_segmentKeys[i] == keys[i]) {
+            segments[i] = m_segments[i];
+        }
+
+        if (!segments[i]) {
+            hasMissingSegments = true;
+        }
+    }
+
+    m_segmentKeys = std::move(keys);
+    m_segments = std::move(segments);
+
+    //! NOTE The audio read ahead may be outdated
+    if (keysChanged) {
+        resetReadAhead();
+    }
+
+    if (!hasMissingSegments) {
+        return;
+    }
+
+    //! NOTE The segments being rendered may be outdated already, the rendering starts again when it's stopped
+    if (m_isRendering) {
+        if (keysChanged) {
+            m_needsRendering = true;
+            m_renderAborted = true;
+        }
+        return;
+    }
+
+    startRendering();
+}
+
+std::vector<FreezeKey> FrozenTrackSource::calculateSegmentKeys() const
+{
+    const MidiMapping& mapping = m_midiData.mapping;
+
+    msecs_t totalMsecs = tickToMsecs(mapping, m_midiData.stream.lastTick) + TAIL_MSECS;
+    size_t segmentsCount = static_cast<size_t>((totalMsecs + SEGMENT_MSECS - 1) / SEGMENT_MSECS);
+
+    KeyHasher common;
+    common.add(KEY_VERSION);
+    common.add(m_sampleRate);
+    common.add(audioChannelsCount());
+    common.add(m_inputParams.resourceMeta);
+
+    for (const auto& pair : m_fxParams) {
+        for (const AudioFxParams& fx : pair.second) {
+            common.add(fx.resourceMeta);
+            common.add(fx.active);
+
+            for (const auto& value : fx.values) {
+                common.add(value.first);
+                common.add(value.second);
+            }
+        }
+    }
+
+    common.add(mapping.division);
+    for (const auto& pair : mapping.tempo) {
+        common.add(pair.first);
+        common.add(pair.second);
+    }
+
+    for (const Program& program : mapping.programms) {
+        common.add(program.channel);
+        common.add(program.program);
+        common.add(program.bank);
+    }
+
+    for (const Event& event : m_midiData.stream.controlEventsStream.val) {
+        common.add(event);
+    }
+
+    std::vector<KeyHasher> hashers(segmentsCount, common);
+    for (size_t i = 0; i < segmentsCount; ++i) {
+        hashers[i].add(i);
+    }
+
+    for (const auto& pair : m_events) {
+        size_t index = static_cast<size_t>(tickToMsecs(mapping, pair.first) / SEGMENT_MSECS);
+
+        //! NOTE The events of a segment are the warm-up of the next one
+        for (size_t i = index; i <= index + 1 && i < segmentsCount; ++i) {
+            hashers[i].add(pair.first);
+
+            for (const Event& event : pair.second) {
+                hashers[i].add(event);
+            }
+        }
+    }
+
+    std::vector<FreezeKey> keys;
+    keys.reserve(segmentsCount);
+
+    for (const KeyHasher& hasher : hashers) {
+        keys.push_back(hasher.key());
+    }
+
+    return keys;
+}
+
+FrozenSegmentPtr FrozenTrackSource::loadSegment(const FreezeKey key, const RenderJob& job) const
+{
+    FrozenSegmentPtr segment = m_cache->load(key);
+
+    if (segment && (segment->audioChannelsCount() != job.audioChannelsCount || segment->sampleRate() != job.sampleRate)) {
+        return nullptr;
+    }
+
+    return segment;
+}
+
+void FrozenTrackSource::startRendering()
+{
+    //! NOTE Only the fluid synth can be created aside from the playback
+    if (m_inputParams.type() != AudioSourceType::Fluid) {
+        LOGW() << "the track " << m_trackId << " can't be frozen: " << make_ret(Err::TrackIsNotFreezable).toString();
+        return;
+    }
+
+    RenderJob job;
+    job.trackId = m_trackId;
+    job.track.mapping = m_midiData.mapping;
+    job.track.setupEvents = m_midiData.stream.controlEventsStream.val;
+    job.track.events = m_events;
+    job.track.lastTick = m_midiData.stream.lastTick;
+    job.inputParams = m_inputParams;
+    job.fxParams = m_fxParams;
+    job.soundFontDirectories = configuration()->soundFontDirectories();
+    job.sampleRate = m_sampleRate;
+    job.audioChannelsCount = audioChannelsCount();
+    job.totalMsecs = tickToMsecs(m_midiData.mapping, m_midiData.stream.lastTick) + TAIL_MSECS;
+
+    for (size_t i = 0; i < m_segments.size(); ++i) {
+        if (!m_segments[i]) {
+            job.segments.push_back({ i, m_segmentKeys[i] });
+        }
+    }
+
+    if (job.segments.empty()) {
+        return;
+    }
+
+    if (m_renderThread.joinable()) {
+        m_renderThread.join();
+    }
+
+    m_isRendering = true;
+    m_needsRendering = false;
+    m_renderAborted = false;
+
+    std::weak_ptr<FrozenTrackSource> weakThis = weak_from_this();
+
+    m_renderThread = std::thread([this, weakThis, job = std::move(job)]() {
+        renderSegments(job);
+
+        //! NOTE The source may be removed while the last segment is being written
+        Async::call(nullptr, [weakThis]() {
+            if (std::shared_ptr<FrozenTrackSource> self = weakThis.lock()) {
+                self->onRenderingFinished();
+            }
+        }, AudioThread::ID);
+    });
+}
+
+void FrozenTrackSource::onRenderingFinished()
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (m_renderThread.joinable()) {
+        m_renderThread.join();
+    }
+
+    m_isRendering = false;
+
+    if (m_needsRendering) {
+        m_needsRendering = false;
+        updateSegments();
+    }
+}
+
+void FrozenTrackSource::onSegmentLoaded(const FreezeKey key, FrozenSegmentPtr segment)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    for (size_t i = 0; i < m_segmentKeys.size(); ++i) {
+        if (m_segmentKeys[i] == key && !m_segments[i]) {
+            m_segments[i] = segment;
+        }
+    }
+}
+
+void FrozenTrackSource::renderSegments(const RenderJob& job)
+{
+    runtime::setThreadName("audio_freeze_render");
+    AudioSanitizer::setupOfflineRenderThread();
+
+    std::weak_ptr<FrozenTrackSource> weakThis = weak_from_this();
+
+    auto sendSegment = [weakThis](const FreezeKey key, FrozenSegmentPtr segment) {
+        Async::call(nullptr, [weakThis, key, segment]() {
+            if (std::shared_ptr<FrozenTrackSource> self = weakThis.lock()) {
+                self->onSegmentLoaded(key, segment);
+            }
+        }, AudioThread::ID);
+    };
+
+    //! NOTE Only the segments, which aren't in the cache, are rendered
+    std::vector<std::pair<size_t, FreezeKey> > segmentsToRender;
+    for (const auto& pair : job.segments) {
+        if (m_renderAborted) {
+            return;
+        }
+
+        if (FrozenSegmentPtr segment = loadSegment(pair.second, job)) {
+            sendSegment(pair.second, segment);
+        } else {
+            segmentsToRender.push_back(pair);
+        }
+    }
+
+    if (segmentsToRender.empty()) {
+        return;
+    }
+
+    //! NOTE The graph is private to the render, so it doesn't interfere with the playback
+    auto fluidResolver = std::make_shared<FluidResolver>(job.soundFontDirectories, async::Channel<io::paths>());
+    auto synthResolver = std::make_shared<SynthResolver>();
+    synthResolver->registerResolver(AudioSourceType::Fluid, fluidResolver);
+    synthResolver->init(job.inputParams);
+
+    auto fxResolver = std::make_shared<fx::FxResolver>();
+    fxResolver->registerResolver(AudioFxType::MuseFx, std::make_shared<fx::MuseFxResolver>(job.audioChannelsCount));
+
+    samples_t blockSize = job.sampleRate / BLOCKS_PER_SECOND;
+    samples_t segmentSize = segmentSamplesPerChannel();
+    samples_t warmupSize = WARMUP_MSECS * job.sampleRate / 1000;
+    samples_t totalSamples = job.totalMsecs * job.sampleRate / 1000;
+
+    std::vector<float> block(blockSize * job.audioChannelsCount, 0.f);
+    std::vector<float> segment;
+    segment.reserve(segmentSize * job.audioChannelsCount);
+
+    size_t runStart = 0;
+    while (runStart < segmentsToRender.size() && !m_renderAborted) {
+        //! NOTE The consecutive segments are rendered in one pass, only the first one needs the warm-up
+        size_t runEnd = runStart + 1;
+        while (runEnd < segmentsToRender.size() && segmentsToRender[runEnd].first == segmentsToRender[runEnd - 1].first + 1) {
+            ++runEnd;
+        }
+
+        TrackEventsProvider provider(job.track);
+
+        auto source = std::make_shared<MidiAudioSource>(job.trackId, provider.midiData());
+        source->setsynthResolver(synthResolver);
+        source->setMidiOutputEnabled(false);
+        source->setSampleRate(job.sampleRate);
+
+        AudioInputParams appliedParams;
+        source->applyInputParams(job.inputParams, appliedParams);
+        source->setIsActive(true);
+
+        std::vector<IFxProcessorPtr> fxProcessors = fxResolver->resolveFxList(job.trackId, job.fxParams);
+        for (IFxProcessorPtr& fx : fxProcessors) {
+            fx->setSampleRate(job.sampleRate);
+        }
+
+        auto processBlock = [&](const samples_t samplesPerChannel) {
+            std::fill(block.begin(), block.end(), 0.f);
+            source->process(block.data(), static_cast<unsigned int>(samplesPerChannel));
+
+            for (IFxProcessorPtr& fx : fxProcessors) {
+                if (fx->active()) {
+                    fx->process(block.data(), static_cast<unsigned int>(samplesPerChannel));
+                }
+            }
+        };
+
+        samples_t firstSegmentStart = segmentsToRender[runStart].first * segmentSize;
+        samples_t position = firstSegmentStart - std::min(firstSegmentStart, warmupSize);
+        source->seek(position * 1000 / job.sampleRate);
+
+        while (position < firstSegmentStart && !m_renderAborted) {
+            samples_t samplesPerChannel = std::min(blockSize, firstSegmentStart - position);
+            processBlock(samplesPerChannel);
+            position += samplesPerChannel;
+        }
+
+        for (size_t i = runStart; i < runEnd && !m_renderAborted; ++i) {
+            samples_t segmentEnd = std::min(position + segmentSize, totalSamples);
+            segment.clear();
+
+            while (position < segmentEnd && !m_renderAborted) {
+                samples_t samplesPerChannel = std::min(blockSize, segmentEnd - position);
+                processBlock(samplesPerChannel);
+                segment.insert(segment.end(), block.begin(), block.begin() + samplesPerChannel * job.audioChannelsCount);
+                position += samplesPerChannel;
+            }
+
+            if (m_renderAborted) {
+                return;
+            }
+
+            FreezeKey key = segmentsToRender[i].second;
+            Ret ret = m_cache->store(key, segment.data(), segment.size() / job.audioChannelsCount, job.audioChannelsCount, job.sampleRate);
+            if (!ret) {
+                LOGE() << "failed to store the frozen segment of the track " << job.trackId << ": " << ret.toString();
+                return;
+            }
+
+            if (FrozenSegmentPtr stored = loadSegment(key, job)) {
+                sendSegment(key, stored);
+            }
+        }
+
+        runStart = runEnd;
+    }
+}
+
+bool FrozenTrackSource::readFrozen(float* buffer, const samples_t from, const samples_t samplesPerChannel) const
+{
+    samples_t segmentSize = segmentSamplesPerChannel();
+    if (segmentSize == 0 || m_segments.empty()) {
+        return false;
+    }
+
+    //! NOTE The block is taken from the cache only when it's there completely
+    size_t firstIndex = from / segmentSize;
+    size_t lastIndex = (from + samplesPerChannel - 1) / segmentSize;
+
+    for (size_t i = firstIndex; i <= lastIndex && i < m_segments.size(); ++i) {
+        if (!m_segments[i]) {
+            return false;
+        }
+    }
+
+    audioch_t audioChannelsCount = this->audioChannelsCount();
+    samples_t position = from;
+    samples_t written = 0;
+
+    while (written < samplesPerChannel) {
+        size_t index = position / segmentSize;
+        samples_t offset = position % segmentSize;
+        samples_t count = std::min(samplesPerChannel - written, segmentSize - offset);
+        float* dst = buffer + written * audioChannelsCount;
+
+        //! NOTE After the end of the track there is silence
+        samples_t available = 0;
+        if (index < m_segments.size() && offset < m_segments[index]->samplesPerChannel()) {
+            available = std::min(count, m_segments[index]->samplesPerChannel() - offset);
+            m_segments[index]->read(dst, offset, available);
+        }
+
+        std::fill(dst + available * audioChannelsCount, dst + count * audioChannelsCount, 0.f);
+
+        written += count;
+        position += count;
+    }
+
+    return true;
+}
+
+void FrozenTrackSource::resetReadAhead()
+{
+    m_readAheadStart = 0;
+    m_readAheadEnd = 0;
+}
+
+samples_t FrozenTrackSource::segmentSamplesPerChannel() const
+{
+    return SEGMENT_MSECS * m_sampleRate / 1000;
+}
@@ -0,0 +1,141 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_FROZENTRACKSOURCE_H
+#define MU_AUDIO_FROZENTRACKSOURCE_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "modularity/ioc.h"
+#include "async/asyncable.h"
+#include "async/channel.h"
+
+#include "iaudioconfiguration.h"
+#include "iofflinerenderer.h"
+#include "internal/worker/track.h"
+#include "freezecache.h"
+
+namespace mu::audio {
+//! NOTE Plays a track from its pre-rendered audio. The track is split into segments,
+//! which are rendered in the background and kept in the freeze cache.
+//! The live input is used for the segments, which are not rendered (yet), e.g. right after an edit
+class FrozenTrackSource : public ITrackAudioInput, public async::Asyncable, public std::enable_shared_from_this<FrozenTrackSource>
+{
+    INJECT(audio, IAudioConfiguration, configuration)
+
+public:
+    explicit FrozenTrackSource(const TrackId trackId, const midi::MidiData& midiData, ITrackAudioInputPtr liveInput,
+                               const AudioInputParams& inputParams, const AudioFxParamsMap& fxParams);
+    ~FrozenTrackSource() override;
+
+    ITrackAudioInputPtr liveInput() const;
+
+    //! NOTE The fx are rendered into the frozen segments, they must not be applied to them again
+    bool isPlayingFrozen() const;
+    void setFxParams(const AudioFxParamsMap& fxParams);
+
+    bool isActive() const override;
+    void setIsActive(const bool active) override;
+
+    void setSampleRate(unsigned int sampleRate) override;
+    unsigned int audioChannelsCount() const override;
+    async::Channel<unsigned int> audioChannelsCountChanged() const override;
+    void process(float* buffer, unsigned int sampleCount) override;
+
+    //! NOTE Called by the worker before the block is processed: reads the frozen audio ahead,
+    //! so the processing thread doesn't touch the mapped cache files, and syncs the live input when the frozen audio ends
+    void prepareProcessing(const samples_t samplesPerChannel);
+
+    void seek(const msecs_t newPositionMsecs) override;
+    void prefetch(const msecs_t positionMsecs) override;
+    void applyInputParams(const AudioInputParams& originParams, AudioInputParams& resultParams) override;
+    unsigned int activeVoicesCount() const override;
+    void setVoicesLimit(unsigned int limit) override;
+    unsigned int stolenVoicesCount() const override;
+
+private:
+    struct RenderJob {
+        TrackId trackId = -1;
+        IOfflineRenderer::Track track;
+        AudioInputParams inputParams;
+        AudioFxParamsMap fxParams;
+        io::paths soundFontDirectories;
+        unsigned int sampleRate = 0;
+        audioch_t audioChannelsCount = 0;
+        msecs_t totalMsecs = 0;
+
+        //! NOTE The segments to load from the cache or to render in the ascending order
+        std::vector<std::pair<size_t /*index*/, FreezeKey> > segments;
+    };
+
+    void updateSegments();
+    std::vector<FreezeKey> calculateSegmentKeys() const;
+    FrozenSegmentPtr loadSegment(const FreezeKey key, const RenderJob& job) const;
+
+    void startRendering();
+    void onRenderingFinished();
+    void onSegmentLoaded(const FreezeKey key, FrozenSegmentPtr segment);
+
+    void renderSegments(const RenderJob& job);
+
+    bool readFrozen(float* buffer, const samples_t from, const samples_t samplesPerChannel) const;
+    void resetReadAhead();
+    samples_t segmentSamplesPerChannel() const;
+
+    TrackId m_trackId = -1;
+    midi::MidiData m_midiData;
+    ITrackAudioInputPtr m_liveInput = nullptr;
+
+    AudioInputParams m_inputParams;
+    AudioFxParamsMap m_fxParams;
+    unsigned int m_sampleRate = 0;
+
+    midi::Events m_events;
+    bool m_hasEvents = false;
+
+    FreezeCachePtr m_cache = nullptr;
+    std::vector<FreezeKey> m_segmentKeys;
+    std::vector<FrozenSegmentPtr> m_segments;
+
+    std::thread m_renderThread;
+    std::atomic<bool> m_renderAborted = false;
+    bool m_isRendering = false;
+    bool m_needsRendering = false;
+
+    samples_t m_position = 0;
+
+    //! NOTE The frozen audio from the position on, the frames [start, end) are not played yet
+    std::vector<float> m_readAheadBuffer;
+    samples_t m_readAheadStart = 0;
+    samples_t m_readAheadEnd = 0;
+
+    bool m_isActive = false;
+    bool m_isLiveInSync = true;
+    bool m_isPlayingFrozen = false;
+};
+
+using FrozenTrackSourcePtr = std::shared_ptr<FrozenTrackSource>;
+}
+
+#endif // MU_AUDIO_FROZENTRACKSOURCE_H
@@ -0,0 +1,356 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "equaliser.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "log.h"
+
+#include "internal/audiosanitizer.h"
+
+using namespace mu::audio;
+using namespace mu::audio::fx;
+
+//! NOTE The coefficients are changed every RAMP_BLOCK_SIZE frames, RAMP_STEPS_COUNT times (about 20 ms at 48 kHz),
+//! the blocks are also the units of the deinterleaving
+static constexpr samples_t RAMP_BLOCK_SIZE = 32;
+static constexpr samples_t RAMP_STEPS_COUNT = 32;
+
+static constexpr float MAX_FREQUENCY_RATIO = 0.49f;
+static constexpr volume_db_t MAX_BAND_GAIN = 24.f;
+
+bool Equaliser::Coefficients::isIdentity() const
+{
+    return b0 == 1.f && b1 == 0.f && b2 == 0.f && a1 == 0.f && a2 == 0.f;
+}
+
+Equaliser::Equaliser(const audioch_t audioChannelsCount)
+    : m_audioChannelsCount(audioChannelsCount)
+{
+    m_channelsBlocks.assign(m_audioChannelsCount * RAMP_BLOCK_SIZE, 0.f);
+    setBands(defaultBands());
+}
+
+EqualiserBandList Equaliser::defaultBands()
+{
+    EqualiserBand low;
+    low.type = EqualiserBand::Type::LowShelf;
+    low.frequency = 100.f;
+
+    EqualiserBand mid;
+    mid.type = EqualiserBand::Type::Peak;
+    mid.frequency = 1'000.f;
+
+    EqualiserBand high;
+    high.type = EqualiserBand::Type::HighShelf;
+    high.frequency = 8'000.f;
+
+    return { low, mid, high };
+}
+
+AudioFxType Equaliser::type() const
+{
+    return AudioFxType::MuseFx;
+}
+
+AudioResourceId Equaliser::resourceId() const
+{
+    return EQUALISER_ID;
+}
+
+void Equaliser::setSampleRate(unsigned int sampleRate)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (m_sampleRate == sampleRate) {
+        return;
+    }
+
+    m_sampleRate = sampleRate;
+    updateTargets(false /*ramp*/);
+}
+
+bool Equaliser::active() const
+{
+    return m_active;
+}
+
+void Equaliser::setActive(bool active)
+{
+    m_active = active;
+}
+
+const EqualiserBandList& Equaliser::bands() const
+{
+    return m_bands;
+}
+
+void Equaliser::setBands(const EqualiserBandList& bands)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (m_bands == bands) {
+        return;
+    }
+
+    //! NOTE The states of the bands which remain are kept, so the changes are smooth
+    bool sameBandsCount = m_bands.size() == bands.size();
+    m_bands = bands;
+
+    if (!sameBandsCount) {
+        m_states.assign(m_bands.size(), BandState());
+        for (BandState& state : m_states) {
+            state.z1.assign(m_audioChannelsCount, 0.f);
+            state.z2.assign(m_audioChannelsCount, 0.f);
+        }
+    }
+
+    updateTargets(sameBandsCount /*ramp*/);
+}
+
+void Equaliser::setValues(const AudioFxValues& values)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    EqualiserBandList bands = defaultBands();
+    const std::string gainKeys[] = { EQUALISER_LOW_GAIN, EQUALISER_MID_GAIN, EQUALISER_HIGH_GAIN };
+
+    for (size_t i = 0; i < bands.size(); ++i) {
+        auto it = values.find(gainKeys[i]);
+        if (it != values.end()) {
+            bands[i].gain = std::clamp(it->second, -MAX_BAND_GAIN, MAX_BAND_GAIN);
+        }
+    }
+
+    setBands(bands);
+}
+
+void Equaliser::updateTargets(const bool ramp)
+{
+    if (!m_sampleRate) {
+        return;
+    }
+
+    for (size_t i = 0; i < m_bands.size(); ++i) {
+        BandState& state = m_states[i];
+        state.target = calculateCoefficients(m_bands[i], m_sampleRate);
+
+        if (!ramp) {
+            state.current = state.target;
+            state.rampStepsLeft = 0;
+            continue;
+        }
+
+        const float steps = static_cast<float>(RAMP_STEPS_COUNT);
+        state.step.b0 = (state.target.b0 - state.current.b0) / steps;
+        state.step.b1 = (state.target.b1 - state.current.b1) / steps;
+        state.step.b2 = (state.target.b2 - state.current.b2) / steps;
+        state.step.a1 = (state.target.a1 - state.current.a1) / steps;
+        state.step.a2 = (state.target.a2 - state.current.a2) / steps;
+        state.rampStepsLeft = RAMP_STEPS_COUNT;
+    }
+}
+
+Equaliser::Coefficients Equaliser::calculateCoefficients(const EqualiserBand& band, const unsigned int sampleRate)
+{
+    Coefficients result;
+
+    bool isGainBand = band.type == EqualiserBand::Type::Peak
+                      || band.type == EqualiserBand::Type::LowShelf
+                      || band.type == EqualiserBand::Type::HighShelf;
+
+    //! NOTE The disabled and flat bands are identities, they are skipped while processing
+    if (!band.enabled || (isGainBand && band.gain == 0.f)) {
+        return result;
+    }
+
+    const double frequency = std::clamp<double>(band.frequency, 1.0, MAX_FREQUENCY_RATIO * sampleRate);
+    const double q = std::max(band.q, 0.01f);
+    const double a = std::pow(10.0, band.gain / 40.0);
+    const double w0 = 2.0 * M_PI * frequency / sampleRate;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double shelfAlpha = 2.0 * std::sqrt(a) * alpha;
+
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0, a0 = 1.0, a1 = 0.0, a2 = 0.0;
+
+    switch (band.type) {
+    case EqualiserBand::Type::Peak:
+        b0 = 1.0 + alpha * a;
+        b1 = -2.0 * cosW0;
+        b2 = 1.0 - alpha * a;
+        a0 = 1.0 + alpha / a;
+        a1 = -2.0 * cosW0;
+        a2 = 1.0 - alpha / a;
+        break;
+    case EqualiserBand::Type::LowShelf:
+        b0 = a * ((a + 1.0) - (a - 1.0) * cosW0 + shelfAlpha);
+        b1 = 2.0 * a * ((a - 1.0) - (a + 1.0) * cosW0);
+        b2 = a * ((a + 1.0) - (a - 1.0) * cosW0 - shelfAlpha);
+        a0 = (a + 1.0) + (a - 1.0) * cosW0 + shelfAlpha;
+        a1 = -2.0 * ((a - 1.0) + (a + 1.0) * cosW0);
+        a2 = (a + 1.0) + (a - 1.0) * cosW0 - shelfAlpha;
+        break;
+    case EqualiserBand::Type::HighShelf:
+        b0 = a * ((a + 1.0) + (a - 1.0) * cosW0 + shelfAlpha);
+        b1 = -2.0 * a * ((a - 1.0) + (a + 1.0) * cosW0);
+        b2 = a * ((a + 1.0) + (a - 1.0) * cosW0 - shelfAlpha);
+        a0 = (a + 1.0) - (a - 1.0) * cosW0 + shelfAlpha;
+        a1 = 2.0 * ((a - 1.0) - (a + 1.0) * cosW0);
+        a2 = (a + 1.0) - (a - 1.0) * cosW0 - shelfAlpha;
+        break;
+    case EqualiserBand::Type::LowPass:
+        b0 = (1.0 - cosW0) / 2.0;
+        b1 = 1.0 - cosW0;
+        b2 = (1.0 - cosW0) / 2.0;
+        a0 = 1.0 + alpha;
+        a1 = -2.0 * cosW0;
+        a2 = 1.0 - alpha;
+        break;
+    case EqualiserBand::Type::HighPass:
+        b0 = (1.0 + cosW0) / 2.0;
+        b1 = -(1.0 + cosW0);
+        b2 = (1.0 + cosW0) / 2.0;
+        a0 = 1.0 + alpha;
+        a1 = -2.0 * cosW0;
+        a2 = 1.0 - alpha;
+        break;
+    }
+
+    //! NOTE Normalised once here, so there is no division per sample
+    result.b0 = static_cast<float>(b0 / a0);
+    result.b1 = static_cast<float>(b1 / a0);
+    result.b2 = static_cast<float>(b2 / a0);
+    result.a1 = static_cast<float>(a1 / a0);
+    result.a2 = static_cast<float>(a2 / a0);
+
+    return result;
+}
+
+void Equaliser::advanceRamp(BandState& state) const
+{
+    if (state.rampStepsLeft == 0) {
+        return;
+    }
+
+    --state.rampStepsLeft;
+
+    if (state.rampStepsLeft == 0) {
+        state.current = state.target;
+
+        //! NOTE The band is skipped from now on, so its history must not be applied when it's enabled again
+        if (state.current.isIdentity()) {
+            std::fill(state.z1.begin(), state.z1.end(), 0.f);
+            std::fill(state.z2.begin(), state.z2.end(), 0.f);
+        }
+        return;
+    }
+
+    state.current.b0 += state.step.b0;
+    state.current.b1 += state.step.b1;
+    state.current.b2 += state.step.b2;
+    state.current.a1 += state.step.a1;
+    state.current.a2 += state.step.a2;
+}
+
+void Equaliser::process(float* buffer, unsigned int sampleCount)
+{
+    if (!m_sampleRate || m_states.empty() || m_audioChannelsCount == 0) {
+        return;
+    }
+
+    for (samples_t frame = 0; frame < sampleCount; frame += RAMP_BLOCK_SIZE) {
+        const samples_t framesCount = std::min<samples_t>(RAMP_BLOCK_SIZE, sampleCount - frame);
+        float* block = buffer + frame * m_audioChannelsCount;
+
+        bool isDeinterleaved = false;
+
+        for (BandState& state : m_states) {
+            if (state.rampStepsLeft == 0 && state.current.isIdentity()) {
+                continue;
+            }
+
+            //! NOTE The mono block is contiguous already
+            if (m_audioChannelsCount == 1) {
+                processBand(state, 0, block, framesCount);
+                advanceRamp(state);
+                continue;
+            }
+
+            if (!isDeinterleaved) {
+                deinterleave(block, framesCount);
+                isDeinterleaved = true;
+            }
+
+            for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
+                processBand(state, audioChNum, m_channelsBlocks.data() + audioChNum * RAMP_BLOCK_SIZE, framesCount);
+            }
+
+            advanceRamp(state);
+        }
+
+        if (isDeinterleaved) {
+            interleave(block, framesCount);
+        }
+    }
+}
+
+void Equaliser::deinterleave(const float* buffer, const samples_t framesCount)
+{
+    for (samples_t frame = 0; frame < framesCount; ++frame) {
+        for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
+            m_channelsBlocks[audioChNum * RAMP_BLOCK_SIZE + frame] = buffer[frame * m_audioChannelsCount + audioChNum];
+        }
+    }
+}
+
+void Equaliser::interleave(float* buffer, const samples_t framesCount) const
+{
+    for (samples_t frame = 0; frame < framesCount; ++frame) {
+        for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
+            buffer[frame * m_audioChannelsCount + audioChNum] = m_channelsBlocks[audioChNum * RAMP_BLOCK_SIZE + frame];
+        }
+    }
+}
+
+void Equaliser::processBand(BandState& state, const audioch_t audioChNum, float* samples, const samples_t framesCount)
+{
+    const Coefficients& c = state.current;
+
+    float z1 = state.z1[audioChNum];
+    float z2 = state.z2[audioChNum];
+
+    for (samples_t frame = 0; frame < framesCount; ++frame) {
+        const float x = samples[frame];
+        const float y = c.b0 * x + z1;
+
+        z1 = c.b1 * x - c.a1 * y + z2;
+        z2 = c.b2 * x - c.a2 * y;
+
+        samples[frame] = y;
+    }
+
+    state.z1[audioChNum] = z1;
+    state.z2[audioChNum] = z2;
+}
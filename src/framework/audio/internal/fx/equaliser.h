@@ -0,0 +1,133 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_EQUALISER_H
+#define MU_AUDIO_EQUALISER_H
+
+#include <vector>
+
+#include "ifxprocessor.h"
+
+namespace mu::audio::fx {
+static const AudioResourceId EQUALISER_ID = "Equaliser";
+
+//! NOTE The gains (dB) of the default bands in AudioFxParams::values
+static const std::string EQUALISER_LOW_GAIN = "lowGain";
+static const std::string EQUALISER_MID_GAIN = "midGain";
+static const std::string EQUALISER_HIGH_GAIN = "highGain";
+
+struct EqualiserBand {
+    enum class Type {
+        Peak,
+        LowShelf,
+        HighShelf,
+        LowPass,
+        HighPass
+    };
+
+    Type type = Type::Peak;
+    float frequency = 1'000.f;
+    volume_db_t gain = 0.f;
+    float q = 0.707f;
+    bool enabled = true;
+
+    bool operator==(const EqualiserBand& other) const
+    {
+        return type == other.type
+               && frequency == other.frequency
+               && gain == other.gain
+               && q == other.q
+               && enabled == other.enabled;
+    }
+};
+
+using EqualiserBandList = std::vector<EqualiserBand>;
+
+//! NOTE Multi-band equaliser: a cascade of normalised biquads (transposed direct form II).
+//! The interleaved buffer is split into the per-channel blocks, so each band filters contiguous samples
+//! with its history kept in registers. The coefficient changes are ramped to avoid zipper noise
+class Equaliser : public IFxProcessor
+{
+public:
+    explicit Equaliser(const audioch_t audioChannelsCount);
+
+    //! NOTE The coefficients of the RBJ Audio EQ Cookbook, normalised by a0
+    struct Coefficients {
+        float b0 = 1.f;
+        float b1 = 0.f;
+        float b2 = 0.f;
+        float a1 = 0.f;
+        float a2 = 0.f;
+
+        bool isIdentity() const;
+    };
+
+    static EqualiserBandList defaultBands();
+    static Coefficients calculateCoefficients(const EqualiserBand& band, const unsigned int sampleRate);
+
+    AudioFxType type() const override;
+    AudioResourceId resourceId() const override;
+    void setSampleRate(unsigned int sampleRate) override;
+
+    bool active() const override;
+    void setActive(bool active) override;
+
+    const EqualiserBandList& bands() const;
+    void setBands(const EqualiserBandList& bands);
+
+    //! NOTE Sets up the default bands with the gains of the values, the missing ones are flat
+    void setValues(const AudioFxValues& values);
+
+    void process(float* buffer, unsigned int sampleCount) override;
+
+private:
+    struct BandState {
+        Coefficients current;
+        Coefficients target;
+        Coefficients step;
+        samples_t rampStepsLeft = 0;
+
+        //! the filter history, one value per audio channel
+        std::vector<float> z1;
+        std::vector<float> z2;
+    };
+
+    void updateTargets(const bool ramp);
+    void advanceRamp(BandState& state) const;
+
+    void deinterleave(const float* buffer, const samples_t framesCount);
+    void interleave(float* buffer, const samples_t framesCount) const;
+    static void processBand(BandState& state, const audioch_t audioChNum, float* samples, const samples_t framesCount);
+
+    audioch_t m_audioChannelsCount = 0;
+    unsigned int m_sampleRate = 0;
+    bool m_active = true;
+
+    EqualiserBandList m_bands;
+    std::vector<BandState> m_states;
+
+    //! the block of each audio channel, one after another
+    std::vector<float> m_channelsBlocks;
+};
+}
+
+#endif // MU_AUDIO_EQUALISER_H
@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "musefxresolver.h"
+
+#include "log.h"
+
+#include "equaliser.h"
+
+using namespace mu::audio;
+using namespace mu::audio::fx;
+
+static const AudioResourceVendor MUSE_VENDOR = "MuseScore";
+
+MuseFxResolver::MuseFxResolver(const audioch_t audioChannelsCount)
+    : m_audioChannelsCount(audioChannelsCount)
+{
+}
+
+std::vector<IFxProcessorPtr> MuseFxResolver::resolveFxList(const TrackId trackId, const std::vector<AudioFxParams>& fxParams)
+{
+    return updateFxMap(m_tracksFxMap[trackId], fxParams);
+}
+
+std::vector<IFxProcessorPtr> MuseFxResolver::resolveMasterFxList(const std::vector<AudioFxParams>& fxParams)
+{
+    return updateFxMap(m_masterFxMap, fxParams);
+}
+
+AudioResourceMetaList MuseFxResolver::resolveResources() const
+{
+    AudioResourceMeta equaliserMeta;
+    equaliserMeta.id = EQUALISER_ID;
+    equaliserMeta.type = AudioResourceType::MusePlugin;
+    equaliserMeta.vendor = MUSE_VENDOR;
+    equaliserMeta.hasNativeEditorSupport = false;
+
+    return { equaliserMeta };
+}
+
+void MuseFxResolver::refresh()
+{
+}
+
+IFxProcessorPtr MuseFxResolver::createFx(const AudioResourceId& resourceId) const
+{
+    if (resourceId == EQUALISER_ID) {
+        return std::make_shared<Equaliser>(m_audioChannelsCount);
+    }
+
+    LOGE() << "unknown fx: " << resourceId;
+    return nullptr;
+}
+
+std::vector<IFxProcessorPtr> MuseFxResolver::updateFxMap(FxMap& fxMap, const std::vector<AudioFxParams>& fxParams) const
+{
+    //! NOTE The existing processors are kept, so their state (and the settings) survive the params update
+    FxMap updatedMap;
+    std::vector<IFxProcessorPtr> result;
+
+    for (const AudioFxParams& params : fxParams) {
+        const AudioResourceId& resourceId = params.resourceMeta.id;
+
+        IFxProcessorPtr fx;
+        auto it = fxMap.find(resourceId);
+        if (it != fxMap.end()) {
+            fx = it->second;
+        } else {
+            fx = createFx(resourceId);
+        }
+
+        if (!fx) {
+            continue;
+        }
+
+        fx->setActive(params.active);
+
+        if (resourceId == EQUALISER_ID) {
+            std::static_pointer_cast<Equaliser>(fx)->setValues(params.values);
+        }
+
+        updatedMap.insert_or_assign(resourceId, fx);
+        result.push_back(std::move(fx));
+    }
+
+    fxMap = std::move(updatedMap);
+
+    return result;
+}
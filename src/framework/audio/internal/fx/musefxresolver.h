@@ -0,0 +1,56 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_MUSEFXRESOLVER_H
+#define MU_AUDIO_MUSEFXRESOLVER_H
+
+#include <map>
+#include <unordered_map>
+
+#include "ifxresolver.h"
+
+namespace mu::audio::fx {
+//! NOTE Resolves the fx processors which are built into the application
+class MuseFxResolver : public IFxResolver::IResolver
+{
+public:
+    explicit MuseFxResolver(const audioch_t audioChannelsCount);
+
+    std::vector<IFxProcessorPtr> resolveFxList(const TrackId trackId, const std::vector<AudioFxParams>& fxParams) override;
+    std::vector<IFxProcessorPtr> resolveMasterFxList(const std::vector<AudioFxParams>& fxParams) override;
+    AudioResourceMetaList resolveResources() const override;
+    void refresh() override;
+
+private:
+    using FxMap = std::unordered_map<AudioResourceId, IFxProcessorPtr>;
+
+    IFxProcessorPtr createFx(const AudioResourceId& resourceId) const;
+    std::vector<IFxProcessorPtr> updateFxMap(FxMap& fxMap, const std::vector<AudioFxParams>& fxParams) const;
+
+    audioch_t m_audioChannelsCount = 0;
+
+    std::map<TrackId, FxMap> m_tracksFxMap;
+    FxMap m_masterFxMap;
+};
+}
+
+#endif // MU_AUDIO_MUSEFXRESOLVER_H
@@ -36,6 +36,16 @@ public:
 
     virtual void pop(float* dest, size_t sampleCount) = 0;
     virtual void setMinSampleLag(size_t lag) = 0;
+
+    struct Stats
+    {
+        samples_t filledSamples = 0;  // samples per channel left in the buffer before the latest forward
+        samples_t targetSamples = 0;  // samples per channel the forward fills the buffer up to
+        uint64_t underrunsCount = 0;  // pops which took more samples than the buffer had
+    };
+
+    //! NOTE Doesn't lock, can be called while the buffer is being forwarded
+    virtual Stats stats() const = 0;
 };
 
 using IAudioBufferPtr = std::shared_ptr<IAudioBuffer>;
@@ -0,0 +1,300 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "offlinerenderer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "log.h"
+#include "runtime.h"
+
+#include "audioerrors.h"
+#include "internal/audiosanitizer.h"
+#include "internal/audiomathutils.h"
+#include "internal/trackeventsprovider.h"
+#include "internal/synthesizers/synthresolver.h"
+#include "internal/synthesizers/fluidsynth/fluidresolver.h"
+#include "internal/worker/midiaudiosource.h"
+#include "internal/worker/mixer.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+using namespace mu::midi;
+
+//! NOTE 10 ms per block keeps the msecs passed to the midi sources exact
+static constexpr unsigned int BLOCKS_PER_SECOND = 100;
+
+//! NOTE Bounds the memory used by the blocks which are rendered, but not consumed yet
+static constexpr size_t MAX_QUEUED_BLOCKS = 32;
+
+namespace mu::audio {
+struct RenderedBlock {
+    std::vector<float> buffer;
+    samples_t samplesPerChannel = 0;
+};
+
+//! NOTE Hands the blocks over from the render thread to the caller's thread
+class RenderedBlocksQueue
+{
+public:
+    RenderedBlocksQueue(const size_t blocksCount, const size_t blockBufferSize)
+        : m_blocks(blocksCount)
+    {
+        for (RenderedBlock& block : m_blocks) {
+            block.buffer.resize(blockBufferSize, 0.f);
+            m_freeBlocks.push_back(&block);
+        }
+    }
+
+    RenderedBlock* acquireFree()
+    {
+        std::unique_lock lock(m_mutex);
+        m_condition.wait(lock, [this]() { return m_cancelled || !m_freeBlocks.empty(); });
+
+        if (m_cancelled) {
+            return nullptr;
+        }
+
+        RenderedBlock* block = m_freeBlocks.front();
+        m_freeBlocks.pop_front();
+        return block;
+    }
+
+    void pushReady(RenderedBlock* block)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_readyBlocks.push_back(block);
+        }
+        m_condition.notify_all();
+    }
+
+    RenderedBlock* popReady()
+    {
+        std::unique_lock lock(m_mutex);
+        m_condition.wait(lock, [this]() { return m_finished || !m_readyBlocks.empty(); });
+
+        if (m_readyBlocks.empty()) {
+            return nullptr;
+        }
+
+        RenderedBlock* block = m_readyBlocks.front();
+        m_readyBlocks.pop_front();
+        return block;
+    }
+
+    void release(RenderedBlock* block)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_freeBlocks.push_back(block);
+        }
+        m_condition.notify_all();
+    }
+
+    void finish()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_finished = true;
+        }
+        m_condition.notify_all();
+    }
+
+    void cancel()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_cancelled = true;
+        }
+        m_condition.notify_all();
+    }
+
+private:
+    std::vector<RenderedBlock> m_blocks;
+    std::deque<RenderedBlock*> m_freeBlocks;
+    std::deque<RenderedBlock*> m_readyBlocks;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_finished = false;
+    bool m_cancelled = false;
+};
+}
+
+Ret OfflineRenderer::render(const TrackList& tracks, const Spec& spec, const BlockConsumer& consumer, const ProgressHandler& progress)
+{
+    IF_ASSERT_FAILED(consumer && spec.sampleRate >= BLOCKS_PER_SECOND && spec.audioChannelsCount > 0
+                     && spec.audioChannelsCount <= MAX_SUPPORTED_AUDIO_CHANNELS) {
+        return make_ret(Err::EngineInvalidParameter);
+    }
+
+    msecs_t totalMsecs = 0;
+    for (const Track& track : tracks) {
+        if (!track.mapping.isValid()) {
+            return make_ret(Err::InvalidMidiMapping);
+        }
+
+        totalMsecs = std::max(totalMsecs, tickToMsecs(track.mapping, track.lastTick));
+    }
+
+    if (totalMsecs == 0) {
+        return make_ret(Err::NothingToRender);
+    }
+
+    totalMsecs += spec.tailMsecs;
+
+    std::atomic<bool> aborted = false;
+    {
+        std::lock_guard lock(m_activeRendersMutex);
+        m_activeRenders.insert(&aborted);
+    }
+
+    samples_t blockSize = spec.sampleRate / BLOCKS_PER_SECOND;
+    samples_t totalSamples = totalMsecs * spec.sampleRate / 1000;
+
+    RenderedBlocksQueue queue(MAX_QUEUED_BLOCKS, blockSize * spec.audioChannelsCount);
+
+    Ret renderRet = make_ret(Ret::Code::Ok);
+    std::thread renderThread([this, &tracks, &spec, totalSamples, &aborted, &queue, &renderRet]() {
+        renderRet = renderTracks(tracks, spec, totalSamples, aborted, queue);
+        queue.finish();
+    });
+
+    Ret consumeRet = make_ret(Ret::Code::Ok);
+    samples_t consumedSamples = 0;
+
+    while (RenderedBlock* block = queue.popReady()) {
+        if (consumeRet && !aborted) {
+            consumeRet = consumer(block->buffer.data(), block->samplesPerChannel);
+            consumedSamples += block->samplesPerChannel;
+
+            if (progress) {
+                progress(consumedSamples * 1000 / spec.sampleRate, totalMsecs);
+            }
+        }
+
+        if (!consumeRet || aborted) {
+            queue.cancel();
+        }
+
+        queue.release(block);
+    }
+
+    renderThread.join();
+
+    {
+        std::lock_guard lock(m_activeRendersMutex);
+        m_activeRenders.erase(&aborted);
+    }
+
+    if (aborted) {
+        return make_ret(Ret::Code::Cancel);
+    }
+
+    if (!consumeRet) {
+        return consumeRet;
+    }
+
+    return renderRet;
+}
+
+void OfflineRenderer::abort()
+{
+    std::lock_guard lock(m_activeRendersMutex);
+    for (std::atomic<bool>* aborted : m_activeRenders) {
+        *aborted = true;
+    }
+}
+
+Ret OfflineRenderer::renderTracks(const TrackList& tracks, const Spec& spec, const samples_t totalSamples,
+                                  const std::atomic<bool>& aborted, RenderedBlocksQueue& queue)
+{
+    runtime::setThreadName("audio_offline_render");
+    AudioSanitizer::setupOfflineRenderThread();
+    ONLY_AUDIO_WORKER_THREAD;
+
+    //! NOTE The graph is private to this render, so it doesn't interfere with the playback
+    //! and works in the modes where the audio worker isn't started (e.g. converter)
+    auto fluidResolver = std::make_shared<FluidResolver>(configuration()->soundFontDirectories(), async::Channel<io::paths>());
+    auto synthResolver = std::make_shared<SynthResolver>();
+    synthResolver->registerResolver(AudioSourceType::Fluid, fluidResolver);
+    synthResolver->init(configuration()->defaultAudioInputParams());
+
+    if (synthResolver->resolveAvailableResources().empty()) {
+        return make_ret(Err::NoLoadedSoundFonts);
+    }
+
+    std::vector<std::unique_ptr<TrackEventsProvider> > providers;
+    providers.reserve(tracks.size());
+
+    auto mixer = std::make_shared<Mixer>();
+    mixer->setAudioChannelsCount(spec.audioChannelsCount);
+    mixer->setSampleRate(spec.sampleRate);
+    mixer->setMaxSourceSampleRate(configuration()->maxSourceSampleRate());
+
+    //! NOTE Processed serially: the events requests sent from the render pool threads would be queued
+    //! to this thread, which doesn't process the queued events, so those tracks would stay silent
+    mixer->setRenderWorkersCount(0);
+
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        const TrackId trackId = static_cast<TrackId>(i);
+        providers.push_back(std::make_unique<TrackEventsProvider>(tracks[i]));
+
+        auto source = std::make_shared<MidiAudioSource>(trackId, providers.back()->midiData());
+        source->setsynthResolver(synthResolver);
+        source->setMidiOutputEnabled(false);
+
+        Ret ret = mixer->addChannel(trackId, source).ret;
+        if (!ret) {
+            return ret;
+        }
+
+        AudioInputParams inputParams;
+        source->applyInputParams(synthResolver->resolveDefaultInputParams(), inputParams);
+        source->setIsActive(true);
+    }
+
+    samples_t blockSize = spec.sampleRate / BLOCKS_PER_SECOND;
+    samples_t renderedSamples = 0;
+
+    while (renderedSamples < totalSamples && !aborted) {
+        RenderedBlock* block = queue.acquireFree();
+        if (!block) {
+            break;
+        }
+
+        samples_t samplesPerChannel = std::min(blockSize, totalSamples - renderedSamples);
+        mixer->process(block->buffer.data(), static_cast<unsigned int>(samplesPerChannel));
+
+        block->samplesPerChannel = samplesPerChannel;
+        queue.pushReady(block);
+
+        renderedSamples += samplesPerChannel;
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
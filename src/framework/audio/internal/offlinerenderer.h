@@ -0,0 +1,54 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_OFFLINERENDERER_H
+#define MU_AUDIO_OFFLINERENDERER_H
+
+#include <atomic>
+#include <mutex>
+#include <set>
+
+#include "modularity/ioc.h"
+#include "iofflinerenderer.h"
+#include "iaudioconfiguration.h"
+
+namespace mu::audio {
+class RenderedBlocksQueue;
+class OfflineRenderer : public IOfflineRenderer
+{
+    INJECT(audio, IAudioConfiguration, configuration)
+
+public:
+    Ret render(const TrackList& tracks, const Spec& spec, const BlockConsumer& consumer,
+               const ProgressHandler& progress = nullptr) override;
+    void abort() override;
+
+private:
+    Ret renderTracks(const TrackList& tracks, const Spec& spec, const samples_t totalSamples, const std::atomic<bool>& aborted,
+                     RenderedBlocksQueue& queue);
+
+    //! NOTE The renders may run concurrently (e.g. the converter jobs), each one has its own abort flag
+    std::set<std::atomic<bool>*> m_activeRenders;
+    std::mutex m_activeRendersMutex;
+};
+}
+
+#endif // MU_AUDIO_OFFLINERENDERER_H
@@ -24,11 +24,20 @@
 #define ALSA_PCM_NEW_HW_PARAMS_API
 #include <alsa/asoundlib.h>
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <string.h>
 #include <math.h>
 #include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 
 #include "log.h"
 #include "runtime.h"
@@ -36,42 +45,195 @@
 using namespace mu::audio;
 
 namespace  {
+static constexpr unsigned int DEFAULT_PERIODS_COUNT = 2;
+
+//! NOTE Below the priorities of the system audio servers (e.g. jackd uses 70-80)
+static constexpr int REALTIME_PRIORITY = 60;
+
+//! NOTE Touched at the thread start, so the stack pages don't fault in the middle of the processing
+static constexpr size_t PREFAULT_STACK_SIZE = 64 * 1024;
+
+static constexpr int WAIT_TIMEOUT_MSECS = 1000;
+
 struct ALSAData
 {
-    float* buffer;
-    snd_pcm_t* alsaDeviceHandle;
-    int samples;
-    int channels;
-    bool audioProcessingDone;
-    pthread_t threadHandle;
+    snd_pcm_t* alsaDeviceHandle = nullptr;
+    bool mmapAccess = false;
+
+    //! NOTE Used only for the read/write access, in the mmap mode the callback writes to the device buffer
+    std::vector<float> buffer;
+
+    snd_pcm_uframes_t periodSize = 0;
+    snd_pcm_uframes_t bufferSize = 0;
+    int channels = 0;
+
+    std::atomic<bool> audioProcessingDone = false;
+    pthread_t threadHandle = 0;
+    bool threadStarted = false;
+
     IAudioDriver::Callback callback;
-    void* userdata;
+    void* userdata = nullptr;
+
+    std::atomic<uint64_t> xrunsCount = 0;
+    std::atomic<uint32_t> latencyFrames = 0;
 };
 
 static ALSAData* _alsaData{ nullptr };
 
+//! NOTE Guards the lifetime of _alsaData, stats() is called from other threads than open() and close()
+static std::mutex _alsaDataMutex;
+
+static void prefaultStack()
+{
+    char stack[PREFAULT_STACK_SIZE];
+    volatile char* page = stack;
+    for (size_t i = 0; i < PREFAULT_STACK_SIZE; i += 1024) {
+        page[i] = 0;
+    }
+}
+
+//! NOTE Needs the rtprio limit (e.g. the "audio" group in limits.conf) or CAP_SYS_NICE,
+//! otherwise the thread keeps the default priority
+static void setupRealtimePriority()
+{
+    int priority = std::min(REALTIME_PRIORITY, sched_get_priority_max(SCHED_FIFO));
+
+    rlimit limit;
+    if (getrlimit(RLIMIT_RTPRIO, &limit) == 0 && limit.rlim_cur < static_cast<rlim_t>(priority)) {
+        limit.rlim_cur = std::min(limit.rlim_max, static_cast<rlim_t>(priority));
+        setrlimit(RLIMIT_RTPRIO, &limit);
+    }
+
+    sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+
+    int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (ret != 0) {
+        LOGW() << "failed to set the realtime priority: " << strerror(ret);
+        return;
+    }
+
+    LOGI() << "realtime priority: " << priority;
+}
+
+//! NOTE Returns false when the device can't be recovered
+static bool recoverFromError(ALSAData* data, int error)
+{
+    if (error == -EPIPE) {
+        data->xrunsCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int ret = snd_pcm_recover(data->alsaDeviceHandle, error, 1 /*silent*/);
+    if (ret < 0) {
+        LOGE() << "unable to recover the device: " << snd_strerror(ret);
+        return false;
+    }
+
+    return true;
+}
+
+static void updateLatency(ALSAData* data)
+{
+    snd_pcm_sframes_t delay = 0;
+    if (snd_pcm_delay(data->alsaDeviceHandle, &delay) == 0 && delay >= 0) {
+        data->latencyFrames.store(static_cast<uint32_t>(delay), std::memory_order_relaxed);
+    }
+}
+
+static int writeMmap(ALSAData* data, snd_pcm_uframes_t frames)
+{
+    while (frames > 0) {
+        const snd_pcm_channel_area_t* areas = nullptr;
+        snd_pcm_uframes_t offset = 0;
+        snd_pcm_uframes_t chunk = frames;
+
+        int ret = snd_pcm_mmap_begin(data->alsaDeviceHandle, &areas, &offset, &chunk);
+        if (ret < 0) {
+            return ret;
+        }
+
+        //! NOTE The channels are interleaved, so all the areas point to the same memory
+        uint8_t* stream = static_cast<uint8_t*>(areas[0].addr) + (areas[0].first + offset * areas[0].step) / 8;
+        data->callback(data->userdata, stream, static_cast<int>(chunk * data->channels * sizeof(float)));
+
+        snd_pcm_sframes_t committed = snd_pcm_mmap_commit(data->alsaDeviceHandle, offset, chunk);
+        if (committed < 0) {
+            return static_cast<int>(committed);
+        }
+
+        if (static_cast<snd_pcm_uframes_t>(committed) != chunk) {
+            return -EPIPE;
+        }
+
+        frames -= chunk;
+    }
+
+    return 0;
+}
+
+static int writeInterleaved(ALSAData* data, snd_pcm_uframes_t frames)
+{
+    data->callback(data->userdata, reinterpret_cast<uint8_t*>(data->buffer.data()),
+                   static_cast<int>(frames * data->channels * sizeof(float)));
+
+    const float* samples = data->buffer.data();
+    while (frames > 0) {
+        snd_pcm_sframes_t written = snd_pcm_writei(data->alsaDeviceHandle, samples, frames);
+        if (written < 0) {
+            return static_cast<int>(written);
+        }
+
+        samples += written * data->channels;
+        frames -= written;
+    }
+
+    return 0;
+}
+
 static void* alsaThread(void* aParam)
 {
     mu::runtime::setThreadName("audio_driver");
     ALSAData* data = static_cast<ALSAData*>(aParam);
 
-    int ret = snd_pcm_wait(data->alsaDeviceHandle, 1000);
-    IF_ASSERT_FAILED(ret > 0) {
-        return nullptr;
-    }
+    setupRealtimePriority();
+    prefaultStack();
+
+    snd_pcm_t* handle = data->alsaDeviceHandle;
 
     while (!data->audioProcessingDone)
     {
-        uint8_t* stream = (uint8_t*)data->buffer;
-        int len = data->samples * data->channels * sizeof(float);
+        snd_pcm_sframes_t avail = snd_pcm_avail_update(handle);
+        if (avail < 0) {
+            if (!recoverFromError(data, static_cast<int>(avail))) {
+                break;
+            }
+            continue;
+        }
 
-        data->callback(data->userdata, stream, len);
+        if (static_cast<snd_pcm_uframes_t>(avail) < data->periodSize) {
+            //! NOTE The device buffer is full, the playback starts once it's filled up for the first time
+            if (snd_pcm_state(handle) == SND_PCM_STATE_PREPARED) {
+                int ret = snd_pcm_start(handle);
+                if (ret < 0 && !recoverFromError(data, ret)) {
+                    break;
+                }
+                continue;
+            }
+
+            int ret = snd_pcm_wait(handle, WAIT_TIMEOUT_MSECS);
+            if (ret < 0 && !recoverFromError(data, ret)) {
+                break;
+            }
+            continue;
+        }
 
-        snd_pcm_sframes_t pcm = snd_pcm_writei(data->alsaDeviceHandle, data->buffer, data->samples);
-        if (pcm != -EPIPE) {
-        } else {
-            snd_pcm_prepare(data->alsaDeviceHandle);
+        int ret = data->mmapAccess ? writeMmap(data, data->periodSize) : writeInterleaved(data, data->periodSize);
+        if (ret < 0 && !recoverFromError(data, ret)) {
+            break;
         }
+
+        updateLatency(data);
     }
 
     LOGI() << "exit";
@@ -85,19 +247,120 @@ static void alsaCleanup()
     }
 
     _alsaData->audioProcessingDone = true;
-    if (_alsaData->threadHandle) {
+    if (_alsaData->threadStarted) {
         pthread_join(_alsaData->threadHandle, nullptr);
     }
-    snd_pcm_drain(_alsaData->alsaDeviceHandle);
-    snd_pcm_close(_alsaData->alsaDeviceHandle);
 
-    if (nullptr != _alsaData->buffer) {
-        delete[] _alsaData->buffer;
+    if (_alsaData->alsaDeviceHandle) {
+        snd_pcm_drop(_alsaData->alsaDeviceHandle);
+        snd_pcm_close(_alsaData->alsaDeviceHandle);
     }
 
+    if (!_alsaData->buffer.empty()) {
+        munlock(_alsaData->buffer.data(), _alsaData->buffer.size() * sizeof(float));
+    }
+
+    std::lock_guard<std::mutex> lock(_alsaDataMutex);
     delete _alsaData;
     _alsaData = nullptr;
 }
+
+static bool setupHwParams(ALSAData* data, const IAudioDriver::Spec& spec, unsigned int* sampleRate)
+{
+    snd_pcm_t* handle = data->alsaDeviceHandle;
+
+    snd_pcm_hw_params_t* params;
+    snd_pcm_hw_params_alloca(&params);
+    snd_pcm_hw_params_any(handle, params);
+
+    //! NOTE The mmap access saves a copy of every buffer, not all the devices (plugins) support it
+    data->mmapAccess = snd_pcm_hw_params_set_access(handle, params, SND_PCM_ACCESS_MMAP_INTERLEAVED) == 0;
+    if (!data->mmapAccess) {
+        int rc = snd_pcm_hw_params_set_access(handle, params, SND_PCM_ACCESS_RW_INTERLEAVED);
+        if (rc < 0) {
+            LOGE() << "unable to set the access: " << snd_strerror(rc);
+            return false;
+        }
+    }
+
+    int rc = snd_pcm_hw_params_set_format(handle, params, SND_PCM_FORMAT_FLOAT_LE);
+    if (rc < 0) {
+        LOGE() << "unable to set the format: " << snd_strerror(rc);
+        return false;
+    }
+
+    rc = snd_pcm_hw_params_set_channels(handle, params, spec.channels);
+    if (rc < 0) {
+        LOGE() << "unable to set the channels count: " << snd_strerror(rc);
+        return false;
+    }
+
+    unsigned int rate = spec.sampleRate;
+    int dir = 0;
+    rc = snd_pcm_hw_params_set_rate_near(handle, params, &rate, &dir);
+    if (rc < 0) {
+        LOGE() << "unable to set the sample rate: " << snd_strerror(rc);
+        return false;
+    }
+
+    //! NOTE The requested size is the whole device buffer (i.e. the latency), it's split into the periods
+    unsigned int periods = spec.periodsCount > 0 ? spec.periodsCount : DEFAULT_PERIODS_COUNT;
+    dir = 0;
+    rc = snd_pcm_hw_params_set_periods_near(handle, params, &periods, &dir);
+    if (rc < 0) {
+        LOGE() << "unable to set the periods count: " << snd_strerror(rc);
+        return false;
+    }
+
+    snd_pcm_uframes_t bufferSize = spec.samples;
+    rc = snd_pcm_hw_params_set_buffer_size_near(handle, params, &bufferSize);
+    if (rc < 0) {
+        LOGE() << "unable to set the buffer size: " << snd_strerror(rc);
+        return false;
+    }
+
+    rc = snd_pcm_hw_params(handle, params);
+    if (rc < 0) {
+        LOGE() << "unable to set the hw params: " << snd_strerror(rc);
+        return false;
+    }
+
+    snd_pcm_hw_params_get_rate(params, &rate, &dir);
+    snd_pcm_hw_params_get_period_size(params, &data->periodSize, &dir);
+    snd_pcm_hw_params_get_buffer_size(params, &data->bufferSize);
+
+    *sampleRate = rate;
+
+    LOGI() << "access: " << (data->mmapAccess ? "mmap" : "read/write")
+           << ", sample rate: " << rate
+           << ", period size: " << data->periodSize
+           << ", buffer size: " << data->bufferSize;
+
+    return true;
+}
+
+static bool setupSwParams(ALSAData* data)
+{
+    snd_pcm_t* handle = data->alsaDeviceHandle;
+
+    snd_pcm_sw_params_t* params;
+    snd_pcm_sw_params_alloca(&params);
+    snd_pcm_sw_params_current(handle, params);
+
+    //! NOTE Wake up once a whole period can be written
+    snd_pcm_sw_params_set_avail_min(handle, params, data->periodSize);
+
+    //! NOTE Started explicitly when the buffer is full
+    snd_pcm_sw_params_set_start_threshold(handle, params, data->bufferSize);
+
+    int rc = snd_pcm_sw_params(handle, params);
+    if (rc < 0) {
+        LOGE() << "unable to set the sw params: " << snd_strerror(rc);
+        return false;
+    }
+
+    return true;
+}
 }
 
 LinuxAudioDriver::LinuxAudioDriver()
@@ -111,63 +374,56 @@ std::string LinuxAudioDriver::name() const
 
 bool LinuxAudioDriver::open(const Spec& spec, Spec* activeSpec)
 {
-    _alsaData = new ALSAData;
-    memset(_alsaData, 0, sizeof(ALSAData));
-    _alsaData->samples = spec.samples;
+    {
+        std::lock_guard<std::mutex> lock(_alsaDataMutex);
+        _alsaData = new ALSAData;
+    }
+
     _alsaData->channels = spec.channels;
     _alsaData->callback = spec.callback;
     _alsaData->userdata = spec.userdata;
 
-    int rc;
-    snd_pcm_t* handle;
-    rc = snd_pcm_open(&handle, "default", SND_PCM_STREAM_PLAYBACK, 0);
+    int rc = snd_pcm_open(&_alsaData->alsaDeviceHandle, "default", SND_PCM_STREAM_PLAYBACK, 0);
     if (rc < 0) {
+        LOGE() << "unable to open the device: " << snd_strerror(rc);
+        _alsaData->alsaDeviceHandle = nullptr;
+        alsaCleanup();
         return false;
     }
 
-    _alsaData->alsaDeviceHandle = handle;
-
-    snd_pcm_hw_params_t* params;
-    snd_pcm_hw_params_alloca(&params);
-    snd_pcm_hw_params_any(handle, params);
-
-    snd_pcm_hw_params_set_access(handle, params, SND_PCM_ACCESS_RW_INTERLEAVED);
-    snd_pcm_hw_params_set_format(handle, params, SND_PCM_FORMAT_FLOAT_LE);
-    snd_pcm_hw_params_set_channels(handle, params, spec.channels);
-    snd_pcm_hw_params_set_buffer_size(handle, params, spec.samples);
-
-    unsigned int aSamplerate = spec.sampleRate;
-    unsigned int val = aSamplerate;
-    int dir = 0;
-    rc = snd_pcm_hw_params_set_rate_near(handle, params, &val, &dir);
-    if (rc < 0) {
+    unsigned int sampleRate = 0;
+    if (!setupHwParams(_alsaData, spec, &sampleRate) || !setupSwParams(_alsaData)) {
+        alsaCleanup();
         return false;
     }
 
-    rc = snd_pcm_hw_params(handle, params);
-    if (rc < 0) {
-        return false;
+    if (!_alsaData->mmapAccess) {
+        //! NOTE Locked and touched, so the audio thread doesn't fault on it
+        _alsaData->buffer.assign(_alsaData->periodSize * _alsaData->channels, 0.f);
+        if (mlock(_alsaData->buffer.data(), _alsaData->buffer.size() * sizeof(float)) != 0) {
+            LOGW() << "unable to lock the buffer: " << strerror(errno);
+        }
     }
 
-    snd_pcm_hw_params_get_rate(params, &val, &dir);
-    aSamplerate = val;
-
-    _alsaData->buffer = new float[_alsaData->samples * _alsaData->channels];
-    //_alsaData->sampleBuffer = new short[_alsaData->samples * _alsaData->channels];
+    _alsaData->latencyFrames = static_cast<uint32_t>(_alsaData->bufferSize);
 
     if (activeSpec) {
         *activeSpec = spec;
         activeSpec->format = Format::AudioF32;
-        activeSpec->sampleRate = aSamplerate;
+        activeSpec->sampleRate = sampleRate;
+        //! NOTE The callback is called for a period
+        activeSpec->samples = static_cast<uint16_t>(_alsaData->periodSize);
+        activeSpec->periodsCount = static_cast<uint8_t>(_alsaData->bufferSize / _alsaData->periodSize);
     }
 
-    _alsaData->threadHandle = 0;
     int ret = pthread_create(&_alsaData->threadHandle, NULL, alsaThread, (void*)_alsaData);
-
     if (0 != ret) {
+        alsaCleanup();
         return false;
     }
 
+    _alsaData->threadStarted = true;
+
     return true;
 }
 
@@ -213,3 +469,18 @@ void LinuxAudioDriver::resume()
 void LinuxAudioDriver::suspend()
 {
 }
+
+IAudioDriver::Stats LinuxAudioDriver::stats() const
+{
+    std::lock_guard<std::mutex> lock(_alsaDataMutex);
+
+    Stats stats;
+    if (!_alsaData) {
+        return stats;
+    }
+
+    stats.xrunsCount = _alsaData->xrunsCount.load(std::memory_order_relaxed);
+    stats.latencyFrames = _alsaData->latencyFrames.load(std::memory_order_relaxed);
+
+    return stats;
+}
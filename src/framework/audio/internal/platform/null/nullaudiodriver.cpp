@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "nullaudiodriver.h"
+
+#include <chrono>
+
+#include "log.h"
+#include "runtime.h"
+
+using namespace mu::audio;
+
+static const std::string NULL_DEVICE_NAME = "null";
+
+//! NOTE How long a suspended driver waits before checking the state again
+static constexpr std::chrono::milliseconds SUSPENDED_POLL_INTERVAL(10);
+
+NullAudioDriver::NullAudioDriver(const Pacing pacing)
+    : m_pacing(pacing)
+{
+}
+
+NullAudioDriver::~NullAudioDriver()
+{
+    if (isOpened()) {
+        close();
+    }
+}
+
+std::string NullAudioDriver::name() const
+{
+    return "MUAUDIO(NULL)";
+}
+
+bool NullAudioDriver::open(const Spec& spec, Spec* activeSpec)
+{
+    IF_ASSERT_FAILED(!isOpened()) {
+        return false;
+    }
+
+    IF_ASSERT_FAILED(spec.callback && spec.sampleRate > 0 && spec.channels > 0 && spec.samples > 0) {
+        return false;
+    }
+
+    m_spec = spec;
+    m_spec.format = Format::AudioF32;
+    m_buffer.assign(static_cast<size_t>(m_spec.samples) * m_spec.channels, 0.f);
+
+    if (activeSpec) {
+        *activeSpec = m_spec;
+    }
+
+    m_xrunsCount = 0;
+    m_callbacksCount = 0;
+    m_suspended = false;
+    m_running = true;
+
+    m_thread = std::make_unique<std::thread>([this]() {
+        run();
+    });
+
+    return true;
+}
+
+void NullAudioDriver::close()
+{
+    m_running = false;
+
+    if (m_thread) {
+        m_thread->join();
+        m_thread = nullptr;
+    }
+}
+
+bool NullAudioDriver::isOpened() const
+{
+    return m_thread != nullptr;
+}
+
+std::string NullAudioDriver::outputDevice() const
+{
+    return NULL_DEVICE_NAME;
+}
+
+bool NullAudioDriver::selectOutputDevice(const std::string& name)
+{
+    return name == NULL_DEVICE_NAME;
+}
+
+std::vector<std::string> NullAudioDriver::availableOutputDevices() const
+{
+    return { NULL_DEVICE_NAME };
+}
+
+mu::async::Notification NullAudioDriver::availableOutputDevicesChanged() const
+{
+    return mu::async::Notification();
+}
+
+void NullAudioDriver::resume()
+{
+    m_suspended = false;
+}
+
+void NullAudioDriver::suspend()
+{
+    m_suspended = true;
+}
+
+IAudioDriver::Stats NullAudioDriver::stats() const
+{
+    Stats stats;
+    stats.xrunsCount = m_xrunsCount;
+    stats.latencyFrames = m_spec.samples;
+
+    return stats;
+}
+
+NullAudioDriver::Pacing NullAudioDriver::pacing() const
+{
+    return m_pacing;
+}
+
+uint64_t NullAudioDriver::callbacksCount() const
+{
+    return m_callbacksCount;
+}
+
+void NullAudioDriver::run()
+{
+    using clock = std::chrono::steady_clock;
+
+    mu::runtime::setThreadName("audio_driver");
+
+    const clock::duration period = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>(static_cast<double>(m_spec.samples) / m_spec.sampleRate));
+
+    uint8_t* stream = reinterpret_cast<uint8_t*>(m_buffer.data());
+    const int len = static_cast<int>(m_buffer.size() * sizeof(float));
+
+    clock::time_point deadline = clock::now() + period;
+
+    while (m_running) {
+        if (m_suspended) {
+            std::this_thread::sleep_for(SUSPENDED_POLL_INTERVAL);
+            deadline = clock::now() + period;
+            continue;
+        }
+
+        m_spec.callback(m_spec.userdata, stream, len);
+        ++m_callbacksCount;
+
+        if (m_pacing == Pacing::FreeRunning) {
+            continue;
+        }
+
+        //! NOTE The device would have played the buffer out by the deadline,
+        //! so a late callback is an underrun. The schedule restarts from now, like after a device recovery
+        clock::time_point now = clock::now();
+        if (now > deadline) {
+            ++m_xrunsCount;
+            deadline = now + period;
+            continue;
+        }
+
+        std::this_thread::sleep_until(deadline);
+        deadline += period;
+    }
+
+    LOGI() << "exit";
+}
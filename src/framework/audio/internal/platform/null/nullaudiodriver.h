@@ -0,0 +1,83 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_NULLAUDIODRIVER_H
+#define MU_AUDIO_NULLAUDIODRIVER_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "iaudiodriver.h"
+
+namespace mu::audio {
+//! NOTE Driver without an audio device: the callback is pulled by its own thread
+//! and the data is dropped. Used to run the audio engine on the machines without a sound card
+class NullAudioDriver : public IAudioDriver
+{
+public:
+    enum class Pacing {
+        Realtime,   // a callback per buffer period, like a device would do
+        FreeRunning // the next callback right after the previous one
+    };
+
+    explicit NullAudioDriver(const Pacing pacing = Pacing::Realtime);
+    ~NullAudioDriver() override;
+
+    std::string name() const override;
+    bool open(const Spec& spec, Spec* activeSpec) override;
+    void close() override;
+    bool isOpened() const override;
+
+    std::string outputDevice() const override;
+    bool selectOutputDevice(const std::string& name) override;
+    std::vector<std::string> availableOutputDevices() const override;
+    async::Notification availableOutputDevicesChanged() const override;
+
+    void resume() override;
+    void suspend() override;
+
+    //! NOTE The xruns are the callbacks which returned after the moment the device would have needed
+    //! the next buffer. Always 0 for the free running pacing
+    Stats stats() const override;
+
+    Pacing pacing() const;
+    uint64_t callbacksCount() const;
+
+private:
+    void run();
+
+    Pacing m_pacing = Pacing::Realtime;
+    Spec m_spec = {};
+
+    std::vector<float> m_buffer;
+    std::unique_ptr<std::thread> m_thread;
+
+    std::atomic<bool> m_running = false;
+    std::atomic<bool> m_suspended = false;
+    std::atomic<uint64_t> m_xrunsCount = 0;
+    std::atomic<uint64_t> m_callbacksCount = 0;
+};
+}
+
+#endif // MU_AUDIO_NULLAUDIODRIVER_H
@@ -300,6 +300,11 @@ void OSXAudioDriver::suspend()
 {
 }
 
+IAudioDriver::Stats OSXAudioDriver::stats() const
+{
+    return Stats();
+}
+
 void OSXAudioDriver::logError(const std::string message, OSStatus error)
 {
     if (error == noErr) {
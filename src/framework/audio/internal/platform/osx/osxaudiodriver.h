@@ -46,6 +46,8 @@ public:
     void resume() override;
     void suspend() override;
 
+    Stats stats() const override;
+
     std::string outputDevice() const override;
     bool selectOutputDevice(const std::string& name) override;
     std::vector<std::string> availableOutputDevices() const override;
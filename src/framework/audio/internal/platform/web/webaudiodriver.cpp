@@ -158,3 +158,8 @@ void WebAudioDriver::suspend()
 {
     web::context.call<val>("suspend");
 }
+
+IAudioDriver::Stats WebAudioDriver::stats() const
+{
+    return Stats();
+}
@@ -289,6 +289,11 @@ void CoreAudioDriver::suspend()
 {
 }
 
+IAudioDriver::Stats CoreAudioDriver::stats() const
+{
+    return Stats();
+}
+
 std::string CoreAudioDriver::outputDevice() const
 {
     NOT_IMPLEMENTED;
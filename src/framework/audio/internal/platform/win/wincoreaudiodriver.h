@@ -44,6 +44,8 @@ public:
     void resume() override;
     void suspend() override;
 
+    Stats stats() const override;
+
 private:
     void clean();
 
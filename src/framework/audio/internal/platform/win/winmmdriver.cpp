@@ -248,3 +248,8 @@ void WinmmDriver::resume()
 void WinmmDriver::suspend()
 {
 }
+
+IAudioDriver::Stats WinmmDriver::stats() const
+{
+    return Stats();
+}
@@ -42,6 +42,8 @@ public:
     async::Notification availableOutputDevicesChanged() const override;
     void resume() override;
     void suspend() override;
+
+    Stats stats() const override;
 };
 }
 }
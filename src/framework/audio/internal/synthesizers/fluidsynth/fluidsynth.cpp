@@ -45,6 +45,17 @@ static const double FLUID_GLOBAL_VOLUME_GAIN{ 1.8 };
 /// @see https://www.fluidsynth.org/api/settings_synth.html
 static const audioch_t FLUID_AUDIO_CHANNELS_PAIR = 1;
 
+//! NOTE The hard limit of an instance, over it Fluid kills the voices itself.
+//! The voices limit set from outside is kept below it
+static const int FLUID_MAX_POLYPHONY = 256;
+
+//! NOTE The release time of a stolen voice in timecents (1200 * log2(seconds)), about 10 ms,
+//! short enough to free the voice quickly and long enough not to click
+static const float STOLEN_VOICE_RELEASE_TIMECENTS = -7973.f;
+
+//! NOTE Full attenuation in centibels, see SF2.01 section 8.1.3
+static const float SILENT_VOICE_ATTENUATION_CB = 1440.f;
+
 struct mu::audio::synth::Fluid {
     fluid_settings_t* settings = nullptr;
     fluid_synth_t* synth = nullptr;
@@ -125,7 +136,7 @@ Ret FluidSynth::init()
     }
 
     //fluid_settings_setint(_fluid->settings, "synth.min-note-length", 50);
-    //fluid_settings_setint(_fluid->settings, "synth.polyphony", conf.polyphony);
+    fluid_settings_setint(m_fluid->settings, "synth.polyphony", FLUID_MAX_POLYPHONY);
 
     fluid_settings_setint(m_fluid->settings, "synth.chorus.active", 0);
 //    fluid_settings_setnum(m_fluid->settings, "synth.chorus.depth", 8);
@@ -153,6 +164,8 @@ Ret FluidSynth::init()
 
     m_fluid->synth = new_fluid_synth(m_fluid->settings);
 
+    m_voices.resize(FLUID_MAX_POLYPHONY, nullptr);
+
     LOGD() << "synth inited\n";
     return true;
 }
@@ -268,6 +281,7 @@ bool FluidSynth::handleEvent(const Event& e)
     int ret = FLUID_OK;
     switch (e.opcode()) {
     case Event::Opcode::NoteOn: {
+        fitVoicesInLimit(1);
         ret = fluid_synth_noteon(m_fluid->synth, e.channel(), e.note(), e.velocity());
     } break;
     case Event::Opcode::NoteOff: {
@@ -303,6 +317,7 @@ void FluidSynth::allSoundsOff()
 
     fluid_synth_all_notes_off(m_fluid->synth, -1);
     fluid_synth_all_sounds_off(m_fluid->synth, -1);
+    m_stolenVoiceIds.clear();
 }
 
 void FluidSynth::flushSound()
@@ -313,12 +328,175 @@ void FluidSynth::flushSound()
 
     fluid_synth_all_notes_off(m_fluid->synth, -1);
     fluid_synth_all_sounds_off(m_fluid->synth, -1);
+    m_stolenVoiceIds.clear();
 
     int size = int(m_sampleRate);
 
     fluid_synth_write_float(m_fluid->synth, size, &m_preallocated[0], 0, 1, &m_preallocated[0], size, 1);
 }
 
+unsigned int FluidSynth::activeVoicesCount() const
+{
+    if (!m_fluid->synth) {
+        return 0;
+    }
+
+    return static_cast<unsigned int>(fluid_synth_get_active_voice_count(m_fluid->synth));
+}
+
+void FluidSynth::setVoicesLimit(unsigned int limit)
+{
+    limit = std::min(limit, static_cast<unsigned int>(FLUID_MAX_POLYPHONY));
+    if (m_voicesLimit == limit) {
+        return;
+    }
+
+    //! NOTE Only the lower limit may require stealing
+    bool isLowered = m_voicesLimit == 0 || (limit != 0 && limit < m_voicesLimit);
+    m_voicesLimit = limit;
+
+    if (isLowered) {
+        fitVoicesInLimit(0);
+    }
+}
+
+unsigned int FluidSynth::stolenVoicesCount() const
+{
+    return m_stolenVoicesCount;
+}
+
+void FluidSynth::fitVoicesInLimit(unsigned int reservedVoicesCount)
+{
+    if (m_voicesLimit == 0 || !m_fluid->synth) {
+        return;
+    }
+
+    //! NOTE The stolen voices are still active while they fade out, they don't count.
+    //! The faded ones are dropped after each block, so the voices list is scanned only when the limit is exceeded
+    unsigned int activeVoicesCount = this->activeVoicesCount();
+    unsigned int playingVoicesCount = activeVoicesCount - std::min(activeVoicesCount, static_cast<unsigned int>(m_stolenVoiceIds.size()));
+
+    if (playingVoicesCount + reservedVoicesCount <= m_voicesLimit) {
+        return;
+    }
+
+    fluid_synth_get_voicelist(m_fluid->synth, m_voices.data(), static_cast<int>(m_voices.size()), -1);
+
+    auto isStolen = [this](unsigned int id) {
+        return std::find(m_stolenVoiceIds.cbegin(), m_stolenVoiceIds.cend(), id) != m_stolenVoiceIds.cend();
+    };
+
+    m_voiceCandidates.clear();
+
+    for (fluid_voice_t* voice : m_voices) {
+        if (!voice) {
+            break;
+        }
+
+        unsigned int id = fluid_voice_get_id(voice);
+        if (isStolen(id)) {
+            continue;
+        }
+
+        VoiceCandidate candidate;
+        candidate.voice = voice;
+        candidate.id = id;
+        candidate.velocity = fluid_voice_get_actual_velocity(voice);
+
+        if (fluid_voice_is_on(voice)) {
+            candidate.importance = VoiceImportance::Held;
+        } else if (fluid_voice_is_sustained(voice) || fluid_voice_is_sostenuto(voice)) {
+            candidate.importance = VoiceImportance::Sustained;
+        } else {
+            candidate.importance = VoiceImportance::Released;
+        }
+
+        m_voiceCandidates.push_back(candidate);
+    }
+
+    size_t requiredVoicesCount = m_voiceCandidates.size() + reservedVoicesCount;
+    if (requiredVoicesCount <= m_voicesLimit) {
+        return;
+    }
+
+    //! NOTE The released voices go first, they are fading out anyway. Then the ones held by the pedal,
+    //! the pedal is usually used to play more voices than fingers, so losing some of them hurts the least.
+    //! Among the voices of the same kind the quietest and then the oldest ones go first
+    std::sort(m_voiceCandidates.begin(), m_voiceCandidates.end(), [](const VoiceCandidate& a, const VoiceCandidate& b) {
+        if (a.importance != b.importance) {
+            return a.importance < b.importance;
+        }
+
+        if (a.velocity != b.velocity) {
+            return a.velocity < b.velocity;
+        }
+
+        return a.id < b.id;
+    });
+
+    size_t voicesToSteal = std::min(requiredVoicesCount - m_voicesLimit, m_voiceCandidates.size());
+    size_t stolenCount = 0;
+
+    for (const VoiceCandidate& candidate : m_voiceCandidates) {
+        if (stolenCount >= voicesToSteal) {
+            break;
+        }
+
+        //! NOTE A note may be played by a few layered voices, they share the id and are stolen together
+        if (isStolen(candidate.id)) {
+            continue;
+        }
+
+        for (const VoiceCandidate& voice : m_voiceCandidates) {
+            if (voice.id != candidate.id) {
+                continue;
+            }
+
+            fluid_voice_gen_set(voice.voice, GEN_VOLENVRELEASE, STOLEN_VOICE_RELEASE_TIMECENTS);
+            fluid_voice_update_param(voice.voice, GEN_VOLENVRELEASE);
+
+            //! NOTE The voice held by the pedal can't be released on its own, it's silenced
+            //! and goes away with the quick release as soon as the pedal is released
+            if (voice.importance == VoiceImportance::Sustained) {
+                fluid_voice_gen_set(voice.voice, GEN_ATTENUATION, SILENT_VOICE_ATTENUATION_CB);
+                fluid_voice_update_param(voice.voice, GEN_ATTENUATION);
+            }
+
+            m_stolenVoiceIds.push_back(candidate.id);
+            ++stolenCount;
+        }
+
+        if (candidate.importance == VoiceImportance::Held) {
+            fluid_synth_stop(m_fluid->synth, candidate.id);
+        }
+    }
+
+    m_stolenVoicesCount += static_cast<unsigned int>(stolenCount);
+}
+
+void FluidSynth::dropFadedStolenVoices()
+{
+    if (m_stolenVoiceIds.empty() || !m_fluid->synth) {
+        return;
+    }
+
+    fluid_synth_get_voicelist(m_fluid->synth, m_voices.data(), static_cast<int>(m_voices.size()), -1);
+
+    m_stolenVoiceIds.erase(std::remove_if(m_stolenVoiceIds.begin(), m_stolenVoiceIds.end(), [this](unsigned int id) {
+        for (fluid_voice_t* voice : m_voices) {
+            if (!voice) {
+                break;
+            }
+
+            if (fluid_voice_get_id(voice) == id) {
+                return false;
+            }
+        }
+
+        return true;
+    }), m_stolenVoiceIds.end());
+}
+
 void FluidSynth::midiChannelSoundsOff(channel_t chan)
 {
     IF_ASSERT_FAILED(m_fluid->synth) {
@@ -403,6 +581,9 @@ unsigned int FluidSynth::audioChannelsCount() const
 void FluidSynth::process(float* buffer, unsigned int sampleCount)
 {
     writeBuf(buffer, sampleCount);
+
+    //! NOTE The stolen voices fade out within a few blocks
+    dropFadedStolenVoices();
 }
 
 async::Channel<unsigned int> FluidSynth::audioChannelsCountChanged() const
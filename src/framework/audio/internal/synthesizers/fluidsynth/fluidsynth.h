@@ -32,6 +32,8 @@
 
 #include "isynthesizer.h"
 
+typedef struct _fluid_voice_t fluid_voice_t;
+
 namespace mu::audio::synth {
 struct Fluid;
 class FluidSynth : public ISynthesizer
@@ -59,6 +61,9 @@ public:
 
     void allSoundsOff() override; // all channels
     void flushSound() override;
+    unsigned int activeVoicesCount() const override;
+    void setVoicesLimit(unsigned int limit) override;
+    unsigned int stolenVoicesCount() const override;
 
     void midiChannelSoundsOff(midi::channel_t chan) override;
     bool midiChannelVolume(midi::channel_t chan, float val) override;  // 0. - 1.
@@ -84,6 +89,23 @@ private:
         io::path path;
     };
 
+    enum class VoiceImportance {
+        Released = 0,
+        Sustained,
+        Held
+    };
+
+    struct VoiceCandidate {
+        fluid_voice_t* voice = nullptr;
+        unsigned int id = 0;
+        int velocity = 0;
+        VoiceImportance importance = VoiceImportance::Held;
+    };
+
+    //! NOTE Steals the least important voices, so the reserved ones fit in the limit too
+    void fitVoicesInLimit(unsigned int reservedVoicesCount);
+    void dropFadedStolenVoices();
+
     std::shared_ptr<Fluid> m_fluid = nullptr;
     std::vector<SoundFont> m_soundFonts;
 
@@ -94,6 +116,12 @@ private:
 
     unsigned int m_sampleRate = 0;
     async::Channel<unsigned int> m_streamsCountChanged;
+
+    unsigned int m_voicesLimit = 0;
+    unsigned int m_stolenVoicesCount = 0;
+    std::vector<unsigned int> m_stolenVoiceIds; // one per voice, while it fades out
+    std::vector<fluid_voice_t*> m_voices;
+    std::vector<VoiceCandidate> m_voiceCandidates;
 };
 
 using FluidSynthPtr = std::shared_ptr<FluidSynth>;
@@ -74,7 +74,7 @@ Ret SanitySynthesizer::removeSoundFonts()
 
 bool SanitySynthesizer::isActive() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
     return m_synth->isActive();
 }
 
@@ -92,13 +92,13 @@ Ret SanitySynthesizer::setupMidiChannels(const std::vector<midi::Event>& events)
 
 bool SanitySynthesizer::handleEvent(const midi::Event& e)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
     return m_synth->handleEvent(e);
 }
 
 void SanitySynthesizer::writeBuf(float* stream, unsigned int samples)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
     m_synth->writeBuf(stream, samples);
 }
 
@@ -110,31 +110,47 @@ void SanitySynthesizer::allSoundsOff()
 
 void SanitySynthesizer::flushSound()
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
     m_synth->flushSound();
 }
 
-void SanitySynthesizer::midiChannelSoundsOff(midi::channel_t chan)
+unsigned int SanitySynthesizer::activeVoicesCount() const
+{
+    return m_synth->activeVoicesCount();
+}
+
+void SanitySynthesizer::setVoicesLimit(unsigned int limit)
 {
     ONLY_AUDIO_WORKER_THREAD;
+    m_synth->setVoicesLimit(limit);
+}
+
+unsigned int SanitySynthesizer::stolenVoicesCount() const
+{
+    return m_synth->stolenVoicesCount();
+}
+
+void SanitySynthesizer::midiChannelSoundsOff(midi::channel_t chan)
+{
+    ONLY_AUDIO_PROCESS_THREAD;
     m_synth->midiChannelSoundsOff(chan);
 }
 
 bool SanitySynthesizer::midiChannelVolume(midi::channel_t chan, float val)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
     return m_synth->midiChannelVolume(chan, val);
 }
 
 bool SanitySynthesizer::midiChannelBalance(midi::channel_t chan, float val)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
     return m_synth->midiChannelBalance(chan, val);
 }
 
 bool SanitySynthesizer::midiChannelPitch(midi::channel_t chan, int16_t val)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
     return m_synth->midiChannelPitch(chan, val);
 }
 
@@ -147,7 +163,7 @@ void SanitySynthesizer::setSampleRate(unsigned int sampleRate)
 
 unsigned int SanitySynthesizer::audioChannelsCount() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
     return m_synth->audioChannelsCount();
 }
 
@@ -159,6 +175,6 @@ async::Channel<unsigned int> SanitySynthesizer::audioChannelsCountChanged() cons
 
 void SanitySynthesizer::process(float* buffer, unsigned int sampleCount)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
     m_synth->process(buffer, sampleCount);
 }
@@ -49,6 +49,9 @@ public:
 
     void allSoundsOff() override;  // all channels
     void flushSound() override;
+    unsigned int activeVoicesCount() const override;
+    void setVoicesLimit(unsigned int limit) override;
+    unsigned int stolenVoicesCount() const override;
     void midiChannelSoundsOff(midi::channel_t chan) override;
     bool midiChannelVolume(midi::channel_t chan, float val) override;   // 0. - 1.
     bool midiChannelBalance(midi::channel_t chan, float val) override;  // -1. - 1.
@@ -0,0 +1,67 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "trackeventsprovider.h"
+
+#include <algorithm>
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::midi;
+
+TrackEventsProvider::TrackEventsProvider(const IOfflineRenderer::Track& track)
+    : m_track(track)
+{
+    m_midiData.mapping = track.mapping;
+    m_midiData.stream.lastTick = track.lastTick;
+    m_midiData.stream.controlEventsStream.set(track.setupEvents);
+
+    m_midiData.stream.eventsRequest.onReceive(this, [this](const tick_t fromTick, const tick_t toTick) {
+        onEventsRequested(fromTick, toTick);
+    });
+}
+
+TrackEventsProvider::~TrackEventsProvider()
+{
+    m_midiData.stream.eventsRequest.resetOnReceive(this);
+}
+
+const MidiData& TrackEventsProvider::midiData() const
+{
+    return m_midiData;
+}
+
+void TrackEventsProvider::onEventsRequested(const tick_t fromTick, const tick_t toTick)
+{
+    //! NOTE The requested ranges may overlap, each event must be sent only once
+    tick_t from = std::max(fromTick, m_nextTick);
+
+    Events events;
+    if (from <= toTick) {
+        auto it = m_track.events.lower_bound(from);
+        auto end = m_track.events.upper_bound(toTick);
+        events.insert(it, end);
+
+        m_nextTick = toTick + 1;
+    }
+
+    m_midiData.stream.mainStream.send(std::move(events), std::max(toTick, m_nextTick - 1));
+}
@@ -19,40 +19,31 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
-#ifndef MU_AUDIO_EQUALISER_H
-#define MU_AUDIO_EQUALISER_H
+#ifndef MU_AUDIO_TRACKEVENTSPROVIDER_H
+#define MU_AUDIO_TRACKEVENTSPROVIDER_H
 
-#include "ifxprocessor.h"
+#include "async/asyncable.h"
+
+#include "iofflinerenderer.h"
 
 namespace mu::audio {
-class Equaliser : public IFxProcessor
+//! NOTE Answers the requests of a midi source from the pre-rendered events.
+//! Lives in the render thread, so the answers are sent synchronously
+class TrackEventsProvider : public async::Asyncable
 {
 public:
-    Equaliser();
-
-    void setSampleRate(unsigned int sampleRate) override;
-
-    bool active() const override;
-    void setActive(bool active) override;
+    explicit TrackEventsProvider(const IOfflineRenderer::Track& track);
+    ~TrackEventsProvider() override;
 
-    void setFrequency(float value);
-    void setGain(float value);
-    void setQ(float value);
-
-    void process(float* buffer, unsigned int sampleCount) override;
+    const midi::MidiData& midiData() const;
 
 private:
-    void calculate();
-
-    unsigned int m_sampleRate = 0;
-    bool m_active = true;
+    void onEventsRequested(const midi::tick_t fromTick, const midi::tick_t toTick);
 
-    float m_gain = 0, m_frequency = 1'000.f, m_q = 1.f;
-    float m_a[3] = { 0, 0, 0 };
-    float m_b[3] = { 0, 0, 0 };
-    float m_x[3] = { 0, 0, 0 };
-    float m_y[3] = { 0, 0, 0 };
+    const IOfflineRenderer::Track& m_track;
+    midi::MidiData m_midiData;
+    midi::tick_t m_nextTick = 0;
 };
 }
 
-#endif // MU_AUDIO_EQUALISER_H
+#endif // MU_AUDIO_TRACKEVENTSPROVIDER_H
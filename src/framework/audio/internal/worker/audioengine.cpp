@@ -64,6 +64,7 @@ mu::Ret AudioEngine::init(IAudioBufferPtr bufferPtr)
 
     m_buffer = std::move(bufferPtr);
     m_buffer->setSource(m_mixer->mixedSource());
+    m_mixer->setOutputBuffer(m_buffer);
 
     m_inited = true;
 
@@ -114,6 +115,50 @@ void AudioEngine::setAudioChannelsCount(const audioch_t count)
     m_mixer->setAudioChannelsCount(count);
 }
 
+void AudioEngine::setRenderWorkersCount(const size_t count)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    IF_ASSERT_FAILED(m_mixer) {
+        return;
+    }
+
+    m_mixer->setRenderWorkersCount(count);
+}
+
+void AudioEngine::setParallelRenderThreshold(const size_t minChannelsCount)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    IF_ASSERT_FAILED(m_mixer) {
+        return;
+    }
+
+    m_mixer->setParallelRenderThreshold(minChannelsCount);
+}
+
+void AudioEngine::setVoicesBudget(const unsigned int count)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    IF_ASSERT_FAILED(m_mixer) {
+        return;
+    }
+
+    m_mixer->setVoicesBudget(count);
+}
+
+void AudioEngine::setMaxSourceSampleRate(const unsigned int sampleRate)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    IF_ASSERT_FAILED(m_mixer) {
+        return;
+    }
+
+    m_mixer->setMaxSourceSampleRate(sampleRate);
+}
+
 MixerPtr AudioEngine::mixer() const
 {
     ONLY_AUDIO_WORKER_THREAD;
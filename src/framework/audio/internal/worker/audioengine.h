@@ -46,6 +46,10 @@ public:
     void setSampleRate(unsigned int sampleRate);
     void setReadBufferSize(uint16_t readBufferSize);
     void setAudioChannelsCount(const audioch_t count);
+    void setRenderWorkersCount(const size_t count);
+    void setParallelRenderThreshold(const size_t minChannelsCount);
+    void setVoicesBudget(const unsigned int count);
+    void setMaxSourceSampleRate(const unsigned int sampleRate);
 
     MixerPtr mixer() const;
 
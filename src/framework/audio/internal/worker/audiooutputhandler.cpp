@@ -129,10 +129,10 @@ Promise<AudioResourceMetaList> AudioOutputHandler::availableOutputResources() co
     }, AudioThread::ID);
 }
 
-Promise<AudioSignalChanges> AudioOutputHandler::signalChanges(const TrackSequenceId sequenceId, const TrackId trackId) const
+Promise<AudioSignalsSnapshotPtr> AudioOutputHandler::signalsSnapshot(const TrackSequenceId sequenceId, const TrackId trackId) const
 {
-    return Promise<AudioSignalChanges>([this, sequenceId, trackId](Promise<AudioSignalChanges>::Resolve resolve,
-                                                                   Promise<AudioSignalChanges>::Reject reject) {
+    return Promise<AudioSignalsSnapshotPtr>([this, sequenceId, trackId](Promise<AudioSignalsSnapshotPtr>::Resolve resolve,
+                                                                        Promise<AudioSignalsSnapshotPtr>::Reject reject) {
         ONLY_AUDIO_WORKER_THREAD;
 
         ITrackSequencePtr s = sequence(sequenceId);
@@ -142,21 +142,64 @@ Promise<AudioSignalChanges> AudioOutputHandler::signalChanges(const TrackSequenc
             return;
         }
 
-        resolve({ s->audioIO()->signalAmplitudeChanged(trackId), s->audioIO()->volumePressureChanged(trackId) });
+        AudioSignalsSnapshotPtr snapshot = s->audioIO()->signalsSnapshot(trackId);
+
+        if (!snapshot) {
+            reject(static_cast<int>(Err::InvalidTrackId), "invalid track id");
+            return;
+        }
+
+        resolve(snapshot);
     }, AudioThread::ID);
 }
 
-Promise<AudioSignalChanges> AudioOutputHandler::masterSignalChanges() const
+Promise<AudioSignalsSnapshotPtr> AudioOutputHandler::masterSignalsSnapshot() const
 {
-    return Promise<AudioSignalChanges>([this](Promise<AudioSignalChanges>::Resolve resolve,
-                                              Promise<AudioSignalChanges>::Reject reject) {
+    return Promise<AudioSignalsSnapshotPtr>([this](Promise<AudioSignalsSnapshotPtr>::Resolve resolve,
+                                                   Promise<AudioSignalsSnapshotPtr>::Reject reject) {
         ONLY_AUDIO_WORKER_THREAD;
 
         IF_ASSERT_FAILED(mixer()) {
             reject(static_cast<int>(Err::Undefined), "undefined reference to a mixer");
         }
 
-        resolve({ mixer()->masterSignalAmplitudeRmsChanged(), mixer()->masterVolumePressureDbfsChanged() });
+        resolve(mixer()->masterSignalsSnapshot());
+    }, AudioThread::ID);
+}
+
+void AudioOutputHandler::setTrackFrozen(const TrackSequenceId sequenceId, const TrackId trackId, const bool frozen)
+{
+    Async::call(this, [this, sequenceId, trackId, frozen]() {
+        ONLY_AUDIO_WORKER_THREAD;
+
+        ITrackSequencePtr s = sequence(sequenceId);
+
+        if (!s) {
+            return;
+        }
+
+        Ret ret = s->audioIO()->setFrozen(trackId, frozen);
+
+        if (!ret) {
+            LOGE() << "unable to change the freeze state of the track " << trackId << ": " << ret.toString();
+        }
+    }, AudioThread::ID);
+}
+
+Promise<bool> AudioOutputHandler::isTrackFrozen(const TrackSequenceId sequenceId, const TrackId trackId) const
+{
+    return Promise<bool>([this, sequenceId, trackId](Promise<bool>::Resolve resolve,
+                                                     Promise<bool>::Reject reject) {
+        ONLY_AUDIO_WORKER_THREAD;
+
+        ITrackSequencePtr s = sequence(sequenceId);
+
+        if (!s) {
+            reject(static_cast<int>(Err::InvalidSequenceId), "invalid sequence id");
+            return;
+        }
+
+        resolve(s->audioIO()->isFrozen(trackId));
     }, AudioThread::ID);
 }
 
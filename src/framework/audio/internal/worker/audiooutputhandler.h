@@ -49,8 +49,11 @@ public:
 
     async::Promise<AudioResourceMetaList> availableOutputResources() const override;
 
-    async::Promise<AudioSignalChanges> signalChanges(const TrackSequenceId sequenceId, const TrackId trackId) const override;
-    async::Promise<AudioSignalChanges> masterSignalChanges() const override;
+    async::Promise<AudioSignalsSnapshotPtr> signalsSnapshot(const TrackSequenceId sequenceId, const TrackId trackId) const override;
+    async::Promise<AudioSignalsSnapshotPtr> masterSignalsSnapshot() const override;
+
+    void setTrackFrozen(const TrackSequenceId sequenceId, const TrackId trackId, const bool frozen) override;
+    async::Promise<bool> isTrackFrozen(const TrackSequenceId sequenceId, const TrackId trackId) const override;
 
 private:
     std::shared_ptr<Mixer> mixer() const;
@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audiosignalmeter.h"
+
+#include <algorithm>
+
+#include "internal/audiomathutils.h"
+
+using namespace mu::audio;
+
+static constexpr unsigned int SNAPSHOT_UPDATE_RATE = 30; // Hz
+
+AudioSignalMeter::AudioSignalMeter()
+    : m_snapshot(std::make_shared<AudioSignalsSnapshot>())
+{
+}
+
+AudioSignalsSnapshotPtr AudioSignalMeter::snapshot() const
+{
+    return m_snapshot;
+}
+
+void AudioSignalMeter::setSampleRate(const unsigned int sampleRate)
+{
+    m_samplesPerUpdate = std::max(sampleRate / SNAPSHOT_UPDATE_RATE, 1u);
+}
+
+void AudioSignalMeter::accumulate(const float* squaredSums, const audioch_t audioChannelsCount, const samples_t samplesPerChannel)
+{
+    audioch_t channelsCount = std::min(audioChannelsCount, MAX_SUPPORTED_AUDIO_CHANNELS);
+
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        m_squaredSums[audioChNum] += squaredSums[audioChNum];
+    }
+
+    m_accumulatedSamples += samplesPerChannel;
+
+    if (m_accumulatedSamples >= m_samplesPerUpdate) {
+        publish(channelsCount);
+    }
+}
+
+void AudioSignalMeter::reset()
+{
+    m_squaredSums.fill(0.f);
+    m_accumulatedSamples = 0;
+
+    for (audioch_t audioChNum = 0; audioChNum < MAX_SUPPORTED_AUDIO_CHANNELS; ++audioChNum) {
+        m_snapshot->setAmplitude(audioChNum, 0.f);
+    }
+}
+
+void AudioSignalMeter::publish(const audioch_t audioChannelsCount)
+{
+    if (m_accumulatedSamples == 0) {
+        return;
+    }
+
+    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+        float rms = samplesRootMeanSquare(std::move(m_squaredSums[audioChNum]), m_accumulatedSamples);
+        m_snapshot->setAmplitude(audioChNum, rms);
+    }
+
+    m_snapshot->setAudioChannelsCount(audioChannelsCount);
+
+    m_squaredSums.fill(0.f);
+    m_accumulatedSamples = 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_AUDIOSIGNALMETER_H
+#define MU_AUDIO_AUDIOSIGNALMETER_H
+
+#include <array>
+#include <memory>
+
+#include "audiotypes.h"
+
+namespace mu::audio {
+//! NOTE Accumulates the signal power of the processed blocks and publishes it
+//! into the snapshot at a fixed (low) rate, independently of the block size
+class AudioSignalMeter
+{
+public:
+    AudioSignalMeter();
+
+    AudioSignalsSnapshotPtr snapshot() const;
+
+    void setSampleRate(const unsigned int sampleRate);
+
+    void accumulate(const float* squaredSums, const audioch_t audioChannelsCount, const samples_t samplesPerChannel);
+    void reset();
+
+private:
+    void publish(const audioch_t audioChannelsCount);
+
+    std::shared_ptr<AudioSignalsSnapshot> m_snapshot = nullptr;
+
+    std::array<float, MAX_SUPPORTED_AUDIO_CHANNELS> m_squaredSums = {};
+    samples_t m_accumulatedSamples = 0;
+    samples_t m_samplesPerUpdate = 0;
+};
+}
+
+#endif // MU_AUDIO_AUDIOSIGNALMETER_H
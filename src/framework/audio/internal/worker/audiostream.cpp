@@ -20,6 +20,10 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "audiostream.h"
+
+#include <algorithm>
+#include <limits>
+
 #include "log.h"
 
 #define DR_WAV_IMPLEMENTATION
@@ -38,7 +42,6 @@
 using namespace mu::audio;
 
 AudioStream::AudioStream()
-    : m_src(m_data, 0, 1, 1)
 {
 }
 
@@ -46,8 +49,8 @@ bool AudioStream::loadFile(const io::path& path)
 {
     bool loaded = loadWAV(path) || loadMP3(path) || loadOGG(path);
     if (loaded) {
-        m_src.setChannelCount(m_channels);
-        m_src.setSampleRateIn(m_sampleRate);
+        //! NOTE The resampler is set up on the first copy with another sample rate
+        m_resampler = Resampler();
     }
     return loaded;
 }
@@ -55,9 +58,10 @@ bool AudioStream::loadFile(const io::path& path)
 void AudioStream::convertSampleRate(unsigned int sampleRate)
 {
     if (sampleRate != m_sampleRate) {
-        auto src = new SampleRateConvertor(m_data, m_channels, m_sampleRate, sampleRate);
-        m_data = src->convert();
+        Resampler resampler(m_channels, m_sampleRate, sampleRate);
+        m_data = resampler.convert(m_data);
         m_sampleRate = sampleRate;
+        m_resampler = Resampler();
     }
 }
 
@@ -74,9 +78,7 @@ unsigned int AudioStream::sampleRate() const
 unsigned int AudioStream::copySamplesToBuffer(float* buffer, unsigned int fromSample, unsigned int sampleCount, unsigned int sampleRate)
 {
     if (m_sampleRate != sampleRate) {
-        m_src.setSampleRateOut(sampleRate);
-
-        return m_src.convert(buffer, fromSample, sampleCount);
+        return copyResampledSamplesToBuffer(buffer, fromSample, sampleCount, sampleRate);
     }
 
     auto from = fromSample * m_channels;
@@ -98,6 +100,52 @@ unsigned int AudioStream::copySamplesToBuffer(float* buffer, unsigned int fromSa
     return count / m_channels;
 }
 
+unsigned int AudioStream::copyResampledSamplesToBuffer(float* buffer, unsigned int fromSample, unsigned int sampleCount,
+                                                       unsigned int sampleRate)
+{
+    if (m_resampler.sampleRateOut() != sampleRate || m_resampler.sampleRateIn() != m_sampleRate
+        || m_resampler.audioChannelsCount() != m_channels) {
+        m_resampler.setup(m_channels, m_sampleRate, sampleRate);
+        m_resampler.reserve(sampleCount * static_cast<samples_t>(m_sampleRate) / sampleRate + 1);
+        m_resampledOutputSample = std::numeric_limits<samples_t>::max();
+    }
+
+    //! NOTE The resampler keeps its state between the sequential calls, it's restarted on seek
+    if (fromSample != m_resampledOutputSample) {
+        m_resampler.reset();
+        m_resampledInputSample = static_cast<samples_t>(fromSample) * m_sampleRate / sampleRate;
+        m_resampledOutputSample = fromSample;
+    }
+
+    const samples_t totalFrames = m_data.size() / m_channels;
+    const samples_t totalOutputFrames = (totalFrames * sampleRate + m_sampleRate - 1) / m_sampleRate;
+
+    if (fromSample >= totalOutputFrames) {
+        return 0;
+    }
+
+    const samples_t framesToWrite = std::min<samples_t>(sampleCount, totalOutputFrames - fromSample);
+    samples_t written = 0;
+
+    while (written < framesToWrite) {
+        float* output = buffer + written * m_channels;
+        samples_t outputFrames = framesToWrite - written;
+
+        if (m_resampledInputSample >= totalFrames) {
+            written += m_resampler.flush(output, outputFrames);
+            break;
+        }
+
+        samples_t inputFrames = std::min(m_resampler.requiredInputFrames(outputFrames), totalFrames - m_resampledInputSample);
+        written += m_resampler.process(m_data.data() + m_resampledInputSample * m_channels, inputFrames, output, outputFrames);
+        m_resampledInputSample += inputFrames;
+    }
+
+    m_resampledOutputSample += written;
+
+    return static_cast<unsigned int>(written);
+}
+
 bool AudioStream::loadWAV(mu::io::path path)
 {
     drwav wav;
@@ -24,7 +24,7 @@
 
 #include <vector>
 #include "audio/iaudiostream.h"
-#include "samplerateconvertor.h"
+#include "resampler.h"
 
 namespace mu::audio {
 class AudioStream : public IAudioStream
@@ -53,10 +53,16 @@ private:
     bool loadMP3(mu::io::path path);
     bool loadOGG(mu::io::path path);
 
+    unsigned int copyResampledSamplesToBuffer(float* buffer, unsigned int fromSample, unsigned int sampleCount, unsigned int sampleRate);
+
     unsigned int m_channels = 1;
     unsigned int m_sampleRate = 1;
     std::vector<float> m_data = {};
-    SampleRateConvertor m_src;
+    Resampler m_resampler;
+
+    //! the position of the resampler in the input and the output samples
+    samples_t m_resampledInputSample = 0;
+    samples_t m_resampledOutputSample = 0;
 };
 }
 
@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audiotelemetrymeter.h"
+
+#include <algorithm>
+
+using namespace mu::audio;
+
+static constexpr unsigned int TELEMETRY_UPDATE_RATE = 4; // Hz
+
+void ProcessingTimeMeter::accumulate(const Clock::duration processingTime, const samples_t samplesPerChannel,
+                                     const unsigned int sampleRate)
+{
+    if (samplesPerChannel == 0 || sampleRate == 0) {
+        return;
+    }
+
+    double processingSecs = std::chrono::duration<double>(processingTime).count();
+    double playbackSecs = static_cast<double>(samplesPerChannel) / static_cast<double>(sampleRate);
+
+    m_processingSecs += processingSecs;
+    m_playbackSecs += playbackSecs;
+    m_peakLoad = std::max(m_peakLoad, static_cast<float>(processingSecs / playbackSecs));
+}
+
+AudioProcessingLoad ProcessingTimeMeter::take()
+{
+    AudioProcessingLoad load;
+
+    if (m_playbackSecs > 0.0) {
+        load.average = static_cast<float>(m_processingSecs / m_playbackSecs);
+        load.peak = m_peakLoad;
+    }
+
+    m_processingSecs = 0.0;
+    m_playbackSecs = 0.0;
+    m_peakLoad = 0.f;
+
+    return load;
+}
+
+void AudioTelemetryMeter::setSampleRate(const unsigned int sampleRate)
+{
+    m_sampleRate = sampleRate;
+    m_samplesPerUpdate = std::max(sampleRate / TELEMETRY_UPDATE_RATE, 1u);
+}
+
+void AudioTelemetryMeter::setOutputBuffer(std::weak_ptr<IAudioBuffer> buffer)
+{
+    m_outputBuffer = std::move(buffer);
+}
+
+bool AudioTelemetryMeter::accumulate(const ProcessingTimeMeter::Clock::duration processingTime, const samples_t samplesPerChannel)
+{
+    m_mixLoad.accumulate(processingTime, samplesPerChannel, m_sampleRate);
+
+    //! NOTE The buffer is the emptiest right before it's filled up, i.e. before the first block of a forward,
+    //! the lowest value over the interval is the closest the playback came to an underrun
+    if (std::shared_ptr<IAudioBuffer> buffer = m_outputBuffer.lock()) {
+        m_lowestBufferFill = std::min(m_lowestBufferFill, buffer->stats().filledSamples);
+    }
+
+    m_accumulatedSamples += samplesPerChannel;
+
+    return m_accumulatedSamples >= m_samplesPerUpdate;
+}
+
+void AudioTelemetryMeter::publish(AudioTelemetry&& telemetry)
+{
+    telemetry.load = m_mixLoad.take();
+
+    if (std::shared_ptr<IAudioBuffer> buffer = m_outputBuffer.lock()) {
+        IAudioBuffer::Stats stats = buffer->stats();
+
+        telemetry.bufferFilledSamples = std::min(m_lowestBufferFill, stats.filledSamples);
+        telemetry.bufferTargetSamples = stats.targetSamples;
+        telemetry.bufferUnderrunsCount = stats.underrunsCount;
+    }
+
+    m_lowestBufferFill = std::numeric_limits<samples_t>::max();
+    m_accumulatedSamples = 0;
+
+    m_telemetryUpdated.send(std::move(telemetry));
+}
+
+mu::async::Channel<AudioTelemetry> AudioTelemetryMeter::telemetryUpdated() const
+{
+    return m_telemetryUpdated;
+}
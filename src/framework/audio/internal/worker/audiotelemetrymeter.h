@@ -0,0 +1,80 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_AUDIOTELEMETRYMETER_H
+#define MU_AUDIO_AUDIOTELEMETRYMETER_H
+
+#include <chrono>
+#include <limits>
+#include <memory>
+
+#include "async/channel.h"
+
+#include "audiotypes.h"
+#include "internal/iaudiobuffer.h"
+
+namespace mu::audio {
+//! NOTE Accumulates the processing time of a part of the audio graph block by block.
+//! It's written and taken by the thread, which processes the part, so it doesn't lock
+class ProcessingTimeMeter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void accumulate(const Clock::duration processingTime, const samples_t samplesPerChannel, const unsigned int sampleRate);
+    AudioProcessingLoad take();
+
+private:
+    double m_processingSecs = 0.0;
+    double m_playbackSecs = 0.0;
+    float m_peakLoad = 0.f;
+};
+
+//! NOTE Accumulates the processing time of the whole mix and publishes the telemetry
+//! at a fixed (low) rate, independently of the block size
+class AudioTelemetryMeter
+{
+public:
+    void setSampleRate(const unsigned int sampleRate);
+    void setOutputBuffer(std::weak_ptr<IAudioBuffer> buffer);
+
+    //! NOTE Returns true, when it's time to publish the telemetry
+    bool accumulate(const ProcessingTimeMeter::Clock::duration processingTime, const samples_t samplesPerChannel);
+    //! NOTE The telemetry of the channels and the voices is filled by the caller
+    void publish(AudioTelemetry&& telemetry);
+
+    async::Channel<AudioTelemetry> telemetryUpdated() const;
+
+private:
+    ProcessingTimeMeter m_mixLoad;
+    unsigned int m_sampleRate = 0;
+
+    std::weak_ptr<IAudioBuffer> m_outputBuffer;
+    samples_t m_lowestBufferFill = std::numeric_limits<samples_t>::max();
+
+    samples_t m_accumulatedSamples = 0;
+    samples_t m_samplesPerUpdate = 0;
+
+    async::Channel<AudioTelemetry> m_telemetryUpdated;
+};
+}
+
+#endif // MU_AUDIO_AUDIOTELEMETRYMETER_H
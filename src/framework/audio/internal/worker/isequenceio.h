@@ -44,8 +44,10 @@ public:
     virtual async::Channel<TrackId, AudioInputParams> inputParamsChanged() const = 0;
     virtual async::Channel<TrackId, AudioOutputParams> outputParamsChanged() const = 0;
 
-    virtual async::Channel<audioch_t, float> signalAmplitudeChanged(const TrackId id) const = 0;
-    virtual async::Channel<audioch_t, volume_dbfs_t> volumePressureChanged(const TrackId id) const = 0;
+    virtual AudioSignalsSnapshotPtr signalsSnapshot(const TrackId id) const = 0;
+
+    virtual Ret setFrozen(const TrackId id, const bool frozen) = 0;
+    virtual bool isFrozen(const TrackId id) const = 0;
 };
 
 using ISequenceIOPtr = std::shared_ptr<ISequenceIO>;
@@ -24,6 +24,7 @@
 
 #include <limits>
 #include <cstring>
+#include <utility>
 
 #include "log.h"
 #include "realfn.h"
@@ -36,6 +37,7 @@ using namespace mu::audio::synth;
 using namespace mu::midi;
 
 static tick_t MINIMAL_REQUIRED_LOOKAHEAD = 480 * 4 * 10; // about 10 measures of 4/4 time signature
+static tick_t KEPT_HISTORY_SIZE = 480 * 4 * 10; // the sent events behind the position, which are kept for the jumps back
 
 MidiAudioSource::MidiAudioSource(const TrackId trackId, const MidiData& midiData)
     : m_trackId(trackId), m_stream(midiData.stream), m_mapping(midiData.mapping)
@@ -50,10 +52,37 @@ MidiAudioSource::MidiAudioSource(const TrackId trackId, const MidiData& midiData
     });
 
     m_stream.mainStream.onReceive(this, [this](Events events, tick_t endTick) {
+        m_hasActiveRequest = false;
+
+        //! NOTE The request was sent before the main stream has been reset,
+        //! the continuation of the new position will be requested on the next process
+        if (m_isActiveRequestOutdated) {
+            m_isActiveRequestOutdated = false;
+            return;
+        }
+
         m_mainStreamEventsBuffer.endTick = std::move(endTick);
         m_mainStreamEventsBuffer.push(std::move(events));
+    });
 
-        m_hasActiveRequest = false;
+    m_stream.patchStream.onReceive(this, [this](Events events, tick_t from, tick_t to) {
+        if (m_hasPreroll) {
+            Events prerollEvents = events;
+            m_prerollEventsBuffer.replace(from, to, std::move(prerollEvents));
+        }
+
+        m_mainStreamEventsBuffer.replace(from, to, std::move(events));
+    });
+
+    m_stream.prerollStream.onReceive(this, [this](Events events, tick_t from, tick_t to) {
+        //! NOTE The loop may have been moved since the request
+        if (!m_hasPreroll || from != m_prerollTick) {
+            return;
+        }
+
+        m_prerollEventsBuffer.reset(from);
+        m_prerollEventsBuffer.endTick = to;
+        m_prerollEventsBuffer.push(std::move(events));
     });
 
     buildTempoMap();
@@ -65,11 +94,13 @@ MidiAudioSource::~MidiAudioSource()
 {
     m_stream.backgroundStream.resetOnReceive(this);
     m_stream.mainStream.resetOnReceive(this);
+    m_stream.patchStream.resetOnReceive(this);
+    m_stream.prerollStream.resetOnReceive(this);
 }
 
 bool MidiAudioSource::isActive() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     if (!m_synth) {
         return false;
@@ -88,12 +119,20 @@ void MidiAudioSource::setIsActive(const bool active)
 
     // invalidate cached events when we stop playing
     if (!active) {
-        invalidateCaches(m_mainStreamEventsBuffer);
+        resetMainStream(0);
+        m_prerollEventsBuffer.reset(m_prerollTick);
+    } else if (m_hasPreroll && !m_prerollEventsBuffer.isLoaded(m_prerollTick)) {
+        sendPrerollRequest();
     }
 
     m_synth->setIsActive(active);
 }
 
+void MidiAudioSource::setMidiOutputEnabled(const bool enabled)
+{
+    m_midiOutputEnabled = enabled;
+}
+
 void MidiAudioSource::setupChannels()
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -105,7 +144,7 @@ void MidiAudioSource::setupChannels()
     m_synth->setupMidiChannels(m_stream.controlEventsStream.val);
 }
 
-void MidiAudioSource::invalidateCaches(EventsBuffer& eventsBuffer)
+void MidiAudioSource::invalidateCaches(MidiEventsBuffer& eventsBuffer)
 {
     IF_ASSERT_FAILED(m_synth) {
         return;
@@ -115,6 +154,15 @@ void MidiAudioSource::invalidateCaches(EventsBuffer& eventsBuffer)
     eventsBuffer.reset();
 }
 
+void MidiAudioSource::resetMainStream(const tick_t tick)
+{
+    //! NOTE The response to the active request doesn't continue the buffer anymore
+    m_isActiveRequestOutdated = m_hasActiveRequest;
+
+    invalidateCaches(m_mainStreamEventsBuffer);
+    m_mainStreamEventsBuffer.reset(tick);
+}
+
 void MidiAudioSource::requestNextEvents(const tick_t nextTicksNumber)
 {
     if (m_hasActiveRequest) {
@@ -147,11 +195,22 @@ void MidiAudioSource::sendRequestFromTick(const tick_t from)
 {
     tick_t to = std::min(m_stream.lastTick, from + MINIMAL_REQUIRED_LOOKAHEAD);
 
-    m_stream.eventsRequest.send(from, to);
+    //! NOTE The response may come synchronously, when the request is handled in this thread
     m_hasActiveRequest = true;
+    m_stream.eventsRequest.send(from, to);
 }
 
-void MidiAudioSource::findAndSendNextEvents(MidiAudioSource::EventsBuffer& eventsBuffer, const tick_t nextTicks)
+void MidiAudioSource::sendPrerollRequest()
+{
+    if (m_prerollTick >= m_stream.lastTick) {
+        return;
+    }
+
+    tick_t to = std::min(m_stream.lastTick, m_prerollTick + MINIMAL_REQUIRED_LOOKAHEAD);
+    m_stream.prerollRequest.send(m_prerollTick, to);
+}
+
+void MidiAudioSource::findAndSendNextEvents(MidiEventsBuffer& eventsBuffer, const tick_t nextTicks)
 {
     if (eventsBuffer.isEmpty()) {
         return;
@@ -169,6 +228,9 @@ void MidiAudioSource::findAndSendNextEvents(MidiAudioSource::EventsBuffer& event
 
         sendEvents(eventsBuffer.pop());
     }
+
+    eventsBuffer.isCurrentTickPassed = true;
+    eventsBuffer.trimHistory(KEPT_HISTORY_SIZE);
 }
 
 void MidiAudioSource::handleBackgroundStream(const msecs_t nextMsecsNumber)
@@ -187,12 +249,25 @@ void MidiAudioSource::handleMainStream(const msecs_t nextMsecsNumber)
     tick_t nextTicksNumber = tickFromMsec(nextMsecsNumber);
 
     requestNextEvents(nextTicksNumber);
+
+    //! NOTE Keep the position moving through the ranges without events,
+    //! but not while the events are still being requested
+    if (m_mainStreamEventsBuffer.isEmpty()) {
+        if (m_hasActiveRequest) {
+            return;
+        }
+
+        m_mainStreamEventsBuffer.currentTick = std::min(m_stream.lastTick, m_mainStreamEventsBuffer.currentTick + nextTicksNumber);
+        m_mainStreamEventsBuffer.isCurrentTickPassed = true;
+        return;
+    }
+
     findAndSendNextEvents(m_mainStreamEventsBuffer, nextTicksNumber);
 }
 
 void MidiAudioSource::handleNextMsecs(const msecs_t nextMsecsNumber)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     handleBackgroundStream(nextMsecsNumber);
 
@@ -216,7 +291,7 @@ void MidiAudioSource::setSampleRate(unsigned int sampleRate)
 
 unsigned int MidiAudioSource::audioChannelsCount() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     if (!m_synth) {
         return 0;
@@ -238,7 +313,7 @@ async::Channel<unsigned int> MidiAudioSource::audioChannelsCountChanged() const
 
 void MidiAudioSource::process(float* buffer, unsigned int sampleCount)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     if (!m_synth) {
         return;
@@ -257,7 +332,10 @@ bool MidiAudioSource::sendEvents(const std::vector<Event>& events)
 
     for (const Event& event : events) {
         m_synth->handleEvent(event);
-        midiOutPort()->sendEvent(event);
+
+        if (m_midiOutputEnabled) {
+            midiOutPort()->sendEvent(event);
+        }
     }
 
     return true;
@@ -265,19 +343,57 @@ bool MidiAudioSource::sendEvents(const std::vector<Event>& events)
 
 void MidiAudioSource::seek(const msecs_t newPositionMsecs)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
-    invalidateCaches(m_mainStreamEventsBuffer);
-    m_mainStreamEventsBuffer.currentTick = tickFromMsec(newPositionMsecs);
+    IF_ASSERT_FAILED(m_synth) {
+        return;
+    }
+
+    tick_t newPositionTick = tickFromMsec(newPositionMsecs);
+
+    //! NOTE The events around the current position are still in the buffer,
+    //! so the jump back, e.g. to the loop start of a short loop, doesn't wait for the request
+    if (m_mainStreamEventsBuffer.rewind(newPositionTick)) {
+        m_synth->flushSound();
+        return;
+    }
+
+    resetMainStream(newPositionTick);
+
+    //! NOTE The pre-roll is handed over without copying the events,
+    //! and the loop start is requested again for the next restart
+    if (m_hasPreroll && newPositionTick == m_prerollTick && m_prerollEventsBuffer.isLoaded(newPositionTick)) {
+        std::swap(m_mainStreamEventsBuffer, m_prerollEventsBuffer);
+        m_prerollEventsBuffer.reset(m_prerollTick);
+        sendPrerollRequest();
+    }
 
     requestNextEvents(MINIMAL_REQUIRED_LOOKAHEAD);
 }
 
+void MidiAudioSource::prefetch(const msecs_t positionMsecs)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    tick_t positionTick = tickFromMsec(positionMsecs);
+
+    if (m_hasPreroll && positionTick == m_prerollTick) {
+        return;
+    }
+
+    m_hasPreroll = true;
+    m_prerollTick = positionTick;
+    m_prerollEventsBuffer.reset(positionTick);
+
+    sendPrerollRequest();
+}
+
 void MidiAudioSource::applyInputParams(const AudioInputParams& originParams, AudioInputParams& resultParams)
 {
     auto fallbackSynth = [this](AudioInputParams& result) {
         m_synth = synthResolver()->resolveDefaultSynth(m_trackId);
         m_synth->setSampleRate(m_sampleRate);
+        m_synth->setVoicesLimit(m_voicesLimit);
         result = synthResolver()->resolveDefaultInputParams();
         setupChannels();
     };
@@ -295,10 +411,42 @@ void MidiAudioSource::applyInputParams(const AudioInputParams& originParams, Aud
     }
 
     m_synth->setSampleRate(m_sampleRate);
+    m_synth->setVoicesLimit(m_voicesLimit);
     setupChannels();
     resultParams = originParams;
 }
 
+unsigned int MidiAudioSource::activeVoicesCount() const
+{
+    if (!m_synth) {
+        return 0;
+    }
+
+    return m_synth->activeVoicesCount();
+}
+
+void MidiAudioSource::setVoicesLimit(unsigned int limit)
+{
+    if (m_voicesLimit == limit) {
+        return;
+    }
+
+    m_voicesLimit = limit;
+
+    if (m_synth) {
+        m_synth->setVoicesLimit(limit);
+    }
+}
+
+unsigned int MidiAudioSource::stolenVoicesCount() const
+{
+    if (!m_synth) {
+        return 0;
+    }
+
+    return m_synth->stolenVoicesCount();
+}
+
 void MidiAudioSource::buildTempoMap()
 {
     m_tempoMap.clear();
@@ -35,6 +35,7 @@
 
 #include "isynthresolver.h"
 #include "track.h"
+#include "midieventsbuffer.h"
 #include "audiotypes.h"
 
 namespace mu::audio {
@@ -50,57 +51,21 @@ public:
     bool isActive() const override;
     void setIsActive(const bool active) override;
 
+    void setMidiOutputEnabled(const bool enabled);
+
     void setSampleRate(unsigned int sampleRate) override;
     unsigned int audioChannelsCount() const override;
     async::Channel<unsigned int> audioChannelsCountChanged() const override;
     void process(float* buffer, unsigned int sampleCount) override;
 
     void seek(const msecs_t newPositionMsecs) override;
+    void prefetch(const msecs_t positionMsecs) override;
     void applyInputParams(const AudioInputParams& originParams, AudioInputParams& resultParams) override;
+    unsigned int activeVoicesCount() const override;
+    void setVoicesLimit(unsigned int limit) override;
+    unsigned int stolenVoicesCount() const override;
 
 private:
-    struct EventsBuffer {
-        midi::tick_t size = 480 * 4 * 10;
-
-        midi::tick_t currentTick = 0;
-        midi::tick_t endTick = 0;
-
-        bool hasEventsForTick(const midi::tick_t tick) const
-        {
-            return m_eventsMap.find(tick) != m_eventsMap.end();
-        }
-
-        std::vector<midi::Event> pop()
-        {
-            return m_eventsMap.extract(currentTick).mapped();
-        }
-
-        void push(midi::Events&& newEvents)
-        {
-            for (auto& pair : newEvents) {
-                for (midi::Event& event : pair.second) {
-                    std::vector<midi::Event>& eventsAtTick = m_eventsMap[pair.first];
-                    eventsAtTick.push_back(std::move(event));
-                }
-            }
-        }
-
-        bool isEmpty() const
-        {
-            return m_eventsMap.empty();
-        }
-
-        void reset()
-        {
-            currentTick = 0;
-            endTick = 0;
-            m_eventsMap.clear();
-        }
-
-    private:
-        midi::Events m_eventsMap;
-    };
-
     void handleNextMsecs(const msecs_t nextMsecsNumber);
 
     midi::tick_t tickFromMsec(const msecs_t msec) const;
@@ -108,17 +73,21 @@ private:
     void handleBackgroundStream(const msecs_t nextMsecsNumber);
     void handleMainStream(const msecs_t nextMsecsNumber);
 
-    void findAndSendNextEvents(EventsBuffer& eventsBuffer, const midi::tick_t nextTicks);
+    void findAndSendNextEvents(MidiEventsBuffer& eventsBuffer, const midi::tick_t nextTicks);
     bool sendEvents(const std::vector<midi::Event>& events);
     void requestNextEvents(const midi::tick_t nextTicksNumber);
     void sendRequestFromTick(const midi::tick_t from);
+    void sendPrerollRequest();
 
     void buildTempoMap();
     void setupChannels();
 
-    void invalidateCaches(EventsBuffer& eventsBuffer);
+    void invalidateCaches(MidiEventsBuffer& eventsBuffer);
+    void resetMainStream(const midi::tick_t tick);
 
     bool m_hasActiveRequest = false;
+    bool m_isActiveRequestOutdated = false;
+    bool m_midiOutputEnabled = true;
 
     TrackId m_trackId = -1;
     synth::ISynthesizerPtr m_synth = nullptr;
@@ -127,10 +96,16 @@ private:
     midi::MidiStream m_stream;
     midi::MidiMapping m_mapping;
 
-    EventsBuffer m_mainStreamEventsBuffer;
-    EventsBuffer m_backgroundStreamEventsBuffer;
+    MidiEventsBuffer m_mainStreamEventsBuffer;
+    MidiEventsBuffer m_backgroundStreamEventsBuffer;
+
+    //! NOTE The events from the loop start, the main stream is restored from them on the loop restart
+    MidiEventsBuffer m_prerollEventsBuffer;
+    midi::tick_t m_prerollTick = 0;
+    bool m_hasPreroll = false;
 
     unsigned int m_sampleRate = 0;
+    unsigned int m_voicesLimit = 0;
 
     struct TempoItem {
         midi::tempo_t tempo = 500000;
@@ -0,0 +1,189 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_MIDIEVENTSBUFFER_H
+#define MU_AUDIO_MIDIEVENTSBUFFER_H
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "midi/miditypes.h"
+
+namespace mu::audio {
+//! NOTE The events of a midi stream around the playback position: the ones to send from the current tick on,
+//! and the already sent ones, which are kept for the jumps back
+struct MidiEventsBuffer {
+    midi::tick_t size = 480 * 4 * 10;
+
+    midi::tick_t currentTick = 0;
+    midi::tick_t endTick = 0;
+
+    //! NOTE The sent events from this tick on are kept,
+    //! so the position can be moved back to them without requesting the events again
+    midi::tick_t historyStartTick = 0;
+    bool isCurrentTickPassed = false;
+
+    bool hasEventsForTick(const midi::tick_t tick) const
+    {
+        return m_eventsMap.find(tick) != m_eventsMap.end();
+    }
+
+    const std::vector<midi::Event>& pop()
+    {
+        return moveNode(m_eventsMap, m_historyMap, m_eventsMap.find(currentTick))->second;
+    }
+
+    void push(midi::Events&& newEvents)
+    {
+        splice(std::move(newEvents));
+    }
+
+    void replace(const midi::tick_t from, const midi::tick_t to, midi::Events&& newEvents)
+    {
+        midi::tick_t sentEndTick = isCurrentTickPassed ? currentTick + 1 : currentTick;
+
+        //! NOTE The kept sent events of the range are outdated now
+        if (from < sentEndTick && to >= historyStartTick) {
+            historyStartTick = std::min(to + 1, sentEndTick);
+            m_historyMap.erase(m_historyMap.begin(), m_historyMap.lower_bound(historyStartTick));
+        }
+
+        midi::tick_t start = std::max(from, sentEndTick);
+        midi::tick_t end = std::min(to, endTick);
+
+        if (start > end) {
+            return;
+        }
+
+        //! NOTE Note offs are kept, they may belong to the notes which are sounding already
+        auto it = m_eventsMap.lower_bound(start);
+        while (it != m_eventsMap.end() && it->first <= end) {
+            std::vector<midi::Event>& events = it->second;
+            events.erase(std::remove_if(events.begin(), events.end(), [](const midi::Event& event) {
+                return !isNoteOff(event);
+            }), events.end());
+
+            if (events.empty()) {
+                it = m_eventsMap.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        //! NOTE The events after the end tick will be requested as usual
+        newEvents.erase(newEvents.begin(), newEvents.lower_bound(start));
+        newEvents.erase(newEvents.upper_bound(endTick), newEvents.end());
+
+        splice(std::move(newEvents));
+    }
+
+    bool isEmpty() const
+    {
+        return m_eventsMap.empty();
+    }
+
+    bool isLoaded(const midi::tick_t tick) const
+    {
+        return tick >= historyStartTick && tick < endTick;
+    }
+
+    //! NOTE Moves the position inside the loaded range without dropping the events
+    bool rewind(const midi::tick_t tick)
+    {
+        if (!isLoaded(tick)) {
+            return false;
+        }
+
+        while (!m_eventsMap.empty() && m_eventsMap.begin()->first < tick) {
+            moveNode(m_eventsMap, m_historyMap, m_eventsMap.begin());
+        }
+
+        auto it = m_historyMap.lower_bound(tick);
+        while (it != m_historyMap.end()) {
+            moveNode(m_historyMap, m_eventsMap, it++);
+        }
+
+        currentTick = tick;
+        isCurrentTickPassed = false;
+
+        return true;
+    }
+
+    void trimHistory(const midi::tick_t historySize)
+    {
+        if (currentTick < historyStartTick + historySize) {
+            return;
+        }
+
+        historyStartTick = currentTick - historySize;
+        m_historyMap.erase(m_historyMap.begin(), m_historyMap.lower_bound(historyStartTick));
+    }
+
+    void reset(const midi::tick_t tick = 0)
+    {
+        currentTick = tick;
+        endTick = tick;
+        historyStartTick = tick;
+        isCurrentTickPassed = false;
+        m_eventsMap.clear();
+        m_historyMap.clear();
+    }
+
+private:
+    //! NOTE The nodes of the ticks which are not in the buffer yet are moved without reallocation,
+    //! only the events of the already present ticks are appended
+    void splice(midi::Events&& newEvents)
+    {
+        m_eventsMap.merge(newEvents);
+
+        for (auto& pair : newEvents) {
+            std::vector<midi::Event>& eventsAtTick = m_eventsMap[pair.first];
+            eventsAtTick.insert(eventsAtTick.end(), std::make_move_iterator(pair.second.begin()),
+                                std::make_move_iterator(pair.second.end()));
+        }
+    }
+
+    static midi::Events::iterator moveNode(midi::Events& source, midi::Events& destination, midi::Events::iterator it)
+    {
+        auto result = destination.insert(source.extract(it));
+        if (!result.inserted) {
+            std::vector<midi::Event>& eventsAtTick = result.position->second;
+            eventsAtTick.insert(eventsAtTick.end(), std::make_move_iterator(result.node.mapped().begin()),
+                                std::make_move_iterator(result.node.mapped().end()));
+        }
+
+        return result.position;
+    }
+
+    static bool isNoteOff(const midi::Event& event)
+    {
+        return event.opcode() == midi::Event::Opcode::NoteOff
+               || (event.opcode() == midi::Event::Opcode::NoteOn && event.velocity() == 0);
+    }
+
+    midi::Events m_eventsMap;
+    midi::Events m_historyMap;
+};
+}
+
+#endif // MU_AUDIO_MIDIEVENTSBUFFER_H
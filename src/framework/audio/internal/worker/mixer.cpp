@@ -24,6 +24,7 @@
 #include "async/async.h"
 #include "log.h"
 
+#include <chrono>
 #include <limits>
 
 #include "internal/audiosanitizer.h"
@@ -63,7 +64,11 @@ RetVal<MixerChannelPtr> Mixer::addChannel(const TrackId trackId, IAudioSourcePtr
         return result;
     }
 
-    m_mixerChannels.emplace(trackId, std::make_shared<MixerChannel>(trackId, std::move(source), m_sampleRate));
+    MixerChannelPtr channel = std::make_shared<MixerChannel>(trackId, std::move(source), m_sampleRate);
+    channel->setMaxSourceSampleRate(m_maxSourceSampleRate);
+
+    m_mixerChannels.emplace(trackId, std::move(channel));
+    updateChannelsList();
 
     result.val = m_mixerChannels[trackId];
     result.ret = make_ret(Ret::Code::Ok);
@@ -79,6 +84,7 @@ Ret Mixer::removeChannel(const TrackId id)
 
     if (search != m_mixerChannels.end() && search->second) {
         m_mixerChannels.erase(id);
+        updateChannelsList();
         return make_ret(Ret::Code::Ok);
     }
 
@@ -89,13 +95,52 @@ void Mixer::setAudioChannelsCount(const audioch_t count)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    IF_ASSERT_FAILED(count <= MAX_SUPPORTED_AUDIO_CHANNELS) {
+        return;
+    }
+
     m_audioChannelsCount = count;
+    updateMasterGains();
+}
+
+void Mixer::setRenderWorkersCount(const size_t count)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_renderPool.init(count);
+}
+
+void Mixer::setParallelRenderThreshold(const size_t minChannelsCount)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_parallelRenderThreshold = minChannelsCount;
+}
+
+void Mixer::setVoicesBudget(const unsigned int count)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_voiceGovernor.setVoicesBudget(count);
+}
+
+void Mixer::setMaxSourceSampleRate(const unsigned int sampleRate)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_maxSourceSampleRate = sampleRate;
+
+    for (auto& channel : m_mixerChannels) {
+        channel.second->setMaxSourceSampleRate(sampleRate);
+    }
 }
 
 void Mixer::setSampleRate(unsigned int sampleRate)
 {
     ONLY_AUDIO_WORKER_THREAD;
     AbstractAudioSource::setSampleRate(sampleRate);
+    m_masterSignalMeter.setSampleRate(sampleRate);
+    m_telemetryMeter.setSampleRate(sampleRate);
 
     for (auto& channel : m_mixerChannels) {
         channel.second->setSampleRate(sampleRate);
@@ -113,20 +158,33 @@ void Mixer::process(float* outBuffer, unsigned int samplesPerChannel)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    ProcessingTimeMeter::Clock::time_point startTime = ProcessingTimeMeter::Clock::now();
+
     for (IClockPtr clock : m_clocks) {
         clock->forward((samplesPerChannel * 1000) / m_sampleRate);
     }
 
     std::fill(outBuffer, outBuffer + samplesPerChannel * audioChannelsCount(), 0.f);
+    m_masterSquaredSums.fill(0.f);
 
-    if (m_writeCacheBuff.size() != samplesPerChannel * audioChannelsCount()) {
-        m_writeCacheBuff.resize(samplesPerChannel * audioChannelsCount(), 0.f);
+    for (MixerChannel* channel : m_channelsList) {
+        channel->prepareProcessing(samplesPerChannel);
     }
 
-    for (auto& channel : m_mixerChannels) {
-        channel.second->process(m_writeCacheBuff.data(), samplesPerChannel);
-        mixOutput(outBuffer, m_writeCacheBuff.data(), samplesPerChannel);
-        std::fill(m_writeCacheBuff.begin(), m_writeCacheBuff.end(), 0.f);
+    bool parallelRenderAllowed = m_renderPool.workersCount() > 0
+                                 && m_channelsList.size() > 1
+                                 && m_channelsList.size() >= m_parallelRenderThreshold;
+
+    if (parallelRenderAllowed) {
+        processChannelsParallel(outBuffer, samplesPerChannel);
+    } else {
+        processChannels(outBuffer, samplesPerChannel);
+    }
+
+    if (m_masterParams.muted) {
+        m_masterSignalMeter.reset();
+    } else {
+        m_masterSignalMeter.accumulate(m_masterSquaredSums.data(), audioChannelsCount(), samplesPerChannel);
     }
 
     // TODO add limiter
@@ -136,6 +194,68 @@ void Mixer::process(float* outBuffer, unsigned int samplesPerChannel)
             fxProcessor->process(outBuffer, samplesPerChannel);
         }
     }
+
+    ProcessingTimeMeter::Clock::duration processingTime = ProcessingTimeMeter::Clock::now() - startTime;
+
+    if (m_sampleRate > 0 && samplesPerChannel > 0) {
+        double playbackSecs = static_cast<double>(samplesPerChannel) / static_cast<double>(m_sampleRate);
+        double processingSecs = std::chrono::duration<double>(processingTime).count();
+        m_voiceGovernor.update(static_cast<float>(processingSecs / playbackSecs), m_channelsList);
+    }
+
+    if (m_telemetryMeter.accumulate(processingTime, samplesPerChannel)) {
+        publishTelemetry();
+    }
+}
+
+void Mixer::processChannels(float* outBuffer, unsigned int samplesPerChannel)
+{
+    if (m_writeCacheBuff.size() != samplesPerChannel * audioChannelsCount()) {
+        m_writeCacheBuff.resize(samplesPerChannel * audioChannelsCount(), 0.f);
+    }
+
+    for (MixerChannel* channel : m_channelsList) {
+        channel->process(m_writeCacheBuff.data(), samplesPerChannel);
+        mixOutput(outBuffer, m_writeCacheBuff.data(), samplesPerChannel);
+        std::fill(m_writeCacheBuff.begin(), m_writeCacheBuff.end(), 0.f);
+    }
+}
+
+void Mixer::processChannelsParallel(float* outBuffer, unsigned int samplesPerChannel)
+{
+    size_t bufferSize = samplesPerChannel * audioChannelsCount();
+
+    //! NOTE The buffers are reallocated only when the channels list or the block size has changed
+    if (m_channelsWriteCacheBuff.size() != m_channelsList.size()) {
+        m_channelsWriteCacheBuff.resize(m_channelsList.size());
+    }
+
+    for (std::vector<float>& buffer : m_channelsWriteCacheBuff) {
+        if (buffer.size() != bufferSize) {
+            buffer.resize(bufferSize, 0.f);
+        }
+    }
+
+    //! NOTE Each channel owns its own synthesizer and fx chain, so channels don't share any state while rendering
+    m_renderPool.parallelFor(m_channelsList.size(), [this, samplesPerChannel](size_t idx) {
+        std::vector<float>& buffer = m_channelsWriteCacheBuff[idx];
+        std::fill(buffer.begin(), buffer.end(), 0.f);
+        m_channelsList[idx]->process(buffer.data(), samplesPerChannel);
+    });
+
+    //! NOTE Mixing is done in the channels order, so the result is the same as in the serial mode
+    for (std::vector<float>& buffer : m_channelsWriteCacheBuff) {
+        mixOutput(outBuffer, buffer.data(), samplesPerChannel);
+    }
+}
+
+void Mixer::updateChannelsList()
+{
+    m_channelsList.clear();
+
+    for (auto& pair : m_mixerChannels) {
+        m_channelsList.push_back(pair.second.get());
+    }
 }
 
 void Mixer::addClock(IClockPtr clock)
@@ -168,6 +288,7 @@ void Mixer::setMasterOutputParams(const AudioOutputParams& params)
     }
 
     m_masterParams = params;
+    updateMasterGains();
 
     m_masterFxProcessors.clear();
     m_masterFxProcessors = fxResolver()->resolveMasterFxList(params.fxParams);
@@ -183,14 +304,21 @@ Channel<AudioOutputParams> Mixer::masterOutputParamsChanged() const
     return m_masterOutputParamsChanged;
 }
 
-Channel<audioch_t, float> Mixer::masterSignalAmplitudeRmsChanged() const
+AudioSignalsSnapshotPtr Mixer::masterSignalsSnapshot() const
+{
+    return m_masterSignalMeter.snapshot();
+}
+
+void Mixer::setOutputBuffer(std::weak_ptr<IAudioBuffer> buffer)
 {
-    return m_masterSignalAmplitudeRmsChanged;
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_telemetryMeter.setOutputBuffer(std::move(buffer));
 }
 
-Channel<audioch_t, float> Mixer::masterVolumePressureDbfsChanged() const
+Channel<AudioTelemetry> Mixer::telemetryUpdated() const
 {
-    return m_masterVolumePressureDbfsChanged;
+    return m_telemetryMeter.telemetryUpdated();
 }
 
 void Mixer::mixOutput(float* outBuffer, float* inBuffer, unsigned int samplesCount)
@@ -203,23 +331,31 @@ void Mixer::mixOutput(float* outBuffer, float* inBuffer, unsigned int samplesCou
         return;
     }
 
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        float squaredSum = 0.f;
+    //! NOTE Only the last mixed channel matters, it gives the power of the whole mix
+    m_masterSquaredSums.fill(0.f);
 
-        gain_t totalGain = balanceGain(m_masterParams.balance, audioChNum) * gainFromDecibels(m_masterParams.volume);
+    mixWithGain(outBuffer, inBuffer, m_masterGains.data(), audioChannelsCount(), samplesCount, m_masterSquaredSums.data());
+}
 
-        for (samples_t s = 0; s < samplesCount; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
+void Mixer::publishTelemetry()
+{
+    AudioTelemetry telemetry;
+    telemetry.channels.reserve(m_channelsList.size());
 
-            float resultSample = (outBuffer[idx] + inBuffer[idx]) * totalGain;
+    for (MixerChannel* channel : m_channelsList) {
+        telemetry.channels.push_back(channel->takeTelemetry());
+        m_stolenVoicesCount += telemetry.channels.back().stolenVoicesCount;
+    }
 
-            outBuffer[idx] = resultSample;
+    telemetry.voicesBudget = m_voiceGovernor.voicesBudget();
+    telemetry.stolenVoicesCount = m_stolenVoicesCount;
 
-            squaredSum += resultSample * resultSample;
-        }
+    m_telemetryMeter.publish(std::move(telemetry));
+}
 
-        float rms = samplesRootMeanSquare(std::move(squaredSum), samplesCount);
-        m_masterSignalAmplitudeRmsChanged.send(audioChNum, rms);
-        m_masterVolumePressureDbfsChanged.send(audioChNum, dbFullScaleFromSample(rms));
+void Mixer::updateMasterGains()
+{
+    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
+        m_masterGains[audioChNum] = balanceGain(m_masterParams.balance, audioChNum) * gainFromDecibels(m_masterParams.volume);
     }
 }
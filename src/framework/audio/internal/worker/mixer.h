@@ -24,11 +24,17 @@
 
 #include <memory>
 #include <map>
+#include <array>
 
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
 
+#include "internal/audioworkerpool.h"
+
 #include "abstractaudiosource.h"
+#include "audiosignalmeter.h"
+#include "audiotelemetrymeter.h"
+#include "voicegovernor.h"
 #include "mixerchannel.h"
 #include "ifxresolver.h"
 #include "iclock.h"
@@ -48,6 +54,15 @@ public:
 
     void setAudioChannelsCount(const audioch_t count);
 
+    void setRenderWorkersCount(const size_t count);
+    void setParallelRenderThreshold(const size_t minChannelsCount);
+
+    //! NOTE The voices all the synthesizers may play at once, 0 means no budget
+    void setVoicesBudget(const unsigned int count);
+
+    //! NOTE The sources render at most at this rate, each channel resamples its source to the rate of the mixer
+    void setMaxSourceSampleRate(const unsigned int sampleRate);
+
     void addClock(IClockPtr clock);
     void removeClock(IClockPtr clock);
 
@@ -55,8 +70,11 @@ public:
     void setMasterOutputParams(const AudioOutputParams& params);
     async::Channel<AudioOutputParams> masterOutputParamsChanged() const;
 
-    async::Channel<audioch_t, float> masterSignalAmplitudeRmsChanged() const;
-    async::Channel<audioch_t, volume_dbfs_t> masterVolumePressureDbfsChanged() const;
+    AudioSignalsSnapshotPtr masterSignalsSnapshot() const;
+
+    //! NOTE The buffer the mix is written to, its fill level is a part of the telemetry
+    void setOutputBuffer(std::weak_ptr<IAudioBuffer> buffer);
+    async::Channel<AudioTelemetry> telemetryUpdated() const;
 
     // IAudioSource
     void setSampleRate(unsigned int sampleRate) override;
@@ -64,10 +82,22 @@ public:
     void process(float* outBuffer, unsigned int samplesPerChannel) override;
 
 private:
+    void processChannels(float* outBuffer, unsigned int samplesPerChannel);
+    void processChannelsParallel(float* outBuffer, unsigned int samplesPerChannel);
     void mixOutput(float* outBuffer, float* inBuffer, unsigned int samplesCount);
+    void updateMasterGains();
+    void publishTelemetry();
+
+    void updateChannelsList();
 
     std::vector<float> m_writeCacheBuff;
 
+    AudioWorkerPool m_renderPool;
+    size_t m_parallelRenderThreshold = 0;
+    unsigned int m_maxSourceSampleRate = 0;
+    std::vector<MixerChannel*> m_channelsList;
+    std::vector<std::vector<float> > m_channelsWriteCacheBuff;
+
     AudioOutputParams m_masterParams;
     async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
     std::vector<IFxProcessorPtr> m_masterFxProcessors = {};
@@ -77,8 +107,13 @@ private:
     std::set<IClockPtr> m_clocks;
     audioch_t m_audioChannelsCount = 0;
 
-    async::Channel<audioch_t, float> m_masterSignalAmplitudeRmsChanged;
-    async::Channel<audioch_t, volume_dbfs_t> m_masterVolumePressureDbfsChanged;
+    std::array<gain_t, MAX_SUPPORTED_AUDIO_CHANNELS> m_masterGains = {};
+    std::array<float, MAX_SUPPORTED_AUDIO_CHANNELS> m_masterSquaredSums = {};
+    AudioSignalMeter m_masterSignalMeter;
+    AudioTelemetryMeter m_telemetryMeter;
+
+    VoiceGovernor m_voiceGovernor;
+    uint64_t m_stolenVoicesCount = 0;
 };
 
 using MixerPtr = std::shared_ptr<Mixer>;
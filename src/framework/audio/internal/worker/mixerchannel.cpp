@@ -21,6 +21,9 @@
  */
 #include "mixerchannel.h"
 
+#include <algorithm>
+#include <array>
+
 #include "log.h"
 
 #include "internal/audiomathutils.h"
@@ -35,6 +38,8 @@ MixerChannel::MixerChannel(const TrackId trackId, IAudioSourcePtr source, const
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    m_trackInput = std::dynamic_pointer_cast<ITrackAudioInput>(m_audioSource);
+
     setSampleRate(sampleRate);
 }
 
@@ -54,17 +59,18 @@ void MixerChannel::applyOutputParams(const AudioOutputParams& originParams, Audi
         fx->setSampleRate(m_sampleRate);
     }
 
-    resultParams = m_params;
-}
+    m_fxTimeMeters.assign(m_fxProcessors.size(), ProcessingTimeMeter());
 
-Channel<audioch_t, float> MixerChannel::signalAmplitudeRmsChanged() const
-{
-    return m_signalAmplitudeRmsChanged;
+    if (m_frozenSource) {
+        m_frozenSource->setFxParams(originParams.fxParams);
+    }
+
+    resultParams = m_params;
 }
 
-Channel<audioch_t, volume_dbfs_t> MixerChannel::volumePressureDbfsChanged() const
+AudioSignalsSnapshotPtr MixerChannel::signalsSnapshot() const
 {
-    return m_volumePressureDbfsChanged;
+    return m_signalMeter.snapshot();
 }
 
 bool MixerChannel::isActive() const
@@ -89,17 +95,61 @@ void MixerChannel::setSampleRate(unsigned int sampleRate)
         return;
     }
 
-    m_audioSource->setSampleRate(sampleRate);
+    m_sampleRate = sampleRate;
+
+    m_signalMeter.setSampleRate(sampleRate);
 
     for (IFxProcessorPtr fx : m_fxProcessors) {
         fx->setSampleRate(sampleRate);
     }
+
+    updateSourceSampleRate();
 }
 
-unsigned int MixerChannel::audioChannelsCount() const
+void MixerChannel::setMaxSourceSampleRate(unsigned int sampleRate)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    m_maxSourceSampleRate = sampleRate;
+
+    updateSourceSampleRate();
+}
+
+unsigned int MixerChannel::sourceSampleRate() const
+{
+    return m_sourceSampleRate;
+}
+
+void MixerChannel::updateSourceSampleRate()
+{
+    IF_ASSERT_FAILED(m_audioSource) {
+        return;
+    }
+
+    unsigned int sourceSampleRate = m_sampleRate;
+    if (m_maxSourceSampleRate > 0) {
+        sourceSampleRate = std::min(sourceSampleRate, m_maxSourceSampleRate);
+    }
+
+    if (sourceSampleRate != m_sourceSampleRate) {
+        m_sourceSampleRate = sourceSampleRate;
+
+        m_audioSource->setSampleRate(m_sourceSampleRate);
+
+        if (m_frozenSource) {
+            m_frozenSource->setSampleRate(m_sourceSampleRate);
+        }
+    }
+
+    if (m_sourceSampleRate != m_sampleRate && m_sourceSampleRate > 0) {
+        m_resampler.setup(std::max(m_audioSource->audioChannelsCount(), 1u), m_sourceSampleRate, m_sampleRate);
+    }
+}
+
+unsigned int MixerChannel::audioChannelsCount() const
+{
+    ONLY_AUDIO_PROCESS_THREAD;
+
     IF_ASSERT_FAILED(m_audioSource) {
         return 0;
     }
@@ -120,7 +170,7 @@ async::Channel<unsigned int> MixerChannel::audioChannelsCountChanged() const
 
 void MixerChannel::process(float* buffer, unsigned int sampleCount)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_PROCESS_THREAD;
 
     IF_ASSERT_FAILED(m_audioSource) {
         return;
@@ -128,39 +178,175 @@ void MixerChannel::process(float* buffer, unsigned int sampleCount)
 
     if (m_params.muted) {
         std::fill(buffer, buffer + sampleCount * audioChannelsCount(), 0.f);
+        m_signalMeter.reset();
         return;
     }
 
-    m_audioSource->process(buffer, sampleCount);
+    ProcessingTimeMeter::Clock::time_point startTime = ProcessingTimeMeter::Clock::now();
 
-    for (IFxProcessorPtr fx : m_fxProcessors) {
-        if (!fx->active()) {
+    if (m_sourceSampleRate == m_sampleRate) {
+        processSource(buffer, sampleCount);
+    } else {
+        processResampledSource(buffer, sampleCount);
+    }
+
+    ProcessingTimeMeter::Clock::time_point finishTime = ProcessingTimeMeter::Clock::now();
+    m_sourceTimeMeter.accumulate(finishTime - startTime, sampleCount, m_sampleRate);
+
+    m_peakVoicesCount = std::max(m_peakVoicesCount, activeVoicesCount());
+
+    //! NOTE The frozen segments contain the output of the fx already
+    bool isFxApplied = m_frozenSource && m_frozenSource->isPlayingFrozen();
+
+    for (size_t i = 0; i < m_fxProcessors.size(); ++i) {
+        IFxProcessor* fx = m_fxProcessors[i].get();
+        if (isFxApplied || !fx->active()) {
             continue;
         }
+
+        startTime = finishTime;
         fx->process(buffer, sampleCount);
+        finishTime = ProcessingTimeMeter::Clock::now();
+
+        m_fxTimeMeters[i].accumulate(finishTime - startTime, sampleCount, m_sampleRate);
     }
 
     completeOutput(buffer, sampleCount);
 }
 
-void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) const
+void MixerChannel::prepareProcessing(unsigned int sampleCount)
 {
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        float squaredSum = 0.f;
+    ONLY_AUDIO_WORKER_THREAD;
 
-        gain_t totalGain = balanceGain(m_params.balance, audioChNum) * gainFromDecibels(m_params.volume);
+    if (!m_frozenSource || m_params.muted) {
+        return;
+    }
 
-        for (unsigned int s = 0; s < samplesCount; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
+    samples_t sourceSampleCount = sampleCount;
+    if (m_sourceSampleRate != m_sampleRate) {
+        sourceSampleCount = m_resampler.requiredInputFrames(sampleCount);
+    }
 
-            buffer[idx] = buffer[idx] * totalGain;
+    m_frozenSource->prepareProcessing(sourceSampleCount);
+}
 
-            squaredSum += buffer[idx] * buffer[idx];
-        }
+void MixerChannel::processSource(float* buffer, unsigned int sampleCount)
+{
+    if (m_frozenSource) {
+        m_frozenSource->process(buffer, sampleCount);
+    } else {
+        m_audioSource->process(buffer, sampleCount);
+    }
+}
+
+void MixerChannel::processResampledSource(float* buffer, unsigned int sampleCount)
+{
+    audioch_t channelsCount = audioChannelsCount();
+    if (channelsCount == 0) {
+        return;
+    }
+
+    //! NOTE The source may change its channels count, the state of the resampler starts over then
+    if (m_resampler.audioChannelsCount() != channelsCount) {
+        m_resampler.setup(channelsCount, m_sourceSampleRate, m_sampleRate);
+    }
+
+    //! NOTE The buffers only grow with the first blocks, the next ones are processed without allocations
+    samples_t inputFrames = m_resampler.requiredInputFrames(sampleCount);
+    if (m_sourceBuffer.size() < inputFrames * channelsCount) {
+        m_sourceBuffer.resize(inputFrames * channelsCount);
+        m_resampler.reserve(inputFrames);
+    }
+
+    std::fill(m_sourceBuffer.begin(), m_sourceBuffer.begin() + inputFrames * channelsCount, 0.f);
+    processSource(m_sourceBuffer.data(), static_cast<unsigned int>(inputFrames));
+
+    samples_t writtenFrames = m_resampler.process(m_sourceBuffer.data(), inputFrames, buffer, sampleCount);
+
+    IF_ASSERT_FAILED(writtenFrames == sampleCount) {
+        std::fill(buffer + writtenFrames * channelsCount, buffer + sampleCount * channelsCount, 0.f);
+    }
+}
+
+void MixerChannel::setFrozenSource(FrozenTrackSourcePtr source)
+{
+    ONLY_AUDIO_WORKER_THREAD;
 
-        float rms = samplesRootMeanSquare(std::move(squaredSum), samplesCount);
+    m_frozenSource = std::move(source);
+
+    if (m_frozenSource) {
+        m_frozenSource->setSampleRate(m_sourceSampleRate);
+        m_frozenSource->setFxParams(m_params.fxParams);
+    }
+}
+
+unsigned int MixerChannel::activeVoicesCount() const
+{
+    ITrackAudioInput* input = trackInput();
+    return input ? input->activeVoicesCount() : 0;
+}
+
+void MixerChannel::setVoicesLimit(unsigned int limit)
+{
+    ONLY_AUDIO_WORKER_THREAD;
 
-        m_signalAmplitudeRmsChanged.send(audioChNum, rms);
-        m_volumePressureDbfsChanged.send(audioChNum, dbFullScaleFromSample(rms));
+    if (ITrackAudioInput* input = trackInput()) {
+        input->setVoicesLimit(limit);
     }
 }
+
+AudioChannelTelemetry MixerChannel::takeTelemetry()
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    AudioChannelTelemetry telemetry;
+    telemetry.trackId = m_trackId;
+    telemetry.sourceLoad = m_sourceTimeMeter.take();
+    telemetry.activeVoicesCount = m_peakVoicesCount;
+
+    if (ITrackAudioInput* input = trackInput()) {
+        //! NOTE The counter starts over with a new synthesizer
+        unsigned int stolenVoicesCount = input->stolenVoicesCount();
+        telemetry.stolenVoicesCount = stolenVoicesCount >= m_lastStolenVoicesCount
+                                      ? stolenVoicesCount - m_lastStolenVoicesCount
+                                      : stolenVoicesCount;
+        m_lastStolenVoicesCount = stolenVoicesCount;
+    }
+
+    for (size_t i = 0; i < m_fxProcessors.size(); ++i) {
+        AudioFxTelemetry fx;
+        fx.resourceId = m_fxProcessors[i]->resourceId();
+        fx.load = m_fxTimeMeters[i].take();
+
+        telemetry.fx.push_back(std::move(fx));
+    }
+
+    m_peakVoicesCount = 0;
+
+    return telemetry;
+}
+
+void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount)
+{
+    audioch_t channelsCount = audioChannelsCount();
+
+    IF_ASSERT_FAILED(channelsCount <= MAX_SUPPORTED_AUDIO_CHANNELS) {
+        return;
+    }
+
+    std::array<gain_t, MAX_SUPPORTED_AUDIO_CHANNELS> gains = {};
+    std::array<float, MAX_SUPPORTED_AUDIO_CHANNELS> squaredSums = {};
+
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        gains[audioChNum] = balanceGain(m_params.balance, audioChNum) * gainFromDecibels(m_params.volume);
+    }
+
+    applyGain(buffer, gains.data(), channelsCount, samplesCount, squaredSums.data());
+
+    m_signalMeter.accumulate(squaredSums.data(), channelsCount, samplesCount);
+}
+
+ITrackAudioInput* MixerChannel::trackInput() const
+{
+    return m_frozenSource ? m_frozenSource.get() : m_trackInput.get();
+}
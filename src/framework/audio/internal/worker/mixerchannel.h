@@ -29,6 +29,10 @@
 #include "ifxresolver.h"
 #include "ifxprocessor.h"
 #include "track.h"
+#include "audiosignalmeter.h"
+#include "audiotelemetrymeter.h"
+#include "resampler.h"
+#include "internal/freeze/frozentracksource.h"
 
 namespace mu::audio {
 class MixerChannel : public ITrackAudioOutput, public async::Asyncable
@@ -40,8 +44,7 @@ public:
 
     void applyOutputParams(const AudioOutputParams& originParams, AudioOutputParams& resultParams) override;
 
-    async::Channel<audioch_t, float> signalAmplitudeRmsChanged() const override;
-    async::Channel<audioch_t, volume_dbfs_t> volumePressureDbfsChanged() const override;
+    AudioSignalsSnapshotPtr signalsSnapshot() const override;
 
     bool isActive() const override;
     void setIsActive(bool arg) override;
@@ -51,19 +54,53 @@ public:
     async::Channel<unsigned int> audioChannelsCountChanged() const override;
     void process(float* buffer, unsigned int sampleCount) override;
 
+    //! NOTE Called by the worker before the block is processed, the processing itself may run on the render pool
+    void prepareProcessing(unsigned int sampleCount);
+
+    //! NOTE The source renders at most at this rate and its output is resampled to the rate of the channel,
+    //!      0 means the rate of the channel
+    void setMaxSourceSampleRate(unsigned int sampleRate);
+    unsigned int sourceSampleRate() const;
+
+    //! NOTE The frozen source replaces the source of the channel, until it's reset
+    void setFrozenSource(FrozenTrackSourcePtr source);
+
+    //! NOTE The voices played by the source right now, 0 for the sources without voices
+    unsigned int activeVoicesCount() const;
+    void setVoicesLimit(unsigned int limit);
+
+    //! NOTE Returns the telemetry accumulated since the previous call and starts over
+    AudioChannelTelemetry takeTelemetry();
+
 private:
-    void completeOutput(float* buffer, unsigned int samplesCount) const;
+    void updateSourceSampleRate();
+    void processSource(float* buffer, unsigned int sampleCount);
+    void processResampledSource(float* buffer, unsigned int sampleCount);
+
+    void completeOutput(float* buffer, unsigned int samplesCount);
+    ITrackAudioInput* trackInput() const;
 
     TrackId m_trackId = -1;
 
     unsigned int m_sampleRate = 0;
+    unsigned int m_maxSourceSampleRate = 0;
+    unsigned int m_sourceSampleRate = 0;
     AudioOutputParams m_params;
 
     IAudioSourcePtr m_audioSource = nullptr;
+    FrozenTrackSourcePtr m_frozenSource = nullptr;
     std::vector<IFxProcessorPtr> m_fxProcessors = {};
 
-    mutable async::Channel<audioch_t, float> m_signalAmplitudeRmsChanged;
-    mutable async::Channel<audioch_t, volume_dbfs_t> m_volumePressureDbfsChanged;
+    Resampler m_resampler;
+    std::vector<float> m_sourceBuffer;
+
+    AudioSignalMeter m_signalMeter;
+
+    ITrackAudioInputPtr m_trackInput = nullptr;
+    ProcessingTimeMeter m_sourceTimeMeter;
+    std::vector<ProcessingTimeMeter> m_fxTimeMeters;
+    unsigned int m_peakVoicesCount = 0;
+    unsigned int m_lastStolenVoicesCount = 0;
 };
 
 using MixerChannelPtr = std::shared_ptr<MixerChannel>;
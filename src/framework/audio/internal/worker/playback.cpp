@@ -31,6 +31,7 @@
 #include "internal/worker/trackshandler.h"
 #include "internal/worker/audiooutputhandler.h"
 #include "internal/worker/tracksequence.h"
+#include "internal/worker/audioengine.h"
 
 #include "audioerrors.h"
 
@@ -45,6 +46,10 @@ void Playback::init()
     m_playerHandlersPtr = std::make_shared<PlayerHandler>(this);
     m_trackHandlersPtr = std::make_shared<TracksHandler>(this);
     m_audioOutputPtr = std::make_shared<AudioOutputHandler>(this);
+
+    AudioEngine::instance()->mixer()->telemetryUpdated().onReceive(this, [this](const AudioTelemetry& telemetry) {
+        m_telemetryUpdated.send(telemetry);
+    });
 }
 
 Promise<TrackSequenceId> Playback::addSequence()
@@ -127,6 +132,13 @@ IAudioOutputPtr Playback::audioOutput() const
     return m_audioOutputPtr;
 }
 
+Channel<AudioTelemetry> Playback::telemetryUpdated() const
+{
+    ONLY_AUDIO_MAIN_OR_WORKER_THREAD;
+
+    return m_telemetryUpdated;
+}
+
 ITrackSequencePtr Playback::sequence(const TrackSequenceId id) const
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -50,6 +50,8 @@ public:
     ITracksPtr tracks() const override;
     IAudioOutputPtr audioOutput() const override;
 
+    async::Channel<AudioTelemetry> telemetryUpdated() const override;
+
 protected:
     // IGetTrackSequence
     ITrackSequencePtr sequence(const TrackSequenceId id) const override;
@@ -63,6 +65,7 @@ private:
 
     async::Channel<TrackSequenceId> m_sequenceAdded;
     async::Channel<TrackSequenceId> m_sequenceRemoved;
+    async::Channel<AudioTelemetry> m_telemetryUpdated;
 };
 }
 
@@ -0,0 +1,300 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "internal/audiomathutils.h"
+#include "log.h"
+
+using namespace mu::audio;
+
+//! NOTE The quality of the conversion: the filter length per phase for the upsampling,
+//! it grows proportionally to the ratio for the downsampling
+static constexpr samples_t BASE_TAPS_COUNT = 32;
+static constexpr samples_t MAX_PHASES_COUNT = 1024;
+static constexpr double ROLLOFF = 0.95;
+static constexpr double KAISER_BETA = 8.6; // ~ 90 dB of the stopband attenuation
+static constexpr samples_t CONVERT_BLOCK_SIZE = 4096;
+
+static double zeroBessel(const double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = x / 2.0;
+
+    for (int k = 1; k < 64; ++k) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+
+    return sum;
+}
+
+static double sinc(const double x)
+{
+    if (x == 0.0) {
+        return 1.0;
+    }
+
+    return std::sin(M_PI * x) / (M_PI * x);
+}
+
+Resampler::Resampler(const audioch_t audioChannelsCount, const unsigned int sampleRateIn, const unsigned int sampleRateOut)
+{
+    setup(audioChannelsCount, sampleRateIn, sampleRateOut);
+}
+
+void Resampler::setup(const audioch_t audioChannelsCount, const unsigned int sampleRateIn, const unsigned int sampleRateOut)
+{
+    IF_ASSERT_FAILED(audioChannelsCount > 0 && sampleRateIn > 0 && sampleRateOut > 0) {
+        return;
+    }
+
+    bool ratioChanged = m_sampleRateIn != sampleRateIn || m_sampleRateOut != sampleRateOut;
+
+    m_audioChannelsCount = audioChannelsCount;
+    m_sampleRateIn = sampleRateIn;
+    m_sampleRateOut = sampleRateOut;
+
+    if (ratioChanged) {
+        initFilterBank();
+    }
+
+    m_input.resize(m_audioChannelsCount);
+    reset();
+}
+
+void Resampler::initFilterBank()
+{
+    samples_t divisor = std::gcd(m_sampleRateIn, m_sampleRateOut);
+    m_L = m_sampleRateOut / divisor;
+    m_M = m_sampleRateIn / divisor;
+
+    m_phasesCount = std::min(m_L, MAX_PHASES_COUNT);
+
+    //! NOTE The cutoff is relative to the input Nyquist frequency,
+    //! it's lowered to the output Nyquist frequency for the downsampling
+    double ratio = std::min(1.0, m_sampleRateOut / static_cast<double>(m_sampleRateIn));
+    double cutoff = m_L == m_M ? 1.0 : ratio * ROLLOFF;
+
+    //! NOTE Keep the taps count a multiple of the vector size for the inner products
+    m_tapsCount = static_cast<samples_t>(std::ceil(BASE_TAPS_COUNT / ratio));
+    m_tapsCount = (m_tapsCount + simd::FLOAT4_SIZE - 1) / simd::FLOAT4_SIZE * simd::FLOAT4_SIZE;
+
+    const samples_t half = m_tapsCount / 2;
+    const double windowNorm = zeroBessel(KAISER_BETA);
+
+    m_filterBank.assign(m_phasesCount * m_tapsCount, 0.f);
+
+    for (samples_t phase = 0; phase < m_phasesCount; ++phase) {
+        double fraction = phase / static_cast<double>(m_phasesCount);
+        float* coefficients = m_filterBank.data() + phase * m_tapsCount;
+        double sum = 0.0;
+
+        for (samples_t tap = 0; tap < m_tapsCount; ++tap) {
+            //! NOTE The distance between the input frame of the tap and the output frame
+            double x = static_cast<double>(tap) - static_cast<double>(half - 1) - fraction;
+            double windowArg = x / half;
+            double window = std::abs(windowArg) < 1.0 ? zeroBessel(KAISER_BETA * std::sqrt(1.0 - windowArg * windowArg)) / windowNorm : 0.0;
+            double value = cutoff * sinc(cutoff * x) * window;
+
+            coefficients[tap] = static_cast<float>(value);
+            sum += value;
+        }
+
+        //! NOTE Unity gain for DC in each phase
+        if (sum != 0.0) {
+            for (samples_t tap = 0; tap < m_tapsCount; ++tap) {
+                coefficients[tap] = static_cast<float>(coefficients[tap] / sum);
+            }
+        }
+    }
+}
+
+void Resampler::reserve(const samples_t maxInputFramesPerBlock)
+{
+    for (std::vector<float>& channel : m_input) {
+        channel.reserve(maxInputFramesPerBlock + 2 * m_tapsCount);
+    }
+}
+
+void Resampler::reset()
+{
+    //! NOTE The history before the first input frame is silence
+    const samples_t half = m_tapsCount / 2;
+    for (std::vector<float>& channel : m_input) {
+        channel.assign(half - 1, 0.f);
+    }
+
+    m_position = half - 1;
+    m_phase = 0;
+}
+
+audioch_t Resampler::audioChannelsCount() const
+{
+    return m_audioChannelsCount;
+}
+
+unsigned int Resampler::sampleRateIn() const
+{
+    return m_sampleRateIn;
+}
+
+unsigned int Resampler::sampleRateOut() const
+{
+    return m_sampleRateOut;
+}
+
+samples_t Resampler::requiredInputFrames(const samples_t outputFrames) const
+{
+    if (outputFrames == 0 || m_input.empty()) {
+        return 0;
+    }
+
+    samples_t lastPosition = m_position + (m_phase + (outputFrames - 1) * m_M) / m_L;
+    samples_t requiredFrames = lastPosition + m_tapsCount / 2 + 1;
+    samples_t bufferedFrames = m_input.front().size();
+
+    return requiredFrames > bufferedFrames ? requiredFrames - bufferedFrames : 0;
+}
+
+samples_t Resampler::process(const float* input, const samples_t inputFrames, float* output, const samples_t maxOutputFrames)
+{
+    if (m_input.empty()) {
+        return 0;
+    }
+
+    push(input, inputFrames);
+    samples_t written = pull(output, maxOutputFrames);
+    dropConsumedFrames();
+
+    return written;
+}
+
+samples_t Resampler::flush(float* output, const samples_t maxOutputFrames)
+{
+    if (m_input.empty()) {
+        return 0;
+    }
+
+    for (std::vector<float>& channel : m_input) {
+        channel.resize(channel.size() + m_tapsCount / 2, 0.f);
+    }
+
+    samples_t written = pull(output, maxOutputFrames);
+    dropConsumedFrames();
+
+    return written;
+}
+
+std::vector<float> Resampler::convert(const std::vector<float>& input)
+{
+    if (m_input.empty()) {
+        return {};
+    }
+
+    reset();
+
+    const samples_t inputFrames = input.size() / m_audioChannelsCount;
+    const samples_t outputFrames = (inputFrames * m_L + m_M - 1) / m_M;
+
+    std::vector<float> output(outputFrames * m_audioChannelsCount, 0.f);
+    samples_t written = 0;
+
+    for (samples_t frame = 0; frame < inputFrames; frame += CONVERT_BLOCK_SIZE) {
+        samples_t blockSize = std::min(CONVERT_BLOCK_SIZE, inputFrames - frame);
+        written += process(input.data() + frame * m_audioChannelsCount, blockSize,
+                           output.data() + written * m_audioChannelsCount, outputFrames - written);
+    }
+
+    written += flush(output.data() + written * m_audioChannelsCount, outputFrames - written);
+    output.resize(written * m_audioChannelsCount);
+
+    reset();
+
+    return output;
+}
+
+void Resampler::push(const float* input, const samples_t inputFrames)
+{
+    for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
+        std::vector<float>& channel = m_input[audioChNum];
+        samples_t offset = channel.size();
+        channel.resize(offset + inputFrames);
+
+        for (samples_t frame = 0; frame < inputFrames; ++frame) {
+            channel[offset + frame] = input[frame * m_audioChannelsCount + audioChNum];
+        }
+    }
+}
+
+samples_t Resampler::pull(float* output, const samples_t maxOutputFrames)
+{
+    const samples_t half = m_tapsCount / 2;
+    const samples_t bufferedFrames = m_input.front().size();
+
+    samples_t written = 0;
+    while (written < maxOutputFrames && m_position + half < bufferedFrames) {
+        const float* coefficients = phaseCoefficients(m_phase);
+        const samples_t firstFrame = m_position - (half - 1);
+
+        for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
+            output[written * m_audioChannelsCount + audioChNum]
+                = simd::dotProduct(m_input[audioChNum].data() + firstFrame, coefficients, m_tapsCount);
+        }
+
+        ++written;
+
+        m_phase += m_M;
+        m_position += m_phase / m_L;
+        m_phase %= m_L;
+    }
+
+    return written;
+}
+
+void Resampler::dropConsumedFrames()
+{
+    const samples_t firstFrame = m_position - (m_tapsCount / 2 - 1);
+    if (firstFrame == 0) {
+        return;
+    }
+
+    const samples_t droppedFrames = std::min<samples_t>(firstFrame, m_input.front().size());
+    for (std::vector<float>& channel : m_input) {
+        channel.erase(channel.begin(), channel.begin() + droppedFrames);
+    }
+
+    m_position -= droppedFrames;
+}
+
+const float* Resampler::phaseCoefficients(const samples_t phase) const
+{
+    return m_filterBank.data() + (phase * m_phasesCount / m_L) * m_tapsCount;
+}
@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_RESAMPLER_H
+#define MU_AUDIO_RESAMPLER_H
+
+#include <vector>
+
+#include "audiotypes.h"
+
+namespace mu::audio {
+//! NOTE Streaming polyphase resampler for interleaved audio.
+//! The input is fed block by block, the state (history and phase) is kept between the blocks,
+//! so it can be used both in the realtime graph and for the long offline conversions
+class Resampler
+{
+public:
+    Resampler() = default;
+    Resampler(const audioch_t audioChannelsCount, const unsigned int sampleRateIn, const unsigned int sampleRateOut);
+
+    void setup(const audioch_t audioChannelsCount, const unsigned int sampleRateIn, const unsigned int sampleRateOut);
+
+    //! reserve the buffers, so the blocks up to the given size are processed without allocations
+    void reserve(const samples_t maxInputFramesPerBlock);
+
+    void reset();
+
+    audioch_t audioChannelsCount() const;
+    unsigned int sampleRateIn() const;
+    unsigned int sampleRateOut() const;
+
+    //! the number of input frames to feed to get the given number of output frames
+    samples_t requiredInputFrames(const samples_t outputFrames) const;
+
+    //! feed the input frames and write at most maxOutputFrames of the output, returns the number of written frames.
+    //! The input which is not converted yet is kept for the next call
+    samples_t process(const float* input, const samples_t inputFrames, float* output, const samples_t maxOutputFrames);
+
+    //! feed the silence to get the tail of the converted signal, when there is no more input
+    samples_t flush(float* output, const samples_t maxOutputFrames);
+
+    //! convert the whole interleaved data at once
+    std::vector<float> convert(const std::vector<float>& input);
+
+private:
+    void initFilterBank();
+
+    void push(const float* input, const samples_t inputFrames);
+    samples_t pull(float* output, const samples_t maxOutputFrames);
+    void dropConsumedFrames();
+
+    const float* phaseCoefficients(const samples_t phase) const;
+
+    audioch_t m_audioChannelsCount = 0;
+    unsigned int m_sampleRateIn = 0;
+    unsigned int m_sampleRateOut = 0;
+
+    //! the conversion ratio is L/M, the output frame advances the input by M/L frames
+    samples_t m_L = 1;
+    samples_t m_M = 1;
+
+    //! the phases of the filter bank, L when it is small enough, otherwise the nearest phase is used
+    samples_t m_phasesCount = 1;
+    samples_t m_tapsCount = 0;
+    std::vector<float> m_filterBank;
+
+    //! the deinterleaved input, the history for the filter is kept at the front
+    std::vector<std::vector<float> > m_input;
+    samples_t m_position = 0;
+    samples_t m_phase = 0;
+};
+}
+
+#endif // MU_AUDIO_RESAMPLER_H
@@ -25,6 +25,8 @@
 #include "log.h"
 
 #include "internal/audiosanitizer.h"
+#include "internal/freeze/frozentracksource.h"
+#include "internal/worker/mixerchannel.h"
 #include "audioerrors.h"
 
 using namespace mu;
@@ -114,28 +116,82 @@ Channel<TrackId, AudioOutputParams> SequenceIO::outputParamsChanged() const
     return m_outputParamsChanged;
 }
 
-Channel<audioch_t, float> SequenceIO::signalAmplitudeChanged(const TrackId id) const
+AudioSignalsSnapshotPtr SequenceIO::signalsSnapshot(const TrackId id) const
 {
     ONLY_AUDIO_WORKER_THREAD;
 
     IF_ASSERT_FAILED(m_getTracks) {
-        return {};
+        return nullptr;
     }
 
     TrackPtr track = m_getTracks->track(id);
 
-    return track->outputHandler->signalAmplitudeRmsChanged();
+    if (!track) {
+        return nullptr;
+    }
+
+    return track->outputHandler->signalsSnapshot();
 }
 
-Channel<audioch_t, volume_dbfs_t> SequenceIO::volumePressureChanged(const TrackId id) const
+Ret SequenceIO::setFrozen(const TrackId id, const bool frozen)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
     IF_ASSERT_FAILED(m_getTracks) {
-        return {};
+        return make_ret(Err::Undefined);
+    }
+
+    TrackPtr track = m_getTracks->track(id);
+
+    if (!track) {
+        return make_ret(Err::InvalidTrackId);
+    }
+
+    if (isFrozen(id) == frozen) {
+        return make_ret(Ret::Code::Ok);
+    }
+
+    MixerChannelPtr channel = std::dynamic_pointer_cast<MixerChannel>(track->outputHandler);
+
+    IF_ASSERT_FAILED(channel) {
+        return make_ret(Err::Undefined);
+    }
+
+    if (!frozen) {
+        FrozenTrackSourcePtr frozenSource = std::static_pointer_cast<FrozenTrackSource>(track->inputHandler);
+
+        channel->setFrozenSource(nullptr);
+        track->inputHandler = frozenSource->liveInput();
+
+        return make_ret(Ret::Code::Ok);
+    }
+
+    //! NOTE Only the fluid synth can be rendered aside from the playback
+    if (track->type != Midi || track->inputParams().type() != AudioSourceType::Fluid) {
+        return make_ret(Err::TrackIsNotFreezable);
+    }
+
+    const midi::MidiData& midiData = std::get<midi::MidiData>(track->playbackData());
+
+    auto frozenSource = std::make_shared<FrozenTrackSource>(id, midiData, track->inputHandler, track->inputParams(),
+                                                            track->outputParams().fxParams);
+    frozenSource->setIsActive(track->inputHandler->isActive());
+
+    track->inputHandler = frozenSource;
+    channel->setFrozenSource(frozenSource);
+
+    return make_ret(Ret::Code::Ok);
+}
+
+bool SequenceIO::isFrozen(const TrackId id) const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    IF_ASSERT_FAILED(m_getTracks) {
+        return false;
     }
 
     TrackPtr track = m_getTracks->track(id);
 
-    return track->outputHandler->volumePressureDbfsChanged();
+    return track && std::dynamic_pointer_cast<FrozenTrackSource>(track->inputHandler) != nullptr;
 }
@@ -42,8 +42,10 @@ public:
     async::Channel<TrackId, AudioInputParams> inputParamsChanged() const override;
     async::Channel<TrackId, AudioOutputParams> outputParamsChanged() const override;
 
-    async::Channel<audioch_t, float> signalAmplitudeChanged(const TrackId id) const override;
-    async::Channel<audioch_t, volume_dbfs_t> volumePressureChanged(const TrackId id) const override;
+    AudioSignalsSnapshotPtr signalsSnapshot(const TrackId id) const override;
+
+    Ret setFrozen(const TrackId id, const bool frozen) override;
+    bool isFrozen(const TrackId id) const override;
 
 private:
     IGetTracks* m_getTracks = nullptr;
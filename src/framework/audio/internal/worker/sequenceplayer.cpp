@@ -55,11 +55,8 @@ void SequencePlayer::seek(const msecs_t newPositionMsecs)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    //! NOTE The inputs are moved by the seekOccurred notification
     m_clock->seek(newPositionMsecs);
-
-    for (auto& pair : tracks()) {
-        pair.second->inputHandler->seek(newPositionMsecs);
-    }
 }
 
 void SequencePlayer::stop()
@@ -106,7 +103,17 @@ Ret SequencePlayer::setLoop(const msecs_t fromMsec, const msecs_t toMsec)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    return m_clock->setTimeLoop(fromMsec, toMsec);
+    Ret ret = m_clock->setTimeLoop(fromMsec, toMsec);
+    if (!ret) {
+        return ret;
+    }
+
+    //! NOTE The playback jumps to the loop start every time it reaches the loop end
+    for (auto& pair : tracks()) {
+        pair.second->inputHandler->prefetch(fromMsec);
+    }
+
+    return ret;
 }
 
 void SequencePlayer::resetLoop()
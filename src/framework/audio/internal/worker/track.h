@@ -45,7 +45,19 @@ public:
     virtual ~ITrackAudioInput() = default;
 
     virtual void seek(const msecs_t newPositionMsecs) = 0;
+
+    //! NOTE Prepares the data from the position the playback is likely to jump to,
+    //! so the seek to it doesn't wait for the data
+    virtual void prefetch(const msecs_t positionMsecs) = 0;
+
     virtual void applyInputParams(const AudioInputParams& originParams, AudioInputParams& resultParams) = 0;
+
+    //! NOTE Called by the thread which processes the input, right after the processing
+    virtual unsigned int activeVoicesCount() const = 0;
+
+    //! NOTE The most voices the input plays at once, 0 means no limit
+    virtual void setVoicesLimit(unsigned int limit) = 0;
+    virtual unsigned int stolenVoicesCount() const = 0; // may start over, when the synthesizer is changed
 };
 
 class ITrackAudioOutput : public IAudioSource
@@ -55,11 +67,7 @@ public:
 
     virtual void applyOutputParams(const AudioOutputParams& originParams, AudioOutputParams& resultParams) = 0;
 
-    // root mean square of a processed sample block
-    virtual async::Channel<audioch_t, float> signalAmplitudeRmsChanged() const = 0;
-
-    // root mean square of a processed sample block in the "decibels relative to full scale" units
-    virtual async::Channel<audioch_t, volume_dbfs_t> volumePressureDbfsChanged() const = 0;
+    virtual AudioSignalsSnapshotPtr signalsSnapshot() const = 0;
 };
 
 using ITrackAudioInputPtr = std::shared_ptr<ITrackAudioInput>;
@@ -0,0 +1,135 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "voicegovernor.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "log.h"
+
+using namespace mu::audio;
+
+//! NOTE The budget shrinks above the high load and grows back below the low one,
+//! the gap between them keeps it from swinging back and forth
+static constexpr float HIGH_LOAD = 0.75f;
+static constexpr float LOW_LOAD = 0.5f;
+static constexpr float LOAD_SMOOTHING = 0.5f;
+
+static constexpr float BUDGET_SHRINK_FACTOR = 0.8f;
+static constexpr float BUDGET_GROW_FACTOR = 1.02f;
+static constexpr float MIN_VOICES_BUDGET = 16.f;
+static constexpr unsigned int MIN_VOICES_PER_INSTANCE = 4;
+
+//! NOTE The stolen voices take a few milliseconds to fade out,
+//! the load is measured again only after they are gone
+static constexpr unsigned int SHRINK_COOLDOWN_BLOCKS_COUNT = 2;
+
+void VoiceGovernor::setVoicesBudget(const unsigned int count)
+{
+    m_maxVoicesBudget = count;
+    m_voicesBudget = static_cast<float>(count);
+    m_isBudgetReduced = false;
+}
+
+unsigned int VoiceGovernor::voicesBudget() const
+{
+    return static_cast<unsigned int>(m_voicesBudget);
+}
+
+void VoiceGovernor::update(const float load, const std::vector<MixerChannel*>& channels)
+{
+    if (m_maxVoicesBudget == 0) {
+        if (m_hasLimits) {
+            for (MixerChannel* channel : channels) {
+                channel->setVoicesLimit(0);
+            }
+
+            m_hasLimits = false;
+        }
+
+        return;
+    }
+
+    m_smoothedLoad += (load - m_smoothedLoad) * LOAD_SMOOTHING;
+
+    m_demands.resize(channels.size());
+    unsigned int activeVoicesCount = 0;
+
+    for (size_t i = 0; i < channels.size(); ++i) {
+        m_demands[i] = channels[i]->activeVoicesCount();
+        activeVoicesCount += m_demands[i];
+    }
+
+    if (m_cooldownBlocksCount > 0) {
+        --m_cooldownBlocksCount;
+    } else if (m_smoothedLoad >= HIGH_LOAD) {
+        //! NOTE Cut from the voices played now, the budget may be far above them
+        float budget = std::min(m_voicesBudget, static_cast<float>(activeVoicesCount)) * BUDGET_SHRINK_FACTOR;
+        m_voicesBudget = std::max(budget, MIN_VOICES_BUDGET);
+        m_cooldownBlocksCount = SHRINK_COOLDOWN_BLOCKS_COUNT;
+
+        if (!m_isBudgetReduced) {
+            LOGW() << "audio processing load: " << m_smoothedLoad << ", the voices budget is reduced to " << voicesBudget();
+            m_isBudgetReduced = true;
+        }
+    } else if (m_smoothedLoad < LOW_LOAD && m_voicesBudget < m_maxVoicesBudget) {
+        m_voicesBudget = std::min(m_voicesBudget * BUDGET_GROW_FACTOR + 1.f, static_cast<float>(m_maxVoicesBudget));
+
+        if (m_isBudgetReduced && voicesBudget() == m_maxVoicesBudget) {
+            LOGI() << "the voices budget is restored to " << m_maxVoicesBudget;
+            m_isBudgetReduced = false;
+        }
+    }
+
+    shareBudget(channels);
+}
+
+void VoiceGovernor::shareBudget(const std::vector<MixerChannel*>& channels)
+{
+    if (channels.empty()) {
+        return;
+    }
+
+    m_order.resize(channels.size());
+    std::iota(m_order.begin(), m_order.end(), 0);
+    std::sort(m_order.begin(), m_order.end(), [this](size_t a, size_t b) {
+        return m_demands[a] < m_demands[b];
+    });
+
+    //! NOTE Each instance gets an equal share, the part of it an instance doesn't play now
+    //! is shared between the busier ones. The limit of an instance is never lower than its share,
+    //! so a quiet instance may start playing without being cut right away
+    float remainingBudget = m_voicesBudget;
+    size_t remainingCount = m_order.size();
+
+    for (size_t idx : m_order) {
+        float share = remainingBudget / static_cast<float>(remainingCount);
+        unsigned int limit = std::max(static_cast<unsigned int>(share), MIN_VOICES_PER_INSTANCE);
+
+        channels[idx]->setVoicesLimit(limit);
+
+        remainingBudget -= std::min(static_cast<float>(m_demands[idx]), share);
+        --remainingCount;
+    }
+
+    m_hasLimits = true;
+}
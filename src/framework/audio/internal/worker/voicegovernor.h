@@ -0,0 +1,58 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_VOICEGOVERNOR_H
+#define MU_AUDIO_VOICEGOVERNOR_H
+
+#include <vector>
+
+#include "mixerchannel.h"
+
+namespace mu::audio {
+//! NOTE Shares the voices budget between the synthesizers of the mix. The budget shrinks,
+//! when the processing of the blocks approaches the deadline, and grows back, when the load drops,
+//! so the dense passages of large scores lose some voices instead of dropping out
+class VoiceGovernor
+{
+public:
+    void setVoicesBudget(const unsigned int count); // 0 means no budget
+    unsigned int voicesBudget() const;              // the current one, it's lower than the set one under the high load
+
+    //! NOTE Called after each processed block with its load, see AudioProcessingLoad
+    void update(const float load, const std::vector<MixerChannel*>& channels);
+
+private:
+    void shareBudget(const std::vector<MixerChannel*>& channels);
+
+    unsigned int m_maxVoicesBudget = 0;
+    float m_voicesBudget = 0.f;
+    bool m_hasLimits = false;
+
+    float m_smoothedLoad = 0.f;
+    unsigned int m_cooldownBlocksCount = 0;
+    bool m_isBudgetReduced = false;
+
+    std::vector<unsigned int> m_demands;
+    std::vector<size_t> m_order;
+};
+}
+
+#endif // MU_AUDIO_VOICEGOVERNOR_H
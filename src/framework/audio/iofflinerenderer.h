@@ -0,0 +1,69 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_IOFFLINERENDERER_H
+#define MU_AUDIO_IOFFLINERENDERER_H
+
+#include <functional>
+#include <vector>
+
+#include "modularity/imoduleexport.h"
+#include "ret.h"
+
+#include "audiotypes.h"
+
+namespace mu::audio {
+class IOfflineRenderer : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(IOfflineRenderer)
+
+public:
+    virtual ~IOfflineRenderer() = default;
+
+    struct Track {
+        midi::MidiMapping mapping;
+        std::vector<midi::Event> setupEvents;
+        midi::Events events;
+        midi::tick_t lastTick = 0;
+    };
+    using TrackList = std::vector<Track>;
+
+    struct Spec {
+        unsigned int sampleRate = 44100;
+        audioch_t audioChannelsCount = 2;
+        msecs_t tailMsecs = 1000; // release time after the last event
+    };
+
+    //! NOTE Receives interleaved samples, an error stops rendering
+    using BlockConsumer = std::function<Ret (const float* buffer, samples_t samplesPerChannel)>;
+    using ProgressHandler = std::function<void (msecs_t renderedMsecs, msecs_t totalMsecs)>;
+
+    //! NOTE Renders the tracks as fast as possible without an audio device.
+    //! Blocks until rendering is finished, the consumer is called on the caller's thread
+    virtual Ret render(const TrackList& tracks, const Spec& spec, const BlockConsumer& consumer,
+                       const ProgressHandler& progress = nullptr) = 0;
+    virtual void abort() = 0;
+};
+
+using IOfflineRendererPtr = std::shared_ptr<IOfflineRenderer>;
+}
+
+#endif // MU_AUDIO_IOFFLINERENDERER_H
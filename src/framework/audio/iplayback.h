@@ -58,6 +58,9 @@ public:
 
     // 4. Adjust a Sequence output
     virtual std::shared_ptr<IAudioOutput> audioOutput() const = 0;
+
+    // Performance of the audio worker, sent a few times per second
+    virtual async::Channel<AudioTelemetry> telemetryUpdated() const = 0;
 };
 
 using IPlaybackPtr = std::shared_ptr<IPlayback>;
@@ -51,6 +51,12 @@ public:
 
     virtual void allSoundsOff() = 0; // all channels
     virtual void flushSound() = 0;
+    virtual unsigned int activeVoicesCount() const = 0;
+
+    //! NOTE The most voices the synthesizer plays at once, 0 means no limit.
+    //! Over the limit the least important voices are stolen, i.e. faded out quickly
+    virtual void setVoicesLimit(unsigned int limit) = 0;
+    virtual unsigned int stolenVoicesCount() const = 0; // since the start
     virtual void midiChannelSoundsOff(midi::channel_t chan) = 0;
     virtual bool midiChannelVolume(midi::channel_t chan, float val) = 0;  // 0. - 1.
     virtual bool midiChannelBalance(midi::channel_t chan, float val) = 0; // -1. - 1.
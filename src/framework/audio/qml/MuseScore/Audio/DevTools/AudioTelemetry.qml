@@ -0,0 +1,116 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+import QtQuick 2.15
+
+import MuseScore.UiComponents 1.0
+import MuseScore.Audio 1.0
+
+Rectangle {
+    id: root
+
+    color: ui.theme.backgroundPrimaryColor
+
+    AudioTelemetryModel {
+        id: telemetryModel
+    }
+
+    function percent(value) {
+        return (value * 100).toFixed(1) + "%"
+    }
+
+    Flickable {
+        anchors.fill: parent
+        anchors.margins: 8
+        contentWidth: width
+        contentHeight: contentColumn.height
+        clip: true
+
+        Column {
+            id: contentColumn
+
+            width: parent.width
+            spacing: 4
+
+            StyledTextLabel {
+                height: 32
+                font: ui.theme.bodyBoldFont
+                text: "Audio worker"
+            }
+
+            StyledTextLabel {
+                horizontalAlignment: Text.AlignLeft
+                text: "Load: " + root.percent(telemetryModel.load) + ", peak: " + root.percent(telemetryModel.peakLoad)
+            }
+
+            StyledTextLabel {
+                horizontalAlignment: Text.AlignLeft
+                text: "Buffer fill (lowest): " + root.percent(telemetryModel.bufferFillLevel)
+            }
+
+            StyledTextLabel {
+                horizontalAlignment: Text.AlignLeft
+                text: "Buffer underruns: " + telemetryModel.bufferUnderrunsCount
+                      + ", driver xruns: " + telemetryModel.driverXrunsCount
+            }
+
+            StyledTextLabel {
+                horizontalAlignment: Text.AlignLeft
+                text: "Voices budget: " + (telemetryModel.voicesBudget > 0 ? telemetryModel.voicesBudget : "none")
+                      + ", stolen voices: " + telemetryModel.stolenVoicesCount
+            }
+
+            StyledTextLabel {
+                height: 40
+                verticalAlignment: Text.AlignBottom
+                font: ui.theme.bodyBoldFont
+                text: "Channels (the heaviest first)"
+            }
+
+            Repeater {
+                model: telemetryModel.channels
+
+                delegate: Column {
+                    width: contentColumn.width
+
+                    StyledTextLabel {
+                        horizontalAlignment: Text.AlignLeft
+                        text: modelData.name + " - load: " + root.percent(modelData.average)
+                              + ", peak: " + root.percent(modelData.peak)
+                              + ", voices: " + modelData.voices
+                              + (modelData.stolenVoices > 0 ? ", stolen: " + modelData.stolenVoices : "")
+                    }
+
+                    Repeater {
+                        model: modelData.fx
+
+                        delegate: StyledTextLabel {
+                            leftPadding: 24
+                            horizontalAlignment: Text.AlignLeft
+                            text: modelData.name + " - load: " + root.percent(modelData.average)
+                                  + ", peak: " + root.percent(modelData.peak)
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,205 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "internal/audioworkerpool.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+class AudioWorkerPoolTests : public ::testing::Test
+{
+public:
+    //! NOTE Runs the batch on the pool and checks, that each task is run exactly once
+    static void expectEachTaskOnce(AudioWorkerPool& pool, const size_t tasksCount)
+    {
+        std::vector<std::atomic<int> > runsCounts(tasksCount);
+        for (std::atomic<int>& count : runsCounts) {
+            count = 0;
+        }
+
+        pool.parallelFor(tasksCount, [&runsCounts](size_t idx) {
+            runsCounts[idx].fetch_add(1);
+        });
+
+        for (size_t idx = 0; idx < tasksCount; ++idx) {
+            EXPECT_EQ(runsCounts[idx].load(), 1) << "task: " << idx << " of " << tasksCount;
+        }
+    }
+};
+
+TEST_F(AudioWorkerPoolTests, ClaimEachTaskOnce)
+{
+    //! GIVEN Batch of 5 tasks
+    AudioTaskCounter counter;
+    uint32_t generation = counter.publish(5);
+
+    //! WHEN Claim the tasks
+    std::vector<uint32_t> claimed;
+    uint32_t idx = 0;
+    while (counter.claim(generation, idx)) {
+        claimed.push_back(idx);
+    }
+
+    //! THEN Each task is claimed once, in order
+    EXPECT_EQ(claimed, std::vector<uint32_t>({ 0, 1, 2, 3, 4 }));
+    EXPECT_FALSE(counter.claim(generation, idx));
+}
+
+TEST_F(AudioWorkerPoolTests, GenerationRollover)
+{
+    //! GIVEN Counter at the last generation
+    const uint32_t lastGeneration = std::numeric_limits<uint32_t>::max();
+    AudioTaskCounter counter(lastGeneration);
+
+    //! WHEN Publish the next batch
+    uint32_t generation = counter.publish(2);
+
+    //! THEN The generation wraps around to 0
+    EXPECT_EQ(generation, 0u);
+    EXPECT_EQ(counter.generation(), 0u);
+
+    //! THEN The tasks are claimed with the new generation only
+    uint32_t idx = 0;
+    EXPECT_FALSE(counter.claim(lastGeneration, idx));
+    EXPECT_TRUE(counter.claim(generation, idx));
+    EXPECT_EQ(idx, 0u);
+    EXPECT_TRUE(counter.claim(generation, idx));
+    EXPECT_EQ(idx, 1u);
+    EXPECT_FALSE(counter.claim(generation, idx));
+}
+
+TEST_F(AudioWorkerPoolTests, LateWorker)
+{
+    //! GIVEN Finished batch of 1 task
+    AudioTaskCounter counter;
+    uint32_t firstGeneration = counter.publish(1);
+
+    uint32_t idx = 0;
+    EXPECT_TRUE(counter.claim(firstGeneration, idx));
+
+    //! WHEN The next, bigger batch is published
+    uint32_t secondGeneration = counter.publish(8);
+
+    //! THEN A worker, which is late with the first generation, claims nothing
+    EXPECT_FALSE(counter.claim(firstGeneration, idx));
+
+    //! THEN The tasks of the second batch are all there
+    uint32_t claimedCount = 0;
+    while (counter.claim(secondGeneration, idx)) {
+        EXPECT_EQ(idx, claimedCount);
+        ++claimedCount;
+    }
+
+    EXPECT_EQ(claimedCount, 8u);
+}
+
+TEST_F(AudioWorkerPoolTests, ConcurrentClaims)
+{
+    //! GIVEN Batch, which is claimed by several threads at once
+    constexpr uint32_t TASKS_COUNT = 100000;
+    constexpr size_t THREADS_COUNT = 4;
+
+    AudioTaskCounter counter;
+    uint32_t generation = counter.publish(TASKS_COUNT);
+
+    std::vector<std::atomic<int> > claimsCounts(TASKS_COUNT);
+    for (std::atomic<int>& count : claimsCounts) {
+        count = 0;
+    }
+
+    //! WHEN Claim all the tasks
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREADS_COUNT; ++i) {
+        threads.emplace_back([&counter, &claimsCounts, generation]() {
+            uint32_t idx = 0;
+            while (counter.claim(generation, idx)) {
+                claimsCounts[idx].fetch_add(1);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    //! THEN Each task is claimed exactly once
+    for (uint32_t idx = 0; idx < TASKS_COUNT; ++idx) {
+        EXPECT_EQ(claimsCounts[idx].load(), 1) << "task: " << idx;
+    }
+}
+
+TEST_F(AudioWorkerPoolTests, ExactTaskCoverage)
+{
+    //! GIVEN Pool of 3 workers
+    AudioWorkerPool pool;
+    pool.init(3);
+    EXPECT_EQ(pool.workersCount(), 3u);
+
+    //! THEN Each task of the batches of different sizes is run exactly once
+    for (size_t i = 0; i < 1000; ++i) {
+        expectEachTaskOnce(pool, 2 + i % 63);
+    }
+
+    //! THEN Without the workers the tasks are run by the caller
+    pool.deinit();
+    EXPECT_EQ(pool.workersCount(), 0u);
+    expectEachTaskOnce(pool, 10);
+}
+
+TEST_F(AudioWorkerPoolTests, ParkedWorkers)
+{
+    //! GIVEN Pool, which has been idle long enough for the workers to park
+    AudioWorkerPool pool;
+    pool.init(2);
+    expectEachTaskOnce(pool, 16);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    //! WHEN Run the next batches, the tasks are slow, so the caller parks as well
+    for (size_t i = 0; i < 10; ++i) {
+        std::vector<std::atomic<int> > runsCounts(4);
+        for (std::atomic<int>& count : runsCounts) {
+            count = 0;
+        }
+
+        pool.parallelFor(runsCounts.size(), [&runsCounts](size_t idx) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            runsCounts[idx].fetch_add(1);
+        });
+
+        //! THEN The workers are woken up and all the tasks are finished, when the call returns
+        for (const std::atomic<int>& count : runsCounts) {
+            EXPECT_EQ(count.load(), 1);
+        }
+    }
+
+    //! THEN The parked workers are stopped
+    pool.deinit();
+}
@@ -0,0 +1,526 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QtGlobal>
+
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+#include <sys/resource.h>
+#endif
+
+#include "log.h"
+#include "async/processevents.h"
+
+#include "iofflinerenderer.h"
+#include "internal/audiosanitizer.h"
+#include "internal/platform/null/nullaudiodriver.h"
+#include "internal/synthesizers/synthresolver.h"
+#include "internal/synthesizers/fluidsynth/fluidresolver.h"
+#include "internal/trackeventsprovider.h"
+#include "internal/worker/midiaudiosource.h"
+#include "internal/worker/mixer.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+using namespace mu::midi;
+
+//! NOTE The allocations are counted only while the graph is processed,
+//! on all the threads, so the ones of the render pool threads are counted too
+static std::atomic<bool> s_countAllocations = false;
+static std::atomic<uint64_t> s_allocationsCount = 0;
+
+static void countAllocation()
+{
+    if (s_countAllocations.load(std::memory_order_relaxed)) {
+        s_allocationsCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+#ifdef __GLIBC__
+//! NOTE The C allocation functions are replaced, so the ones of FluidSynth are counted too.
+//! operator new of libstdc++ calls malloc, so it's counted here as well
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+
+void* malloc(std::size_t size)
+{
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size)
+{
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, std::size_t size)
+{
+    countAllocation();
+    return __libc_realloc(ptr, size);
+}
+}
+#else
+//! NOTE Only the C++ allocations are counted on the other platforms
+void* operator new(std::size_t size)
+{
+    countAllocation();
+
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+#endif
+
+namespace {
+static constexpr unsigned int SAMPLE_RATE = 48000;
+static constexpr audioch_t AUDIO_CHANNELS_COUNT = 2;
+
+//! NOTE 10 ms per block keeps the msecs passed to the midi sources exact
+static constexpr uint16_t BLOCK_SIZE = 480;
+
+static constexpr int DIVISION = 480;
+static constexpr tempo_t TEMPO = 500000; // 120 bpm
+
+static constexpr int DEFAULT_AUDIO_SECONDS = 5;
+
+//! NOTE A score generated from a few parameters: every track plays the given number
+//! of chords per beat (legato), the pitches walk through two octaves
+struct Workload {
+    std::string name;
+    size_t tracksCount = 0;
+    int chordsPerBeat = 0;
+    int chordSize = 0;
+    std::vector<program_t> programs;
+};
+
+static const std::vector<Workload> WORKLOADS = {
+    { "solo_piano", 1, 4, 3, { 0 } },
+    { "string_quartet", 4, 2, 1, { 40, 40, 41, 42 } },
+    { "orchestra", 32, 1, 2, { 73, 71, 68, 70, 60, 56, 57, 58, 47, 48, 48, 49, 49, 42, 43, 52 } },
+};
+
+static std::string environmentValue(const char* name)
+{
+    const char* value = std::getenv(name);
+    return value ? std::string(value) : std::string();
+}
+
+static int audioSeconds()
+{
+    std::string value = environmentValue("MU_AUDIO_BENCHMARK_SECONDS");
+    int seconds = value.empty() ? 0 : std::atoi(value.c_str());
+    return seconds > 0 ? seconds : DEFAULT_AUDIO_SECONDS;
+}
+
+static io::paths soundFontDirectories()
+{
+    std::string dir = environmentValue("MU_AUDIO_BENCHMARK_SOUNDFONTS_DIR");
+    if (dir.empty()) {
+        dir = AUDIO_BENCHMARK_SOUNDFONTS_DIR;
+    }
+
+    return { io::path(dir) };
+}
+
+static size_t peakMemoryBytes()
+{
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef Q_OS_MACOS
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+    return 0;
+#endif
+}
+
+static IOfflineRenderer::Track makeTrack(const Workload& workload, const size_t trackIdx, const tick_t lastTick)
+{
+    IOfflineRenderer::Track track;
+
+    program_t program = workload.programs[trackIdx % workload.programs.size()];
+
+    track.mapping.division = DIVISION;
+    track.mapping.tempo = { { 0, TEMPO } };
+    track.mapping.programms = { Program { 0, program, 0 } };
+    track.lastTick = lastTick;
+
+    Event programChange;
+    programChange.setMessageType(Event::MessageType::ChannelVoice10);
+    programChange.setOpcode(Event::Opcode::ProgramChange);
+    programChange.setProgram(program);
+    programChange.setChannel(0);
+    track.setupEvents = { programChange };
+
+    const tick_t step = DIVISION / workload.chordsPerBeat;
+    int stepIdx = 0;
+
+    for (tick_t tick = 0; tick + step <= lastTick; tick += step, ++stepIdx) {
+        for (int noteIdx = 0; noteIdx < workload.chordSize; ++noteIdx) {
+            int pitch = 48 + static_cast<int>((trackIdx * 7 + stepIdx * 5 + noteIdx * 4) % 24);
+
+            Event noteOn(Event::Opcode::NoteOn, Event::MessageType::ChannelVoice10);
+            noteOn.setChannel(0);
+            noteOn.setNote(pitch);
+            noteOn.setVelocity(80);
+            track.events[tick].push_back(noteOn);
+
+            Event noteOff(Event::Opcode::NoteOff, Event::MessageType::ChannelVoice10);
+            noteOff.setChannel(0);
+            noteOff.setNote(pitch);
+            noteOff.setVelocity(0);
+            track.events[tick + step].push_back(noteOff);
+        }
+    }
+
+    return track;
+}
+
+struct BenchmarkResult {
+    std::vector<double> blockRenderMsecs;
+    uint64_t callbacksCount = 0;
+    uint64_t xrunsCount = 0;
+    uint64_t allocationsCount = 0;
+    size_t peakMemoryBytes = 0;
+};
+
+//! NOTE The audio graph of a run. It's built, processed and destroyed on the driver thread,
+//! which plays the audio worker role for it
+class BenchmarkSession
+{
+public:
+    BenchmarkSession(const Workload& workload, std::shared_ptr<SynthResolver> synthResolver, const samples_t totalSamples)
+        : m_workload(workload), m_synthResolver(std::move(synthResolver)), m_totalSamples(totalSamples)
+    {
+        const samples_t totalMsecs = totalSamples * 1000 / SAMPLE_RATE;
+        const tick_t lastTick = static_cast<tick_t>(totalMsecs * DIVISION * 1000 / TEMPO);
+
+        for (size_t i = 0; i < m_workload.tracksCount; ++i) {
+            m_tracks.push_back(makeTrack(m_workload, i, lastTick));
+        }
+
+        m_blockRenderMsecs.reserve(totalSamples / BLOCK_SIZE + 1);
+    }
+
+    void onCallback(float* buffer, const samples_t samplesPerChannel)
+    {
+        if (m_finished) {
+            std::memset(buffer, 0, samplesPerChannel * AUDIO_CHANNELS_COUNT * sizeof(float));
+            return;
+        }
+
+        if (!m_mixer) {
+            setupGraph();
+        }
+
+        using clock = std::chrono::steady_clock;
+
+        //! NOTE Like the audio worker loop does: the events requests sent from the render pool threads
+        //! are queued to this thread, the providers answer them here
+        async::processEvents();
+
+        clock::time_point start = clock::now();
+        s_countAllocations = true;
+
+        m_mixer->process(buffer, static_cast<unsigned int>(samplesPerChannel));
+
+        s_countAllocations = false;
+        clock::time_point end = clock::now();
+
+        m_blockRenderMsecs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        m_renderedSamples += samplesPerChannel;
+
+        if (m_renderedSamples >= m_totalSamples) {
+            teardownGraph();
+            finish();
+        }
+    }
+
+    void waitFinished()
+    {
+        std::unique_lock lock(m_mutex);
+        m_condition.wait(lock, [this]() { return m_finished.load(); });
+    }
+
+    const std::vector<double>& blockRenderMsecs() const
+    {
+        return m_blockRenderMsecs;
+    }
+
+private:
+    void setupGraph()
+    {
+        AudioSanitizer::setupOfflineRenderThread();
+        ONLY_AUDIO_WORKER_THREAD;
+
+        m_mixer = std::make_shared<Mixer>();
+        m_mixer->setAudioChannelsCount(AUDIO_CHANNELS_COUNT);
+        m_mixer->setSampleRate(SAMPLE_RATE);
+
+        //! NOTE Same defaults as in AudioConfiguration
+        int cpuCount = static_cast<int>(std::thread::hardware_concurrency());
+        m_mixer->setRenderWorkersCount(std::clamp(cpuCount - 2, 0, 6));
+        m_mixer->setParallelRenderThreshold(4);
+
+        for (size_t i = 0; i < m_tracks.size(); ++i) {
+            const TrackId trackId = static_cast<TrackId>(i);
+            m_providers.push_back(std::make_unique<TrackEventsProvider>(m_tracks[i]));
+
+            auto source = std::make_shared<MidiAudioSource>(trackId, m_providers.back()->midiData());
+            source->setsynthResolver(m_synthResolver);
+            source->setMidiOutputEnabled(false);
+
+            m_mixer->addChannel(trackId, source);
+
+            AudioInputParams inputParams;
+            source->applyInputParams(m_synthResolver->resolveDefaultInputParams(), inputParams);
+            source->setIsActive(true);
+        }
+    }
+
+    void teardownGraph()
+    {
+        ONLY_AUDIO_WORKER_THREAD;
+
+        m_mixer = nullptr;
+        m_providers.clear();
+    }
+
+    void finish()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_finished = true;
+        }
+        m_condition.notify_all();
+    }
+
+    Workload m_workload;
+    std::shared_ptr<SynthResolver> m_synthResolver;
+    samples_t m_totalSamples = 0;
+    samples_t m_renderedSamples = 0;
+
+    IOfflineRenderer::TrackList m_tracks;
+    std::vector<std::unique_ptr<TrackEventsProvider> > m_providers;
+    std::shared_ptr<Mixer> m_mixer;
+
+    std::vector<double> m_blockRenderMsecs;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::atomic<bool> m_finished = false;
+};
+
+static double percentile(const std::vector<double>& sortedValues, const double p)
+{
+    if (sortedValues.empty()) {
+        return 0.0;
+    }
+
+    size_t idx = static_cast<size_t>(p / 100.0 * static_cast<double>(sortedValues.size() - 1) + 0.5);
+    return sortedValues[std::min(idx, sortedValues.size() - 1)];
+}
+}
+
+class AudioEngineBenchmark : public ::testing::TestWithParam<std::tuple<size_t, NullAudioDriver::Pacing> >
+{
+public:
+    void SetUp() override
+    {
+        //! NOTE The resolvers are created on the test thread, it plays the worker role for them
+        AudioSanitizer::setupOfflineRenderThread();
+
+        auto fluidResolver = std::make_shared<FluidResolver>(soundFontDirectories(), async::Channel<io::paths>());
+        AudioResourceMetaList soundFonts = fluidResolver->resolveResources();
+        if (soundFonts.empty()) {
+            GTEST_SKIP() << "no soundfonts found, set MU_AUDIO_BENCHMARK_SOUNDFONTS_DIR";
+        }
+
+        m_synthResolver = std::make_shared<SynthResolver>();
+        m_synthResolver->registerResolver(AudioSourceType::Fluid, fluidResolver);
+        m_synthResolver->init(AudioInputParams { soundFonts.front() });
+    }
+
+    BenchmarkResult run(const Workload& workload, const NullAudioDriver::Pacing pacing)
+    {
+        const samples_t totalSamples = static_cast<samples_t>(audioSeconds()) * SAMPLE_RATE;
+        BenchmarkSession session(workload, m_synthResolver, totalSamples);
+
+        NullAudioDriver driver(pacing);
+
+        IAudioDriver::Spec spec;
+        spec.sampleRate = SAMPLE_RATE;
+        spec.format = IAudioDriver::Format::AudioF32;
+        spec.channels = AUDIO_CHANNELS_COUNT;
+        spec.samples = BLOCK_SIZE;
+        spec.userdata = &session;
+        spec.callback = [](void* userdata, uint8_t* stream, int byteCount) {
+            samples_t samplesPerChannel = byteCount / (AUDIO_CHANNELS_COUNT * sizeof(float));
+            static_cast<BenchmarkSession*>(userdata)->onCallback(reinterpret_cast<float*>(stream), samplesPerChannel);
+        };
+
+        s_allocationsCount = 0;
+
+        BenchmarkResult result;
+        if (!driver.open(spec, nullptr)) {
+            ADD_FAILURE() << "null driver open failed";
+            return result;
+        }
+
+        session.waitFinished();
+
+        //! NOTE Read before the close, the callbacks after the end aren't part of the run
+        result.callbacksCount = session.blockRenderMsecs().size();
+        result.xrunsCount = driver.stats().xrunsCount;
+        driver.close();
+
+        result.blockRenderMsecs = session.blockRenderMsecs();
+        result.allocationsCount = s_allocationsCount;
+        result.peakMemoryBytes = peakMemoryBytes();
+
+        return result;
+    }
+
+    void report(const Workload& workload, const NullAudioDriver::Pacing pacing, BenchmarkResult& result)
+    {
+        std::vector<double>& msecs = result.blockRenderMsecs;
+        std::sort(msecs.begin(), msecs.end());
+
+        double totalMsecs = 0.0;
+        for (double value : msecs) {
+            totalMsecs += value;
+        }
+
+        const double blockBudgetMsecs = 1000.0 * BLOCK_SIZE / SAMPLE_RATE;
+        const double audioMsecs = static_cast<double>(audioSeconds()) * 1000.0;
+
+        std::stringstream ss;
+        ss << workload.name << (pacing == NullAudioDriver::Pacing::Realtime ? " (realtime)" : " (free running)")
+           << ": blocks: " << result.callbacksCount
+           << ", block budget: " << blockBudgetMsecs << " ms"
+           << ", p50: " << percentile(msecs, 50) << " ms"
+           << ", p90: " << percentile(msecs, 90) << " ms"
+           << ", p99: " << percentile(msecs, 99) << " ms"
+           << ", p99.9: " << percentile(msecs, 99.9) << " ms"
+           << ", max: " << (msecs.empty() ? 0.0 : msecs.back()) << " ms"
+           << ", realtime load: " << 100.0 * totalMsecs / audioMsecs << " %"
+           << ", xruns: " << result.xrunsCount
+           << ", audio thread allocations: " << result.allocationsCount
+           << ", peak memory: " << result.peakMemoryBytes / (1024 * 1024) << " MB";
+
+        LOGI() << ss.str();
+
+        //! NOTE Stored in the xml report (--gtest_output=xml), so the runs can be compared
+        RecordProperty("p50_us", static_cast<int>(percentile(msecs, 50) * 1000.0));
+        RecordProperty("p99_us", static_cast<int>(percentile(msecs, 99) * 1000.0));
+        RecordProperty("max_us", static_cast<int>((msecs.empty() ? 0.0 : msecs.back()) * 1000.0));
+        RecordProperty("xruns", static_cast<int>(result.xrunsCount));
+        RecordProperty("allocations", static_cast<int>(result.allocationsCount));
+        RecordProperty("peak_memory_kb", static_cast<int>(result.peakMemoryBytes / 1024));
+    }
+
+    void checkLimits(const BenchmarkResult& result)
+    {
+        //! NOTE The limits are optional, they depend on the machine
+        std::string maxP99 = environmentValue("MU_AUDIO_BENCHMARK_MAX_P99_MSECS");
+        if (!maxP99.empty()) {
+            EXPECT_LE(percentile(result.blockRenderMsecs, 99), std::atof(maxP99.c_str()));
+        }
+
+        std::string maxXruns = environmentValue("MU_AUDIO_BENCHMARK_MAX_XRUNS");
+        if (!maxXruns.empty()) {
+            EXPECT_LE(result.xrunsCount, static_cast<uint64_t>(std::atoll(maxXruns.c_str())));
+        }
+    }
+
+private:
+    std::shared_ptr<SynthResolver> m_synthResolver;
+};
+
+TEST_P(AudioEngineBenchmark, Render)
+{
+    const Workload& workload = WORKLOADS.at(std::get<0>(GetParam()));
+    const NullAudioDriver::Pacing pacing = std::get<1>(GetParam());
+
+    BenchmarkResult result = run(workload, pacing);
+
+    EXPECT_EQ(result.callbacksCount, (static_cast<samples_t>(audioSeconds()) * SAMPLE_RATE + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+    report(workload, pacing, result);
+    checkLimits(result);
+}
+
+INSTANTIATE_TEST_SUITE_P(Workloads, AudioEngineBenchmark,
+                         ::testing::Combine(::testing::Range<size_t>(0, WORKLOADS.size()),
+                                            ::testing::Values(NullAudioDriver::Pacing::FreeRunning,
+                                                              NullAudioDriver::Pacing::Realtime)));
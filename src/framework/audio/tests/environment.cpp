@@ -0,0 +1,38 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "testing/environment.h"
+
+#include "modularity/ioc.h"
+#include "internal/fx/fxresolver.h"
+
+//! NOTE The benchmark and the offline renderer build their own audio graphs, so the audio module isn't set up.
+//! Only the fx resolver is registered, it's injected into the mixer
+static mu::testing::SuiteEnvironment audio_senv(
+{
+},
+    nullptr,
+    []() {
+    mu::modularity::ioc()->registerExport<mu::audio::fx::IFxResolver>("audio_tests",
+                                                                      std::make_shared<mu::audio::fx::FxResolver>());
+}
+    );
@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "internal/audiosanitizer.h"
+#include "internal/fx/equaliser.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::fx;
+
+static constexpr unsigned int SAMPLE_RATE = 48000;
+
+class EqualiserTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        //! NOTE The equaliser is used by the test thread only, so it plays the worker role for it
+        AudioSanitizer::setupOfflineRenderThread();
+    }
+
+    static EqualiserBand band(const EqualiserBand::Type type, const float frequency, const volume_db_t gain)
+    {
+        EqualiserBand result;
+        result.type = type;
+        result.frequency = frequency;
+        result.gain = gain;
+        result.q = 0.707f;
+
+        return result;
+    }
+
+    static void expectCoefficients(const Equaliser::Coefficients& actual, const std::vector<float>& expected)
+    {
+        const float tolerance = 1e-5f;
+        EXPECT_NEAR(actual.b0, expected[0], tolerance);
+        EXPECT_NEAR(actual.b1, expected[1], tolerance);
+        EXPECT_NEAR(actual.b2, expected[2], tolerance);
+        EXPECT_NEAR(actual.a1, expected[3], tolerance);
+        EXPECT_NEAR(actual.a2, expected[4], tolerance);
+    }
+
+    //! NOTE Processes a second of the sine in the blocks of the given size, returns the gain (dB) of the second half
+    static float sineGain(Equaliser& equaliser, const double frequency, const unsigned int blockSize = 512)
+    {
+        const samples_t frames = SAMPLE_RATE;
+        std::vector<float> buffer(frames);
+        for (samples_t i = 0; i < frames; ++i) {
+            buffer[i] = 0.1f * static_cast<float>(std::sin(2.0 * M_PI * frequency * i / SAMPLE_RATE));
+        }
+
+        for (samples_t frame = 0; frame < frames; frame += blockSize) {
+            equaliser.process(buffer.data() + frame, static_cast<unsigned int>(std::min<samples_t>(blockSize, frames - frame)));
+        }
+
+        double energy = 0.0;
+        for (samples_t i = frames / 2; i < frames; ++i) {
+            energy += buffer[i] * buffer[i];
+        }
+
+        double inputEnergy = 0.1 * 0.1 / 2.0 * (frames / 2);
+        return static_cast<float>(10.0 * std::log10(energy / inputEnergy));
+    }
+};
+
+TEST_F(EqualiserTests, CoefficientsMatchCookbook)
+{
+    //! THEN The coefficients are the ones of the RBJ Audio EQ Cookbook, normalised by a0
+    expectCoefficients(Equaliser::calculateCoefficients(band(EqualiserBand::Type::Peak, 1000.f, 6.f), 48000),
+                       { 1.06105108f, -1.86125590f, 0.81626553f, -1.86125590f, 0.87731661f });
+
+    expectCoefficients(Equaliser::calculateCoefficients(band(EqualiserBand::Type::LowShelf, 100.f, -12.f), 48000),
+                       { 0.99349878f, -1.97397542f, 0.98056140f, -1.97384907f, 0.97418652f });
+
+    expectCoefficients(Equaliser::calculateCoefficients(band(EqualiserBand::Type::HighShelf, 8000.f, 9.f), 44100),
+                       { 1.91331074f, -1.48677732f, 0.53640436f, -0.21689122f, 0.17982899f });
+
+    expectCoefficients(Equaliser::calculateCoefficients(band(EqualiserBand::Type::LowPass, 2000.f, 0.f), 48000),
+                       { 0.01440110f, 0.02880221f, 0.01440110f, -1.63295501f, 0.69055942f });
+
+    expectCoefficients(Equaliser::calculateCoefficients(band(EqualiserBand::Type::HighPass, 200.f, 0.f), 48000),
+                       { 0.98165557f, -1.96331115f, 0.98165557f, -1.96297470f, 0.96364759f });
+}
+
+TEST_F(EqualiserTests, FlatAndDisabledBandsAreIdentities)
+{
+    //! THEN The bands which change nothing are skipped while processing
+    EXPECT_TRUE(Equaliser::calculateCoefficients(band(EqualiserBand::Type::Peak, 1000.f, 0.f), SAMPLE_RATE).isIdentity());
+    EXPECT_TRUE(Equaliser::calculateCoefficients(band(EqualiserBand::Type::LowShelf, 100.f, 0.f), SAMPLE_RATE).isIdentity());
+
+    EqualiserBand disabled = band(EqualiserBand::Type::LowPass, 1000.f, 0.f);
+    disabled.enabled = false;
+    EXPECT_TRUE(Equaliser::calculateCoefficients(disabled, SAMPLE_RATE).isIdentity());
+}
+
+TEST_F(EqualiserTests, PeakResponse)
+{
+    //! GIVEN A +12 dB peak at 1 kHz
+    Equaliser equaliser(1);
+    equaliser.setSampleRate(SAMPLE_RATE);
+    equaliser.setBands({ band(EqualiserBand::Type::Peak, 1000.f, 12.f) });
+
+    //! THEN The center frequency is boosted by the gain, the far ones are untouched
+    EXPECT_NEAR(sineGain(equaliser, 1000.0), 12.f, 0.1f);
+    EXPECT_NEAR(sineGain(equaliser, 50.0), 0.f, 0.2f);
+    EXPECT_NEAR(sineGain(equaliser, 15000.0), 0.f, 0.2f);
+}
+
+TEST_F(EqualiserTests, ParameterRamping)
+{
+    //! GIVEN A flat low shelf and the DC signal
+    Equaliser equaliser(1);
+    equaliser.setSampleRate(SAMPLE_RATE);
+    equaliser.setBands({ band(EqualiserBand::Type::LowShelf, 100.f, 0.f) });
+
+    std::vector<float> buffer(4096, 1.f);
+    equaliser.process(buffer.data(), 512);
+    EXPECT_FLOAT_EQ(buffer[511], 1.f);
+
+    //! WHEN The gain is changed to +12 dB
+    EqualiserBand boosted = band(EqualiserBand::Type::LowShelf, 100.f, 12.f);
+    equaliser.setBands({ boosted });
+
+    std::fill(buffer.begin(), buffer.end(), 1.f);
+    equaliser.process(buffer.data(), static_cast<unsigned int>(buffer.size()));
+
+    //! THEN The first block is still processed with the previous coefficients
+    EXPECT_NEAR(buffer[0], 1.f, 1e-6f);
+
+    //! THEN The level moves towards the target without jumps
+    const float targetGain = std::pow(10.f, 12.f / 20.f);
+
+    float maxJump = 0.f;
+    for (size_t i = 1; i < buffer.size(); ++i) {
+        maxJump = std::max(maxJump, std::abs(buffer[i] - buffer[i - 1]));
+    }
+
+    EXPECT_LT(maxJump, 0.25f * (targetGain - 1.f));
+
+    //! THEN The target is reached at the end of the ramp
+    EXPECT_NEAR(buffer.back(), targetGain, 0.01f * targetGain);
+}
+
+TEST_F(EqualiserTests, SampleRateChangeIsNotRamped)
+{
+    //! GIVEN The equaliser with a boost, set up before the sample rate is known
+    Equaliser equaliser(1);
+    equaliser.setBands({ band(EqualiserBand::Type::LowShelf, 100.f, 12.f) });
+
+    //! WHEN The sample rate is set
+    equaliser.setSampleRate(SAMPLE_RATE);
+
+    //! THEN The target coefficients apply from the first sample
+    std::vector<float> buffer(SAMPLE_RATE / 10, 1.f);
+    equaliser.process(buffer.data(), static_cast<unsigned int>(buffer.size()));
+
+    EXPECT_NEAR(buffer.back(), std::pow(10.f, 12.f / 20.f), 0.05f);
+}
+
+TEST_F(EqualiserTests, ChannelsStateIsolation)
+{
+    //! GIVEN A stereo and a mono equaliser with the same bands
+    const EqualiserBandList bands = { band(EqualiserBand::Type::Peak, 1000.f, 9.f), band(EqualiserBand::Type::HighPass, 80.f, 0.f) };
+
+    Equaliser stereo(2);
+    stereo.setSampleRate(SAMPLE_RATE);
+    stereo.setBands(bands);
+
+    Equaliser mono(1);
+    mono.setSampleRate(SAMPLE_RATE);
+    mono.setBands(bands);
+
+    //! GIVEN A signal in the left channel only
+    const samples_t frames = 4000;
+    std::vector<float> interleaved(frames * 2, 0.f);
+    std::vector<float> left(frames);
+    for (samples_t i = 0; i < frames; ++i) {
+        left[i] = static_cast<float>(std::sin(2.0 * M_PI * 997.0 * i / SAMPLE_RATE) + 0.3 * std::sin(2.0 * M_PI * 61.0 * i / SAMPLE_RATE));
+        interleaved[i * 2] = left[i];
+    }
+
+    //! WHEN Process it in the blocks, which don't match the internal ones
+    const samples_t blockSize = 77;
+    for (samples_t frame = 0; frame < frames; frame += blockSize) {
+        const unsigned int count = static_cast<unsigned int>(std::min(blockSize, frames - frame));
+        stereo.process(interleaved.data() + frame * 2, count);
+        mono.process(left.data() + frame, count);
+    }
+
+    //! THEN The right channel stays silent, the left one is the same as the mono one
+    for (samples_t i = 0; i < frames; ++i) {
+        ASSERT_EQ(interleaved[i * 2 + 1], 0.f) << "frame: " << i;
+        ASSERT_FLOAT_EQ(interleaved[i * 2], left[i]) << "frame: " << i;
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "internal/freeze/freezecache.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+static constexpr unsigned int SAMPLE_RATE = 48000;
+static constexpr audioch_t AUDIO_CHANNELS_COUNT = 2;
+
+class FreezeCacheTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+    }
+
+    io::path dirPath() const
+    {
+        return io::path(m_dir.path());
+    }
+
+    static std::vector<float> makeSamples(const samples_t samplesPerChannel)
+    {
+        std::vector<float> samples(samplesPerChannel * AUDIO_CHANNELS_COUNT);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            samples[i] = static_cast<float>(i % 64) / 16.f - 2.f;
+        }
+
+        return samples;
+    }
+
+    //! NOTE Makes the segment look used at the given time
+    void setUsedTime(const FreezeKey key, const QDateTime& time) const
+    {
+        QFile file(m_dir.filePath(QString::number(key, 16).rightJustified(16, '0') + ".mufz"));
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.setFileTime(time, QFileDevice::FileModificationTime));
+    }
+
+private:
+    QTemporaryDir m_dir;
+};
+
+TEST_F(FreezeCacheTests, StoreLoad)
+{
+    //! GIVEN Samples, some of them are out of the [-1, 1] range
+    FreezeCache cache(dirPath());
+    std::vector<float> samples = makeSamples(1000);
+
+    //! WHEN Store them and load
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_TRUE(cache.store(1, samples.data(), 1000, AUDIO_CHANNELS_COUNT, SAMPLE_RATE));
+    EXPECT_TRUE(cache.contains(1));
+
+    FrozenSegmentPtr segment = cache.load(1);
+    ASSERT_TRUE(segment);
+
+    //! THEN The segment is the same, the peaks aren't clipped
+    EXPECT_EQ(segment->audioChannelsCount(), AUDIO_CHANNELS_COUNT);
+    EXPECT_EQ(segment->sampleRate(), SAMPLE_RATE);
+    EXPECT_EQ(segment->samplesPerChannel(), 1000u);
+
+    std::vector<float> loaded(samples.size(), 0.f);
+    segment->read(loaded.data(), 0, 1000);
+    EXPECT_EQ(loaded, samples);
+
+    //! THEN A part of the segment is read from the given position
+    std::vector<float> part(10 * AUDIO_CHANNELS_COUNT, 0.f);
+    segment->read(part.data(), 500, 10);
+    EXPECT_EQ(part, std::vector<float>(samples.begin() + 500 * AUDIO_CHANNELS_COUNT, samples.begin() + 510 * AUDIO_CHANNELS_COUNT));
+}
+
+TEST_F(FreezeCacheTests, BrokenSegment)
+{
+    //! GIVEN Stored segment, which is truncated then
+    FreezeCache cache(dirPath());
+    std::vector<float> samples = makeSamples(100);
+    EXPECT_TRUE(cache.store(1, samples.data(), 100, AUDIO_CHANNELS_COUNT, SAMPLE_RATE));
+
+    QFile file(dirPath().toQString() + "/0000000000000001.mufz");
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.resize(file.size() - 4));
+    file.close();
+
+    //! THEN It isn't loaded
+    EXPECT_FALSE(cache.load(1));
+
+    //! THEN Nothing is loaded for an unknown key
+    EXPECT_FALSE(cache.load(2));
+}
+
+TEST_F(FreezeCacheTests, RemoveLeastRecentlyUsed)
+{
+    //! GIVEN Cache, which has room for two segments
+    std::vector<float> samples = makeSamples(1000);
+    const uint64_t segmentSize = 1000 * AUDIO_CHANNELS_COUNT * sizeof(float) + 64;
+    FreezeCache cache(dirPath(), 2 * segmentSize);
+
+    //! GIVEN Two segments, the first one is used after the second one
+    EXPECT_TRUE(cache.store(1, samples.data(), 1000, AUDIO_CHANNELS_COUNT, SAMPLE_RATE));
+    EXPECT_TRUE(cache.store(2, samples.data(), 1000, AUDIO_CHANNELS_COUNT, SAMPLE_RATE));
+
+    QDateTime now = QDateTime::currentDateTime();
+    setUsedTime(1, now.addSecs(-20));
+    setUsedTime(2, now.addSecs(-10));
+
+    EXPECT_TRUE(cache.load(1));
+
+    //! WHEN Store the third one
+    EXPECT_TRUE(cache.store(3, samples.data(), 1000, AUDIO_CHANNELS_COUNT, SAMPLE_RATE));
+
+    //! THEN The least recently used one is removed
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(3));
+}
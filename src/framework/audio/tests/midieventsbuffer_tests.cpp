@@ -0,0 +1,172 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <utility>
+
+#include "internal/worker/midieventsbuffer.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::midi;
+
+static constexpr tick_t BEAT = 480;
+static constexpr tick_t HISTORY_SIZE = BEAT * 4;
+
+class MidiEventsBufferTests : public ::testing::Test
+{
+public:
+    //! NOTE A note on every beat of the range, the pitch is the beat number
+    static Events beats(const tick_t from, const tick_t to)
+    {
+        Events events;
+        for (tick_t tick = from; tick < to; tick += BEAT) {
+            Event noteOn(Event::Opcode::NoteOn, Event::MessageType::ChannelVoice10);
+            noteOn.setNote(static_cast<uint8_t>(tick / BEAT));
+            noteOn.setVelocity(80);
+            events[tick].push_back(noteOn);
+        }
+
+        return events;
+    }
+
+    static void load(MidiEventsBuffer& buffer, const tick_t from, const tick_t to)
+    {
+        buffer.reset(from);
+        buffer.endTick = to;
+        buffer.push(beats(from, to));
+    }
+
+    //! NOTE Sends the events up to the tick like MidiAudioSource does, returns the sent pitches
+    static std::vector<uint8_t> play(MidiEventsBuffer& buffer, const tick_t to)
+    {
+        std::vector<uint8_t> sent;
+
+        for (tick_t tick = buffer.currentTick; tick <= to; ++tick) {
+            buffer.currentTick = tick;
+
+            if (!buffer.hasEventsForTick(tick)) {
+                continue;
+            }
+
+            for (const Event& event : buffer.pop()) {
+                sent.push_back(event.note());
+            }
+        }
+
+        buffer.isCurrentTickPassed = true;
+        buffer.trimHistory(HISTORY_SIZE);
+
+        return sent;
+    }
+};
+
+TEST_F(MidiEventsBufferTests, SeekBackInsideHistory)
+{
+    //! GIVEN The buffer loaded with 20 beats, played till the beat 6
+    MidiEventsBuffer buffer;
+    load(buffer, 0, BEAT * 20);
+
+    EXPECT_EQ(play(buffer, BEAT * 6), std::vector<uint8_t>({ 0, 1, 2, 3, 4, 5, 6 }));
+
+    //! WHEN The position is moved back by 3 beats
+    ASSERT_TRUE(buffer.rewind(BEAT * 3));
+
+    //! THEN The sent events are played again, without loading them
+    EXPECT_EQ(buffer.currentTick, BEAT * 3);
+    EXPECT_EQ(play(buffer, BEAT * 8), std::vector<uint8_t>({ 3, 4, 5, 6, 7, 8 }));
+
+    //! WHEN The position is moved forward inside the loaded range
+    ASSERT_TRUE(buffer.rewind(BEAT * 12));
+
+    //! THEN The skipped events aren't sent
+    EXPECT_EQ(play(buffer, BEAT * 13), std::vector<uint8_t>({ 12, 13 }));
+}
+
+TEST_F(MidiEventsBufferTests, SeekOutsideHistory)
+{
+    //! GIVEN The buffer played further than the kept history
+    MidiEventsBuffer buffer;
+    load(buffer, 0, BEAT * 20);
+    play(buffer, BEAT * 10);
+
+    EXPECT_EQ(buffer.historyStartTick, BEAT * 10 - HISTORY_SIZE);
+
+    //! THEN The positions before the history and after the loaded range aren't in the buffer
+    EXPECT_FALSE(buffer.rewind(BEAT * 2));
+    EXPECT_FALSE(buffer.rewind(BEAT * 20));
+
+    //! THEN The failed seeks don't move the position
+    EXPECT_EQ(buffer.currentTick, BEAT * 10);
+    EXPECT_EQ(play(buffer, BEAT * 11), std::vector<uint8_t>({ 11 }));
+
+    //! THEN The oldest kept event is still there
+    ASSERT_TRUE(buffer.rewind(BEAT * 11 - HISTORY_SIZE));
+    EXPECT_EQ(play(buffer, BEAT * 8), std::vector<uint8_t>({ 7, 8 }));
+}
+
+TEST_F(MidiEventsBufferTests, PatchInvalidatesHistory)
+{
+    //! GIVEN The buffer played till the beat 6
+    MidiEventsBuffer buffer;
+    load(buffer, 0, BEAT * 20);
+    play(buffer, BEAT * 6);
+
+    //! WHEN The beats 3-4 are changed
+    buffer.replace(BEAT * 3, BEAT * 4, beats(BEAT * 3, BEAT * 5));
+
+    //! THEN The sent events before the change can't be replayed anymore
+    EXPECT_FALSE(buffer.rewind(BEAT * 2));
+    ASSERT_TRUE(buffer.rewind(BEAT * 5));
+    EXPECT_EQ(play(buffer, BEAT * 7), std::vector<uint8_t>({ 5, 6, 7 }));
+}
+
+TEST_F(MidiEventsBufferTests, PrerollHandoff)
+{
+    //! GIVEN The main buffer far behind the loop start, and the pre-roll of the loop start
+    MidiEventsBuffer main;
+    load(main, BEAT * 40, BEAT * 60);
+    play(main, BEAT * 50);
+
+    MidiEventsBuffer preroll;
+    load(preroll, BEAT * 8, BEAT * 18);
+
+    //! WHEN The loop restarts, like in MidiAudioSource::seek
+    ASSERT_FALSE(main.rewind(BEAT * 8));
+    main.reset(BEAT * 8);
+
+    ASSERT_TRUE(preroll.isLoaded(BEAT * 8));
+    std::swap(main, preroll);
+    preroll.reset(BEAT * 8);
+
+    //! THEN The main buffer continues from the loop start with the pre-rolled events
+    EXPECT_TRUE(main.isLoaded(BEAT * 8));
+    EXPECT_EQ(main.endTick, BEAT * 18);
+    EXPECT_EQ(play(main, BEAT * 10), std::vector<uint8_t>({ 8, 9, 10 }));
+
+    //! THEN The pre-roll is empty, it's requested again
+    EXPECT_TRUE(preroll.isEmpty());
+    EXPECT_FALSE(preroll.isLoaded(BEAT * 8));
+
+    //! THEN The old main events are gone
+    EXPECT_FALSE(main.rewind(BEAT * 45));
+}
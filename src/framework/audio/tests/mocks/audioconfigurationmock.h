@@ -0,0 +1,63 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_AUDIOCONFIGURATIONMOCK_H
+#define MU_AUDIO_AUDIOCONFIGURATIONMOCK_H
+
+#include <gmock/gmock.h>
+
+#include "framework/audio/iaudioconfiguration.h"
+
+namespace mu::audio {
+class AudioConfigurationMock : public IAudioConfiguration
+{
+public:
+    MOCK_METHOD(std::vector<std::string>, availableAudioApiList, (), (const, override));
+
+    MOCK_METHOD(std::string, currentAudioApi, (), (const, override));
+    MOCK_METHOD(void, setCurrentAudioApi, (const std::string&), (override));
+
+    MOCK_METHOD(audioch_t, audioChannelsCount, (), (const, override));
+    MOCK_METHOD(unsigned int, driverBufferSize, (), (const, override));
+    MOCK_METHOD(unsigned int, driverPeriodsCount, (), (const, override));
+
+    MOCK_METHOD(size_t, renderWorkersCount, (), (const, override));
+    MOCK_METHOD(size_t, parallelRenderMinChannelsCount, (), (const, override));
+    MOCK_METHOD(unsigned int, voicesBudget, (), (const, override));
+    MOCK_METHOD(unsigned int, maxSourceSampleRate, (), (const, override));
+
+    MOCK_METHOD(io::path, freezeCacheDirectory, (), (const, override));
+
+    MOCK_METHOD(bool, isShowControlsInMixer, (), (const, override));
+    MOCK_METHOD(void, setIsShowControlsInMixer, (bool), (override));
+
+    MOCK_METHOD(AudioInputParams, defaultAudioInputParams, (), (const, override));
+    MOCK_METHOD(io::paths, soundFontDirectories, (), (const, override));
+    MOCK_METHOD(async::Channel<io::paths>, soundFontDirectoriesChanged, (), (const, override));
+
+    MOCK_METHOD(const synth::SynthesizerState&, synthesizerState, (), (const, override));
+    MOCK_METHOD(Ret, saveSynthesizerState, (const synth::SynthesizerState&), (override));
+    MOCK_METHOD(async::Notification, synthesizerStateChanged, (), (const, override));
+    MOCK_METHOD(async::Notification, synthesizerStateGroupChanged, (const std::string&), (const, override));
+};
+}
+
+#endif // MU_AUDIO_AUDIOCONFIGURATIONMOCK_H
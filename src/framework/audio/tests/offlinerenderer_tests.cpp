@@ -0,0 +1,287 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "mocks/audioconfigurationmock.h"
+
+#include "audioerrors.h"
+#include "internal/audiosanitizer.h"
+#include "internal/offlinerenderer.h"
+#include "internal/synthesizers/fluidsynth/fluidresolver.h"
+
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+using namespace mu::midi;
+
+static constexpr unsigned int SAMPLE_RATE = 44100;
+static constexpr int DIVISION = 480;
+static constexpr tempo_t TEMPO = 500000; // 120 bpm, a beat is 500 ms
+
+class OfflineRendererTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_configuration = std::make_shared<AudioConfigurationMock>();
+        m_renderer.setconfiguration(m_configuration);
+
+        ON_CALL(*m_configuration, soundFontDirectories()).WillByDefault(Return(soundFontDirectories()));
+        ON_CALL(*m_configuration, renderWorkersCount()).WillByDefault(Return(4));
+        ON_CALL(*m_configuration, parallelRenderMinChannelsCount()).WillByDefault(Return(2));
+        ON_CALL(*m_configuration, voicesBudget()).WillByDefault(Return(0));
+        ON_CALL(*m_configuration, maxSourceSampleRate()).WillByDefault(Return(0));
+        ON_CALL(*m_configuration, synthesizerState()).WillByDefault(ReturnRef(m_synthesizerState));
+    }
+
+    static io::paths soundFontDirectories()
+    {
+        const char* dir = std::getenv("MU_AUDIO_BENCHMARK_SOUNDFONTS_DIR");
+        return { io::path(dir ? dir : AUDIO_BENCHMARK_SOUNDFONTS_DIR) };
+    }
+
+    //! NOTE Sets up the soundfont found in the directories, returns false if there is none
+    bool setupSoundFont()
+    {
+        //! NOTE The resolver is used by the test thread only, so it plays the worker role for it
+        AudioSanitizer::setupOfflineRenderThread();
+
+        FluidResolver fluidResolver(soundFontDirectories(), async::Channel<io::paths>());
+        AudioResourceMetaList soundFonts = fluidResolver.resolveResources();
+        if (soundFonts.empty()) {
+            return false;
+        }
+
+        ON_CALL(*m_configuration, defaultAudioInputParams()).WillByDefault(Return(AudioInputParams { soundFonts.front() }));
+        return true;
+    }
+
+    //! NOTE Every track plays one beat: the first track the first beat, the second track the second one, etc.
+    static IOfflineRenderer::TrackList makeTracks(const size_t tracksCount)
+    {
+        IOfflineRenderer::TrackList tracks;
+
+        for (size_t i = 0; i < tracksCount; ++i) {
+            IOfflineRenderer::Track track;
+            track.mapping.division = DIVISION;
+            track.mapping.tempo = { { 0, TEMPO } };
+            track.mapping.programms = { Program { static_cast<channel_t>(i), 0, 0 } };
+
+            Event programChange;
+            programChange.setMessageType(Event::MessageType::ChannelVoice10);
+            programChange.setOpcode(Event::Opcode::ProgramChange);
+            programChange.setProgram(0);
+            programChange.setChannel(static_cast<channel_t>(i));
+            track.setupEvents.push_back(programChange);
+
+            const tick_t onTick = static_cast<tick_t>(i * DIVISION);
+            const tick_t offTick = onTick + DIVISION;
+
+            Event noteOn(Event::Opcode::NoteOn, Event::MessageType::ChannelVoice10);
+            noteOn.setChannel(static_cast<channel_t>(i));
+            noteOn.setNote(60);
+            noteOn.setVelocity(100);
+            track.events[onTick].push_back(noteOn);
+
+            Event noteOff(Event::Opcode::NoteOff, Event::MessageType::ChannelVoice10);
+            noteOff.setChannel(static_cast<channel_t>(i));
+            noteOff.setNote(60);
+            noteOff.setVelocity(0);
+            track.events[offTick].push_back(noteOff);
+
+            track.lastTick = offTick;
+            tracks.push_back(std::move(track));
+        }
+
+        return tracks;
+    }
+
+    static IOfflineRenderer::Spec makeSpec()
+    {
+        IOfflineRenderer::Spec spec;
+        spec.sampleRate = SAMPLE_RATE;
+        spec.audioChannelsCount = 2;
+        spec.tailMsecs = 0;
+
+        return spec;
+    }
+
+    static float peak(const std::vector<float>& samples, size_t from, size_t to)
+    {
+        float result = 0.f;
+        for (size_t i = from; i < std::min(to, samples.size()); ++i) {
+            result = std::max(result, std::abs(samples[i]));
+        }
+
+        return result;
+    }
+
+protected:
+    OfflineRenderer m_renderer;
+    std::shared_ptr<AudioConfigurationMock> m_configuration;
+    SynthesizerState m_synthesizerState;
+};
+
+TEST_F(OfflineRendererTests, NothingToRender)
+{
+    //! GIVEN Track without events
+    IOfflineRenderer::TrackList tracks = makeTracks(1);
+    tracks.front().events.clear();
+    tracks.front().lastTick = 0;
+
+    //! WHEN Render it
+    bool consumed = false;
+    Ret ret = m_renderer.render(tracks, makeSpec(), [&consumed](const float*, samples_t) {
+        consumed = true;
+        return make_ret(Ret::Code::Ok);
+    });
+
+    //! THEN Nothing is rendered
+    EXPECT_EQ(ret.code(), static_cast<int>(Err::NothingToRender));
+    EXPECT_FALSE(consumed);
+
+    //! THEN The same for no tracks
+    ret = m_renderer.render({}, makeSpec(), [](const float*, samples_t) { return make_ret(Ret::Code::Ok); });
+    EXPECT_EQ(ret.code(), static_cast<int>(Err::NothingToRender));
+}
+
+TEST_F(OfflineRendererTests, InvalidMidiMapping)
+{
+    //! GIVEN Track without programs
+    IOfflineRenderer::TrackList tracks = makeTracks(1);
+    tracks.front().mapping.programms.clear();
+
+    //! WHEN Render it
+    Ret ret = m_renderer.render(tracks, makeSpec(), [](const float*, samples_t) { return make_ret(Ret::Code::Ok); });
+
+    //! THEN The mapping is rejected
+    EXPECT_EQ(ret.code(), static_cast<int>(Err::InvalidMidiMapping));
+}
+
+TEST_F(OfflineRendererTests, RenderTracks)
+{
+    if (!setupSoundFont()) {
+        GTEST_SKIP() << "no soundfonts found, set MU_AUDIO_BENCHMARK_SOUNDFONTS_DIR";
+    }
+
+    //! GIVEN More tracks than the threshold of the parallel rendering in the configuration
+    const size_t tracksCount = 4;
+    IOfflineRenderer::TrackList tracks = makeTracks(tracksCount);
+    IOfflineRenderer::Spec spec = makeSpec();
+
+    //! WHEN Render them
+    std::vector<float> samples;
+    msecs_t lastRenderedMsecs = 0;
+
+    Ret ret = m_renderer.render(tracks, spec, [&samples](const float* buffer, samples_t samplesPerChannel) {
+        samples.insert(samples.end(), buffer, buffer + samplesPerChannel * 2);
+        return make_ret(Ret::Code::Ok);
+    }, [&lastRenderedMsecs](msecs_t renderedMsecs, msecs_t) {
+        lastRenderedMsecs = renderedMsecs;
+    });
+
+    //! THEN All the samples are rendered
+    EXPECT_TRUE(ret);
+
+    const msecs_t totalMsecs = tracksCount * TEMPO / 1000;
+    EXPECT_EQ(samples.size(), totalMsecs * SAMPLE_RATE / 1000 * 2);
+    EXPECT_EQ(lastRenderedMsecs, totalMsecs);
+
+    //! THEN Every track is heard in its beat
+    const size_t beatSamples = TEMPO / 1000 * SAMPLE_RATE / 1000 * 2;
+    for (size_t i = 0; i < tracksCount; ++i) {
+        EXPECT_GT(peak(samples, i * beatSamples, (i + 1) * beatSamples), 0.001f) << "track " << i << " is silent";
+    }
+}
+
+TEST_F(OfflineRendererTests, Abort)
+{
+    if (!setupSoundFont()) {
+        GTEST_SKIP() << "no soundfonts found, set MU_AUDIO_BENCHMARK_SOUNDFONTS_DIR";
+    }
+
+    IOfflineRenderer::TrackList tracks = makeTracks(2);
+
+    //! WHEN Abort while rendering
+    Ret ret = m_renderer.render(tracks, makeSpec(), [this](const float*, samples_t) {
+        m_renderer.abort();
+        return make_ret(Ret::Code::Ok);
+    });
+
+    //! THEN The render is cancelled
+    EXPECT_EQ(ret.code(), static_cast<int>(Ret::Code::Cancel));
+
+    //! WHEN Abort when nothing is rendered, then render
+    m_renderer.abort();
+
+    samples_t renderedSamples = 0;
+    ret = m_renderer.render(tracks, makeSpec(), [&renderedSamples](const float*, samples_t samplesPerChannel) {
+        renderedSamples += samplesPerChannel;
+        return make_ret(Ret::Code::Ok);
+    });
+
+    //! THEN The abort doesn't affect the next render
+    EXPECT_TRUE(ret);
+    EXPECT_EQ(renderedSamples, 2 * TEMPO / 1000 * SAMPLE_RATE / 1000);
+}
+
+TEST_F(OfflineRendererTests, ResampledSources)
+{
+    if (!setupSoundFont()) {
+        GTEST_SKIP() << "no soundfonts found, set MU_AUDIO_BENCHMARK_SOUNDFONTS_DIR";
+    }
+
+    //! GIVEN The sources render at most at 48 kHz, the output is at 96 kHz
+    ON_CALL(*m_configuration, maxSourceSampleRate()).WillByDefault(Return(48000));
+
+    const size_t tracksCount = 2;
+    IOfflineRenderer::TrackList tracks = makeTracks(tracksCount);
+    IOfflineRenderer::Spec spec = makeSpec();
+    spec.sampleRate = 96000;
+
+    //! WHEN Render the tracks
+    std::vector<float> samples;
+    Ret ret = m_renderer.render(tracks, spec, [&samples](const float* buffer, samples_t samplesPerChannel) {
+        samples.insert(samples.end(), buffer, buffer + samplesPerChannel * 2);
+        return make_ret(Ret::Code::Ok);
+    });
+
+    //! THEN All the samples of the output rate are rendered
+    EXPECT_TRUE(ret);
+
+    const msecs_t totalMsecs = tracksCount * TEMPO / 1000;
+    EXPECT_EQ(samples.size(), totalMsecs * spec.sampleRate / 1000 * 2);
+
+    //! THEN Every track is heard in its beat
+    const size_t beatSamples = TEMPO / 1000 * spec.sampleRate / 1000 * 2;
+    for (size_t i = 0; i < tracksCount; ++i) {
+        EXPECT_GT(peak(samples, i * beatSamples, (i + 1) * beatSamples), 0.001f) << "track " << i << " is silent";
+    }
+}
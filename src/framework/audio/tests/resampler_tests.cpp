@@ -0,0 +1,183 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "internal/worker/resampler.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+class ResamplerTests : public ::testing::Test
+{
+public:
+    static std::vector<float> sine(const double frequency, const unsigned int sampleRate, const samples_t frames,
+                                   const audioch_t audioChannelsCount = 1)
+    {
+        std::vector<float> result(frames * audioChannelsCount);
+        for (samples_t frame = 0; frame < frames; ++frame) {
+            float value = static_cast<float>(std::sin(2.0 * M_PI * frequency * frame / sampleRate));
+            for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+                result[frame * audioChannelsCount + audioChNum] = value;
+            }
+        }
+
+        return result;
+    }
+
+    //! NOTE The RMS of a mono signal without the edges, where the filter sees the silence around the signal
+    static double rms(const std::vector<float>& samples, const size_t edge)
+    {
+        double sum = 0.0;
+        size_t count = 0;
+        for (size_t i = edge; i + edge < samples.size(); ++i) {
+            sum += samples[i] * samples[i];
+            ++count;
+        }
+
+        return count > 0 ? std::sqrt(sum / count) : 0.0;
+    }
+
+    //! NOTE The gain of the sine passed through the resampler
+    static double sineGain(const double frequency, const unsigned int sampleRateIn, const unsigned int sampleRateOut)
+    {
+        Resampler resampler(1, sampleRateIn, sampleRateOut);
+        std::vector<float> output = resampler.convert(sine(frequency, sampleRateIn, sampleRateIn));
+
+        return rms(output, sampleRateOut / 10) * std::sqrt(2.0);
+    }
+};
+
+TEST_F(ResamplerTests, OutputFramesCount)
+{
+    struct Ratio {
+        unsigned int in = 0;
+        unsigned int out = 0;
+    };
+
+    const std::vector<Ratio> ratios = { { 44100, 48000 }, { 48000, 44100 }, { 96000, 44100 }, { 22050, 48000 }, { 48000, 48000 } };
+
+    for (const Ratio& ratio : ratios) {
+        //! GIVEN A second and a bit of stereo audio
+        const samples_t inputFrames = ratio.in + 123;
+        std::vector<float> input = sine(440.0, ratio.in, inputFrames, 2);
+
+        //! WHEN Convert it
+        Resampler resampler(2, ratio.in, ratio.out);
+        std::vector<float> output = resampler.convert(input);
+
+        //! THEN The duration is kept
+        const samples_t expectedFrames = (inputFrames * ratio.out + ratio.in - 1) / ratio.in;
+        EXPECT_EQ(output.size(), expectedFrames * 2) << ratio.in << " -> " << ratio.out;
+    }
+}
+
+TEST_F(ResamplerTests, MatchesReferenceSine)
+{
+    //! GIVEN A 1 kHz sine at 44.1 kHz
+    const double frequency = 1000.0;
+    std::vector<float> input = sine(frequency, 44100, 44100);
+
+    //! WHEN Convert it to 48 kHz
+    Resampler resampler(1, 44100, 48000);
+    std::vector<float> output = resampler.convert(input);
+
+    //! THEN It's the same sine at 48 kHz, with no delay
+    std::vector<float> reference = sine(frequency, 48000, output.size());
+
+    double maxError = 0.0;
+    for (size_t i = 1000; i + 1000 < output.size(); ++i) {
+        maxError = std::max(maxError, std::abs(static_cast<double>(output[i]) - reference[i]));
+    }
+
+    EXPECT_LT(maxError, 1e-3);
+}
+
+TEST_F(ResamplerTests, Passband)
+{
+    //! THEN The frequencies below the cutoff keep their level when upsampling and downsampling
+    for (double frequency : { 100.0, 1000.0, 10000.0, 15000.0 }) {
+        EXPECT_NEAR(sineGain(frequency, 44100, 48000), 1.0, 0.01) << frequency << " Hz, 44.1 -> 48 kHz";
+        EXPECT_NEAR(sineGain(frequency, 96000, 44100), 1.0, 0.01) << frequency << " Hz, 96 -> 44.1 kHz";
+    }
+}
+
+TEST_F(ResamplerTests, Stopband)
+{
+    //! THEN The frequencies above the output Nyquist frequency are removed, instead of folding back into the audible range
+    for (double frequency : { 30000.0, 40000.0 }) {
+        EXPECT_LT(sineGain(frequency, 96000, 44100), 1e-3) << frequency << " Hz, 96 -> 44.1 kHz";
+    }
+}
+
+TEST_F(ResamplerTests, ContinuityAcrossBlocks)
+{
+    //! GIVEN A stereo sine, the channels are different
+    const unsigned int sampleRateIn = 44100;
+    const unsigned int sampleRateOut = 48000;
+
+    std::vector<float> input = sine(440.0, sampleRateIn, sampleRateIn, 2);
+    for (size_t i = 1; i < input.size(); i += 2) {
+        input[i] *= -0.5f;
+    }
+
+    Resampler reference(2, sampleRateIn, sampleRateOut);
+    std::vector<float> expected = reference.convert(input);
+
+    //! WHEN Stream it in the blocks of irregular sizes, pulled as the realtime graph does
+    Resampler resampler(2, sampleRateIn, sampleRateOut);
+    resampler.reserve(1024);
+
+    std::vector<float> output;
+    std::vector<float> block(2048 * 2);
+
+    const std::vector<samples_t> outputBlockSizes = { 1, 64, 511, 512, 1000, 7 };
+    samples_t inputFrame = 0;
+    size_t blockNum = 0;
+
+    const samples_t inputFrames = input.size() / 2;
+    while (true) {
+        samples_t outputFrames = outputBlockSizes[blockNum++ % outputBlockSizes.size()];
+        samples_t requiredFrames = resampler.requiredInputFrames(outputFrames);
+        if (inputFrame + requiredFrames > inputFrames) {
+            break;
+        }
+
+        samples_t written = resampler.process(input.data() + inputFrame * 2, requiredFrames, block.data(), outputFrames);
+        inputFrame += requiredFrames;
+
+        //! THEN Each block is filled completely with the required input
+        ASSERT_EQ(written, outputFrames);
+        output.insert(output.end(), block.begin(), block.begin() + written * 2);
+    }
+
+    //! THEN The streamed output is the same as the one converted at once, there are no clicks at the block borders
+    ASSERT_LE(output.size(), expected.size());
+    ASSERT_GT(output.size(), expected.size() / 2);
+
+    for (size_t i = 0; i < output.size(); ++i) {
+        ASSERT_NEAR(output[i], expected[i], 1e-5f) << "sample: " << i;
+    }
+}
@@ -0,0 +1,225 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "internal/audiosanitizer.h"
+#include "internal/worker/mixerchannel.h"
+#include "internal/worker/voicegovernor.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+static constexpr unsigned int SAMPLE_RATE = 48000;
+
+static constexpr float HIGH_LOAD = 1.f;
+static constexpr float LOW_LOAD = 0.1f;
+
+namespace {
+//! NOTE Plays the given number of voices and records the limit set by the governor
+class VoicesInput : public ITrackAudioInput
+{
+public:
+    bool isActive() const override { return true; }
+    void setIsActive(bool) override {}
+
+    void setSampleRate(unsigned int) override {}
+    unsigned int audioChannelsCount() const override { return 2; }
+    async::Channel<unsigned int> audioChannelsCountChanged() const override { return {}; }
+    void process(float*, unsigned int) override {}
+
+    void seek(const msecs_t) override {}
+    void prefetch(const msecs_t) override {}
+    void applyInputParams(const AudioInputParams& originParams, AudioInputParams& resultParams) override { resultParams = originParams; }
+
+    unsigned int activeVoicesCount() const override { return voicesCount; }
+    void setVoicesLimit(unsigned int limit) override { voicesLimit = limit; }
+    unsigned int stolenVoicesCount() const override { return 0; }
+
+    unsigned int voicesCount = 0;
+    unsigned int voicesLimit = 0;
+};
+}
+
+class VoiceGovernorTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        //! NOTE The channels are used by the test thread only, so it plays the worker role for them
+        AudioSanitizer::setupOfflineRenderThread();
+    }
+
+    void setupChannels(const std::vector<unsigned int>& voicesCounts)
+    {
+        for (size_t i = 0; i < voicesCounts.size(); ++i) {
+            auto input = std::make_shared<VoicesInput>();
+            input->voicesCount = voicesCounts[i];
+
+            m_inputs.push_back(input);
+            m_channels.push_back(std::make_shared<MixerChannel>(static_cast<TrackId>(i), input, SAMPLE_RATE));
+            m_channelsList.push_back(m_channels.back().get());
+        }
+    }
+
+    void update(const float load, const size_t blocksCount = 1)
+    {
+        for (size_t i = 0; i < blocksCount; ++i) {
+            m_governor.update(load, m_channelsList);
+        }
+    }
+
+    std::vector<unsigned int> limits() const
+    {
+        std::vector<unsigned int> result;
+        for (const auto& input : m_inputs) {
+            result.push_back(input->voicesLimit);
+        }
+
+        return result;
+    }
+
+    unsigned int minLimit() const
+    {
+        std::vector<unsigned int> all = limits();
+        return *std::min_element(all.begin(), all.end());
+    }
+
+protected:
+    VoiceGovernor m_governor;
+
+    std::vector<std::shared_ptr<VoicesInput> > m_inputs;
+    std::vector<MixerChannelPtr> m_channels;
+    std::vector<MixerChannel*> m_channelsList;
+};
+
+TEST_F(VoiceGovernorTests, BudgetShrinksUnderHighLoad)
+{
+    //! GIVEN 4 instances playing 200 voices with the budget of 256
+    setupChannels({ 50, 50, 50, 50 });
+    m_governor.setVoicesBudget(256);
+
+    //! WHEN The load stays high
+    update(HIGH_LOAD, 2);
+
+    //! THEN The budget is cut from the played voices, not from the set budget
+    EXPECT_EQ(m_governor.voicesBudget(), 160);
+    EXPECT_EQ(limits(), std::vector<unsigned int>({ 40, 40, 40, 40 }));
+
+    //! THEN The budget isn't cut again until the stolen voices fade out
+    update(HIGH_LOAD, 2);
+    EXPECT_EQ(m_governor.voicesBudget(), 160);
+
+    update(HIGH_LOAD);
+    EXPECT_EQ(m_governor.voicesBudget(), 128);
+
+    //! THEN The budget never goes below the minimum
+    update(HIGH_LOAD, 100);
+    EXPECT_EQ(m_governor.voicesBudget(), 16);
+    EXPECT_EQ(limits(), std::vector<unsigned int>({ 4, 4, 4, 4 }));
+}
+
+TEST_F(VoiceGovernorTests, BudgetGrowsBackUnderLowLoad)
+{
+    //! GIVEN The budget reduced by the high load
+    setupChannels({ 50, 50, 50, 50 });
+    m_governor.setVoicesBudget(256);
+
+    update(HIGH_LOAD, 10);
+    unsigned int reducedBudget = m_governor.voicesBudget();
+    ASSERT_LT(reducedBudget, 256);
+
+    //! WHEN The load is low for a block
+    update(LOW_LOAD, 3);
+
+    //! THEN The budget grows gradually
+    EXPECT_GT(m_governor.voicesBudget(), reducedBudget);
+    EXPECT_LT(m_governor.voicesBudget(), 256);
+
+    //! WHEN The load stays low
+    update(LOW_LOAD, 1000);
+
+    //! THEN The set budget is restored, not exceeded
+    EXPECT_EQ(m_governor.voicesBudget(), 256);
+    EXPECT_EQ(minLimit(), 64);
+}
+
+TEST_F(VoiceGovernorTests, MediumLoadKeepsBudget)
+{
+    //! GIVEN The budget reduced by the high load
+    setupChannels({ 50, 50 });
+    m_governor.setVoicesBudget(256);
+
+    update(HIGH_LOAD, 10);
+
+    //! WHEN The load is between the low and the high thresholds
+    update(0.6f, 10);
+    unsigned int reducedBudget = m_governor.voicesBudget();
+
+    update(0.6f, 100);
+
+    //! THEN The budget stays as it is
+    EXPECT_EQ(m_governor.voicesBudget(), reducedBudget);
+}
+
+TEST_F(VoiceGovernorTests, BudgetIsSharedByDemand)
+{
+    //! GIVEN 4 instances: a silent one, two quiet ones and a busy one
+    setupChannels({ 0, 90, 10, 5 });
+    m_governor.setVoicesBudget(100);
+
+    //! WHEN The budget is shared
+    update(LOW_LOAD);
+
+    //! THEN The quiet instances keep at least the equal share, the unused part of it goes to the busier ones
+    EXPECT_EQ(limits(), std::vector<unsigned int>({ 25, 85, 47, 33 }));
+
+    //! WHEN The demand changes
+    m_inputs[0]->voicesCount = 60;
+    m_inputs[1]->voicesCount = 70;
+    m_inputs[2]->voicesCount = 0;
+    update(LOW_LOAD);
+
+    //! THEN The shares follow it
+    EXPECT_EQ(limits(), std::vector<unsigned int>({ 47, 47, 25, 33 }));
+}
+
+TEST_F(VoiceGovernorTests, NoBudgetResetsLimits)
+{
+    //! GIVEN The limited instances
+    setupChannels({ 30, 30 });
+    m_governor.setVoicesBudget(32);
+    update(LOW_LOAD);
+
+    EXPECT_EQ(limits(), std::vector<unsigned int>({ 16, 16 }));
+
+    //! WHEN The budget is turned off
+    m_governor.setVoicesBudget(0);
+    update(HIGH_LOAD, 10);
+
+    //! THEN The instances are not limited anymore
+    EXPECT_EQ(limits(), std::vector<unsigned int>({ 0, 0 }));
+    EXPECT_EQ(m_governor.voicesBudget(), 0);
+}
@@ -32,6 +32,7 @@
 #include <set>
 #include <cassert>
 #include "async/channel.h"
+#include "async/notification.h"
 #include "retval.h"
 #include "midievent.h"
 
@@ -84,6 +85,18 @@ struct MidiStream {
     async::Channel<Events, tick_t /*endTick*/> backgroundStream;
     async::Channel<tick_t /*from*/, tick_t /*from*/> eventsRequest;
 
+    //! NOTE Replaces the main stream events, which were already sent, after the score has been changed
+    async::Channel<Events, tick_t /*from*/, tick_t /*to*/> patchStream;
+
+    //! NOTE Events of the position the playback is likely to jump to, e.g. the loop start,
+    //! they are kept aside from the main stream until the jump happens
+    async::Channel<tick_t /*from*/, tick_t /*to*/> prerollRequest;
+    async::Channel<Events, tick_t /*from*/, tick_t /*to*/> prerollStream;
+
+    //! NOTE All the events of the track at once, e.g. to render the track in the background
+    async::Notification fullEventsRequest;
+    async::Channel<Events> fullEventsStream;
+
     bool operator==(const MidiStream& other) const
     {
         return lastTick == other.lastTick
@@ -22,6 +22,7 @@
 # set(MODULE_TEST_INCLUDE ...)       - set include (by default see below include_directories)
 # set(MODULE_TEST_SRC ...)           - set sources and headers files
 # set(MODULE_TEST_LINK ...)          - set libraries for link
+# set(MODULE_TEST_NO_CTEST ON)       - only build the target, it isn't run by ctest (for example, benchmarks)
 
 # After all the settings you need to do:
 # include(${PROJECT_SOURCE_DIR}/framework/testing/gtest.cmake)
@@ -59,4 +60,6 @@ target_link_libraries(${MODULE_TEST}
     ${MODULE_TEST_LINK}
     )
 
-add_test(NAME ${MODULE_TEST} COMMAND ${MODULE_TEST})
+if (NOT MODULE_TEST_NO_CTEST)
+    add_test(NAME ${MODULE_TEST} COMMAND ${MODULE_TEST})
+endif()
@@ -41,6 +41,11 @@ AudioFxType VstFxProcessor::type() const
     return audio::AudioFxType::VstFx;
 }
 
+AudioResourceId VstFxProcessor::resourceId() const
+{
+    return m_pluginPtr->name();
+}
+
 void VstFxProcessor::setSampleRate(unsigned int sampleRate)
 {
     m_vstAudioClient->setSampleRate(sampleRate);
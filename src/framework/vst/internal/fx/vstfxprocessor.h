@@ -18,6 +18,7 @@ public:
     void init();
 
     audio::AudioFxType type() const override;
+    audio::AudioResourceId resourceId() const override;
     void setSampleRate(unsigned int sampleRate) override;
     bool active() const override;
     void setActive(bool active) override;
@@ -115,6 +115,22 @@ void VstSynthesiser::flushSound()
     NOT_IMPLEMENTED;
 }
 
+unsigned int VstSynthesiser::activeVoicesCount() const
+{
+    //! NOTE The plugins don't report their voices
+    return 0;
+}
+
+void VstSynthesiser::setVoicesLimit(unsigned int /*limit*/)
+{
+    //! NOTE The plugins manage their polyphony themselves
+}
+
+unsigned int VstSynthesiser::stolenVoicesCount() const
+{
+    return 0;
+}
+
 Ret VstSynthesiser::setupMidiChannels(const std::vector<midi::Event>& /*events*/)
 {
     NOT_IMPLEMENTED;
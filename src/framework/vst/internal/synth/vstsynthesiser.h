@@ -62,6 +62,9 @@ public:
     void writeBuf(float* stream, unsigned int samples) override;
     void allSoundsOff() override;
     void flushSound() override;
+    unsigned int activeVoicesCount() const override;
+    void setVoicesLimit(unsigned int limit) override;
+    unsigned int stolenVoicesCount() const override;
 
     Ret setupMidiChannels(const std::vector<midi::Event>& events) override;
     void midiChannelSoundsOff(midi::channel_t chan) override;
@@ -21,11 +21,20 @@
  */
 #include "abstractaudiowriter.h"
 
+#include <set>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/part.h"
+#include "libmscore/instrument.h"
+
+#include "notation/internal/notationmidiutils.h"
+
 #include "log.h"
 
 using namespace mu::iex::audioexport;
 using namespace mu::project;
 using namespace mu::notation;
+using namespace mu::audio;
 
 std::vector<INotationWriter::UnitType> AbstractAudioWriter::supportedUnitTypes() const
 {
@@ -38,19 +47,53 @@ bool AbstractAudioWriter::supportsUnitType(UnitType unitType) const
     return std::find(unitTypes.cbegin(), unitTypes.cend(), unitType) != unitTypes.cend();
 }
 
-mu::Ret AbstractAudioWriter::write(INotationPtr, io::Device&, const Options& options)
+mu::Ret AbstractAudioWriter::write(INotationPtr notation, io::Device& destinationDevice, const Options& options)
 {
     IF_ASSERT_FAILED(unitTypeFromOptions(options) != UnitType::MULTI_PART) {
         return Ret(Ret::Code::NotSupported);
     }
 
-    if (supportsUnitType(static_cast<UnitType>(options.value(OptionKey::UNIT_TYPE, Val(0)).toInt()))) {
+    if (!supportsUnitType(static_cast<UnitType>(options.value(OptionKey::UNIT_TYPE, Val(0)).toInt()))) {
+        NOT_SUPPORTED;
+        return Ret(Ret::Code::NotSupported);
+    }
+
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    IAudioEncoderPtr encoder = createEncoder(destinationDevice);
+    if (!encoder) {
         NOT_IMPLEMENTED;
-        return Ret(Ret::Code::NotImplemented);
+        return make_ret(Ret::Code::NotImplemented);
     }
 
-    NOT_SUPPORTED;
-    return Ret(Ret::Code::NotSupported);
+    if (!offlineRenderer()) {
+        LOGE() << "offline audio renderer is not available";
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    IOfflineRenderer::Spec spec;
+
+    Ret ret = encoder->begin(spec);
+    if (!ret) {
+        return ret;
+    }
+
+    auto consumer = [&encoder](const float* buffer, samples_t samplesPerChannel) {
+        return encoder->encode(buffer, samplesPerChannel);
+    };
+
+    auto progress = [this](msecs_t renderedMsecs, msecs_t totalMsecs) {
+        m_progress.send(framework::Progress(renderedMsecs, totalMsecs));
+    };
+
+    ret = offlineRenderer()->render(renderMidiTracks(notation), spec, consumer, progress);
+    if (!ret) {
+        return ret;
+    }
+
+    return encoder->end();
 }
 
 mu::Ret AbstractAudioWriter::writeList(const INotationPtrList&, io::Device&, const Options& options)
@@ -70,7 +113,9 @@ mu::Ret AbstractAudioWriter::writeList(const INotationPtrList&, io::Device&, con
 
 void AbstractAudioWriter::abort()
 {
-    NOT_IMPLEMENTED;
+    if (offlineRenderer()) {
+        offlineRenderer()->abort();
+    }
 }
 
 mu::framework::ProgressChannel AbstractAudioWriter::progress() const
@@ -93,3 +138,60 @@ INotationWriter::UnitType AbstractAudioWriter::unitTypeFromOptions(const Options
 
     return unitType;
 }
+
+IOfflineRenderer::TrackList AbstractAudioWriter::renderMidiTracks(INotationPtr notation) const
+{
+    TRACEFUNC;
+
+    Ms::Score* score = notation->elements()->msScore();
+    IF_ASSERT_FAILED(score) {
+        return {};
+    }
+
+    Ms::EventMap msevents;
+    score->renderMidi(&msevents, false /*metronome*/, Ms::MScore::playRepeats, score->synthesizerState(),
+                      true /*renderStavesInParallel*/);
+
+    midi::TempoMap tempos = NotationMidiUtils::makeTempoMap(score);
+
+    IOfflineRenderer::TrackList tracks;
+    std::map<midi::channel_t, size_t> trackIndexByChannel;
+
+    for (const Ms::Part* part : score->parts()) {
+        IOfflineRenderer::Track track;
+        track.mapping = NotationMidiUtils::makeMidiMapping(part, tempos);
+
+        for (auto it = part->instruments()->cbegin(); it != part->instruments()->cend(); ++it) {
+            for (const Ms::Channel* channel : it->second->channel()) {
+                trackIndexByChannel.insert({ static_cast<midi::channel_t>(channel->channel()), tracks.size() });
+                track.setupEvents.push_back(NotationMidiUtils::makeProgramChangeEvent(channel));
+            }
+        }
+
+        tracks.push_back(std::move(track));
+    }
+
+    static const std::set<Ms::EventType> SKIP_EVENTS
+        = { Ms::EventType::ME_INVALID, Ms::EventType::ME_EOT, Ms::EventType::ME_TICK1, Ms::EventType::ME_TICK2 };
+
+    for (const auto& pair : msevents) {
+        const Ms::NPlayEvent& ev = pair.second;
+
+        if (SKIP_EVENTS.find(static_cast<Ms::EventType>(ev.type())) != SKIP_EVENTS.end()) {
+            continue;
+        }
+
+        auto search = trackIndexByChannel.find(static_cast<midi::channel_t>(ev.channel()));
+        if (search == trackIndexByChannel.end()) {
+            continue;
+        }
+
+        IOfflineRenderer::Track& track = tracks[search->second];
+        midi::tick_t tick = static_cast<midi::tick_t>(pair.first);
+
+        track.events[tick].push_back(midi::Event::fromMIDI10Package(ev.toPackage()));
+        track.lastTick = std::max(track.lastTick, tick);
+    }
+
+    return tracks;
+}
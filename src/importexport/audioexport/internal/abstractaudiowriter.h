@@ -24,9 +24,16 @@
 
 #include "project/inotationwriter.h"
 
+#include "modularity/ioc.h"
+#include "audio/iofflinerenderer.h"
+
+#include "iaudioencoder.h"
+
 namespace mu::iex::audioexport {
 class AbstractAudioWriter : public project::INotationWriter
 {
+    INJECT(iex_audioexport, audio::IOfflineRenderer, offlineRenderer)
+
 public:
     AbstractAudioWriter() = default;
     virtual ~AbstractAudioWriter() = default;
@@ -41,8 +48,14 @@ public:
     framework::ProgressChannel progress() const override;
 
 protected:
+    //! NOTE Returns nullptr, if the format can't be encoded
+    virtual IAudioEncoderPtr createEncoder(io::Device& destinationDevice) const = 0;
+
     UnitType unitTypeFromOptions(const Options& options) const;
     framework::ProgressChannel m_progress;
+
+private:
+    audio::IOfflineRenderer::TrackList renderMidiTracks(notation::INotationPtr notation) const;
 };
 }
 
@@ -22,18 +22,13 @@
 
 #include "flacwriter.h"
 
-#include "log.h"
+#include <sndfile.h>
+
+#include "sndfileencoder.h"
 
 using namespace mu::iex::audioexport;
-using namespace mu::io;
 
-mu::Ret FlacWriter::write(notation::INotationPtr notation, Device& destinationDevice, const Options& options)
+IAudioEncoderPtr FlacWriter::createEncoder(io::Device& destinationDevice) const
 {
-    UNUSED(notation)
-    UNUSED(destinationDevice)
-    UNUSED(options)
-
-    NOT_IMPLEMENTED;
-
-    return make_ret(Ret::Code::NotImplemented);
+    return std::make_unique<SndFileEncoder>(destinationDevice, SF_FORMAT_FLAC | SF_FORMAT_PCM_16);
 }
@@ -28,8 +28,8 @@
 namespace mu::iex::audioexport {
 class FlacWriter : public AbstractAudioWriter
 {
-public:
-    Ret write(notation::INotationPtr notation, io::Device& destinationDevice, const Options& options = Options()) override;
+protected:
+    IAudioEncoderPtr createEncoder(io::Device& destinationDevice) const override;
 };
 }
 
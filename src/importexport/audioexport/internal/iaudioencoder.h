@@ -0,0 +1,45 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_IMPORTEXPORT_IAUDIOENCODER_H
+#define MU_IMPORTEXPORT_IAUDIOENCODER_H
+
+#include <memory>
+
+#include "ret.h"
+#include "audio/iofflinerenderer.h"
+
+namespace mu::iex::audioexport {
+//! NOTE Receives the rendered audio block by block, so the whole score is never kept in memory
+class IAudioEncoder
+{
+public:
+    virtual ~IAudioEncoder() = default;
+
+    virtual Ret begin(const audio::IOfflineRenderer::Spec& spec) = 0;
+    virtual Ret encode(const float* buffer, audio::samples_t samplesPerChannel) = 0;
+    virtual Ret end() = 0;
+};
+
+using IAudioEncoderPtr = std::unique_ptr<IAudioEncoder>;
+}
+
+#endif // MU_IMPORTEXPORT_IAUDIOENCODER_H
@@ -22,18 +22,23 @@
 
 #include "mp3writer.h"
 
+#include <sndfile.h>
+
+#include "sndfileencoder.h"
+
 #include "log.h"
 
 using namespace mu::iex::audioexport;
-using namespace mu::framework;
 
-mu::Ret Mp3Writer::write(notation::INotationPtr notation, io::Device& destinationDevice, const Options& options)
+IAudioEncoderPtr Mp3Writer::createEncoder(io::Device& destinationDevice) const
 {
-    UNUSED(notation)
+#ifdef SNDFILE_HAS_MPEG
+    return std::make_unique<SndFileEncoder>(destinationDevice, SF_FORMAT_MPEG | SF_FORMAT_MPEG_LAYER_III,
+                                            configuration()->exportMp3Bitrate());
+#else
     UNUSED(destinationDevice)
-    UNUSED(options)
-
-    NOT_IMPLEMENTED;
 
-    return make_ret(Ret::Code::NotImplemented);
+    LOGE() << "libsndfile is built without MP3 support";
+    return nullptr;
+#endif
 }
@@ -25,11 +25,15 @@
 
 #include "abstractaudiowriter.h"
 
+#include "iaudioexportconfiguration.h"
+
 namespace mu::iex::audioexport {
 class Mp3Writer : public AbstractAudioWriter
 {
-public:
-    Ret write(notation::INotationPtr notation, io::Device& destinationDevice, const Options& options = Options()) override;
+    INJECT(iex_audioexport, IAudioExportConfiguration, configuration)
+
+protected:
+    IAudioEncoderPtr createEncoder(io::Device& destinationDevice) const override;
 };
 }
 
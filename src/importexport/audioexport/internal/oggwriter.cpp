@@ -22,18 +22,13 @@
 
 #include "oggwriter.h"
 
-#include "log.h"
+#include <sndfile.h>
+
+#include "sndfileencoder.h"
 
 using namespace mu::iex::audioexport;
-using namespace mu::io;
 
-mu::Ret OggWriter::write(notation::INotationPtr notation, Device& destinationDevice, const Options& options)
+IAudioEncoderPtr OggWriter::createEncoder(io::Device& destinationDevice) const
 {
-    UNUSED(notation)
-    UNUSED(destinationDevice)
-    UNUSED(options)
-
-    NOT_IMPLEMENTED;
-
-    return make_ret(Ret::Code::NotImplemented);
+    return std::make_unique<SndFileEncoder>(destinationDevice, SF_FORMAT_OGG | SF_FORMAT_VORBIS);
 }
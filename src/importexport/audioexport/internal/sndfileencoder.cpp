@@ -0,0 +1,197 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sndfileencoder.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include <sndfile.h>
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::iex::audioexport;
+using namespace mu::audio;
+
+static io::Device* toDevice(void* userData)
+{
+    return static_cast<io::Device*>(userData);
+}
+
+static sf_count_t deviceSize(void* userData)
+{
+    return toDevice(userData)->size();
+}
+
+static sf_count_t deviceSeek(sf_count_t offset, int whence, void* userData)
+{
+    io::Device* device = toDevice(userData);
+
+    qint64 pos = offset;
+    switch (whence) {
+    case SEEK_CUR: pos += device->pos();
+        break;
+    case SEEK_END: pos += device->size();
+        break;
+    default:
+        break;
+    }
+
+    //! NOTE Sequential devices can't seek, the encoders then keep the headers written at the beginning
+    if (!device->seek(pos)) {
+        return -1;
+    }
+
+    return device->pos();
+}
+
+static sf_count_t deviceRead(void* ptr, sf_count_t count, void* userData)
+{
+    return toDevice(userData)->read(static_cast<char*>(ptr), count);
+}
+
+static sf_count_t deviceWrite(const void* ptr, sf_count_t count, void* userData)
+{
+    return toDevice(userData)->write(static_cast<const char*>(ptr), count);
+}
+
+static sf_count_t deviceTell(void* userData)
+{
+    return toDevice(userData)->pos();
+}
+
+SndFileEncoder::SndFileEncoder(io::Device& device, int format, int bitrate)
+    : m_device(device), m_format(format), m_bitrate(bitrate)
+{
+}
+
+SndFileEncoder::~SndFileEncoder()
+{
+    if (m_sndFile) {
+        sf_close(m_sndFile);
+    }
+}
+
+Ret SndFileEncoder::begin(const IOfflineRenderer::Spec& spec)
+{
+    IF_ASSERT_FAILED(!m_sndFile) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    SF_INFO info;
+    info.frames = 0;
+    info.samplerate = static_cast<int>(spec.sampleRate);
+    info.channels = static_cast<int>(spec.audioChannelsCount);
+    info.format = m_format;
+    info.sections = 0;
+    info.seekable = 0;
+
+    if (!sf_format_check(&info)) {
+        LOGE() << "format isn't supported by libsndfile: " << m_format;
+        return make_ret(Ret::Code::NotSupported);
+    }
+
+    static SF_VIRTUAL_IO deviceIo = { deviceSize, deviceSeek, deviceRead, deviceWrite, deviceTell };
+
+    m_sndFile = sf_open_virtual(&deviceIo, SFM_WRITE, &info, &m_device);
+    if (!m_sndFile) {
+        LOGE() << "failed open sndfile encoder: " << sf_strerror(nullptr);
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    //! NOTE The rendered samples may exceed 1.0, the integer formats clip them instead of wrapping around
+    sf_command(m_sndFile, SFC_SET_CLIPPING, nullptr, SF_TRUE);
+
+    if (m_bitrate > 0) {
+        applyBitrate(spec.sampleRate);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+void SndFileEncoder::applyBitrate(const sample_rate_t sampleRate)
+{
+#ifdef SNDFILE_HAS_MPEG
+    if ((m_format & SF_FORMAT_TYPEMASK) != SF_FORMAT_MPEG) {
+        return;
+    }
+
+    int mode = SF_BITRATE_MODE_CONSTANT;
+    if (!sf_command(m_sndFile, SFC_SET_BITRATE_MODE, &mode, sizeof(mode))) {
+        LOGW() << "failed set constant bitrate mode: " << sf_strerror(m_sndFile);
+        return;
+    }
+
+    //! NOTE libsndfile maps the compression level linearly onto the bitrates of the MPEG version,
+    //!      which the sample rate selects: 1.0 is the lowest one, 0.0 is the highest one
+    int minBitrate = 8;
+    int maxBitrate = 64;
+    if (sampleRate >= 32000) {
+        minBitrate = 32;
+        maxBitrate = 320;
+    } else if (sampleRate >= 16000) {
+        maxBitrate = 160;
+    }
+
+    int bitrate = std::clamp(m_bitrate, minBitrate, maxBitrate);
+    double compressionLevel = static_cast<double>(maxBitrate - bitrate) / (maxBitrate - minBitrate);
+
+    if (!sf_command(m_sndFile, SFC_SET_COMPRESSION_LEVEL, &compressionLevel, sizeof(compressionLevel))) {
+        LOGW() << "failed set bitrate: " << bitrate << ", " << sf_strerror(m_sndFile);
+    }
+#else
+    UNUSED(sampleRate)
+#endif
+}
+
+Ret SndFileEncoder::encode(const float* buffer, samples_t samplesPerChannel)
+{
+    IF_ASSERT_FAILED(m_sndFile) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    sf_count_t frames = static_cast<sf_count_t>(samplesPerChannel);
+    if (sf_writef_float(m_sndFile, buffer, frames) != frames) {
+        LOGE() << "failed encode audio: " << sf_strerror(m_sndFile);
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+Ret SndFileEncoder::end()
+{
+    IF_ASSERT_FAILED(m_sndFile) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    int err = sf_close(m_sndFile);
+    m_sndFile = nullptr;
+
+    if (err != SF_ERR_NO_ERROR) {
+        LOGE() << "failed finish audio encoding: " << sf_error_number(err);
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
@@ -0,0 +1,56 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_IMPORTEXPORT_SNDFILEENCODER_H
+#define MU_IMPORTEXPORT_SNDFILEENCODER_H
+
+#include "io/device.h"
+
+#include "iaudioencoder.h"
+
+typedef struct sf_private_tag SNDFILE;
+
+namespace mu::iex::audioexport {
+//! NOTE Encodes with libsndfile, which writes to the device through its virtual io
+class SndFileEncoder : public IAudioEncoder
+{
+public:
+    //! NOTE The format is a combination of the libsndfile SF_FORMAT_* major format and subtype
+    //!      The constant bitrate, in kbps, is only applied to MP3, 0 keeps the default of the encoder
+    SndFileEncoder(io::Device& device, int format, int bitrate = 0);
+    ~SndFileEncoder() override;
+
+    Ret begin(const audio::IOfflineRenderer::Spec& spec) override;
+    Ret encode(const float* buffer, audio::samples_t samplesPerChannel) override;
+    Ret end() override;
+
+private:
+    void applyBitrate(const audio::sample_rate_t sampleRate);
+
+    io::Device& m_device;
+    int m_format = 0;
+    int m_bitrate = 0;
+    SNDFILE* m_sndFile = nullptr;
+};
+}
+
+#endif // MU_IMPORTEXPORT_SNDFILEENCODER_H
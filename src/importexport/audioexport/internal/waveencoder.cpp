@@ -0,0 +1,138 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "waveencoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QByteArray>
+#include <QtEndian>
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::iex::audioexport;
+using namespace mu::audio;
+
+static constexpr uint16_t WAVE_FORMAT_PCM = 1;
+static constexpr uint16_t WAVE_BITS_PER_SAMPLE = 16;
+static constexpr uint32_t WAVE_HEADER_SIZE = 44;
+
+WaveEncoder::WaveEncoder(io::Device& device)
+    : m_device(device)
+{
+}
+
+Ret WaveEncoder::begin(const IOfflineRenderer::Spec& spec)
+{
+    m_sampleRate = spec.sampleRate;
+    m_channelsCount = spec.audioChannelsCount;
+    m_dataSize = m_device.isSequential() ? std::numeric_limits<uint32_t>::max() - WAVE_HEADER_SIZE : 0;
+    m_headerPos = m_device.pos();
+
+    return writeHeader();
+}
+
+Ret WaveEncoder::encode(const float* buffer, samples_t samplesPerChannel)
+{
+    size_t samplesCount = samplesPerChannel * m_channelsCount;
+    m_pcmBuffer.resize(samplesCount);
+
+    for (size_t i = 0; i < samplesCount; ++i) {
+        float sample = std::clamp(buffer[i], -1.f, 1.f);
+        m_pcmBuffer[i] = qToLittleEndian(static_cast<int16_t>(std::lrint(sample * 32767.f)));
+    }
+
+    qint64 bytesCount = static_cast<qint64>(samplesCount * sizeof(int16_t));
+    if (m_device.write(reinterpret_cast<const char*>(m_pcmBuffer.data()), bytesCount) != bytesCount) {
+        LOGE() << "failed write wave data: " << m_device.errorString();
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    if (!m_device.isSequential()) {
+        m_dataSize = static_cast<uint32_t>(std::min<uint64_t>(uint64_t(m_dataSize) + bytesCount,
+                                                              std::numeric_limits<uint32_t>::max() - WAVE_HEADER_SIZE));
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+Ret WaveEncoder::end()
+{
+    if (m_device.isSequential()) {
+        return make_ret(Ret::Code::Ok);
+    }
+
+    qint64 endPos = m_device.pos();
+    if (!m_device.seek(m_headerPos)) {
+        LOGE() << "failed seek to wave header: " << m_device.errorString();
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    Ret ret = writeHeader();
+    m_device.seek(endPos);
+
+    return ret;
+}
+
+Ret WaveEncoder::writeHeader()
+{
+    QByteArray header;
+    header.reserve(WAVE_HEADER_SIZE);
+
+    auto appendUInt32 = [&header](uint32_t value) {
+        value = qToLittleEndian(value);
+        header.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    auto appendUInt16 = [&header](uint16_t value) {
+        value = qToLittleEndian(value);
+        header.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    uint16_t blockAlign = m_channelsCount * WAVE_BITS_PER_SAMPLE / 8;
+
+    header.append("RIFF", 4);
+    appendUInt32(WAVE_HEADER_SIZE - 8 + m_dataSize);
+    header.append("WAVE", 4);
+
+    header.append("fmt ", 4);
+    appendUInt32(16);
+    appendUInt16(WAVE_FORMAT_PCM);
+    appendUInt16(m_channelsCount);
+    appendUInt32(m_sampleRate);
+    appendUInt32(m_sampleRate * blockAlign);
+    appendUInt16(blockAlign);
+    appendUInt16(WAVE_BITS_PER_SAMPLE);
+
+    header.append("data", 4);
+    appendUInt32(m_dataSize);
+
+    if (m_device.write(header) != header.size()) {
+        LOGE() << "failed write wave header: " << m_device.errorString();
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
@@ -0,0 +1,58 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_IMPORTEXPORT_WAVEENCODER_H
+#define MU_IMPORTEXPORT_WAVEENCODER_H
+
+#include <vector>
+
+#include "io/device.h"
+
+#include "iaudioencoder.h"
+
+namespace mu::iex::audioexport {
+//! NOTE Writes 16-bit PCM. The sizes in the header are patched when the data is complete,
+//! sequential devices keep the maximum sizes, as for a stream of unknown length
+class WaveEncoder : public IAudioEncoder
+{
+public:
+    explicit WaveEncoder(io::Device& device);
+
+    Ret begin(const audio::IOfflineRenderer::Spec& spec) override;
+    Ret encode(const float* buffer, audio::samples_t samplesPerChannel) override;
+    Ret end() override;
+
+private:
+    Ret writeHeader();
+
+    io::Device& m_device;
+    qint64 m_headerPos = 0;
+
+    uint32_t m_sampleRate = 0;
+    uint16_t m_channelsCount = 0;
+    uint32_t m_dataSize = 0;
+
+    std::vector<int16_t> m_pcmBuffer;
+};
+}
+
+#endif // MU_IMPORTEXPORT_WAVEENCODER_H
@@ -22,18 +22,11 @@
 
 #include "wavewriter.h"
 
-#include "log.h"
+#include "waveencoder.h"
 
 using namespace mu::iex::audioexport;
-using namespace mu::framework;
 
-mu::Ret WaveWriter::write(notation::INotationPtr notation, io::Device& destinationDevice, const Options& options)
+IAudioEncoderPtr WaveWriter::createEncoder(io::Device& destinationDevice) const
 {
-    UNUSED(notation)
-    UNUSED(destinationDevice)
-    UNUSED(options)
-
-    NOT_IMPLEMENTED;
-
-    return make_ret(Ret::Code::NotImplemented);
+    return std::make_unique<WaveEncoder>(destinationDevice);
 }
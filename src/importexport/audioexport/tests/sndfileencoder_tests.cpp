@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <QBuffer>
+#include <QByteArray>
+
+#include <sndfile.h>
+
+#include "internal/sndfileencoder.h"
+
+using namespace mu;
+using namespace mu::iex::audioexport;
+using namespace mu::audio;
+
+class SndFileEncoderTests : public ::testing::Test
+{
+public:
+    //! NOTE Encodes a second of a sawtooth
+    static QByteArray encode(int format, int bitrate = 0)
+    {
+        QBuffer buffer;
+        buffer.open(QIODevice::ReadWrite);
+
+        SndFileEncoder encoder(buffer, format, bitrate);
+
+        IOfflineRenderer::Spec spec;
+        spec.sampleRate = 44100;
+        spec.audioChannelsCount = 2;
+
+        std::vector<float> samples(441 * 2);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            samples[i] = (i % 100) / 100.f - 0.5f;
+        }
+
+        EXPECT_TRUE(encoder.begin(spec));
+        for (int block = 0; block < 100; ++block) {
+            EXPECT_TRUE(encoder.encode(samples.data(), 441));
+        }
+        EXPECT_TRUE(encoder.end());
+
+        return buffer.data();
+    }
+};
+
+TEST_F(SndFileEncoderTests, Flac)
+{
+    //! WHEN Encode to FLAC
+    QByteArray data = encode(SF_FORMAT_FLAC | SF_FORMAT_PCM_16);
+
+    //! THEN The FLAC stream is written and compressed
+    EXPECT_EQ(data.left(4), QByteArray("fLaC"));
+    EXPECT_LT(data.size(), 44100 * 2 * 2);
+}
+
+TEST_F(SndFileEncoderTests, OggVorbis)
+{
+    //! WHEN Encode to Ogg Vorbis
+    QByteArray data = encode(SF_FORMAT_OGG | SF_FORMAT_VORBIS);
+
+    //! THEN The Ogg stream is written
+    EXPECT_EQ(data.left(4), QByteArray("OggS"));
+    EXPECT_GT(data.size(), 0);
+}
+
+#ifdef SNDFILE_HAS_MPEG
+TEST_F(SndFileEncoderTests, Mp3)
+{
+    //! WHEN Encode to MP3 at 128 kbps
+    QByteArray data = encode(SF_FORMAT_MPEG | SF_FORMAT_MPEG_LAYER_III, 128);
+
+    //! THEN The stream starts with an ID3 tag or with a frame sync
+    ASSERT_GT(data.size(), 2);
+    bool isId3 = data.startsWith("ID3");
+    bool isFrameSync = static_cast<uint8_t>(data[0]) == 0xFF && (static_cast<uint8_t>(data[1]) & 0xE0) == 0xE0;
+    EXPECT_TRUE(isId3 || isFrameSync);
+
+    //! THEN A second is about 16 KB long
+    EXPECT_GT(data.size(), 12000);
+    EXPECT_LT(data.size(), 20000);
+}
+
+TEST_F(SndFileEncoderTests, Mp3Bitrate)
+{
+    //! WHEN Encode to MP3 at different bitrates
+    QByteArray lowBitrateData = encode(SF_FORMAT_MPEG | SF_FORMAT_MPEG_LAYER_III, 64);
+    QByteArray highBitrateData = encode(SF_FORMAT_MPEG | SF_FORMAT_MPEG_LAYER_III, 256);
+
+    //! THEN The size follows the bitrate
+    EXPECT_GT(highBitrateData.size(), lowBitrateData.size() * 3);
+}
+#endif
@@ -0,0 +1,163 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QtEndian>
+
+#include "internal/waveencoder.h"
+
+using namespace mu;
+using namespace mu::iex::audioexport;
+using namespace mu::audio;
+
+class WaveEncoderTests : public ::testing::Test
+{
+public:
+    static uint32_t uint32At(const QByteArray& data, int pos)
+    {
+        uint32_t value = 0;
+        std::memcpy(&value, data.constData() + pos, sizeof(value));
+        return qFromLittleEndian(value);
+    }
+
+    static uint16_t uint16At(const QByteArray& data, int pos)
+    {
+        uint16_t value = 0;
+        std::memcpy(&value, data.constData() + pos, sizeof(value));
+        return qFromLittleEndian(value);
+    }
+
+    static int16_t sampleAt(const QByteArray& data, size_t idx)
+    {
+        return static_cast<int16_t>(uint16At(data, static_cast<int>(44 + idx * sizeof(int16_t))));
+    }
+};
+
+TEST_F(WaveEncoderTests, Header)
+{
+    //! GIVEN Encoder writing to a buffer
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    WaveEncoder encoder(buffer);
+
+    IOfflineRenderer::Spec spec;
+    spec.sampleRate = 48000;
+    spec.audioChannelsCount = 2;
+
+    //! WHEN Encode 100 frames in two blocks
+    std::vector<float> samples(100 * 2, 0.f);
+
+    EXPECT_TRUE(encoder.begin(spec));
+    EXPECT_TRUE(encoder.encode(samples.data(), 60));
+    EXPECT_TRUE(encoder.encode(samples.data(), 40));
+    EXPECT_TRUE(encoder.end());
+
+    //! THEN The header describes 16-bit stereo PCM with the sizes of the written data
+    const QByteArray& data = buffer.data();
+    const uint32_t dataSize = 100 * 2 * sizeof(int16_t);
+
+    ASSERT_EQ(data.size(), static_cast<int>(44 + dataSize));
+
+    EXPECT_EQ(data.mid(0, 4), QByteArray("RIFF"));
+    EXPECT_EQ(uint32At(data, 4), 36 + dataSize);
+    EXPECT_EQ(data.mid(8, 4), QByteArray("WAVE"));
+
+    EXPECT_EQ(data.mid(12, 4), QByteArray("fmt "));
+    EXPECT_EQ(uint32At(data, 16), 16u);
+    EXPECT_EQ(uint16At(data, 20), 1u); // PCM
+    EXPECT_EQ(uint16At(data, 22), 2u); // channels
+    EXPECT_EQ(uint32At(data, 24), 48000u); // sample rate
+    EXPECT_EQ(uint32At(data, 28), 48000u * 4); // byte rate
+    EXPECT_EQ(uint16At(data, 32), 4u); // block align
+    EXPECT_EQ(uint16At(data, 34), 16u); // bits per sample
+
+    EXPECT_EQ(data.mid(36, 4), QByteArray("data"));
+    EXPECT_EQ(uint32At(data, 40), dataSize);
+
+    //! THEN The device is left at the end of the data
+    EXPECT_EQ(buffer.pos(), data.size());
+}
+
+TEST_F(WaveEncoderTests, Samples)
+{
+    //! GIVEN Encoder writing mono to a buffer
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    WaveEncoder encoder(buffer);
+
+    IOfflineRenderer::Spec spec;
+    spec.audioChannelsCount = 1;
+
+    //! WHEN Encode the samples, some of them are out of range
+    std::vector<float> samples = { 0.f, 0.5f, -0.5f, 1.f, -1.f, 2.f, -2.f };
+
+    EXPECT_TRUE(encoder.begin(spec));
+    EXPECT_TRUE(encoder.encode(samples.data(), samples.size()));
+    EXPECT_TRUE(encoder.end());
+
+    //! THEN The samples are converted to 16-bit, the out of range ones are clipped
+    const QByteArray& data = buffer.data();
+    ASSERT_EQ(data.size(), static_cast<int>(44 + samples.size() * sizeof(int16_t)));
+
+    EXPECT_EQ(sampleAt(data, 0), 0);
+    EXPECT_EQ(sampleAt(data, 1), 16384);
+    EXPECT_EQ(sampleAt(data, 2), -16384);
+    EXPECT_EQ(sampleAt(data, 3), 32767);
+    EXPECT_EQ(sampleAt(data, 4), -32767);
+    EXPECT_EQ(sampleAt(data, 5), 32767);
+    EXPECT_EQ(sampleAt(data, 6), -32767);
+}
+
+TEST_F(WaveEncoderTests, HeaderAtDevicePosition)
+{
+    //! GIVEN Buffer with some data written before the wave
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    buffer.write("prefix");
+
+    WaveEncoder encoder(buffer);
+
+    IOfflineRenderer::Spec spec;
+    spec.audioChannelsCount = 1;
+
+    //! WHEN Encode a few samples
+    std::vector<float> samples(10, 0.f);
+
+    EXPECT_TRUE(encoder.begin(spec));
+    EXPECT_TRUE(encoder.encode(samples.data(), samples.size()));
+    EXPECT_TRUE(encoder.end());
+
+    //! THEN The header is patched in place, the data before it is kept
+    QByteArray data = buffer.data();
+    EXPECT_EQ(data.left(6), QByteArray("prefix"));
+
+    QByteArray wave = data.mid(6);
+    EXPECT_EQ(wave.mid(0, 4), QByteArray("RIFF"));
+    EXPECT_EQ(uint32At(wave, 40), 10u * sizeof(int16_t));
+}
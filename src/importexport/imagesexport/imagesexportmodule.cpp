@@ -29,6 +29,7 @@
 #include "internal/svgwriter.h"
 
 #include "internal/imagesexportconfiguration.h"
+#include "internal/pagerecordscache.h"
 
 #include "log.h"
 
@@ -36,6 +37,7 @@ using namespace mu::iex::imagesexport;
 using namespace mu::project;
 
 static std::shared_ptr<ImagesExportConfiguration> s_configuration = std::make_shared<ImagesExportConfiguration>();
+static std::shared_ptr<PageRecordsCache> s_pageRecordsCache = std::make_shared<PageRecordsCache>();
 
 std::string ImagesExportModule::moduleName() const
 {
@@ -45,6 +47,7 @@ std::string ImagesExportModule::moduleName() const
 void ImagesExportModule::registerExports()
 {
     modularity::ioc()->registerExport<IImagesExportConfiguration>(moduleName(), s_configuration);
+    modularity::ioc()->registerExport<IPageRecordsCache>(moduleName(), s_pageRecordsCache);
 }
 
 void ImagesExportModule::resolveImports()
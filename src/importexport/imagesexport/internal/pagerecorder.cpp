@@ -0,0 +1,148 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "pagerecorder.h"
+
+#include "infrastructure/draw/bufferedpaintprovider.h"
+#include "infrastructure/draw/painter.h"
+#include "libmscore/image.h"
+#include "libmscore/mscore.h"
+#include "libmscore/page.h"
+#include "libmscore/score.h"
+
+#include "log.h"
+
+using namespace mu::iex::imagesexport;
+using namespace mu::draw;
+using namespace Ms;
+
+//! NOTE The svg images are rendered by QSvgRenderer straight into the QPainter of the device,
+//! so the pages with them can't be recorded and are printed into the device directly
+static bool canRecordPage(Page* page)
+{
+    for (const EngravingItem* item : page->items(page->abbox())) {
+        if (item->isImage() && toImage(item)->getImageType() == ImageType::SVG) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+DrawDataPtr PageRecorder::record(Score* score, int pageNumber, double pixelRatio)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(score && pageNumber >= 0 && pageNumber < score->npages()) {
+        return nullptr;
+    }
+
+    if (!canRecordPage(score->pages().at(pageNumber))) {
+        return nullptr;
+    }
+
+    //! NOTE The render state is thread local, so it is set for the thread of the record
+    double pixelRatioBackup = MScore::pixelRatio;
+    MScore::pixelRatio = pixelRatio;
+
+    auto provider = std::make_shared<BufferedPaintProvider>();
+    {
+        Painter painter(provider, "page_record");
+        painter.setAntialiasing(true);
+
+        score->print(&painter, pageNumber);
+
+        painter.endDraw();
+    }
+
+    MScore::pixelRatio = pixelRatioBackup;
+
+    return std::make_shared<DrawData>(provider->drawData());
+}
+
+//! NOTE The recorded transforms already include the transforms of the items,
+//! so the data is painted by the provider, bypassing the transforms of the painter
+void PageRecorder::paint(IPaintProviderPtr provider, const DrawData& data, const Transform& pageTransform)
+{
+    bool isClipping = false;
+
+    for (const DrawData::Object& obj : data.objects) {
+        for (const DrawData::Data& d : obj.datas) {
+            const DrawData::State& st = d.state;
+
+            //! NOTE The clip rect is set with its own transform, as it was recorded.
+            //! The clipping enabled without a valid clip rect isn't replayed
+            const bool isStateClipping = st.isClipping && st.clipRect.isValid();
+            if (isStateClipping) {
+                provider->setTransform(st.clipTransform * pageTransform);
+                provider->setClipRect(st.clipRect);
+            } else if (isClipping) {
+                provider->setClipping(false);
+            }
+            isClipping = isStateClipping;
+
+            provider->setPen(st.pen);
+            provider->setBrush(st.brush);
+            provider->setFont(st.font);
+            provider->setTransform(st.transform * pageTransform);
+            provider->setAntialiasing(st.isAntialiasing);
+            provider->setCompositionMode(st.compositionMode);
+
+            if (!d.paths.empty()) {
+                for (const DrawPath& path : d.paths) {
+                    provider->setPen(path.pen);
+                    provider->setBrush(path.brush);
+                    provider->drawPath(path.path);
+                }
+
+                provider->setPen(st.pen);
+                provider->setBrush(st.brush);
+            }
+
+            for (const DrawPolygon& pl : d.polygons) {
+                if (pl.polygon.empty()) {
+                    continue;
+                }
+                provider->drawPolygon(&pl.polygon[0], pl.polygon.size(), pl.mode);
+            }
+
+            for (const DrawText& t : d.texts) {
+                provider->drawText(t.pos, t.text);
+            }
+
+            for (const DrawRectText& t : d.rectTexts) {
+                provider->drawText(t.rect, t.flags, t.text);
+            }
+
+            for (const DrawPixmap& px : d.pixmaps) {
+                provider->drawPixmap(px.pos, px.pm);
+            }
+
+            for (const DrawTiledPixmap& px : d.tiledPixmap) {
+                provider->drawTiledPixmap(px.rect, px.pm, px.offset);
+            }
+        }
+    }
+
+    if (isClipping) {
+        provider->setClipping(false);
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_IMPORTEXPORT_PAGERECORDER_H
+#define MU_IMPORTEXPORT_PAGERECORDER_H
+
+#include "infrastructure/draw/buffereddrawtypes.h"
+#include "infrastructure/draw/ipaintprovider.h"
+
+namespace Ms {
+class Score;
+}
+
+namespace mu::iex::imagesexport {
+class PageRecorder
+{
+public:
+    //! NOTE Records the page in its own coordinates (the DPI units), for a device with the given pixel ratio.
+    //! Returns null if the page can't be recorded
+    static draw::DrawDataPtr record(Ms::Score* score, int pageNumber, double pixelRatio);
+
+    //! NOTE The recorded transforms are mapped to the device by the page transform
+    static void paint(draw::IPaintProviderPtr provider, const draw::DrawData& data, const draw::Transform& pageTransform);
+};
+}
+
+#endif // MU_IMPORTEXPORT_PAGERECORDER_H
@@ -0,0 +1,67 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "pagerecordscache.h"
+
+#include "pagerecorder.h"
+
+using namespace mu::iex::imagesexport;
+using namespace mu::draw;
+
+void PageRecordsCache::open()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isOpened = true;
+}
+
+void PageRecordsCache::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isOpened = false;
+    m_records.clear();
+}
+
+DrawDataPtr PageRecordsCache::pageRecord(Ms::Score* score, int pageNumber, double pixelRatio)
+{
+    const Key key { score, pageNumber, pixelRatio };
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_isOpened) {
+            auto it = m_records.find(key);
+            if (it != m_records.end()) {
+                return it->second;
+            }
+        }
+    }
+
+    //! NOTE The page is recorded out of the lock, the pages are recorded by several threads at once.
+    //! If two writers record the same page meanwhile, the records are the same, the first one is kept
+    DrawDataPtr record = PageRecorder::record(score, pageNumber, pixelRatio);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_isOpened) {
+        return record;
+    }
+
+    auto it = m_records.emplace(key, record).first;
+    return it->second;
+}
@@ -0,0 +1,49 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_IMPORTEXPORT_PAGERECORDSCACHE_H
+#define MU_IMPORTEXPORT_PAGERECORDSCACHE_H
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include "../ipagerecordscache.h"
+
+namespace mu::iex::imagesexport {
+class PageRecordsCache : public IPageRecordsCache
+{
+public:
+    void open() override;
+    void close() override;
+
+    draw::DrawDataPtr pageRecord(Ms::Score* score, int pageNumber, double pixelRatio) override;
+
+private:
+    using Key = std::tuple<const Ms::Score*, int, double>;
+
+    std::mutex m_mutex;
+    bool m_isOpened = false;
+    std::map<Key, draw::DrawDataPtr> m_records;
+};
+}
+
+#endif // MU_IMPORTEXPORT_PAGERECORDSCACHE_H
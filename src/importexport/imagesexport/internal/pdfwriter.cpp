@@ -23,8 +23,14 @@
 #include "pdfwriter.h"
 
 #include <QPdfWriter>
+#include <QThreadPool>
+#include <QtConcurrent>
 
+#include <deque>
+
+#include "pagerecorder.h"
 #include "libmscore/masterscore.h"
+#include "libmscore/page.h"
 
 #include "log.h"
 
@@ -62,7 +68,7 @@ mu::Ret PdfWriter::write(INotationPtr notation, io::Device& destinationDevice, c
         return false;
     }
 
-    doWrite(pdfWriter, painter, score);
+    doWrite(pdfWriter, painter, { score });
 
     painter.endDraw();
 
@@ -93,11 +99,7 @@ mu::Ret PdfWriter::writeList(const INotationPtrList& notations, io::Device& dest
     QPdfWriter pdfWriter(&destinationDevice);
     preparePdfWriter(pdfWriter, documentTitle(*(firstScore->masterScore())));
 
-    mu::draw::Painter painter(&pdfWriter, "pdfwriter");
-    if (!painter.isActive()) {
-        return false;
-    }
-
+    std::vector<Score*> scores;
     for (auto notation : notations) {
         IF_ASSERT_FAILED(notation) {
             return make_ret(Ret::Code::UnknownError);
@@ -108,13 +110,16 @@ mu::Ret PdfWriter::writeList(const INotationPtrList& notations, io::Device& dest
             return make_ret(Ret::Code::UnknownError);
         }
 
-        if (score != firstScore) {
-            pdfWriter.newPage();
-        }
+        scores.push_back(score);
+    }
 
-        doWrite(pdfWriter, painter, score);
+    mu::draw::Painter painter(&pdfWriter, "pdfwriter");
+    if (!painter.isActive()) {
+        return false;
     }
 
+    doWrite(pdfWriter, painter, scores);
+
     painter.endDraw();
 
     return true;
@@ -147,32 +152,95 @@ void PdfWriter::preparePdfWriter(QPdfWriter& pdfWriter, const QString& title) co
     pdfWriter.setPageMargins(QMarginsF());
 }
 
-void PdfWriter::doWrite(QPdfWriter& pdfWriter, mu::draw::Painter& painter, Score* score) const
+static RectF pageViewport(const QPdfWriter& pdfWriter, const Score* score)
 {
-    IF_ASSERT_FAILED(score) {
-        return;
+    QSizeF size(score->styleD(Sid::pageWidth), score->styleD(Sid::pageHeight));
+    return RectF(0.0, 0.0, size.width() * pdfWriter.logicalDpiX(), size.height() * pdfWriter.logicalDpiY());
+}
+
+static RectF pageWindow(const Score* score)
+{
+    QSizeF size(score->styleD(Sid::pageWidth), score->styleD(Sid::pageHeight));
+    return RectF(0.0, 0.0, size.width() * DPI, size.height() * DPI);
+}
+
+//! NOTE Maps the page, as it's recorded, to the pdf page
+static mu::draw::Transform pageTransform(const QPdfWriter& pdfWriter)
+{
+    mu::draw::Transform transform;
+    transform.scale(pdfWriter.logicalDpiX() / DPI, pdfWriter.logicalDpiY() / DPI);
+    return transform;
+}
+
+void PdfWriter::doWrite(QPdfWriter& pdfWriter, mu::draw::Painter& painter, const std::vector<Score*>& scores) const
+{
+    TRACEFUNC;
+
+    //! NOTE The pages of all the scores are recorded into display lists by the thread pool,
+    //! while the finished ones are painted here, in order, into the one pdf document.
+    //! Only as many pages as the pool runs at once are kept in memory, unless the records cache is open
+    std::vector<std::pair<Score*, int> > pages;
+    for (Score* score : scores) {
+        IF_ASSERT_FAILED(score) {
+            continue;
+        }
+
+        for (int pageNumber = 0; pageNumber < score->npages(); ++pageNumber) {
+            pages.push_back({ score, pageNumber });
+        }
     }
 
-    score->setPrinting(true);
-    MScore::pdfPrinting = true;
+    const double pixelRatio = DPI / pdfWriter.logicalDpiX();
+    const size_t maxRecordsCount = static_cast<size_t>(std::max(1, QThreadPool::globalInstance()->maxThreadCount()));
+
+    //! NOTE The pages already recorded by the other writers (e.g. png) are taken from the cache
+    IPageRecordsCache* cache = recordsCache().get();
+
+    std::deque<QFuture<mu::draw::DrawDataPtr> > records;
+    size_t nextPage = 0;
+
+    auto startNextRecord = [&]() {
+        Score* score = pages[nextPage].first;
+        int pageNumber = pages[nextPage].second;
+        ++nextPage;
+
+        records.push_back(QtConcurrent::run([cache, score, pageNumber, pixelRatio]() {
+            return cache->pageRecord(score, pageNumber, pixelRatio);
+        }));
+    };
+
+    while (nextPage < pages.size() && records.size() < maxRecordsCount) {
+        startNextRecord();
+    }
+
+    double pixelRatioBackup = MScore::pixelRatio;
+    MScore::pixelRatio = pixelRatio;
 
-    QSizeF size(score->styleD(Sid::pageWidth), score->styleD(Sid::pageHeight));
     painter.setAntialiasing(true);
-    painter.setViewport(RectF(0.0, 0.0, size.width() * pdfWriter.logicalDpiX(), size.height() * pdfWriter.logicalDpiY()));
-    painter.setWindow(RectF(0.0, 0.0, size.width() * DPI, size.height() * DPI));
 
-    double pixelRationBackup = MScore::pixelRatio;
-    MScore::pixelRatio = DPI / pdfWriter.logicalDpiX();
+    for (size_t i = 0; i < pages.size(); ++i) {
+        mu::draw::DrawDataPtr record = records.front().result();
+        records.pop_front();
 
-    for (int pageNumber = 0; pageNumber < score->npages(); ++pageNumber) {
-        if (pageNumber > 0) {
+        if (nextPage < pages.size()) {
+            startNextRecord();
+        }
+
+        if (i > 0) {
             pdfWriter.newPage();
         }
 
-        score->print(&painter, pageNumber);
+        if (record) {
+            PageRecorder::paint(painter.provider(), *record, pageTransform(pdfWriter));
+            continue;
+        }
+
+        Score* score = pages[i].first;
+        painter.setViewport(pageViewport(pdfWriter, score));
+        painter.setWindow(pageWindow(score));
+
+        score->print(&painter, pages[i].second);
     }
 
-    score->setPrinting(false);
-    MScore::pixelRatio = pixelRationBackup;
-    MScore::pdfPrinting = false;
+    MScore::pixelRatio = pixelRatioBackup;
 }
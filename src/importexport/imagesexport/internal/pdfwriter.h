@@ -26,6 +26,7 @@
 #include "abstractimagewriter.h"
 
 #include "../iimagesexportconfiguration.h"
+#include "../ipagerecordscache.h"
 #include "modularity/ioc.h"
 
 class QPdfWriter;
@@ -34,6 +35,7 @@ namespace mu::iex::imagesexport {
 class PdfWriter : public AbstractImageWriter
 {
     INJECT(iex_imagesexport, IImagesExportConfiguration, configuration)
+    INJECT(iex_imagesexport, IPageRecordsCache, recordsCache)
 
 public:
     std::vector<project::INotationWriter::UnitType> supportedUnitTypes() const override;
@@ -43,7 +45,7 @@ public:
 private:
     QString documentTitle(const Ms::Score& score) const;
     void preparePdfWriter(QPdfWriter& pdfWriter, const QString& title) const;
-    void doWrite(QPdfWriter& pdfWriter, mu::draw::Painter& painter, Ms::Score* score) const;
+    void doWrite(QPdfWriter& pdfWriter, mu::draw::Painter& painter, const std::vector<Ms::Score*>& scores) const;
 };
 }
 
@@ -25,9 +25,9 @@
 #include <cmath>
 #include <QImage>
 
+#include "pagerecorder.h"
 #include "libmscore/masterscore.h"
 #include "libmscore/page.h"
-#include "engraving/paint/paint.h"
 
 #include "log.h"
 
@@ -36,6 +36,13 @@ using namespace mu::project;
 using namespace mu::notation;
 using namespace mu::io;
 
+PngWriter::PngWriter()
+{
+    //! NOTE Resolved here, the pages may be written by several threads at once (e.g. the media export)
+    configuration();
+    recordsCache();
+}
+
 std::vector<INotationWriter::UnitType> PngWriter::supportedUnitTypes() const
 {
     return { UnitType::PER_PAGE };
@@ -52,10 +59,6 @@ mu::Ret PngWriter::write(INotationPtr notation, Device& destinationDevice, const
         return make_ret(Ret::Code::UnknownError);
     }
 
-    score->setPrinting(true); // don’t print page break symbols etc.
-
-    double pixelRatioBackup = Ms::MScore::pixelRatio;
-
     const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
     const QList<Ms::Page*>& pages = score->pages();
 
@@ -63,6 +66,8 @@ mu::Ret PngWriter::write(INotationPtr notation, Device& destinationDevice, const
         return false;
     }
 
+    double pixelRatioBackup = Ms::MScore::pixelRatio;
+
     Ms::Page* page = pages[PAGE_NUMBER];
 
     const int TRIM_MARGIN_SIZE = configuration()->trimMarginPixelSize();
@@ -87,6 +92,9 @@ mu::Ret PngWriter::write(INotationPtr notation, Device& destinationDevice, const
     double scaling = CANVAS_DPI / Ms::DPI;
     Ms::MScore::pixelRatio = 1.0 / scaling;
 
+    //! NOTE The page is recorded once for all the writers painting it at this resolution (e.g. the pdf)
+    mu::draw::DrawDataPtr record = recordsCache()->pageRecord(score, PAGE_NUMBER, Ms::MScore::pixelRatio);
+
     mu::draw::Painter painter(&image, "pngwriter");
     painter.setAntialiasing(true);
     painter.scale(scaling, scaling);
@@ -94,13 +102,15 @@ mu::Ret PngWriter::write(INotationPtr notation, Device& destinationDevice, const
         painter.translate(-pageRect.topLeft());
     }
 
-    QList<Ms::EngravingItem*> elements = page->elements();
-    std::stable_sort(elements.begin(), elements.end(), Ms::elementLessThan);
+    if (record) {
+        PageRecorder::paint(painter.provider(), *record, painter.worldTransform());
+    } else {
+        score->print(&painter, PAGE_NUMBER);
+    }
 
-    engraving::Paint::paintElements(painter, elements);
+    painter.endDraw();
     image.save(&destinationDevice, "png");
 
-    score->setPrinting(false);
     Ms::MScore::pixelRatio = pixelRatioBackup;
 
     return true;
@@ -26,14 +26,18 @@
 #include "abstractimagewriter.h"
 
 #include "../iimagesexportconfiguration.h"
+#include "../ipagerecordscache.h"
 #include "modularity/ioc.h"
 
 namespace mu::iex::imagesexport {
 class PngWriter : public AbstractImageWriter
 {
     INJECT(iex_imagesexport, IImagesExportConfiguration, configuration)
+    INJECT(iex_imagesexport, IPageRecordsCache, recordsCache)
 
 public:
+    PngWriter();
+
     std::vector<project::INotationWriter::UnitType> supportedUnitTypes() const override;
     Ret write(notation::INotationPtr notation, io::Device& destinationDevice, const Options& options = Options()) override;
 };
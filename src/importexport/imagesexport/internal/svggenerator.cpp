@@ -27,6 +27,10 @@
 #include <QMimeType>
 #include <QMimeDatabase>
 #include <QPaintEngine>
+#include <QHash>
+#include <QTextLayout>
+#include <QGlyphRun>
+#include <QRawFont>
 
 #include "svggenerator.h"
 #include "libmscore/engravingitem.h"
@@ -169,9 +173,10 @@ public:
     QTextStream* stream;
     int resolution;
 
-    QString header;
 //    QString defs; // NEEDED FOR GRADIENTS
-    QString body;
+
+    // The ids of the glyphs already defined in the document, by font and glyph index
+    QHash<QString, QString> glyphIds;
 
     QBrush brush;
     QPen pen;
@@ -227,6 +232,9 @@ private:
     qreal _dx { 0.0 };
     qreal _dy { 0.0 };
 
+// The transform="matrix()" attribute, when there is more than a translation
+    QString _matrixString;
+
 protected:
 // The Ms::EngravingItem being generated right now
     const Ms::EngravingItem* _element = NULL;
@@ -266,6 +274,8 @@ protected:
 #define SVG_CURVE    'C'
 
 #define SVG_CLASS    " class=\""
+#define SVG_ID       " id=\""
+#define SVG_HREF     " xlink:href=\"#"
 
 #define SVG_ELEMENT_END  "/>"
 #define SVG_RPAREN_QUOTE ")\""
@@ -277,6 +287,9 @@ protected:
 
 #define SVG_IMAGE       "<image"
 #define SVG_PATH        "<path"
+#define SVG_USE         "<use"
+#define SVG_DEFS_BEGIN  "<defs>"
+#define SVG_DEFS_END    "</defs>"
 #define SVG_POLYLINE    "<polyline"
 
 #define SVG_PRESERVE_ASPECT " preserveAspectRatio=\""
@@ -317,6 +330,7 @@ public:
     void popGroup();
 
     void drawPath(const QPainterPath& path);
+    void drawTextItem(const QPointF& p, const QTextItem& textItem);
     void drawPixmap(const QRectF& r, const QPixmap& pm, const QRectF& sr);
     void drawPolygon(const QPoint* points, int pointCount, PolygonDrawMode mode) { QPaintEngine::drawPolygon(points, pointCount, mode); }
     void drawPolygon(const QPointF* points, int pointCount, PolygonDrawMode mode);
@@ -467,6 +481,8 @@ public:
         return *d_func()->stream;
     }
 
+    void writePathData(const QPainterPath& p, qreal dx, qreal dy);
+
     //////////////////////////////
     // SvgPaintEngine::qpenToSVG()
     //////////////////////////////
@@ -1030,8 +1046,13 @@ bool SvgPaintEngine::begin(QPaintDevice*)
         return false;
     }
 
-    // Stream the headers
-    d->stream = new QTextStream(&d->header);
+    // Stream the document straight to the device
+    d->stream = new QTextStream(d->outputDevice);
+
+#ifndef QT_NO_TEXTCODEC
+    d->stream->setCodec(QTextCodec::codecForName("UTF-8"));
+#endif
+
     stream() << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>" << Qt::endl << SVG_BEGIN;
     if (d->viewBox.isValid()) {
         // viewBox has floating point values, size width/height is integer
@@ -1053,12 +1074,9 @@ bool SvgPaintEngine::begin(QPaintDevice*)
         stream() << SVG_DESC_BEGIN << d->attributes.description.toHtmlEscaped() << SVG_DESC_END << Qt::endl;
     }
 
-// <defs> is currently empty. It's necessary for gradients.
-//    d->stream->setString(&d->defs);
-//    *d->stream << "<defs>\n";
+    // The glyphs are defined in <defs> where they are first used, see drawTextItem()
+    d->glyphIds.clear();
 
-    // Point the stream at the body string, for other functions to populate
-    d->stream->setString(&d->body);
     return true;
 }
 
@@ -1066,24 +1084,12 @@ bool SvgPaintEngine::end()
 {
     Q_D(SvgPaintEngine);
 
-// <defs> is currently empty
-//    d->stream->setString(&d->defs);
-//    stream() << "</defs>\n";
-
-    // Point the stream at the real output device (the .svg file)
-    d->stream->setDevice(d->outputDevice);
-
-#ifndef QT_NO_TEXTCODEC
-    d->stream->setCodec(QTextCodec::codecForName("UTF-8"));
-#endif
-
-    // Stream our strings out to the device, in order
-    stream() << d->header;
-//    stream() << d->defs;
-    stream() << d->body;
     stream() << SVG_END << Qt::endl;
+    stream().flush();
 
     delete d->stream;
+    d->stream = nullptr;
+
     return true;
 }
 
@@ -1148,6 +1154,7 @@ void SvgPaintEngine::updateState(const QPaintEngineState& s)
 {
     // Always start fresh
     stateString.clear();
+    _matrixString.clear();
 
     // stateString = Attribute Settings
 
@@ -1187,12 +1194,14 @@ void SvgPaintEngine::updateState(const QPaintEngineState& s)
         // Other transformations are more straightforward with a full matrix
         _dx = 0;
         _dy = 0;
-        stateStream << SVG_MATRIX << t.m11() << SVG_COMMA
-                    << t.m12() << SVG_COMMA
-                    << t.m21() << SVG_COMMA
-                    << t.m22() << SVG_COMMA
-                    << t.m31() << SVG_COMMA
-                    << t.m32() << SVG_RPAREN_QUOTE;
+        QTextStream matrixStream(&_matrixString);
+        matrixStream << SVG_MATRIX << t.m11() << SVG_COMMA
+                     << t.m12() << SVG_COMMA
+                     << t.m21() << SVG_COMMA
+                     << t.m22() << SVG_COMMA
+                     << t.m31() << SVG_COMMA
+                     << t.m32() << SVG_RPAREN_QUOTE;
+        stateStream << _matrixString;
     }
 }
 
@@ -1208,10 +1217,16 @@ void SvgPaintEngine::drawPath(const QPainterPath& p)
 
     // Path data
     stream() << SVG_D;
+    writePathData(p, _dx, _dy);
+    stream() << SVG_QUOTE << SVG_ELEMENT_END << Qt::endl;
+}
+
+void SvgPaintEngine::writePathData(const QPainterPath& p, qreal dx, qreal dy)
+{
     for (int i = 0; i < p.elementCount(); ++i) {
         const QPainterPath::Element& e = p.elementAt(i);
-        qreal x = e.x + _dx;
-        qreal y = e.y + _dy;
+        qreal x = e.x + dx;
+        qreal y = e.y + dy;
         switch (e.type) {
         case QPainterPath::MoveToElement:
             stream() << SVG_MOVE << x << SVG_COMMA << y;
@@ -1225,8 +1240,8 @@ void SvgPaintEngine::drawPath(const QPainterPath& p)
             while (i < p.elementCount()) {
                 const QPainterPath::Element& ee = p.elementAt(i);
                 if (ee.type == QPainterPath::CurveToDataElement) {
-                    stream() << SVG_SPACE << ee.x + _dx
-                             << SVG_COMMA << ee.y + _dy;
+                    stream() << SVG_SPACE << ee.x + dx
+                             << SVG_COMMA << ee.y + dy;
                     ++i;
                 } else {
                     --i;
@@ -1241,7 +1256,83 @@ void SvgPaintEngine::drawPath(const QPainterPath& p)
             stream() << SVG_SPACE;
         }
     }
-    stream() << SVG_QUOTE << SVG_ELEMENT_END << Qt::endl;
+}
+
+void SvgPaintEngine::drawTextItem(const QPointF& p, const QTextItem& textItem)
+{
+    Q_D(SvgPaintEngine);
+
+    // Glyph runs come without the text, they are drawn as outlines
+    const QString text = textItem.text();
+    if (text.isEmpty()) {
+        QPaintEngine::drawTextItem(p, textItem);
+        return;
+    }
+
+    // As QPaintEngine::drawTextItem(), the text is filled with the pen
+    const QPen pen = state->pen();
+    if (pen.style() == Qt::NoPen) {
+        return;
+    }
+
+    // Lay the text out into glyphs, as QPainterPath::addText() does, with the baseline at y = 0
+    QTextLayout layout(text, textItem.font());
+    QTextOption option = layout.textOption();
+    option.setWrapMode(QTextOption::NoWrap);
+    layout.setTextOption(option);
+    layout.beginLayout();
+    QTextLine line = layout.createLine();
+    if (!line.isValid()) {
+        layout.endLayout();
+        return;
+    }
+    line.setPosition(QPointF(0, 0));
+    layout.endLayout();
+
+    const qreal baseline = line.ascent();
+    const QString fill = qbrushToSvg(pen.brush());
+    const bool hasOpacity = !qFuzzyIsNull(state->opacity() - 1);
+
+    for (const QGlyphRun& run : layout.glyphRuns()) {
+        const QRawFont rawFont = run.rawFont();
+        const QVector<quint32> indexes = run.glyphIndexes();
+        const QVector<QPointF> positions = run.positions();
+
+        // Each distinct glyph (the font with its size and style, and the glyph index) is defined
+        // once, where it is first drawn, and every drawing of it refers to that definition
+        const QString fontKey = rawFont.familyName() + QLatin1Char('|') + rawFont.styleName()
+                                + QLatin1Char('|') + QString::number(rawFont.pixelSize())
+                                + QLatin1Char('|') + QString::number(rawFont.weight())
+                                + QLatin1Char('|');
+
+        for (int i = 0; i < indexes.size(); ++i) {
+            const QString key = fontKey + QString::number(indexes.at(i));
+
+            QString id = d->glyphIds.value(key);
+            if (id.isEmpty()) {
+                id = QString::fromLatin1("g%1").arg(d->glyphIds.size());
+                d->glyphIds.insert(key, id);
+
+                stream() << SVG_DEFS_BEGIN << SVG_PATH << SVG_ID << id << SVG_QUOTE << SVG_D;
+                writePathData(rawFont.pathForGlyph(indexes.at(i)), 0, 0);
+                stream() << SVG_QUOTE << SVG_ELEMENT_END << SVG_DEFS_END << Qt::endl;
+            }
+
+            stream() << SVG_USE << SVG_HREF << id << SVG_QUOTE
+                     << SVG_CLASS << getClass(_element) << SVG_QUOTE
+                     << fill;
+
+            if (hasOpacity) {
+                stream() << SVG_OPACITY << state->opacity() << SVG_QUOTE;
+            }
+
+            const QPointF pos = p + positions.at(i) - QPointF(0, baseline);
+            stream() << _matrixString
+                     << SVG_X << SVG_QUOTE << pos.x() + _dx << SVG_QUOTE
+                     << SVG_Y << SVG_QUOTE << pos.y() + _dy << SVG_QUOTE
+                     << SVG_ELEMENT_END << Qt::endl;
+        }
+    }
 }
 
 void SvgPaintEngine::drawPolygon(const QPointF* points, int pointCount,
@@ -39,6 +39,12 @@ using namespace mu::project;
 using namespace mu::notation;
 using namespace mu::io;
 
+SvgWriter::SvgWriter()
+{
+    //! NOTE Resolved here, the pages may be written by several threads at once (e.g. the media export)
+    configuration();
+}
+
 std::vector<INotationWriter::UnitType> SvgWriter::supportedUnitTypes() const
 {
     return { UnitType::PER_PAGE };
@@ -55,19 +61,20 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
         return make_ret(Ret::Code::UnknownError);
     }
 
-    score->setPrinting(true); // don’t print page break symbols etc.
-
-    Ms::MScore::pdfPrinting = true;
-    Ms::MScore::svgPrinting = true;
-
     const QList<Ms::Page*>& pages = score->pages();
-    double pixelRationBackup = Ms::MScore::pixelRatio;
 
     const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
     if (PAGE_NUMBER < 0 || PAGE_NUMBER >= pages.size()) {
         return false;
     }
 
+    score->setPrinting(true); // don’t print page break symbols etc.
+
+    Ms::MScore::pdfPrinting = true;
+    Ms::MScore::svgPrinting = true;
+
+    double pixelRationBackup = Ms::MScore::pixelRatio;
+
     Ms::Page* page = pages.at(PAGE_NUMBER);
 
     SvgGenerator printer;
@@ -34,6 +34,8 @@ class SvgWriter : public AbstractImageWriter
     INJECT(iex, IImagesExportConfiguration, configuration)
 
 public:
+    SvgWriter();
+
     std::vector<project::INotationWriter::UnitType> supportedUnitTypes() const override;
     Ret write(notation::INotationPtr notation, io::Device& destinationDevice, const Options& options = Options()) override;
 
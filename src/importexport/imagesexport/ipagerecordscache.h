@@ -0,0 +1,53 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_IMPORTEXPORT_IPAGERECORDSCACHE_H
+#define MU_IMPORTEXPORT_IPAGERECORDSCACHE_H
+
+#include "modularity/imoduleexport.h"
+#include "infrastructure/draw/buffereddrawtypes.h"
+
+namespace Ms {
+class Score;
+}
+
+namespace mu::iex::imagesexport {
+//! NOTE The pages of the laid out scores recorded into display lists (DrawData),
+//! so the writers painting the same page (e.g. png and pdf) record it once
+class IPageRecordsCache : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(IPageRecordsCache)
+
+public:
+    virtual ~IPageRecordsCache() = default;
+
+    //! NOTE The records are kept only while the cache is open, the scores must not be changed meanwhile
+    //! (e.g. the conversions of one loaded score). When it's closed, the pages are recorded on each request
+    virtual void open() = 0;
+    virtual void close() = 0;
+
+    //! NOTE Thread safe. The page is recorded in its own coordinates, for a device with the given pixel ratio.
+    //! Returns null if the page can't be recorded
+    virtual draw::DrawDataPtr pageRecord(Ms::Score* score, int pageNumber, double pixelRatio) = 0;
+};
+}
+
+#endif // MU_IMPORTEXPORT_IPAGERECORDSCACHE_H
@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QFont>
+#include <QPainter>
+
+#include "internal/svggenerator.h"
+
+class SvgGeneratorTests : public ::testing::Test
+{
+public:
+    struct Text {
+        QPointF pos;
+        QString text;
+        int pixelSize = 20;
+    };
+
+    static QByteArray drawTexts(const std::vector<Text>& texts)
+    {
+        QBuffer buffer;
+
+        SvgGenerator generator;
+        generator.setOutputDevice(&buffer);
+        generator.setSize(QSize(400, 400));
+        generator.setViewBox(QRectF(0, 0, 400, 400));
+
+        QPainter painter(&generator);
+        for (const Text& t : texts) {
+            QFont font = painter.font();
+            font.setPixelSize(t.pixelSize);
+            painter.setFont(font);
+            painter.drawText(t.pos, t.text);
+        }
+        painter.end();
+
+        return buffer.data();
+    }
+
+    static int pathCount(const QByteArray& svg)
+    {
+        return svg.count("<path");
+    }
+
+    static int useCount(const QByteArray& svg)
+    {
+        return svg.count("<use");
+    }
+};
+
+TEST_F(SvgGeneratorTests, RepeatedGlyphIsDefinedOnce)
+{
+    //! GIVEN Three texts made of the same glyph
+    //! WHEN They are drawn
+    QByteArray svg = drawTexts({ { QPointF(10, 50), "a" }, { QPointF(10, 100), "aa" }, { QPointF(10, 150), "aaa" } });
+
+    //! THEN The glyph is defined once and used for each of its six drawings
+    EXPECT_EQ(pathCount(svg), 1);
+    EXPECT_EQ(useCount(svg), 6);
+}
+
+TEST_F(SvgGeneratorTests, GlyphsAreSharedAcrossTexts)
+{
+    //! GIVEN Two different texts made of the same glyphs
+    //! WHEN They are drawn
+    QByteArray svg = drawTexts({ { QPointF(10, 50), "abc" }, { QPointF(10, 100), "cab" } });
+
+    //! THEN Each glyph is defined once, not each text
+    EXPECT_EQ(pathCount(svg), 3);
+    EXPECT_EQ(useCount(svg), 6);
+}
+
+TEST_F(SvgGeneratorTests, FontSizesAreDefinedSeparately)
+{
+    //! GIVEN The same glyph in two font sizes
+    //! WHEN They are drawn
+    QByteArray svg = drawTexts({ { QPointF(10, 50), "a", 20 }, { QPointF(10, 100), "a", 40 }, { QPointF(10, 150), "a", 20 } });
+
+    //! THEN The glyph is defined once per size
+    EXPECT_EQ(pathCount(svg), 2);
+    EXPECT_EQ(useCount(svg), 3);
+}
@@ -224,7 +224,7 @@ bool ExportMidi::write(QIODevice* device, bool midiExpandRepeats, bool exportRPN
     }
 
     EventMap events;
-    m_score->renderMidi(&events, false, midiExpandRepeats, synthState);
+    m_score->renderMidi(&events, false, midiExpandRepeats, synthState, true /*renderStavesInParallel*/);
 
     m_pauseMap.calculate(m_score);
     writeHeader();
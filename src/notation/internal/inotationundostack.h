@@ -24,6 +24,9 @@
 #define MU_SCENE_NOTATION_INOTATIONUNDOSTACK_H
 
 #include "async/notification.h"
+#include "async/channel.h"
+
+#include "notation/notationtypes.h"
 
 namespace Ms {
 class EditData;
@@ -52,6 +55,9 @@ public:
     virtual bool isLocked() const = 0;
 
     virtual async::Notification stackChanged() const = 0;
+
+    //! NOTE Sent before the notation changed notification, the range is undefined when the changes can't be localized
+    virtual async::Channel<ScoreChangesRange> changesChannel() const = 0;
 };
 
 using INotationUndoStackPtr = std::shared_ptr<INotationUndoStack>;
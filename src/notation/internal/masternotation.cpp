@@ -54,7 +54,7 @@ MasterNotation::MasterNotation()
     : Notation()
 {
     m_parts = std::make_shared<MasterNotationParts>(this, interaction(), undoStack());
-    m_notationMidiData = std::make_shared<MasterNotationMidiData>(this, m_notationChanged);
+    m_notationMidiData = std::make_shared<MasterNotationMidiData>(this, m_notationChanged, undoStack()->changesChannel());
 
     m_parts->partsChanged().onNotify(this, [this]() {
         notifyAboutNotationChanged();
@@ -486,10 +486,14 @@ void MasterNotation::doSetExcerpts(ExcerptNotationList excerpts)
     m_excerpts.set(excerpts);
     static_cast<MasterNotationParts*>(m_parts.get())->setExcerpts(excerpts);
 
+    auto midiData = static_cast<MasterNotationMidiData*>(m_notationMidiData.get());
+
     for (auto excerpt : excerpts) {
         excerpt->notation()->undoStack()->stackChanged().onNotify(this, [this]() {
             notifyAboutNeedSaveChanged();
         });
+
+        midiData->addExcerptChanges(excerpt->notation()->undoStack()->changesChannel());
     }
 }
 
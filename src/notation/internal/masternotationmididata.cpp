@@ -22,23 +22,51 @@
 
 #include "masternotationmididata.h"
 
+#include <algorithm>
+#include <limits>
+#include <set>
+
 #include "engraving/libmscore/repeatlist.h"
 #include "engraving/libmscore/tempo.h"
+#include "engraving/libmscore/staff.h"
+#include "engraving/libmscore/undo.h"
 
 #include "log.h"
 
 #include "notationerrors.h"
+#include "notationmidiutils.h"
 
 using namespace mu;
 using namespace mu::notation;
 using namespace mu::midi;
 
-MasterNotationMidiData::MasterNotationMidiData(IGetScore* getScore, async::Notification notationChanged)
+MasterNotationMidiData::MasterNotationMidiData(IGetScore* getScore, async::Notification notationChanged,
+                                               async::Channel<ScoreChangesRange> changesChannel)
     : m_getScore(getScore)
 {
+    changesChannel.onReceive(this, [this](const ScoreChangesRange& range) {
+        invalidate(range);
+        m_handledUndoState = undoState();
+    });
+
     notationChanged.onNotify(this, [this]() {
-        m_renderRanges.clear();
-        m_eventsCache.clear();
+        //! NOTE The changes made by a command are handled by its range already,
+        //! the notification only brings something new, if the score has left the handled state
+        if (isUndoStateHandled()) {
+            return;
+        }
+
+        invalidateAll();
+        m_handledUndoState = undoState();
+    });
+}
+
+void MasterNotationMidiData::addExcerptChanges(async::Channel<ScoreChangesRange> changesChannel)
+{
+    changesChannel.onReceive(this, [this](const ScoreChangesRange& range) {
+        //! NOTE The ticks of the excerpts are the ones of the master score, but the staves aren't
+        invalidate({ range.tickFrom, range.tickTo });
+        m_handledUndoState = undoState();
     });
 }
 
@@ -46,6 +74,8 @@ MasterNotationMidiData::~MasterNotationMidiData()
 {
     for (auto& midiData : m_midiDataMap) {
         midiData.second.stream.eventsRequest.resetOnReceive(this);
+        midiData.second.stream.prerollRequest.resetOnReceive(this);
+        midiData.second.stream.fullEventsRequest.resetOnNotify(this);
     }
     m_parts = nullptr;
 }
@@ -58,6 +88,7 @@ void MasterNotationMidiData::init(INotationPartsPtr parts)
 
     m_parts = std::move(parts);
     m_midiRenderImpl = std::unique_ptr<Ms::MidiRenderer>(new Ms::MidiRenderer(score()));
+    invalidateAll();
 
     m_midiDataMap.clear();
 
@@ -113,8 +144,14 @@ Ret MasterNotationMidiData::triggerElementMidiData(const EngravingItem* element)
 
 Events MasterNotationMidiData::retrieveEvents(const std::vector<channel_t>& midiChannels, const tick_t fromTick, const tick_t toTick) const
 {
-    for (const auto& gap : m_renderRanges.unrenderedGaps(fromTick, toTick)) {
-        loadEvents(gap.second.start, gap.second.end);
+    for (const Ms::MidiRenderer::Chunk& chunk : m_midiRenderImpl->chunksFromRange(fromTick, toTick)) {
+        auto search = m_renderedChunks.find(chunk.utick1());
+        if (search != m_renderedChunks.end() && search->second.utickTo == static_cast<tick_t>(chunk.utick2())) {
+            continue;
+        }
+
+        eraseRenderedChunks(chunk.utick1(), chunk.utick2());
+        renderChunk(chunk);
     }
 
     return eventsFromRange(midiChannels, fromTick, toTick);
@@ -139,22 +176,7 @@ std::vector<Event> MasterNotationMidiData::retrieveSetupEvents(const std::list<I
     std::vector<midi::Event> result;
 
     for (const InstrumentChannel* instrChannel : instrChannels) {
-        Event e;
-
-        e.setMessageType(Event::MessageType::ChannelVoice10);
-        e.setOpcode(Event::Opcode::ProgramChange);
-        e.setProgram(instrChannel->program());
-        e.setBank(instrChannel->bank());
-
-        channel_t channel = instrChannel->channel();
-        //! TODO Modification of templates is required
-        if (!(channel < 16)) {
-            channel = 15;
-        }
-
-        e.setChannel(channel);
-
-        result.emplace_back(std::move(e));
+        result.push_back(NotationMidiUtils::makeProgramChangeEvent(instrChannel));
     }
 
     return result;
@@ -168,19 +190,31 @@ Events MasterNotationMidiData::eventsFromRange(const std::vector<channel_t>& mid
 
     Events result;
 
-    for (const channel_t& channel : midiChannels) {
-        auto search = m_eventsCache.find(channel);
-        if (search == m_eventsCache.cend()) {
+    for (const auto& pair : m_renderedChunks) {
+        const RenderedChunk& chunk = pair.second;
+
+        if (pair.first > toTick) {
+            break;
+        }
+
+        //! NOTE The events of a chunk may last longer than the chunk itself, e.g. the note offs of tied notes
+        if (chunk.lastEventTick < fromTick) {
             continue;
         }
 
-        for (const auto& pair : search->second) {
-            if (pair.first < fromTick || pair.first > toTick) {
+        for (const channel_t& channel : midiChannels) {
+            auto search = chunk.events.find(channel);
+            if (search == chunk.events.cend()) {
                 continue;
             }
 
-            std::vector<Event>& events = result[pair.first];
-            events.insert(events.end(), pair.second.begin(), pair.second.end());
+            auto it = search->second.lower_bound(fromTick);
+            auto end = search->second.upper_bound(toTick);
+
+            for (; it != end; ++it) {
+                std::vector<Event>& events = result[it->first];
+                events.insert(events.end(), it->second.begin(), it->second.end());
+            }
         }
     }
 
@@ -204,22 +238,7 @@ MidiData MasterNotationMidiData::buildMidiData(const Ms::Part* part) const
 
 MidiMapping MasterNotationMidiData::buildMidiMapping(const Ms::Part* part) const
 {
-    midi::MidiMapping mapping;
-
-    mapping.division = Ms::MScore::division;
-    mapping.tempo = makeTempoMap();
-
-    for (auto it = part->instruments()->cbegin(); it != part->instruments()->cend(); ++it) {
-        const Ms::Instrument* instrument = it->second;
-
-        for (const Ms::Channel* channel : instrument->channel()) {
-            mapping.programms.push_back({ static_cast<midi::channel_t>(channel->channel()),
-                                          channel->program(),
-                                          channel->bank() });
-        }
-    }
-
-    return mapping;
+    return NotationMidiUtils::makeMidiMapping(part, NotationMidiUtils::makeTempoMap(score()));
 }
 
 MidiStream MasterNotationMidiData::buildMidiStream(const Ms::Part* part) const
@@ -256,34 +275,22 @@ MidiStream MasterNotationMidiData::buildMidiStream(const Ms::Part* part) const
 
             stream.mainStream.send(retrieveEvents(midiChannels, fromTick, toTick), toTick);
         });
-    }
 
-    return stream;
-}
+        stream.prerollRequest.onReceive(this, [this, stream, midiChannels](const tick_t fromTick, const tick_t toTick) mutable {
+            if (fromTick >= stream.lastTick) {
+                return;
+            }
 
-TempoMap MasterNotationMidiData::makeTempoMap() const
-{
-    midi::TempoMap tempos;
-
-    Ms::TempoMap* tempomap = score()->tempomap();
-    qreal relTempo = tempomap->relTempo();
-    for (const Ms::RepeatSegment* rs : score()->repeatList()) {
-        int startTick = rs->tick, endTick = startTick + rs->len();
-        int tickOffset = rs->utick - rs->tick;
-
-        auto se = tempomap->lower_bound(startTick);
-        auto ee = tempomap->lower_bound(endTick);
-        for (auto it = se; it != ee; ++it) {
-            //
-            // compute midi tempo: microseconds / quarter note
-            //
-            tempo_t tempo = static_cast<tempo_t>(lrint((1.0 / (it->second.tempo * relTempo)) * 1000000.0));
-
-            tempos.insert({ it->first + tickOffset, tempo });
-        }
+            tick_t endTick = std::min(toTick, stream.lastTick);
+            stream.prerollStream.send(retrieveEvents(midiChannels, fromTick, endTick), fromTick, endTick);
+        });
+
+        stream.fullEventsRequest.onNotify(this, [this, stream, midiChannels]() mutable {
+            stream.fullEventsStream.send(retrieveEvents(midiChannels, 0, stream.lastTick));
+        });
     }
 
-    return tempos;
+    return stream;
 }
 
 Ret MasterNotationMidiData::playNoteMidiData(const Ms::Note* note) const
@@ -357,54 +364,187 @@ Ret MasterNotationMidiData::playHarmonyMidiData(const Ms::Harmony* harmony) cons
     return make_ret(Ret::Code::Ok);
 }
 
-void MasterNotationMidiData::loadEvents(const tick_t fromTick, const tick_t toTick) const
+void MasterNotationMidiData::renderChunk(const Ms::MidiRenderer::Chunk& chunk) const
 {
-    Ms::EventMap msevents = renderMsEvents(fromTick, toTick);
+    masterScore()->setExpandRepeats(configuration()->isPlayRepeatsEnabled());
 
-    if (msevents.empty()) {
-        return;
-    }
+    Ms::MidiRenderer::Context ctx;
+    ctx.metronome = configuration()->isMetronomeEnabled();
+    ctx.renderHarmony = true;
+    ctx.renderStavesInParallel = true;
 
-    TicksRange renderedTickRange;
-    renderedTickRange.start = fromTick;
-    renderedTickRange.end = toTick;
+    Ms::EventMap msevents;
+    m_midiRenderImpl->renderChunk(chunk, &msevents, ctx);
 
-    m_renderRanges.insertOrReplace(renderedTickRange.start, std::move(renderedTickRange));
+    RenderedChunk& renderedChunk = m_renderedChunks[chunk.utick1()];
+    renderedChunk = RenderedChunk();
+    renderedChunk.utickTo = chunk.utick2();
 
     for (auto& pair : convertMsEvents(std::move(msevents))) {
         for (Event& event : pair.second) {
-            Events& chunk = m_eventsCache[event.channel()];
-            std::vector<Event>& events = chunk[pair.first];
+            std::vector<Event>& events = renderedChunk.events[event.channel()][pair.first];
             events.push_back(std::move(event));
         }
+
+        renderedChunk.lastEventTick = std::max(renderedChunk.lastEventTick, pair.first);
     }
 }
 
-bool MasterNotationMidiData::hasCachedEvents(const channel_t midiChannel) const
+bool MasterNotationMidiData::eraseRenderedChunks(const int utickFrom, const int utickTo) const
 {
-    return m_eventsCache.find(midiChannel) != m_eventsCache.end();
+    bool erased = false;
+
+    auto it = m_renderedChunks.begin();
+    while (it != m_renderedChunks.end()) {
+        if (it->first < static_cast<tick_t>(utickTo) && it->second.utickTo > static_cast<tick_t>(utickFrom)) {
+            it = m_renderedChunks.erase(it);
+            erased = true;
+        } else {
+            ++it;
+        }
+    }
+
+    return erased;
 }
 
-Ms::EventMap MasterNotationMidiData::renderMsEvents(const tick_t fromTick, const tick_t toTick) const
+void MasterNotationMidiData::invalidate(const ScoreChangesRange& range)
 {
-    Ms::EventMap msevents;
+    if (!m_midiRenderImpl) {
+        return;
+    }
 
-    std::vector<Ms::MidiRenderer::Chunk> mschunks = m_midiRenderImpl->chunksFromRange(fromTick, toTick);
-    if (mschunks.empty()) {
-        return msevents;
+    //! NOTE The chunks partition may change with the score
+    m_midiRenderImpl->setScoreChanged();
+
+    if (!range.isValidBoundary() || isScoreStructureChanged()) {
+        invalidateAll();
+        return;
     }
 
-    masterScore()->setExpandRepeats(configuration()->isPlayRepeatsEnabled());
+    //! NOTE The changed measures may be played several times with the repeats
+    std::vector<Ms::MidiRenderer::Chunk> changedChunks;
+    for (const Ms::MidiRenderer::Chunk& chunk : m_midiRenderImpl->chunksFromRange(0, std::numeric_limits<int>::max())) {
+        if (chunk.tick1() <= range.tickTo && chunk.tick2() > range.tickFrom) {
+            changedChunks.push_back(chunk);
+        }
+    }
 
-    Ms::MidiRenderer::Context ctx;
-    ctx.metronome = configuration()->isMetronomeEnabled();
-    ctx.renderHarmony = true;
+    std::vector<Ms::MidiRenderer::Chunk> renderedChangedChunks;
 
-    for (const auto& mschunk : mschunks) {
-        m_midiRenderImpl->renderChunk(mschunk, &msevents, ctx);
+    for (const Ms::MidiRenderer::Chunk& chunk : changedChunks) {
+        //! NOTE Only the chunks, which could be sent to the audio already, need to be replaced there
+        if (eraseRenderedChunks(chunk.utick1(), chunk.utick2())) {
+            renderChunk(chunk);
+            renderedChangedChunks.push_back(chunk);
+        }
     }
 
-    return msevents;
+    sendPatches(renderedChangedChunks, range);
+}
+
+void MasterNotationMidiData::invalidateAll()
+{
+    m_renderedChunks.clear();
+
+    if (m_midiRenderImpl) {
+        m_midiRenderImpl->setScoreChanged();
+    }
+
+    if (score() && masterScore()->lastMeasure()) {
+        m_scoreEndTick = masterScore()->lastMeasure()->endTick().ticks();
+        m_scoreEndUtick = score()->repeatList().ticks();
+    }
+}
+
+int MasterNotationMidiData::undoState() const
+{
+    if (!score() || !masterScore()->undoStack()) {
+        return INVALID_UNDO_STATE;
+    }
+
+    return masterScore()->undoStack()->state();
+}
+
+bool MasterNotationMidiData::isUndoStateHandled() const
+{
+    int state = undoState();
+    if (state == INVALID_UNDO_STATE) {
+        return false;
+    }
+
+    //! NOTE The changes of an open command aren't in the undo state yet
+    if (masterScore()->undoStack()->active()) {
+        return false;
+    }
+
+    return state == m_handledUndoState;
+}
+
+bool MasterNotationMidiData::isScoreStructureChanged() const
+{
+    if (!masterScore()->lastMeasure()) {
+        return true;
+    }
+
+    //! NOTE Any shift of the measures changes the ticks of all the events after them
+    return m_scoreEndTick != masterScore()->lastMeasure()->endTick().ticks()
+           || m_scoreEndUtick != score()->repeatList().ticks();
+}
+
+void MasterNotationMidiData::sendPatches(const std::vector<Ms::MidiRenderer::Chunk>& chunks, const ScoreChangesRange& range) const
+{
+    if (chunks.empty()) {
+        return;
+    }
+
+    std::set<ID> changedPartIds;
+    if (range.hasStaves()) {
+        for (int staffIdx = range.staffIdxFrom; staffIdx <= range.staffIdxTo; ++staffIdx) {
+            const Ms::Staff* staff = score()->staff(staffIdx);
+            if (staff && staff->part()) {
+                changedPartIds.insert(staff->part()->id());
+            }
+        }
+    }
+
+    for (const Part* part : score()->parts()) {
+        if (range.hasStaves() && changedPartIds.find(part->id()) == changedPartIds.end()) {
+            continue;
+        }
+
+        auto search = m_midiDataMap.find(part->id());
+        if (search == m_midiDataMap.end()) {
+            continue;
+        }
+
+        std::vector<channel_t> midiChannels;
+        for (auto it = part->instruments()->cbegin(); it != part->instruments()->cend(); ++it) {
+            for (const Ms::Channel* channel : it->second->channel()) {
+                midiChannels.push_back(static_cast<channel_t>(channel->channel()));
+            }
+        }
+
+        const MidiStream& stream = search->second.stream;
+
+        for (const Ms::MidiRenderer::Chunk& chunk : chunks) {
+            const RenderedChunk& renderedChunk = m_renderedChunks.at(chunk.utick1());
+
+            Events events;
+            for (const channel_t& channel : midiChannels) {
+                auto channelEvents = renderedChunk.events.find(channel);
+                if (channelEvents == renderedChunk.events.cend()) {
+                    continue;
+                }
+
+                for (const auto& pair : channelEvents->second) {
+                    std::vector<Event>& eventsAtTick = events[pair.first];
+                    eventsAtTick.insert(eventsAtTick.end(), pair.second.begin(), pair.second.end());
+                }
+            }
+
+            stream.patchStream.send(std::move(events), chunk.utick1(), chunk.utick2() - 1);
+        }
+    }
 }
 
 Events MasterNotationMidiData::convertMsEvents(Ms::EventMap&& eventMap) const
@@ -535,50 +675,3 @@ Events MasterNotationMidiData::eventsFromHarmony(const EngravingItem* harmonyEle
 
     return result;
 }
-
-MasterNotationMidiData::TickRangeMap MasterNotationMidiData::RenderRangeMap::unrenderedGaps(const tick_t from, const tick_t to) const
-{
-    TickRangeMap result;
-
-    TicksRange searchRange = { from, to };
-
-    std::vector<TicksRange> unrenderedGaps;
-
-    if (m_renderedRanges.empty()) {
-        result.emplace(from, std::move(searchRange));
-        return result;
-    }
-
-    for (const auto& range : m_renderedRanges) {
-        if (range.second.contains(searchRange)) {
-            return {};
-        } else if (range.second.containsTick(searchRange.start)) {
-            searchRange.start = range.second.end;
-        } else if (range.second.containsTick(searchRange.end)) {
-            searchRange.end = range.second.start;
-        }
-    }
-
-    result.emplace(from, std::move(searchRange));
-    return result;
-}
-
-void MasterNotationMidiData::RenderRangeMap::insertOrReplace(const tick_t key, MasterNotationMidiData::TicksRange&& newRange)
-{
-    auto it = m_renderedRanges.begin();
-
-    while (it != m_renderedRanges.end()) {
-        if (newRange.contains(it->second)) {
-            it = m_renderedRanges.erase(it);
-        } else {
-            ++it;
-        }
-    }
-
-    m_renderedRanges.emplace(key, newRange);
-}
-
-void MasterNotationMidiData::RenderRangeMap::clear()
-{
-    m_renderedRanges.clear();
-}
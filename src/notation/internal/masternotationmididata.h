@@ -28,6 +28,7 @@
 
 #include "async/asyncable.h"
 #include "async/notification.h"
+#include "async/channel.h"
 #include "libmscore/rendermidi.h"
 
 #include "igetscore.h"
@@ -41,11 +42,15 @@ class MasterNotationMidiData : public IMasterNotationMidiData, public async::Asy
     INJECT(notation, INotationConfiguration, configuration)
 
 public:
-    explicit MasterNotationMidiData(IGetScore* getScore, async::Notification notationChanged);
+    explicit MasterNotationMidiData(IGetScore* getScore, async::Notification notationChanged,
+                                    async::Channel<ScoreChangesRange> changesChannel);
     ~MasterNotationMidiData();
 
     void init(INotationPartsPtr parts) override;
 
+    //! NOTE The excerpts have their own undo stacks, the changes made in them are sent through their channels
+    void addExcerptChanges(async::Channel<ScoreChangesRange> changesChannel);
+
     midi::MidiData trackMidiData(const ID& partId) const override;
     Ret triggerElementMidiData(const EngravingItem* element) override;
 
@@ -55,36 +60,11 @@ public:
     std::vector<midi::Event> retrieveSetupEvents(const std::list<InstrumentChannel*> instrChannel) const override;
 
 private:
-    struct TicksRange {
-        midi::tick_t start = 0;
-        midi::tick_t end = 0;
-
-        bool operator <(const TicksRange& other) const
-        {
-            return start < other.start;
-        }
-
-        bool contains(const TicksRange& other) const
-        {
-            return other.start >= start && other.end <= end;
-        }
-
-        bool containsTick(const midi::tick_t tick) const
-        {
-            return tick >= start && tick <= end;
-        }
-    };
-
-    using TickRangeMap = std::map<midi::tick_t, TicksRange>;
-
-    struct RenderRangeMap {
-        TickRangeMap unrenderedGaps(const midi::tick_t from, const midi::tick_t to) const;
-
-        void insertOrReplace(const midi::tick_t key, TicksRange&& newRange);
-        void clear();
-
-    private:
-        mutable TickRangeMap m_renderedRanges;
+    //! NOTE Events of one MidiRenderer chunk, the chunk is the unit of rendering and invalidation
+    struct RenderedChunk {
+        midi::tick_t utickTo = 0;
+        midi::tick_t lastEventTick = 0;
+        std::unordered_map<midi::channel_t, midi::Events> events;
     };
 
     Ms::Score* score() const;
@@ -93,27 +73,37 @@ private:
     midi::MidiData buildMidiData(const Ms::Part* part) const;
     midi::MidiMapping buildMidiMapping(const Ms::Part* part) const;
     midi::MidiStream buildMidiStream(const Ms::Part* part) const;
-    midi::TempoMap makeTempoMap() const;
 
     // play element
     Ret playNoteMidiData(const Ms::Note* note) const;
     Ret playChordMidiData(const Ms::Chord* chord) const;
     Ret playHarmonyMidiData(const Ms::Harmony* harmony) const;
 
-    void loadEvents(const midi::tick_t fromTick, const midi::tick_t toTick) const;
+    void renderChunk(const Ms::MidiRenderer::Chunk& chunk) const;
+    bool eraseRenderedChunks(const int utickFrom, const int utickTo) const;
     midi::Events eventsFromRange(const std::vector<midi::channel_t>& midiChannels, const midi::tick_t fromTick,
                                  const midi::tick_t toTick) const;
-    bool hasCachedEvents(const midi::channel_t midiChannel) const;
 
-    Ms::EventMap renderMsEvents(const midi::tick_t fromTick, const midi::tick_t toTick) const;
+    void invalidate(const ScoreChangesRange& range);
+    void invalidateAll();
+    bool isScoreStructureChanged() const;
+
+    int undoState() const;
+    bool isUndoStateHandled() const;
+    void sendPatches(const std::vector<Ms::MidiRenderer::Chunk>& chunks, const ScoreChangesRange& range) const;
+
     midi::Events convertMsEvents(Ms::EventMap&& eventMap) const;
 
     midi::Events eventsFromNote(const EngravingItem* noteElement, const midi::channel_t midiChannel) const;
     midi::Events eventsFromChord(const EngravingItem* chordElement, const midi::channel_t midiChannel) const;
     midi::Events eventsFromHarmony(const EngravingItem* harmonyElement, const midi::channel_t midiChannel) const;
 
-    mutable RenderRangeMap m_renderRanges;
-    mutable std::unordered_map<midi::channel_t, midi::Events> m_eventsCache = {};
+    mutable std::map<midi::tick_t /*utickFrom*/, RenderedChunk> m_renderedChunks;
+
+    static constexpr int INVALID_UNDO_STATE = -1;
+    int m_handledUndoState = INVALID_UNDO_STATE;
+    int m_scoreEndTick = 0;
+    int m_scoreEndUtick = 0;
 
     std::map<ID /*partId*/, midi::MidiData> m_midiDataMap;
 
@@ -0,0 +1,101 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "notationmidiutils.h"
+
+#include <cmath>
+
+#include "engraving/libmscore/instrument.h"
+#include "engraving/libmscore/mscore.h"
+#include "engraving/libmscore/part.h"
+#include "engraving/libmscore/repeatlist.h"
+#include "engraving/libmscore/score.h"
+#include "engraving/libmscore/tempo.h"
+
+using namespace mu;
+using namespace mu::notation;
+using namespace mu::midi;
+
+TempoMap NotationMidiUtils::makeTempoMap(const Ms::Score* score)
+{
+    midi::TempoMap tempos;
+
+    Ms::TempoMap* tempomap = score->tempomap();
+    qreal relTempo = tempomap->relTempo();
+    for (const Ms::RepeatSegment* rs : score->repeatList()) {
+        int startTick = rs->tick, endTick = startTick + rs->len();
+        int tickOffset = rs->utick - rs->tick;
+
+        auto se = tempomap->lower_bound(startTick);
+        auto ee = tempomap->lower_bound(endTick);
+        for (auto it = se; it != ee; ++it) {
+            //
+            // compute midi tempo: microseconds / quarter note
+            //
+            tempo_t tempo = static_cast<tempo_t>(lrint((1.0 / (it->second.tempo * relTempo)) * 1000000.0));
+
+            tempos.insert({ it->first + tickOffset, tempo });
+        }
+    }
+
+    return tempos;
+}
+
+MidiMapping NotationMidiUtils::makeMidiMapping(const Ms::Part* part, const TempoMap& tempos)
+{
+    midi::MidiMapping mapping;
+
+    mapping.division = Ms::MScore::division;
+    mapping.tempo = tempos;
+
+    for (auto it = part->instruments()->cbegin(); it != part->instruments()->cend(); ++it) {
+        const Ms::Instrument* instrument = it->second;
+
+        for (const Ms::Channel* channel : instrument->channel()) {
+            mapping.programms.push_back({ static_cast<midi::channel_t>(channel->channel()),
+                                          channel->program(),
+                                          channel->bank() });
+        }
+    }
+
+    return mapping;
+}
+
+Event NotationMidiUtils::makeProgramChangeEvent(const Ms::Channel* channel)
+{
+    Event e;
+
+    e.setMessageType(Event::MessageType::ChannelVoice10);
+    e.setOpcode(Event::Opcode::ProgramChange);
+    e.setProgram(channel->program());
+    e.setBank(channel->bank());
+
+    channel_t midiChannel = channel->channel();
+    //! TODO Modification of templates is required
+    if (!(midiChannel < 16)) {
+        midiChannel = 15;
+    }
+
+    e.setChannel(midiChannel);
+
+    return e;
+}
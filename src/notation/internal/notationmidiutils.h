@@ -0,0 +1,46 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_NOTATION_NOTATIONMIDIUTILS_H
+#define MU_NOTATION_NOTATIONMIDIUTILS_H
+
+#include "midi/miditypes.h"
+
+namespace Ms {
+class Score;
+class Part;
+class Channel;
+}
+
+namespace mu::notation {
+//! NOTE The midi data built from a score, shared by the playback and the audio export
+class NotationMidiUtils
+{
+public:
+    //! NOTE Unrolled by the repeat list, the ticks are the playback (utick) ones
+    static midi::TempoMap makeTempoMap(const Ms::Score* score);
+    static midi::MidiMapping makeMidiMapping(const Ms::Part* part, const midi::TempoMap& tempos);
+    static midi::Event makeProgramChangeEvent(const Ms::Channel* channel);
+};
+}
+
+#endif // MU_NOTATION_NOTATIONMIDIUTILS_H
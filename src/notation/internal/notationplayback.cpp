@@ -36,6 +36,7 @@
 #include "libmscore/system.h"
 #include "libmscore/scorefont.h"
 #include "libmscore/page.h"
+#include "libmscore/positiontable.h"
 #include "libmscore/staff.h"
 #include "libmscore/chordrest.h"
 #include "libmscore/chord.h"
@@ -128,54 +129,20 @@ QRect NotationPlayback::playbackCursorRectByTick(tick_t _tick) const
         return QRect();
     }
 
-    Fraction tick = Fraction::fromTicks(_tick);
-
-    Measure* measure = score()->tick2measureMM(tick);
-    if (!measure) {
-        return QRect();
-    }
-
-    Ms::System* system = measure->system();
-    if (!system) {
+    //! NOTE The segments are looked up in the position table of the layout,
+    //! instead of walking the segments of the measure on every cursor update
+    const Ms::PositionTable::SegmentPosition* position = score()->positionTable().cursorSegment(_tick);
+    if (!position || !position->system) {
         return QRect();
     }
 
-    qreal x = 0.0;
-    Ms::Segment* s = nullptr;
-    for (s = measure->first(Ms::SegmentType::ChordRest); s;) {
-        Fraction t1 = s->tick();
-        int x1 = s->canvasPos().x();
-        qreal x2;
-        Fraction t2;
-        Ms::Segment* ns = s->next(Ms::SegmentType::ChordRest);
-        while (ns && !ns->visible()) {
-            ns = ns->next(Ms::SegmentType::ChordRest);
-        }
-        if (ns) {
-            t2 = ns->tick();
-            x2 = ns->canvasPos().x();
-        } else {
-            t2 = measure->endTick();
-            // measure->width is not good enough because of courtesy keysig, timesig
-            Ms::Segment* seg = measure->findSegment(Ms::SegmentType::EndBarLine, measure->tick() + measure->ticks());
-            if (seg) {
-                x2 = seg->canvasPos().x();
-            } else {
-                x2 = measure->canvasPos().x() + measure->width();             //safety, should not happen
-            }
-        }
-        if (tick >= t1 && tick < t2) {
-            Fraction dt = t2 - t1;
-            qreal dx = x2 - x1;
-            x = x1 + dx * (tick - t1).ticks() / dt.ticks();
-            break;
-        }
-        s = ns;
-    }
+    const Ms::System* system = position->system;
 
-    if (!s) {
-        return QRect();
-    }
+    qreal pageX = position->page->pos().x();
+    qreal x1 = position->pos.x() + pageX;
+    qreal x2 = position->endX + pageX;
+    int dt = position->endTick - position->tick;
+    qreal x = x1 + (x2 - x1) * (static_cast<int>(_tick) - position->tick) / dt;
 
     double y = system->staffYpage(0) + system->page()->pos().y();
     double _spatium = score()->spatium();
@@ -53,6 +53,7 @@ void NotationUndoStack::undo(Ms::EditData* editData)
     score()->undoRedo(true, editData);
     masterScore()->setSaved(isStackClean());
 
+    notifyAboutChanges(changesRange());
     notifyAboutNotationChanged();
     notifyAboutUndo();
     notifyAboutStateChanged();
@@ -81,6 +82,7 @@ void NotationUndoStack::redo(Ms::EditData* editData)
     score()->undoRedo(false, editData);
     masterScore()->setSaved(isStackClean());
 
+    notifyAboutChanges(changesRange());
     notifyAboutNotationChanged();
     notifyAboutRedo();
     notifyAboutStateChanged();
@@ -130,9 +132,13 @@ void NotationUndoStack::commitChanges()
         return;
     }
 
+    //! NOTE The command state is reset by endCmd
+    ScoreChangesRange range = changesRange();
+
     score()->endCmd();
     masterScore()->setSaved(isStackClean());
 
+    notifyAboutChanges(range);
     notifyAboutStateChanged();
 }
 
@@ -171,6 +177,38 @@ Ms::UndoStack* NotationUndoStack::undoStack() const
     return score() ? score()->undoStack() : nullptr;
 }
 
+mu::async::Channel<ScoreChangesRange> NotationUndoStack::changesChannel() const
+{
+    return m_changesChannel;
+}
+
+ScoreChangesRange NotationUndoStack::changesRange() const
+{
+    const Ms::CmdState& cmdState = masterScore()->cmdState();
+
+    if (cmdState._instrumentsChanged || cmdState._excerptsChanged) {
+        return {};
+    }
+
+    const Ms::Fraction zero(0, 1);
+    if (cmdState.startTick() < zero || cmdState.endTick() < zero) {
+        return {};
+    }
+
+    //! NOTE A dynamic changes the velocities up to the next dynamic, which may be on any staff (system dynamics)
+    if (cmdState.layoutFlags & Ms::LayoutFlag::FIX_PITCH_VELO) {
+        return { cmdState.startTick().ticks(), masterScore()->endTick().ticks() };
+    }
+
+    return { cmdState.startTick().ticks(), cmdState.endTick().ticks(),
+             cmdState.startStaff(), cmdState.endStaff() };
+}
+
+void NotationUndoStack::notifyAboutChanges(const ScoreChangesRange& range)
+{
+    m_changesChannel.send(range);
+}
+
 void NotationUndoStack::notifyAboutNotationChanged()
 {
     m_notationChanged.notify();
@@ -56,12 +56,16 @@ public:
     bool isLocked() const override;
 
     async::Notification stackChanged() const override;
+    async::Channel<ScoreChangesRange> changesChannel() const override;
 
 private:
     void notifyAboutNotationChanged();
     void notifyAboutStateChanged();
     void notifyAboutUndo();
     void notifyAboutRedo();
+    void notifyAboutChanges(const ScoreChangesRange& range);
+
+    ScoreChangesRange changesRange() const;
 
     bool isStackClean() const;
 
@@ -75,6 +79,7 @@ private:
     async::Notification m_stackStateChanged;
     async::Notification m_undoNotification;
     async::Notification m_redoNotification;
+    async::Channel<ScoreChangesRange> m_changesChannel;
 
     bool m_isLocked = false;
 };
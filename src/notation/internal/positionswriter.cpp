@@ -24,8 +24,9 @@
 
 #include <cmath>
 
+#include "libmscore/masterscore.h"
+#include "libmscore/positiontable.h"
 #include "libmscore/system.h"
-#include "libmscore/repeatlist.h"
 
 #include "log.h"
 #include "global/xmlwriter.h"
@@ -61,17 +62,6 @@ static void writeEventPosition(XmlWriter& writer, const std::string& id, int tim
     writer.writeEndElement();
 }
 
-static void writeMeasureEvents(XmlWriter& writer, Measure* m, int offset, const QHash<void*, int>& segments)
-{
-    for (Ms::Segment* s = m->first(Ms::SegmentType::ChordRest); s; s = s->next(Ms::SegmentType::ChordRest)) {
-        int tick = s->tick().ticks() + offset;
-        int id = segments[(void*)s];
-        int time = lrint(m->score()->repeatList().utick2utime(tick) * 1000);
-
-        writeEventPosition(writer, std::to_string(id), time);
-    }
-}
-
 PositionsWriter::PositionsWriter(PositionsWriter::ElementType elementType)
     : m_elementType(elementType)
 {
@@ -100,8 +90,6 @@ mu::Ret PositionsWriter::write(INotationPtr notation, Device& destinationDevice,
         return make_ret(Ret::Code::UnknownError);
     }
 
-    QHash<void*, int> segments;
-
     XmlWriter writer(&destinationDevice);
 
     writer.writeStartDocument();
@@ -139,26 +127,6 @@ qreal PositionsWriter::pngDpiResolution() const
     return (imagesExportConfiguration()->exportPngDpiResolution() / Ms::DPI) * 12.0;
 }
 
-QHash<void*, int> PositionsWriter::elementIds(const Ms::Score* score) const
-{
-    QHash<void*, int> elementIds;
-
-    int id = 0;
-    if (m_elementType == ElementType::SEGMENT) {
-        Measure* m = score->firstMeasureMM();
-        for (Ms::Segment* s = (m ? m->first(Ms::SegmentType::ChordRest) : nullptr);
-             s; s = s->next1MM(Ms::SegmentType::ChordRest)) {
-            elementIds[(void*)s] = id++;
-        }
-    } else {
-        for (Measure* m = score->firstMeasureMM(); m; m = m->nextMeasureMM()) {
-            elementIds[(void*)m] = id++;
-        }
-    }
-
-    return elementIds;
-}
-
 void PositionsWriter::writeElementsPositions(XmlWriter& writer, const Ms::Score* score) const
 {
     writer.writeStartElement(ELEMENTS_TAG);
@@ -180,9 +148,9 @@ void PositionsWriter::writeSegmentsPositions(XmlWriter& writer, const Ms::Score*
     int id = 0;
     qreal ndpi = pngDpiResolution();
 
-    Measure* measure = score->firstMeasureMM();
-    for (Ms::Segment* segment = (measure ? measure->first(Ms::SegmentType::ChordRest) : nullptr);
-         segment; segment = segment->next1MM(Ms::SegmentType::ChordRest)) {
+    for (const Ms::PositionTable::SegmentPosition& position : score->positionTable().segments()) {
+        const Ms::Segment* segment = position.segment;
+
         qreal sx = 0;
         int tracks = score->nstaves() * Ms::VOICES;
         for (int track = 0; track < tracks; track++) {
@@ -193,15 +161,12 @@ void PositionsWriter::writeSegmentsPositions(XmlWriter& writer, const Ms::Score*
         }
 
         sx *= ndpi;
-        qreal sy = segment->measure()->system()->height() * ndpi;
-
-        int x = segment->pagePos().x() * ndpi;
-        int y = segment->pagePos().y() * ndpi;
+        qreal sy = position.system ? position.system->height() * ndpi : 0.0;
 
-        Page* page = segment->measure()->system()->page();
-        int pageIndex = score->pageIdx(page);
+        int x = position.pos.x() * ndpi;
+        int y = position.pos.y() * ndpi;
 
-        writeElementPosition(writer, std::to_string(id), PointF(x, y), PointF(sx, sy), pageIndex);
+        writeElementPosition(writer, std::to_string(id), PointF(x, y), PointF(sx, sy), position.pageIdx);
 
         id++;
     }
@@ -212,16 +177,13 @@ void PositionsWriter::writeMeasuresPositions(XmlWriter& writer, const Ms::Score*
     int id = 0;
     qreal ndpi = pngDpiResolution();
 
-    for (Measure* measure = score->firstMeasureMM(); measure; measure = measure->nextMeasureMM()) {
-        qreal sx = measure->bbox().width() * ndpi;
-        qreal sy = measure->system()->height() * ndpi;
-        qreal x = measure->pagePos().x() * ndpi;
-        qreal y = measure->system()->pagePos().y() * ndpi;
+    for (const Ms::PositionTable::MeasurePosition& position : score->positionTable().measures()) {
+        qreal sx = position.measure->bbox().width() * ndpi;
+        qreal sy = position.system ? position.system->height() * ndpi : 0.0;
+        qreal x = position.pos.x() * ndpi;
+        qreal y = position.pos.y() * ndpi;
 
-        Page* page = measure->system()->page();
-        int pageIndex = score->pageIdx(page);
-
-        writeElementPosition(writer, std::to_string(id), PointF(x, y), PointF(sx, sy), pageIndex);
+        writeElementPosition(writer, std::to_string(id), PointF(x, y), PointF(sx, sy), position.pageIdx);
 
         id++;
     }
@@ -229,31 +191,19 @@ void PositionsWriter::writeMeasuresPositions(XmlWriter& writer, const Ms::Score*
 
 void PositionsWriter::writeEventsPositions(XmlWriter& writer, const Ms::Score* score) const
 {
-    QHash<void*, int> elementIds = this->elementIds(score);
-
     writer.writeStartElement(EVENTS_TAG);
 
     score->masterScore()->setExpandRepeats(true);
 
-    for (const Ms::RepeatSegment* repeatSegment : score->repeatList()) {
-        int startTick = repeatSegment->tick;
-        int endTick = startTick + repeatSegment->len();
-        int tickOffset = repeatSegment->utick - repeatSegment->tick;
-        for (Measure* measure = score->tick2measureMM(Fraction::fromTicks(startTick)); measure; measure = measure->nextMeasureMM()) {
-            if (m_elementType == ElementType::SEGMENT) {
-                writeMeasureEvents(writer, measure, tickOffset, elementIds);
-            } else {
-                int tick = measure->tick().ticks() + tickOffset;
-                int id = elementIds[(void*)measure];
-                int time = std::lrint(measure->score()->repeatList().utick2utime(tick) * 1000);
-
-                writeEventPosition(writer, std::to_string(id), time);
-            }
+    //! NOTE The ids of the elements are their indexes in the position table
+    const Ms::PositionTable& table = score->positionTable();
+    const std::vector<Ms::PositionTable::Event>& events = m_elementType == ElementType::SEGMENT
+                                                          ? table.segmentEvents()
+                                                          : table.measureEvents();
 
-            if (measure->endTick().ticks() >= endTick) {
-                break;
-            }
-        }
+    for (const Ms::PositionTable::Event& event : events) {
+        int time = std::lrint(event.utime * 1000);
+        writeEventPosition(writer, std::to_string(event.index), time);
     }
 
     writer.writeEndElement();
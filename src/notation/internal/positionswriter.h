@@ -60,7 +60,6 @@ public:
 
 private:
     qreal pngDpiResolution() const;
-    QHash<void*, int> elementIds(const Ms::Score* score) const;
 
     void writeElementsPositions(framework::XmlWriter& writer, const Ms::Score* score) const;
     void writeSegmentsPositions(framework::XmlWriter& writer, const Ms::Score* score) const;
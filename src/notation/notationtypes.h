@@ -409,6 +409,24 @@ struct SelectionRange
     Fraction endTick;
 };
 
+struct ScoreChangesRange
+{
+    int tickFrom = -1;
+    int tickTo = -1;
+    int staffIdxFrom = -1;
+    int staffIdxTo = -1;
+
+    bool isValidBoundary() const
+    {
+        return tickFrom != -1 && tickTo != -1;
+    }
+
+    bool hasStaves() const
+    {
+        return staffIdxFrom != -1 && staffIdxTo != -1;
+    }
+};
+
 struct StaffConfig
 {
     bool visible = false;
@@ -75,6 +75,8 @@ Rectangle {
         MixerPanelModel {
             id: mixerPanelModel
 
+            panelVisible: root.visible
+
             Component.onCompleted: {
                 mixerPanelModel.load()
             }
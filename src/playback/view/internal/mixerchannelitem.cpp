@@ -22,6 +22,8 @@
 
 #include "mixerchannelitem.h"
 
+#include <algorithm>
+
 using namespace mu::playback;
 using namespace mu::audio;
 
@@ -48,7 +50,6 @@ MixerChannelItem::MixerChannelItem(QObject* parent, const audio::TrackId id, con
 
 MixerChannelItem::~MixerChannelItem()
 {
-    m_audioSignalChanges.pressureChanges.resetOnReceive(this);
 }
 
 TrackId MixerChannelItem::id() const
@@ -139,17 +140,31 @@ void MixerChannelItem::loadOutputParams(const AudioOutputParams& newParams)
     emit outputResourceItemListChanged(m_outputResourceItemList);
 }
 
-void MixerChannelItem::subscribeOnAudioSignalChanges(AudioSignalChanges&& audioSignalChanges)
+void MixerChannelItem::setAudioSignalsSnapshot(AudioSignalsSnapshotPtr snapshot)
 {
-    m_audioSignalChanges = audioSignalChanges;
+    m_audioSignalsSnapshot = std::move(snapshot);
+}
 
-    m_audioSignalChanges.pressureChanges.onReceive(this, [this](const audioch_t audioChNum, const volume_dbfs_t newValue) {
-        //!Note There should be no signal changes when the mixer channel is muted.
-        //!     But some audio signal changes still might be "on the way" from the times when the mixer channel wasn't muted
-        //!     So that we have to just ignore them
-        if (muted()) {
-            return;
-        }
+void MixerChannelItem::updateAudioSignals()
+{
+    if (!m_audioSignalsSnapshot) {
+        return;
+    }
+
+    //!Note The snapshot might still keep the values from the times when the mixer channel wasn't muted
+    //!     So that we have to just ignore them
+    if (muted()) {
+        return;
+    }
+
+    //! NOTE Only the first two channels have their meters
+    audioch_t audioChannelsCount = std::min<audioch_t>(m_audioSignalsSnapshot->audioChannelsCount(), 2);
+    if (audioChannelsCount == 0) {
+        return;
+    }
+
+    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+        volume_dbfs_t newValue = m_audioSignalsSnapshot->pressure(audioChNum);
 
         if (newValue < MIN_DISPLAYED_DBFS) {
             setAudioChannelVolumePressure(audioChNum, MIN_DISPLAYED_DBFS);
@@ -158,7 +173,12 @@ void MixerChannelItem::subscribeOnAudioSignalChanges(AudioSignalChanges&& audioS
         } else {
             setAudioChannelVolumePressure(audioChNum, newValue);
         }
-    });
+    }
+
+    //! NOTE The mono signal is shown by both meters
+    if (audioChannelsCount == 1) {
+        setRightChannelPressure(m_leftChannelPressure);
+    }
 }
 
 void MixerChannelItem::setTitle(QString title)
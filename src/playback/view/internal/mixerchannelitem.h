@@ -78,7 +78,9 @@ public:
     void loadInputParams(const audio::AudioInputParams& newParams);
     void loadOutputParams(const audio::AudioOutputParams& newParams);
 
-    void subscribeOnAudioSignalChanges(audio::AudioSignalChanges&& audioSignalChanges);
+    void setAudioSignalsSnapshot(audio::AudioSignalsSnapshotPtr snapshot);
+    void updateAudioSignals();
+    void resetAudioChannelsVolumePressure();
 
     bool outputOnly() const;
 
@@ -120,7 +122,6 @@ signals:
 
 private:
     void setAudioChannelVolumePressure(const audio::audioch_t chNum, const float newValue);
-    void resetAudioChannelsVolumePressure();
 
     void applyMuteToOutputParams(const bool isMuted);
 
@@ -136,7 +137,7 @@ private:
     InputResourceItem* m_inputResourceItem = nullptr;
     QList<OutputResourceItem*> m_outputResourceItemList;
 
-    audio::AudioSignalChanges m_audioSignalChanges;
+    audio::AudioSignalsSnapshotPtr m_audioSignalsSnapshot = nullptr;
 
     bool m_isMaster = false;
     QString m_title;
@@ -28,12 +28,23 @@
 using namespace mu::playback;
 using namespace mu::audio;
 
+static constexpr int AUDIO_SIGNALS_UPDATE_INTERVAL_MS = 33;
+
 MixerPanelModel::MixerPanelModel(QObject* parent)
     : QAbstractListModel(parent)
 {
     controller()->currentTrackSequenceIdChanged().onNotify(this, [this]() {
         load();
     });
+
+    controller()->isPlayingChanged().onNotify(this, [this]() {
+        updateAudioSignalsTimerState();
+    });
+
+    connect(&m_audioSignalsUpdateTimer, &QTimer::timeout, this, &MixerPanelModel::updateAudioSignals);
+
+    m_audioSignalsUpdateTimer.setSingleShot(false);
+    m_audioSignalsUpdateTimer.setInterval(AUDIO_SIGNALS_UPDATE_INTERVAL_MS);
 }
 
 void MixerPanelModel::load()
@@ -58,6 +69,23 @@ void MixerPanelModel::load()
     });
 }
 
+bool MixerPanelModel::panelVisible() const
+{
+    return m_panelVisible;
+}
+
+void MixerPanelModel::setPanelVisible(bool visible)
+{
+    if (m_panelVisible == visible) {
+        return;
+    }
+
+    m_panelVisible = visible;
+    updateAudioSignalsTimerState();
+
+    emit panelVisibleChanged(m_panelVisible);
+}
+
 QVariant MixerPanelModel::data(const QModelIndex& index, int role) const
 {
     if (!index.isValid() || index.row() >= rowCount() || role != ItemRole) {
@@ -141,6 +169,33 @@ void MixerPanelModel::clear()
     m_mixerChannelList.clear();
 }
 
+void MixerPanelModel::updateAudioSignalsTimerState()
+{
+    //! NOTE The meters are only polled while they are seen and the playback is on
+    bool shouldUpdate = m_panelVisible && controller()->isPlaying();
+    if (shouldUpdate == m_audioSignalsUpdateTimer.isActive()) {
+        return;
+    }
+
+    if (shouldUpdate) {
+        m_audioSignalsUpdateTimer.start();
+        return;
+    }
+
+    m_audioSignalsUpdateTimer.stop();
+
+    for (MixerChannelItem* item : m_mixerChannelList) {
+        item->resetAudioChannelsVolumePressure();
+    }
+}
+
+void MixerPanelModel::updateAudioSignals()
+{
+    for (MixerChannelItem* item : m_mixerChannelList) {
+        item->updateAudioSignals();
+    }
+}
+
 MixerChannelItem* MixerPanelModel::buildTrackChannelItem(const audio::TrackSequenceId& sequenceId, const audio::TrackId& trackId)
 {
     MixerChannelItem* item = new MixerChannelItem(this, trackId);
@@ -172,12 +227,12 @@ MixerChannelItem* MixerPanelModel::buildTrackChannelItem(const audio::TrackSeque
                << ", " << text;
     });
 
-    playback()->audioOutput()->signalChanges(sequenceId, trackId)
-    .onResolve(this, [item](AudioSignalChanges signalChanges) {
-        item->subscribeOnAudioSignalChanges(std::move(signalChanges));
+    playback()->audioOutput()->signalsSnapshot(sequenceId, trackId)
+    .onResolve(this, [item](AudioSignalsSnapshotPtr snapshot) {
+        item->setAudioSignalsSnapshot(std::move(snapshot));
     })
     .onReject(this, [](int errCode, std::string text) {
-        LOGE() << "unable to subscribe on audio signal changes from mixer channel, error code: " << errCode
+        LOGE() << "unable to get audio signals of mixer channel, error code: " << errCode
                << ", " << text;
     });
 
@@ -217,12 +272,12 @@ MixerChannelItem* MixerPanelModel::buildMasterChannelItem()
                << ", " << text;
     });
 
-    playback()->audioOutput()->masterSignalChanges()
-    .onResolve(this, [item](AudioSignalChanges signalChanges) {
-        item->subscribeOnAudioSignalChanges(std::move(signalChanges));
+    playback()->audioOutput()->masterSignalsSnapshot()
+    .onResolve(this, [item](AudioSignalsSnapshotPtr snapshot) {
+        item->setAudioSignalsSnapshot(std::move(snapshot));
     })
     .onReject(this, [](int errCode, std::string text) {
-        LOGE() << "unable to subscribe on audio signal changes from master channel, error code: " << errCode
+        LOGE() << "unable to get audio signals of master channel, error code: " << errCode
                << ", " << text;
     });
 
@@ -25,6 +25,7 @@
 
 #include <QAbstractListModel>
 #include <QList>
+#include <QTimer>
 
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
@@ -42,15 +43,25 @@ class MixerPanelModel : public QAbstractListModel, public async::Asyncable
     INJECT(playback, audio::IPlayback, playback)
     INJECT(playback, IPlaybackController, controller)
 
+    Q_PROPERTY(bool panelVisible READ panelVisible WRITE setPanelVisible NOTIFY panelVisibleChanged)
+
 public:
     explicit MixerPanelModel(QObject* parent = nullptr);
 
     Q_INVOKABLE void load();
 
+    bool panelVisible() const;
+
     QVariant data(const QModelIndex& index, int role) const override;
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     QHash<int, QByteArray> roleNames() const override;
 
+public slots:
+    void setPanelVisible(bool visible);
+
+signals:
+    void panelVisibleChanged(bool visible);
+
 private:
     enum Roles {
         ItemRole = Qt::UserRole + 1
@@ -62,10 +73,16 @@ private:
     void sortItems();
     void clear();
 
+    void updateAudioSignalsTimerState();
+    void updateAudioSignals();
+
     MixerChannelItem* buildTrackChannelItem(const audio::TrackSequenceId& sequenceId, const audio::TrackId& trackId);
     MixerChannelItem* buildMasterChannelItem();
 
     QList<MixerChannelItem*> m_mixerChannelList;
+
+    QTimer m_audioSignalsUpdateTimer;
+    bool m_panelVisible = false;
 };
 }
 
@@ -43,6 +43,36 @@ unsigned int AudioConfigurationStub::driverBufferSize() const
     return 0;
 }
 
+unsigned int AudioConfigurationStub::driverPeriodsCount() const
+{
+    return 0;
+}
+
+size_t AudioConfigurationStub::renderWorkersCount() const
+{
+    return 0;
+}
+
+size_t AudioConfigurationStub::parallelRenderMinChannelsCount() const
+{
+    return 0;
+}
+
+unsigned int AudioConfigurationStub::voicesBudget() const
+{
+    return 0;
+}
+
+unsigned int AudioConfigurationStub::maxSourceSampleRate() const
+{
+    return 0;
+}
+
+io::path AudioConfigurationStub::freezeCacheDirectory() const
+{
+    return io::path();
+}
+
 bool AudioConfigurationStub::isShowControlsInMixer() const
 {
     return false;
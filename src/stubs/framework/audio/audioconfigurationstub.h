@@ -36,6 +36,14 @@ public:
 
     int audioChannelsCount() const override;
     unsigned int driverBufferSize() const override;  // samples
+    unsigned int driverPeriodsCount() const override;
+
+    size_t renderWorkersCount() const override;
+    size_t parallelRenderMinChannelsCount() const override;
+    unsigned int voicesBudget() const override;
+    unsigned int maxSourceSampleRate() const override;
+
+    io::path freezeCacheDirectory() const override;
 
     bool isShowControlsInMixer() const override;
     void setIsShowControlsInMixer(bool show) override;
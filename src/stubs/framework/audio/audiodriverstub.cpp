@@ -69,3 +69,8 @@ void AudioDriverStub::resume()
 void AudioDriverStub::suspend()
 {
 }
+
+IAudioDriver::Stats AudioDriverStub::stats() const
+{
+    return Stats();
+}
@@ -40,6 +40,8 @@ public:
 
     void resume() override;
     void suspend() override;
+
+    Stats stats() const override;
 };
 }
 
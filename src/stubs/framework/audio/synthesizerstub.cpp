@@ -114,6 +114,20 @@ void SynthesizerStub::flushSound()
 {
 }
 
+unsigned int SynthesizerStub::activeVoicesCount() const
+{
+    return 0;
+}
+
+void SynthesizerStub::setVoicesLimit(unsigned int)
+{
+}
+
+unsigned int SynthesizerStub::stolenVoicesCount() const
+{
+    return 0;
+}
+
 void SynthesizerStub::channelSoundsOff(midi::channel_t)
 {
 }
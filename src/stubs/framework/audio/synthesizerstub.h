@@ -60,6 +60,9 @@ public:
 
     void allSoundsOff() override;
     void flushSound() override;
+    unsigned int activeVoicesCount() const override;
+    void setVoicesLimit(unsigned int limit) override;
+    unsigned int stolenVoicesCount() const override;
     void channelSoundsOff(midi::channel_t chan) override;
     bool channelVolume(midi::channel_t chan, float val) override;
     bool channelBalance(midi::channel_t chan, float val) override;
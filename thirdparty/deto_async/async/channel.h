@@ -2,6 +2,7 @@
 #define DETO_ASYNC_CHANNEL_H
 
 #include <memory>
+#include <type_traits>
 #include "internal/abstractinvoker.h"
 
 namespace deto {
@@ -32,6 +33,15 @@ public:
         ptr()->invoke(Receive, nd);
     }
 
+    //! NOTE Rvalue args are moved into the channel and handed over to the last receiver without copying
+    template<typename ... U, typename = std::enable_if_t<sizeof...(U) == sizeof...(T) && (std::is_convertible_v<U&&, T> && ...)> >
+    void send(U&&... d)
+    {
+        NotifyData nd;
+        nd.setArgForwarded<T...>(0, std::forward<U>(d)...);
+        ptr()->invoke(Receive, nd);
+    }
+
     template<typename Func>
     void onReceive(const Asyncable* receiver, Func f, Asyncable::AsyncMode mode = Asyncable::AsyncMode::AsyncSetOnce)
     {
@@ -77,7 +87,14 @@ private:
         Call f;
         ReceiveCall(Call _f)
             : f(_f) {}
-        void received(const NotifyData& d) { std::apply(f, d.arg<Arg...>()); }
+        void received(const NotifyData& d)
+        {
+            if (d.canTakeArgs()) {
+                std::apply(f, d.takeArg<Arg...>());
+            } else {
+                std::apply(f, d.arg<Arg...>());
+            }
+        }
     };
 
     struct IClose {
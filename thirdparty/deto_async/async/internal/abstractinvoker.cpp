@@ -32,16 +32,23 @@ void AbstractInvoker::invoke(int type, const NotifyData& data)
     //! NOTE: explicit copy because collection can be modified from elsewhere
     CallBacks callbacks = it->second;
 
-    for (const CallBack& c : callbacks) {
+    for (size_t i = 0; i < callbacks.size(); ++i) {
+        const CallBack& c = callbacks.at(i);
         if (!it->second.containsReceiver(c.receiver)) {
             qDebug("Skipping removed receiver");
             continue;
         }
         if (c.threadID == threadID) {
+            //! NOTE Only the last direct call may take the args, the rest of the callbacks still need them
+            data.setArgsTakeable(i == callbacks.size() - 1);
             invokeCallback(type, c, data);
+            data.setArgsTakeable(false);
         } else {
-            auto functor = [this, type, c, data]() { invokeCallback(type, c, data); };
-            QueuedInvoker::instance()->invoke(c.threadID, functor);
+            auto functor = [this, type, c, data]() {
+                data.setArgsTakeable(true);
+                invokeCallback(type, c, data);
+            };
+            QueuedInvoker::instance()->invoke(c.threadID, std::move(functor));
         }
     }
 }
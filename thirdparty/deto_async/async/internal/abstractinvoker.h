@@ -8,6 +8,8 @@
 #include <mutex>
 #include <thread>
 #include <functional>
+#include <tuple>
+#include <utility>
 
 #include "../asyncable.h"
 
@@ -25,6 +27,13 @@ public:
         m_args.insert(m_args.begin() + i, std::shared_ptr<IArg>(p));
     }
 
+    template<typename ... T, typename ... U>
+    void setArgForwarded(int i, U&&... val)
+    {
+        IArg* p = new Arg<T...>(std::in_place, std::forward<U>(val)...);
+        m_args.insert(m_args.begin() + i, std::shared_ptr<IArg>(p));
+    }
+
     template<typename ... T>
     std::tuple<T...> arg(int i = 0) const
     {
@@ -36,6 +45,39 @@ public:
         return d->val;
     }
 
+    //! NOTE The args are shared between the copies of the data (one copy per queued call).
+    //! The call that holds the last copy may take the args instead of copying them.
+    void setArgsTakeable(bool takeable) const
+    {
+        m_argsTakeable = takeable;
+    }
+
+    bool canTakeArgs() const
+    {
+        if (!m_argsTakeable) {
+            return false;
+        }
+
+        for (const std::shared_ptr<IArg>& arg : m_args) {
+            if (arg.use_count() != 1) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template<typename ... T>
+    std::tuple<T...> takeArg(int i = 0) const
+    {
+        IArg* p = m_args.at(i).get();
+        if (!p) {
+            return {};
+        }
+        Arg<T...>* d = reinterpret_cast<Arg<T...>*>(p);
+        return std::move(d->val);
+    }
+
     struct IArg {
         virtual ~IArg() = default;
     };
@@ -45,10 +87,15 @@ public:
         std::tuple<T...> val;
         Arg(const T&... v)
             : IArg(), val(v ...) {}
+
+        template<typename ... U>
+        Arg(std::in_place_t, U&&... v)
+            : IArg(), val(std::forward<U>(v)...) {}
     };
 
 private:
     std::vector<std::shared_ptr<IArg> > m_args;
+    mutable bool m_argsTakeable = false;
 };
 
 class QueuedInvoker;
@@ -40,7 +40,7 @@ void AsyncImpl::call(Asyncable* caller, IFunction* f, const std::thread::id& th)
     }
 
     auto functor = [this, key]() { onCall(key); };
-    QueuedInvoker::instance()->invoke(th, functor, true);
+    QueuedInvoker::instance()->invoke(th, std::move(functor), true);
 }
 
 void AsyncImpl::onCall(uint64_t key)
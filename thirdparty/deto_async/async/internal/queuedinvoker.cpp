@@ -1,41 +1,178 @@
 #include "queuedinvoker.h"
 
+#include <unordered_map>
+
 using namespace deto::async;
 
+namespace deto::async {
+//! NOTE Closes the queue of the thread when the thread finishes,
+//! the messages sent to it after that are dropped
+struct ThreadQueueOwner {
+    QueuedInvoker::ThreadQueuePtr queue;
+
+    ~ThreadQueueOwner()
+    {
+        if (queue) {
+            queue->close();
+            QueuedInvoker::instance()->unregisterQueue(queue);
+        }
+    }
+};
+}
+
+static thread_local ThreadQueueOwner s_ownQueue;
+
 QueuedInvoker* QueuedInvoker::instance()
 {
     static QueuedInvoker i;
     return &i;
 }
 
-void QueuedInvoker::invoke(const std::thread::id& th, const Functor& f, bool isAlwaysQueued)
+QueuedInvoker::ThreadQueue::ThreadQueue(const std::thread::id& th)
+    : m_threadID(th)
+{
+    m_head.store(&m_stub, std::memory_order_relaxed);
+    m_tail = &m_stub;
+}
+
+QueuedInvoker::ThreadQueue::~ThreadQueue()
+{
+    while (Message* m = pop()) {
+        delete m;
+    }
+}
+
+const std::thread::id& QueuedInvoker::ThreadQueue::threadID() const
+{
+    return m_threadID;
+}
+
+void QueuedInvoker::ThreadQueue::push(Message* m)
 {
-    if (m_onMainThreadInvoke) {
-        if (th == m_mainThreadID) {
-            m_onMainThreadInvoke(f, isAlwaysQueued);
+    pushNode(m);
+}
+
+void QueuedInvoker::ThreadQueue::pushNode(Node* n)
+{
+    n->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = m_head.exchange(n, std::memory_order_acq_rel);
+    prev->next.store(n, std::memory_order_release);
+}
+
+QueuedInvoker::Message* QueuedInvoker::ThreadQueue::pop()
+{
+    Node* tail = m_tail;
+    Node* next = tail->next.load(std::memory_order_acquire);
+
+    if (tail == &m_stub) {
+        if (!next) {
+            return nullptr;
         }
+
+        m_tail = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next) {
+        m_tail = next;
+        return static_cast<Message*>(tail);
+    }
+
+    //! NOTE A producer is in the middle of the push, the message will be taken on the next pop
+    if (tail != m_head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    pushNode(&m_stub);
+
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+        m_tail = next;
+        return static_cast<Message*>(tail);
+    }
+
+    return nullptr;
+}
+
+bool QueuedInvoker::ThreadQueue::isClosed() const
+{
+    return m_closed.load(std::memory_order_acquire);
+}
+
+void QueuedInvoker::ThreadQueue::close()
+{
+    m_closed.store(true, std::memory_order_release);
+}
+
+void QueuedInvoker::enqueue(const std::thread::id& th, Message* m)
+{
+    threadQueue(th)->push(m);
+}
+
+QueuedInvoker::ThreadQueue* QueuedInvoker::threadQueue(const std::thread::id& th)
+{
+    thread_local std::unordered_map<std::thread::id, ThreadQueuePtr> cache;
+
+    ThreadQueuePtr& queue = cache[th];
+    if (!queue || queue->isClosed()) {
+        queue = registeredQueue(th);
+    }
+
+    return queue.get();
+}
+
+QueuedInvoker::ThreadQueuePtr QueuedInvoker::registeredQueue(const std::thread::id& th)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ThreadQueuePtr& queue = m_queues[th];
+    if (!queue) {
+        queue = std::make_shared<ThreadQueue>(th);
     }
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    m_queues[th].push(f);
+    return queue;
+}
+
+void QueuedInvoker::unregisterQueue(const ThreadQueuePtr& queue)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_queues.find(queue->threadID());
+    if (it != m_queues.end() && it->second == queue) {
+        m_queues.erase(it);
+    }
 }
 
 void QueuedInvoker::processEvents()
 {
-    Queue q;
-    {
-        std::lock_guard<std::recursive_mutex> lock(m_mutex);
-        auto n = m_queues.extract(std::this_thread::get_id());
-        if (!n.empty()) {
-            q = n.mapped();
-        }
+    if (!s_ownQueue.queue) {
+        s_ownQueue.queue = registeredQueue(std::this_thread::get_id());
     }
-    while (!q.empty()) {
-        const auto& f = q.front();
-        if (f) {
-            f();
-        }
-        q.pop();
+
+    ThreadQueue* queue = s_ownQueue.queue.get();
+
+    //! NOTE Take the batch of the messages available now,
+    //! the messages sent while it is processed are handled on the next call
+    Message* first = queue->pop();
+    if (!first) {
+        return;
+    }
+
+    Message* last = first;
+    last->next.store(nullptr, std::memory_order_relaxed);
+    while (Message* m = queue->pop()) {
+        m->next.store(nullptr, std::memory_order_relaxed);
+        last->next.store(m, std::memory_order_relaxed);
+        last = m;
+    }
+
+    Message* m = first;
+    while (m) {
+        Message* next = static_cast<Message*>(m->next.load(std::memory_order_relaxed));
+        m->call();
+        delete m;
+        m = next;
     }
 }
 
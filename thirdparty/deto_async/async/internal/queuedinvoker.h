@@ -2,10 +2,14 @@
 #define DETO_ASYNC_QUEUEDINVOKER_H
 
 #include <functional>
-#include <queue>
+#include <atomic>
+#include <memory>
 #include <map>
 #include <mutex>
+#include <new>
 #include <thread>
+#include <type_traits>
+#include <cstddef>
 
 namespace deto {
 namespace async {
@@ -17,7 +21,17 @@ public:
 
     using Functor = std::function<void ()>;
 
-    void invoke(const std::thread::id& th, const Functor& f, bool isAlwaysQueued = false);
+    template<typename F>
+    void invoke(const std::thread::id& th, F&& f, bool isAlwaysQueued = false)
+    {
+        if (m_onMainThreadInvoke && th == m_mainThreadID) {
+            m_onMainThreadInvoke(Functor(std::forward<F>(f)), isAlwaysQueued);
+            return;
+        }
+
+        enqueue(th, Message::create(std::forward<F>(f)));
+    }
+
     void processEvents();
     void onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f);
 
@@ -25,10 +39,94 @@ private:
 
     QueuedInvoker() = default;
 
-    using Queue = std::queue<Functor>;
+    struct Node {
+        std::atomic<Node*> next { nullptr };
+    };
+
+    //! NOTE Small callables are stored inside the message itself,
+    //! so a message costs one allocation
+    class Message : public Node
+    {
+    public:
+        template<typename F>
+        static Message* create(F&& f)
+        {
+            using Fn = std::decay_t<F>;
+
+            Message* m = new Message();
+            if constexpr (sizeof(Fn) <= STORAGE_SIZE && alignof(Fn) <= alignof(std::max_align_t)) {
+                new (m->m_storage) Fn(std::forward<F>(f));
+                m->m_call = [](void* p) { (*static_cast<Fn*>(p))(); };
+                m->m_destroy = [](void* p) { static_cast<Fn*>(p)->~Fn(); };
+            } else {
+                new (m->m_storage) Fn*(new Fn(std::forward<F>(f)));
+                m->m_call = [](void* p) { (**static_cast<Fn**>(p))(); };
+                m->m_destroy = [](void* p) { delete *static_cast<Fn**>(p); };
+            }
+
+            return m;
+        }
+
+        ~Message()
+        {
+            m_destroy(m_storage);
+        }
+
+        void call()
+        {
+            m_call(m_storage);
+        }
+
+    private:
+        Message() = default;
+
+        static constexpr size_t STORAGE_SIZE = 128;
+
+        alignas(std::max_align_t) unsigned char m_storage[STORAGE_SIZE];
+        void (*m_call)(void*) = nullptr;
+        void (*m_destroy)(void*) = nullptr;
+    };
+
+    //! NOTE Intrusive multi-producer single-consumer queue (D. Vyukov).
+    //! Any thread may push, only the owner thread pops
+    class ThreadQueue
+    {
+    public:
+        explicit ThreadQueue(const std::thread::id& th);
+        ~ThreadQueue();
+
+        const std::thread::id& threadID() const;
+
+        void push(Message* m);
+        Message* pop();
+
+        bool isClosed() const;
+        void close();
+
+    private:
+        void pushNode(Node* n);
+
+        std::thread::id m_threadID;
+        std::atomic<Node*> m_head { nullptr };
+        Node* m_tail = nullptr;
+        Node m_stub;
+        std::atomic<bool> m_closed { false };
+    };
+
+    using ThreadQueuePtr = std::shared_ptr<ThreadQueue>;
+
+    void enqueue(const std::thread::id& th, Message* m);
+
+    ThreadQueue* threadQueue(const std::thread::id& th);
+    ThreadQueuePtr registeredQueue(const std::thread::id& th);
+    void unregisterQueue(const ThreadQueuePtr& queue);
+
+    friend struct ThreadQueueOwner;
 
-    std::recursive_mutex m_mutex;
-    std::map<std::thread::id, Queue > m_queues;
+    //! NOTE Only used to register/unregister the queue of a thread,
+    //! the threads keep the found queues in a thread local cache
+    std::mutex m_mutex;
+    std::map<std::thread::id, ThreadQueuePtr> m_queues;
 
     std::function<void(const std::function<void()>&, bool)> m_onMainThreadInvoke;
     std::thread::id m_mainThreadID;